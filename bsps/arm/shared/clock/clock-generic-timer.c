@@ -42,6 +42,11 @@ typedef struct {
 
 static arm_gt_clock_context arm_gt_clock_instance;
 
+#if !defined(CLOCK_DRIVER_USE_ONLY_BOOT_PROCESSOR) && \
+  !CLOCK_DRIVER_USE_FAST_IDLE
+#define CLOCK_DRIVER_USE_TICK_SUPPRESSION 1
+#endif
+
 /* This is defined in dev/clock/clockimpl.h */
 void Clock_isr(rtems_irq_hdl_param arg);
 
@@ -92,6 +97,64 @@ static void arm_gt_clock_at_tick(void)
   arm_gt_clock_set_compare_value(cval);
 }
 
+#if CLOCK_DRIVER_USE_TICK_SUPPRESSION
+static void arm_gt_clock_suppress_ticks(uint32_t ticks)
+{
+  uint64_t cval;
+  uint32_t interval;
+
+  /* The at tick handler programmed the compare value for the next tick */
+  interval = arm_gt_clock_instance.interval;
+  cval = arm_gt_clock_get_compare_value();
+  cval += (uint64_t) (ticks - 1) * interval;
+  arm_gt_clock_set_compare_value(cval);
+}
+
+static uint32_t arm_gt_clock_resume_ticks(uint32_t ticks)
+{
+  uint64_t cval;
+  uint64_t elapsed;
+  uint32_t interval;
+
+  interval = arm_gt_clock_instance.interval;
+  cval = arm_gt_clock_get_compare_value();
+  cval -= (uint64_t) ticks * interval;
+  elapsed = (arm_gt_clock_get_count() - cval) / interval;
+
+  if (elapsed >= ticks) {
+    /* The clock tick interrupt is pending */
+    return ticks - 1;
+  }
+
+  /*
+   * If the counter passes the new compare value before it is set, then the
+   * clock tick interrupt is raised immediately.
+   */
+  cval += (elapsed + 1) * interval;
+  arm_gt_clock_set_compare_value(cval);
+  return (uint32_t) elapsed;
+}
+
+static uint32_t arm_gt_clock_maximum_suppressed_ticks(void)
+{
+  uint64_t half_second;
+  uint64_t ticks;
+
+  /*
+   * The timecounter multiplies the counter delta since the last windup by the
+   * 64-bit scale of its frequency, which overflows after one second.
+   */
+  half_second = arm_gt_clock_instance.tc.tc_frequency / 2;
+  ticks = half_second / arm_gt_clock_instance.interval;
+
+  if (ticks == 0) {
+    return 1;
+  }
+
+  return (uint32_t) ticks;
+}
+#endif
+
 static void arm_gt_clock_handler_install(void)
 {
   rtems_status_code sc;
@@ -195,6 +258,17 @@ RTEMS_SYSINIT_ITEM(
 #define Clock_driver_support_initialize_hardware() \
   arm_gt_clock_initialize()
 
+#if CLOCK_DRIVER_USE_TICK_SUPPRESSION
+#define Clock_driver_support_suppress_ticks(ticks) \
+  arm_gt_clock_suppress_ticks(ticks)
+
+#define Clock_driver_support_resume_ticks(ticks) \
+  arm_gt_clock_resume_ticks(ticks)
+
+#define Clock_driver_support_maximum_suppressed_ticks() \
+  arm_gt_clock_maximum_suppressed_ticks()
+#endif
+
 #define Clock_driver_support_install_isr(isr) \
   arm_gt_clock_handler_install()
 
@@ -41,6 +41,43 @@
 #error "Fast Idle PLUS n ISRs per tick is not supported"
 #endif
 
+/*
+ * A clock driver which is able to program the next clock tick interrupt of
+ * the current processor may define CLOCK_DRIVER_USE_TICK_SUPPRESSION to one.
+ * It must provide the following hooks:
+ *
+ * void Clock_driver_support_suppress_ticks(uint32_t ticks): Programs the next
+ * clock tick interrupt to occur the specified count of clock ticks after the
+ * last clock tick interrupt.
+ *
+ * uint32_t Clock_driver_support_resume_ticks(uint32_t ticks): Programs the
+ * next clock tick interrupt to occur at the next clock tick and returns the
+ * count of clock ticks which elapsed since the last clock tick interrupt and
+ * precede the next clock tick interrupt.  The ticks parameter is the value of
+ * the last suppress call.
+ *
+ * uint32_t Clock_driver_support_maximum_suppressed_ticks(void): Returns the
+ * maximum count of clock ticks which may be suppressed at once.  The
+ * timecounter must not overflow within this time.  In addition, the
+ * timecounter scales the counter delta since the last windup with a 64-bit
+ * multiplication which overflows after one second, so the suppressed time
+ * should not exceed about half a second.  It is called after
+ * Clock_driver_support_initialize_hardware().
+ *
+ * The application enables the clock tick suppression with
+ * CONFIGURE_CLOCK_TICK_SUPPRESSION.
+ */
+#if CLOCK_DRIVER_USE_TICK_SUPPRESSION
+  #if CLOCK_DRIVER_USE_FAST_IDLE || CLOCK_DRIVER_ISRS_PER_TICK
+    #error "Tick suppression PLUS fast idle or n ISRs per tick is not supported"
+  #endif
+
+  #if defined(CLOCK_DRIVER_USE_DUMMY_TIMECOUNTER) || \
+    defined(CLOCK_DRIVER_USE_ONLY_BOOT_PROCESSOR)
+    #error "Tick suppression needs a clock tick interrupt on each processor"
+  #endif
+#endif
+
 /**
  * @brief Do nothing by default.
  */
@@ -113,6 +150,32 @@ static void Clock_driver_timecounter_tick( void )
  */
 volatile uint32_t    Clock_driver_ticks;
 
+#if CLOCK_DRIVER_USE_TICK_SUPPRESSION
+static void Clock_driver_suppress_ticks(
+  Per_CPU_Control *cpu_self,
+  uint32_t         ticks
+)
+{
+  (void) cpu_self;
+  Clock_driver_support_suppress_ticks( ticks );
+}
+
+static uint32_t Clock_driver_resume_ticks(
+  Per_CPU_Control *cpu_self,
+  uint32_t         ticks
+)
+{
+  (void) cpu_self;
+  return Clock_driver_support_resume_ticks( ticks );
+}
+
+static const Watchdog_Tick_suppression_operations
+Clock_driver_tick_suppression = {
+  .suppress = Clock_driver_suppress_ticks,
+  .resume = Clock_driver_resume_ticks
+};
+#endif
+
 #ifdef Clock_driver_support_shutdown_hardware
 #error "Clock_driver_support_shutdown_hardware() is no longer supported"
 #endif
@@ -191,6 +254,14 @@ rtems_isr Clock_isr(
        */
       Clock_driver_timecounter_tick();
     #endif
+
+    #if CLOCK_DRIVER_USE_TICK_SUPPRESSION
+      /*
+       *  Suppress the clock ticks up to the next watchdog expiration if this
+       *  processor is idle.
+       */
+      _Watchdog_Suppress_ticks( _Per_CPU_Get() );
+    #endif
   #endif
 }
 
@@ -234,6 +305,13 @@ rtems_device_driver Clock_initialize(
    */
   Clock_driver_support_initialize_hardware();
 
+  #if CLOCK_DRIVER_USE_TICK_SUPPRESSION
+    _Watchdog_Enable_tick_suppression(
+      &Clock_driver_tick_suppression,
+      Clock_driver_support_maximum_suppressed_ticks()
+    );
+  #endif
+
   /*
    *  If we are counting ISRs per tick, then initialize the counter.
    */
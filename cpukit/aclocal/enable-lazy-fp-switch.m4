@@ -0,0 +1,9 @@
+AC_DEFUN([RTEMS_ENABLE_LAZY_FP_SWITCH],
+  [AC_ARG_ENABLE(lazy-fp-switch,
+    [AS_HELP_STRING([--enable-lazy-fp-switch],[enable the lazy floating point context switch on ports which support it (default=no)])],
+    [case "${enableval}" in 
+      yes) RTEMS_HAS_LAZY_FP_SWITCH=yes ;;
+      no) RTEMS_HAS_LAZY_FP_SWITCH=no ;;
+      *) AC_MSG_ERROR(bad value ${enableval} for enable lazy FP switch option) ;;
+    esac],
+    [RTEMS_HAS_LAZY_FP_SWITCH=no])])
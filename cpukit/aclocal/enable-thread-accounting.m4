@@ -0,0 +1,9 @@
+AC_DEFUN([RTEMS_ENABLE_THREAD_ACCOUNTING],
+  [AC_ARG_ENABLE(thread-accounting,
+    [AS_HELP_STRING([--enable-thread-accounting],[enable the accounting of ready, wait and interrupt times of threads (default=no)])],
+    [case "${enableval}" in 
+      yes) RTEMS_HAS_THREAD_ACCOUNTING=yes ;;
+      no) RTEMS_HAS_THREAD_ACCOUNTING=no ;;
+      *) AC_MSG_ERROR(bad value ${enableval} for enable thread accounting option) ;;
+    esac],
+    [RTEMS_HAS_THREAD_ACCOUNTING=no])])
@@ -0,0 +1,9 @@
+AC_DEFUN([RTEMS_ENABLE_WATCHDOG_TIMER_WHEEL],
+  [AC_ARG_ENABLE(watchdog-timer-wheel,
+    [AS_HELP_STRING([--enable-watchdog-timer-wheel],[use a hierarchical timer wheel for the watchdogs (default=no)])],
+    [case "${enableval}" in 
+      yes) RTEMS_HAS_WATCHDOG_TIMER_WHEEL=yes ;;
+      no) RTEMS_HAS_WATCHDOG_TIMER_WHEEL=no ;;
+      *) AC_MSG_ERROR(bad value ${enableval} for enable watchdog timer wheel option) ;;
+    esac],
+    [RTEMS_HAS_WATCHDOG_TIMER_WHEEL=no])])
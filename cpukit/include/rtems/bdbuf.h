@@ -47,7 +47,9 @@ extern "C" {
  *
  * The Block Device Buffer Management implements a cache between the disk
  * devices and file systems.  The code provides read-ahead and write queuing to
- * the drivers and fast cache look-up using an AVL tree.
+ * the drivers and fast cache look-up using hash tables.  The cache is partitioned
+ * into shards, each with its own lock, hash table and lists, so that accesses
+ * to blocks of different shards do not contend for a lock.
  *
  * The block size used by a file system can be set at runtime and must be a
  * multiple of the disk device block size.  The disk device's physical block
@@ -132,7 +134,8 @@ extern "C" {
  * Empty or cached buffers are added to the LRU list and removed from this
  * queue when a caller requests a buffer.  This is referred to as getting a
  * buffer in the code and the event get in the state diagram.  The buffer is
- * assigned to a block and inserted to the AVL based on the block/device key.
+ * assigned to a block and inserted to the hash table based on the block/device
+ * key.
  * If the block is to be read by the user and not in the cache it is transfered
  * from the disk into memory.  If no buffers are on the LRU list the modified
  * list is checked.  If buffers are on the modified the swap out task will be
@@ -151,14 +154,26 @@ extern "C" {
  * released as modified the user would have to block waiting until it had been
  * written.  This would be a performance problem.
  *
+ * The swap out task writes the buffers of one device at a time.  The buffers
+ * are sorted by block and adjacent blocks are merged into requests of at most
+ * the maximum write blocks.  A write of the swap out task stops after the
+ * current request in case a sync of another device is requested.  The
+ * remaining buffers are written after the sync.
+ *
  * The code performs multiple block reads and writes.  Multiple block reads or
  * read-ahead increases performance with hardware that supports it.  It also
  * helps with a large cache as the disk head movement is reduced.  It however
  * is a speculative operation so excessive use can remove valuable and needed
  * blocks from the cache.  The read-ahead is triggered after two misses of
  * ascending consecutive blocks or a read hit of a block read by the
- * most-resent read-ahead transfer.  The read-ahead works per disk, but all
- * transfers are issued by the read-ahead task.
+ * most-resent read-ahead transfer.  Each disk tracks several concurrent
+ * sequential read streams.  The read-ahead window of a stream doubles with
+ * each read-ahead transfer up to the maximum read-ahead blocks and is halved
+ * if read-ahead blocks are recycled before the stream reached them.  The
+ * blocks of a window which are not in the cache are read by one scatter/gather
+ * transfer, or by one transfer per run of consecutive blocks if the device
+ * requires continuous multi-sector transfers.  All read-ahead transfers are
+ * issued by the read-ahead task.
  *
  * The cache has the following lists of buffers:
  *  - LRU: Accessed or transfered buffers released in least recently used
@@ -181,11 +196,11 @@ extern "C" {
  * @brief State of a buffer of the cache.
  *
  * The state has several implications.  Depending on the state a buffer can be
- * in the AVL tree, in a list, in use by an entity and a group user or not.
+ * in the hash table, in a list, in use by an entity and a group user or not.
  *
  * <table>
  *   <tr>
- *     <th>State</th><th>Valid Data</th><th>AVL Tree</th>
+ *     <th>State</th><th>Valid Data</th><th>Hash Table</th>
  *     <th>LRU List</th><th>Modified List</th><th>Synchronization List</th>
  *     <th>Group User</th><th>External User</th>
  *   </tr>
@@ -302,20 +317,14 @@ typedef struct rtems_bdbuf_group rtems_bdbuf_group;
 /**
  * To manage buffers we using buffer descriptors (BD). A BD holds a buffer plus
  * a range of other information related to managing the buffer in the cache. To
- * speed-up buffer lookup descriptors are organized in AVL-Tree. The fields
+ * speed-up buffer lookup descriptors are organized in hash tables. The fields
  * 'dd' and 'block' are search keys.
  */
 typedef struct rtems_bdbuf_buffer
 {
   rtems_chain_node link;       /**< Link the BD onto a number of lists. */
 
-  struct rtems_bdbuf_avl_node
-  {
-    struct rtems_bdbuf_buffer* left;   /**< Left Child */
-    struct rtems_bdbuf_buffer* right;  /**< Right Child */
-    signed char                cache;  /**< Cache */
-    signed char                bal;    /**< The balance of the sub-tree */
-  } avl;
+  struct rtems_bdbuf_buffer* hash_next; /**< Next BD in the hash bucket. */
 
   rtems_disk_device *dd;        /**< disk device */
 
@@ -327,6 +336,9 @@ typedef struct rtems_bdbuf_buffer
 
   uint32_t waiters;              /**< The number of threads waiting on this
                                   * buffer. */
+  bool read_ahead;               /**< The buffer was transfered by a
+                                  * read-ahead request and not accessed
+                                  * since then. */
   rtems_bdbuf_group* group;      /**< Pointer to the group of BDs this BD is
                                   * part of. */
   uint32_t hold_timer;           /**< Timer to indicate how long a buffer
@@ -352,6 +364,9 @@ struct rtems_bdbuf_group
                                       * 2. */
   uint32_t            users;         /**< How many users the block has. */
   rtems_bdbuf_buffer* bdbuf;         /**< First BD this block covers. */
+  size_t              shard_index;   /**< Index of the cache shard which owns
+                                      * the group. A group without users
+                                      * may move to another shard. */
 };
 
 /**
@@ -359,8 +374,11 @@ struct rtems_bdbuf_group
  * structure.
  */
 typedef struct rtems_bdbuf_config {
-  uint32_t            max_read_ahead_blocks;   /**< Number of blocks to read
-                                                * ahead. */
+  uint32_t            max_read_ahead_blocks;   /**< Maximum number of blocks
+                                                * to read ahead.  The
+                                                * read-ahead window of a
+                                                * stream grows up to this
+                                                * count. */
   uint32_t            max_write_blocks;        /**< Number of blocks to write
                                                 * at once. */
   rtems_task_priority swapout_priority;        /**< Priority of the swap out
@@ -383,6 +401,9 @@ typedef struct rtems_bdbuf_config {
                                                 * allocation size. */
   rtems_task_priority read_ahead_priority;     /**< Priority of the read-ahead
                                                 * task. */
+  size_t              shard_count;             /**< Number of cache shards.
+                                                * It is limited by the number
+                                                * of groups. */
 } rtems_bdbuf_config;
 
 /**
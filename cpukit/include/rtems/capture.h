@@ -579,6 +579,82 @@ rtems_status_code rtems_capture_read (uint32_t     cpu,
  */
 rtems_status_code rtems_capture_release (uint32_t cpu, uint32_t count);
 
+/**
+ * @brief Capture compact format state.
+ *
+ * The capture buffer keeps the full records, since rtems_capture_read()
+ * provides them in place.  The compact format reduces the size of the records
+ * while they are transferred, for example over a slow link.  Each record is
+ * encoded as unsigned LEB128 integers: the events, the zigzag encoded time and
+ * task identifier differences to the previous record, and the size of the
+ * record data, followed by the record data as is.
+ *
+ * The state is the time and task identifier of the previous record.  The
+ * records of each processor are a stream of their own, so use one state for
+ * each processor on the encoder and the decoder side.
+ */
+typedef struct
+{
+  rtems_capture_time time;
+  rtems_id           task_id;
+} rtems_capture_compact_state;
+
+/**
+ * @brief Maximum size of an encoded record in the compact format without the
+ * record data.
+ */
+#define RTEMS_CAPTURE_COMPACT_HEADER_SIZE_MAX 30
+
+/**
+ * @brief Capture compact format initialize
+ *
+ * This function initializes the state of a compact format encoder or
+ * decoder.
+ *
+ * @param[in] state The state to initialize.
+ */
+void rtems_capture_compact_initialize (rtems_capture_compact_state* state);
+
+/**
+ * @brief Capture compact format encode
+ *
+ * This function encodes a capture record in the compact format.
+ *
+ * @param[in] state The encoder state of the processor of the record.
+ * @param[in] rec The capture record as provided by rtems_capture_read().  It
+ *            may be unaligned.
+ * @param[out] buf The buffer for the encoded record.  It shall have a size of
+ *             at least RTEMS_CAPTURE_COMPACT_HEADER_SIZE_MAX bytes plus the
+ *             size of the record data.
+ *
+ * @retval This method returns the size of the encoded record in bytes.
+ */
+size_t rtems_capture_compact_encode (rtems_capture_compact_state* state,
+                                     const void*                  rec,
+                                     void*                        buf);
+
+/**
+ * @brief Capture compact format decode
+ *
+ * This function decodes a capture record in the compact format.  The decoder
+ * state is only updated if a record was decoded.
+ *
+ * @param[in] state The decoder state of the processor of the record.
+ * @param[in] buf The encoded records.
+ * @param[in] size The size of the encoded records in bytes.
+ * @param[out] rec The buffer for the decoded capture record.
+ * @param[in] rec_size The size of the buffer for the decoded record in bytes.
+ *
+ * @retval This method returns the count of bytes of the decoded record.  It
+ *         returns zero if the buffer does not contain a complete record or the
+ *         decoded record does not fit into the record buffer.
+ */
+size_t rtems_capture_compact_decode (rtems_capture_compact_state* state,
+                                     const void*                  buf,
+                                     size_t                       size,
+                                     void*                        rec,
+                                     size_t                       rec_size);
+
 /**
  * @brief Capture filter
  *
@@ -30,6 +30,7 @@
 #include <rtems/ioimpl.h>
 #include <rtems/sysinit.h>
 #include <rtems/score/apimutex.h>
+#include <rtems/score/heapimpl.h>
 #include <rtems/score/percpu.h>
 #include <rtems/score/userextimpl.h>
 #include <rtems/score/wkspace.h>
@@ -195,6 +196,18 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
   #warning "CONFIGURE_SMP_APPLICATION is obsolete since RTEMS 5.1"
 #endif
 
+/*
+ * The processor clusters are used by the cohort SMP locks to prefer lock
+ * hand overs within a cluster.  By default, all processors are in one cluster.
+ */
+#ifndef CONFIGURE_PROCESSORS_PER_CLUSTER
+  #define CONFIGURE_PROCESSORS_PER_CLUSTER _CONFIGURE_MAXIMUM_PROCESSORS
+#endif
+
+#if CONFIGURE_PROCESSORS_PER_CLUSTER < 1
+  #error "CONFIGURE_PROCESSORS_PER_CLUSTER must be greater than zero"
+#endif
+
 /*
  * This sets up the resources for the FIFOs/pipes.
  */
@@ -581,8 +594,14 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
           &IMFS_mknod_control_dir_default,
         #endif
         &IMFS_mknod_control_device,
-        #ifdef CONFIGURE_IMFS_DISABLE_MKNOD_FILE
+        #if defined(CONFIGURE_IMFS_DISABLE_MKNOD_FILE)
           &IMFS_mknod_control_enosys,
+        #elif defined(CONFIGURE_IMFS_USE_EXTENT_FILES)
+          /*
+           * Regular files store their data in contiguous extents and
+           * support shared mappings via mmap().
+           */
+          &IMFS_mknod_control_extfile,
         #else
           &IMFS_mknod_control_memfile,
         #endif
@@ -1201,6 +1220,72 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
     RTEMS_SECTION( ".rtemsstack.interrupt.end" ) = { };
 #endif
 
+/**
+ * @brief Task stack pool configuration.
+ *
+ * Define CONFIGURE_TASK_STACK_POOL to a sequence of
+ * RTEMS_STACK_POOL_CLASS( stack_size, stack_count ) entries without
+ * separators, e.g. RTEMS_STACK_POOL_CLASS( 4096, 8 )
+ * RTEMS_STACK_POOL_CLASS( 16384, 2 ), to allocate the task stacks from a pool
+ * with these size classes, see <rtems/stackpool.h>.  The pool is allocated
+ * from the workspace during system initialization.  Its size is added to the
+ * stack space, so it needs no CONFIGURE_EXTRA_TASK_STACKS.  Define
+ * CONFIGURE_TASK_STACK_POOL_PAINTING to paint the pool stacks and track their
+ * high water marks.
+ */
+#ifdef CONFIGURE_TASK_STACK_POOL
+  #if defined(CONFIGURE_TASK_STACK_ALLOCATOR_INIT) \
+    || defined(CONFIGURE_TASK_STACK_ALLOCATOR) \
+    || defined(CONFIGURE_TASK_STACK_DEALLOCATOR)
+    #error "CONFIGURE_TASK_STACK_POOL cannot be used with a custom task stack allocator"
+  #endif
+
+  #include <rtems/stackpool.h>
+
+  #define CONFIGURE_TASK_STACK_ALLOCATOR_INIT rtems_stack_pool_initialize
+  #define CONFIGURE_TASK_STACK_ALLOCATOR rtems_stack_pool_allocate
+  #define CONFIGURE_TASK_STACK_DEALLOCATOR rtems_stack_pool_free
+
+  /*
+   * The RTEMS_STACK_POOL_CLASS() entries are expanded once to initialize the
+   * size classes and once to get the workspace size of the pool.
+   */
+  #ifdef CONFIGURE_INIT
+    #define RTEMS_STACK_POOL_CLASS( _stack_size, _stack_count ) \
+      { _stack_size, _stack_count },
+
+    const rtems_stack_pool_class rtems_stack_pool_classes[] = {
+      CONFIGURE_TASK_STACK_POOL
+    };
+
+    #undef RTEMS_STACK_POOL_CLASS
+
+    const size_t rtems_stack_pool_class_count =
+      RTEMS_ARRAY_SIZE( rtems_stack_pool_classes );
+
+    #ifdef CONFIGURE_TASK_STACK_POOL_PAINTING
+      const bool rtems_stack_pool_painting = true;
+    #else
+      const bool rtems_stack_pool_painting = false;
+    #endif
+  #endif
+
+  #define RTEMS_STACK_POOL_CLASS( _stack_size, _stack_count ) \
+    + _Configure_From_workspace( \
+      _Configure_Align_up( _stack_size, CPU_STACK_ALIGNMENT ) \
+        * ( _stack_count ) \
+        + CPU_STACK_ALIGNMENT \
+    ) \
+    + _Configure_From_workspace( \
+      RTEMS_STACK_POOL_SLOT_SIZE * ( _stack_count ) \
+    ) \
+    + _Configure_From_workspace( RTEMS_STACK_POOL_CLASS_CONTROL_SIZE )
+
+  #define _CONFIGURE_TASK_STACK_POOL_SIZE ( 0 CONFIGURE_TASK_STACK_POOL )
+#else
+  #define _CONFIGURE_TASK_STACK_POOL_SIZE 0
+#endif
+
 /**
  * Configure the very much optional task stack allocator initialization
  */
@@ -1300,6 +1385,56 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
       NULL;
     #endif
 #endif
+
+/*
+ * With unified work areas, the C Program Heap is the RTEMS Workspace.  Use the
+ * segregated fit heap for the RTEMS Workspace in this case.
+ */
+#if defined(CONFIGURE_UNIFIED_WORK_AREAS) \
+  && defined(CONFIGURE_MALLOC_SEGREGATED_FIT) \
+  && !defined(CONFIGURE_WORKSPACE_SEGREGATED_FIT)
+  #define CONFIGURE_WORKSPACE_SEGREGATED_FIT
+#endif
+
+#ifdef CONFIGURE_INIT
+  /**
+   * This configures the heap initialization handler of the C Program Heap.
+   * The segregated fit heap provides constant time allocations and frees
+   * at the expense of a larger heap control.
+   */
+  const Heap_Initialization_or_extend_handler
+    rtems_malloc_heap_initialize_handler =
+    #ifdef CONFIGURE_MALLOC_SEGREGATED_FIT
+      _Heap_Initialize_segregated_fit;
+    #else
+      _Heap_Initialize;
+    #endif
+
+  /**
+   * This configures the heap initialization handler of the RTEMS Workspace.
+   */
+  const Heap_Initialization_or_extend_handler
+    _Workspace_Initialize_handler =
+    #ifdef CONFIGURE_WORKSPACE_SEGREGATED_FIT
+      _Heap_Initialize_segregated_fit;
+    #else
+      _Heap_Initialize;
+    #endif
+#endif
+
+#ifdef CONFIGURE_INIT
+  /**
+   * This configures the cache in front of the C Program Heap.  The
+   * per-processor cache satisfies small allocations without the allocator
+   * lock at the expense of memory held in the per-processor magazines.
+   */
+  const rtems_malloc_cache_handlers * const rtems_malloc_cache =
+    #ifdef CONFIGURE_MALLOC_PER_CPU_CACHE
+      &rtems_malloc_per_cpu_cache_handlers;
+    #else
+      NULL;
+    #endif
+#endif
 /**@}*/  /* end of Malloc Configuration */
 
 /**
@@ -1742,6 +1877,12 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
     #define CONFIGURE_BDBUF_READ_AHEAD_TASK_PRIORITY \
                               RTEMS_BDBUF_READ_AHEAD_TASK_PRIORITY_DEFAULT
   #endif
+  /*
+   * By default, use one cache shard per configured processor.
+   */
+  #ifndef CONFIGURE_BDBUF_SHARD_COUNT
+    #define CONFIGURE_BDBUF_SHARD_COUNT _CONFIGURE_MAXIMUM_PROCESSORS
+  #endif
   #ifdef CONFIGURE_INIT
     const rtems_bdbuf_config rtems_bdbuf_configuration = {
       CONFIGURE_BDBUF_MAX_READ_AHEAD_BLOCKS,
@@ -1755,7 +1896,8 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
       CONFIGURE_BDBUF_CACHE_MEMORY_SIZE,
       CONFIGURE_BDBUF_BUFFER_MIN_SIZE,
       CONFIGURE_BDBUF_BUFFER_MAX_SIZE,
-      CONFIGURE_BDBUF_READ_AHEAD_TASK_PRIORITY
+      CONFIGURE_BDBUF_READ_AHEAD_TASK_PRIORITY,
+      CONFIGURE_BDBUF_SHARD_COUNT
     };
   #endif
 
@@ -2435,6 +2577,20 @@ struct _reent *__getreent(void)
       (_messages) * (_Configure_Align_up(_size, sizeof(uintptr_t)) \
         + sizeof(CORE_message_queue_Buffer_control)))
 
+/**
+ * The following macro is used to calculate the memory allocated by RTEMS
+ * for a message queue which passes messages by reference
+ * (RTEMS_MESSAGE_BY_REFERENCE).  The pending messages are references and the
+ * buffer pool provides the message buffers of the specified size.
+ */
+#define CONFIGURE_MESSAGE_BUFFERS_FOR_REFERENCE_QUEUE(_messages, _size) \
+    (CONFIGURE_MESSAGE_BUFFERS_FOR_QUEUE(_messages, \
+      sizeof(Message_queue_Reference)) + \
+     ((_size) == 0 ? 0 : _Configure_From_workspace( \
+      (_messages) * _Configure_Align_up( \
+        _Configure_Align_up(sizeof(Message_queue_Buffer_header), \
+          CPU_HEAP_ALIGNMENT) + (_size), CPU_HEAP_ALIGNMENT))))
+
 /*
  * This macro is set to the amount of memory required for pending message
  * buffers in bytes.  It should be constructed by adding together a
@@ -2495,6 +2651,40 @@ struct _reent *__getreent(void)
         * sizeof(User_extensions_Switch_control) \
     ))
 
+/**
+ * This macro reserves the memory required by the object name indices, see
+ * CONFIGURE_OBJECT_NAME_INDEX.  The bucket count of an index is the maximum
+ * rounded up to the next power of two.
+ */
+#ifdef CONFIGURE_OBJECT_NAME_INDEX
+  #define _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(_max) \
+    _Configure_From_workspace( \
+      _Configure_Zero_or_One(_max) * (sizeof(Objects_Name_index) + \
+        3 * _Configure_Max_Objects(_max) * sizeof(Objects_Maximum)))
+
+  #define _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDICES \
+   (_CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(_CONFIGURE_TIMERS) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(CONFIGURE_MAXIMUM_SEMAPHORES) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX( \
+      CONFIGURE_MAXIMUM_MESSAGE_QUEUES) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(CONFIGURE_MAXIMUM_PARTITIONS) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(CONFIGURE_MAXIMUM_REGIONS) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(CONFIGURE_MAXIMUM_PORTS) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(CONFIGURE_MAXIMUM_PERIODS) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX( \
+      CONFIGURE_MAXIMUM_USER_EXTENSIONS) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(_CONFIGURE_BARRIERS) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(_CONFIGURE_POSIX_KEYS) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX( \
+      CONFIGURE_MAXIMUM_POSIX_MESSAGE_QUEUES) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX( \
+      CONFIGURE_MAXIMUM_POSIX_SEMAPHORES) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(CONFIGURE_MAXIMUM_POSIX_SHMS) + \
+    _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDEX(CONFIGURE_MAXIMUM_POSIX_TIMERS))
+#else
+  #define _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDICES 0
+#endif
+
 /**
  * This calculates the memory required for the executive workspace.
  *
@@ -2516,6 +2706,7 @@ struct _reent *__getreent(void)
      CONFIGURE_MAXIMUM_POSIX_SHMS) + \
    _CONFIGURE_MEMORY_FOR_POSIX_QUEUED_SIGNALS + \
    _CONFIGURE_MEMORY_FOR_STATIC_EXTENSIONS + \
+   _CONFIGURE_MEMORY_FOR_OBJECT_NAME_INDICES + \
    _CONFIGURE_MEMORY_FOR_MP + \
    CONFIGURE_MESSAGE_BUFFER_MEMORY + \
    (CONFIGURE_MEMORY_OVERHEAD * 1024) + \
@@ -2633,6 +2824,7 @@ struct _reent *__getreent(void)
     CONFIGURE_EXTRA_MPCI_RECEIVE_SERVER_STACK + \
     _CONFIGURE_LIBBLOCK_TASK_EXTRA_STACKS + \
     CONFIGURE_EXTRA_TASK_STACKS + \
+    _CONFIGURE_TASK_STACK_POOL_SIZE + \
     _CONFIGURE_HEAP_HANDLER_OVERHEAD \
   )
 
@@ -2755,6 +2947,21 @@ struct _reent *__getreent(void)
 
   const uint32_t _Watchdog_Ticks_per_second = _CONFIGURE_TICKS_PER_SECOND;
 
+  /*
+   * If defined, then the clock driver suppresses the clock ticks on idle
+   * processors up to the next watchdog expiration in case it supports this.
+   */
+  #ifdef CONFIGURE_CLOCK_TICK_SUPPRESSION
+    const bool _Watchdog_Tick_suppression_configured = true;
+  #else
+    const bool _Watchdog_Tick_suppression_configured = false;
+  #endif
+
+  #ifdef RTEMS_SMP
+    const uint32_t _SMP_Processors_per_cluster =
+      CONFIGURE_PROCESSORS_PER_CLUSTER;
+  #endif
+
   const size_t _Thread_Initial_thread_count = _CONFIGURE_IDLE_TASKS_COUNT +
     _CONFIGURE_MPCI_RECEIVE_SERVER_COUNT +
     rtems_resource_maximum_per_allocation( _CONFIGURE_TASKS ) +
@@ -2931,6 +3138,16 @@ struct _reent *__getreent(void)
     #endif
   };
 
+  #ifdef CONFIGURE_OBJECT_NAME_INDEX
+    #include <rtems/score/objectimpl.h>
+
+    RTEMS_SYSINIT_ITEM(
+      _Objects_Name_index_initialize,
+      RTEMS_SYSINIT_IDLE_THREADS,
+      RTEMS_SYSINIT_ORDER_FIRST
+    );
+  #endif
+
   #if CONFIGURE_RECORD_PER_PROCESSOR_ITEMS > 0
     #include <rtems/record.h>
 
@@ -79,6 +79,127 @@ void rtems_cpu_usage_reset( void );
  */
 int rtems_cpu_info_report( const rtems_printer *printer );
 
+/**
+ * @brief Count of thread queues with an individual wait time in the thread
+ * accounting.
+ */
+#define RTEMS_THREAD_ACCOUNTING_WAIT_QUEUES 4
+
+/**
+ * @brief Wait time of a thread on a thread queue.
+ */
+typedef struct {
+  /**
+   * @brief The identifier of the object owning the thread queue or zero.
+   *
+   * It is zero for the wait time on all other thread queues.
+   */
+  rtems_id id;
+
+  /**
+   * @brief The name of the thread queue.
+   *
+   * It is copied when the thread queue is first used by the thread, so the
+   * account stays valid after the deletion of the thread queue.  It is empty
+   * for the wait time on all other thread queues.
+   */
+  char name[ 16 ];
+
+  /**
+   * @brief Count of waits on the thread queue.
+   */
+  uint32_t count;
+
+  /**
+   * @brief Accumulated wait time on the thread queue in nanoseconds.
+   */
+  uint64_t wait_time;
+} rtems_thread_accounting_wait;
+
+/**
+ * @brief Time accounts of a thread.
+ *
+ * All times are in nanoseconds and accumulated since the thread creation or
+ * the last rtems_cpu_usage_reset().
+ */
+typedef struct {
+  /**
+   * @brief The thread identifier.
+   */
+  rtems_id id;
+
+  /**
+   * @brief The time the thread executed.
+   */
+  uint64_t cpu_time;
+
+  /**
+   * @brief The time the thread was ready but not executing.
+   */
+  uint64_t ready_time;
+
+  /**
+   * @brief The time the thread waited on thread queues.
+   */
+  uint64_t wait_time;
+
+  /**
+   * @brief The time of the outer-most interrupts preempting the thread.
+   *
+   * This time is only available if the CPU port reports the interrupt entry
+   * and exit instants, otherwise it is zero.
+   */
+  uint64_t isr_time;
+
+  /**
+   * @brief Count of valid entries in the wait queue array.
+   */
+  size_t wait_queue_count;
+
+  /**
+   * @brief The thread queues with the most wait time in descending order.
+   */
+  rtems_thread_accounting_wait wait_queues[
+    RTEMS_THREAD_ACCOUNTING_WAIT_QUEUES
+  ];
+
+  /**
+   * @brief The wait time on all other thread queues.
+   */
+  rtems_thread_accounting_wait other_wait_queues;
+} rtems_thread_accounting;
+
+/**
+ * @brief Visitor routine invoked by rtems_thread_accounting_iterate().
+ *
+ * @param accounting The time accounts of a thread.
+ * @param arg The argument passed to rtems_thread_accounting_iterate().
+ *
+ * @retval true Stop the iteration.
+ * @retval false Continue the iteration.
+ */
+typedef bool ( *rtems_thread_accounting_visitor )(
+  const rtems_thread_accounting *accounting,
+  void                          *arg
+);
+
+/**
+ * @brief Iterates over the time accounts of all threads.
+ *
+ * The accounting is enabled by the --enable-thread-accounting configure
+ * option.  The visitor is invoked in the context of rtems_task_iterate().
+ *
+ * @param visitor The visitor routine invoked for each thread.
+ * @param arg The argument passed to the visitor.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_NOT_IMPLEMENTED The thread accounting is not enabled.
+ */
+rtems_status_code rtems_thread_accounting_iterate(
+  rtems_thread_accounting_visitor  visitor,
+  void                            *arg
+);
+
 #ifdef __cplusplus
 }
 #endif
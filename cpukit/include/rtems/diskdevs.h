@@ -59,7 +59,17 @@ typedef int (*rtems_block_device_ioctl)(
 #define RTEMS_DISK_READ_AHEAD_NO_TRIGGER ((rtems_blkdev_bnum) -1)
 
 /**
- * @brief Block device read-ahead control.
+ * @brief Count of concurrent sequential read streams tracked per disk.
+ */
+#define RTEMS_DISK_READ_AHEAD_STREAM_COUNT 4
+
+/**
+ * @brief Block device read-ahead stream control.
+ *
+ * A stream is detected by a read miss followed by a read of the next block.
+ * The read-ahead window of a stream starts small, doubles with each read-ahead
+ * request up to the configured maximum read-ahead blocks and is halved in
+ * case read-ahead blocks are recycled before the stream reached them.
  */
 typedef struct {
   /**
@@ -67,6 +77,11 @@ typedef struct {
    */
   rtems_chain_node node;
 
+  /**
+   * @brief The disk of this stream.
+   */
+  rtems_disk_device *dd;
+
   /**
    * @brief Block value to trigger the read-ahead request.
    *
@@ -82,6 +97,30 @@ typedef struct {
    * be arbitrary.
    */
   rtems_blkdev_bnum next;
+
+  /**
+   * @brief The block expected to be read next by this stream.
+   *
+   * A value of @ref RTEMS_DISK_READ_AHEAD_NO_TRIGGER indicates an unused
+   * stream.
+   */
+  rtems_blkdev_bnum expected;
+
+  /**
+   * @brief Block count of the last read-ahead request.
+   *
+   * A value of zero indicates that no read-ahead request was issued for this
+   * stream yet.
+   */
+  uint32_t window;
+
+  /**
+   * @brief Value of the read-ahead clock of the disk at the last access of
+   * this stream.
+   *
+   * The least recently used stream is replaced by new streams.
+   */
+  uint32_t last_use;
 } rtems_blkdev_read_ahead;
 
 /**
@@ -144,6 +183,31 @@ typedef struct {
    * Error count of transfers issued by write requests.
    */
   uint32_t write_errors;
+
+  /**
+   * @brief Read-ahead hit count.
+   *
+   * A read-ahead hit occurs in the rtems_bdbuf_read() and rtems_bdbuf_get()
+   * functions in case the block was transfered by a read-ahead request and
+   * this is the first access to it.
+   */
+  uint32_t read_ahead_hits;
+
+  /**
+   * @brief Read-ahead miss count.
+   *
+   * A read-ahead miss occurs in the rtems_bdbuf_read() function in case a read
+   * miss happens for a block of the last read-ahead window of a stream.  A
+   * read miss of a block which a queued read-ahead request did not transfer
+   * yet is no read-ahead miss.
+   */
+  uint32_t read_ahead_misses;
+
+  /**
+   * @brief Count of blocks transfered by read-ahead requests which were
+   * discarded or recycled without an access.
+   */
+  uint32_t read_ahead_wasted;
 } rtems_blkdev_stats;
 
 /**
@@ -267,9 +331,16 @@ struct rtems_disk_device {
   rtems_blkdev_stats stats;
 
   /**
-   * @brief Read-ahead control for this disk.
+   * @brief Read-ahead stream controls for this disk.
+   */
+  rtems_blkdev_read_ahead read_ahead[RTEMS_DISK_READ_AHEAD_STREAM_COUNT];
+
+  /**
+   * @brief Read-ahead clock of this disk.
+   *
+   * Incremented for each access to a read-ahead stream.
    */
-  rtems_blkdev_read_ahead read_ahead;
+  uint32_t read_ahead_clock;
 };
 
 /**
@@ -335,6 +335,61 @@ rtems_dosfs_convert_control *rtems_dosfs_create_utf8_converter(
   const char *codepage
 );
 
+/**
+ * @brief Count of sectors of the active file allocation table (FAT) cached by
+ * each mounted FAT file system instance.
+ *
+ * Modified FAT sectors are kept in this cache and written to all FAT copies
+ * once the current file system operation is complete.  The value is
+ * evaluated at mount time.  A value of zero is treated as one.  The default
+ * is 16.
+ */
+extern uint32_t rtems_dosfs_fat_cache_sectors;
+
+/**
+ * @brief Maximum size in bytes of the free cluster bitmap of each mounted FAT
+ * file system instance.
+ *
+ * On the first cluster allocation of a volume a bitmap of the used data
+ * clusters is built.  The cluster allocator uses it to find free clusters and
+ * contiguous runs of free clusters without a scan of the FAT.  The bitmap
+ * needs one bit per data cluster, e.g. 128KiB for a 32GiB volume with 32KiB
+ * clusters, and is allocated from the heap.  To build it the complete active
+ * FAT is read.  This is done while the volume lock is held, so all other
+ * operations on the volume stall until the first allocation is complete.
+ *
+ * The bitmap is not built if its size exceeds this value, the cluster
+ * allocator scans the FAT instead.  A value of zero disables the bitmap.  The
+ * value is evaluated on each cluster allocation until the bitmap exists.  The
+ * default is UINT32_MAX (no limit).
+ */
+extern uint32_t rtems_dosfs_fat_free_map_max_size;
+
+/**
+ * @brief Maximum count of extents cached for each open file or directory of a
+ * FAT file system.
+ *
+ * An extent is a run of clusters which are contiguous in the file and on the
+ * volume.  The cache avoids following the cluster chain from the start of
+ * the file for backward seeks.  It needs twelve bytes per extent and is
+ * allocated at the first seek which follows the cluster chain.  A value of
+ * zero disables the cache.  The default is 32.
+ */
+extern uint32_t rtems_dosfs_extent_cache_size;
+
+/**
+ * @brief Count of directory entry lookups cached by each mounted FAT file
+ * system instance.
+ *
+ * The cache maps the first cluster of a directory and a normalized file name
+ * to the position of the directory entry.  It records also names which do not
+ * exist in a directory.  Cached names are invalidated if a file is created,
+ * renamed or removed.  Names longer than 48 bytes in the normalized form are
+ * not cached.  An entry needs about 100 bytes.  The value is evaluated at
+ * mount time.  A value of zero disables the cache.  The default is 128.
+ */
+extern uint32_t rtems_dosfs_name_cache_size;
+
 #define MSDOS_FMT_INFO_LEVEL_NONE   (0)
 #define MSDOS_FMT_INFO_LEVEL_INFO   (1)
 #define MSDOS_FMT_INFO_LEVEL_DETAIL (2)
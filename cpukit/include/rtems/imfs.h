@@ -21,6 +21,7 @@
 
 #include <rtems/libio_.h>
 #include <rtems/pipe.h>
+#include <rtems/rbtree.h>
 #include <rtems/score/timecounter.h>
 
 /**
@@ -241,6 +242,7 @@ typedef struct {
 
 struct IMFS_jnode_tt {
   rtems_chain_node    Node;                  /* for chaining them together */
+  rtems_rbtree_node   Index_node;            /* for the directory index */
   IMFS_jnode_t       *Parent;                /* Parent node */
   const char         *name;                  /* "basename" (not \0 terminated) */
   uint16_t            namelen;               /* Length of "basename" */
@@ -260,10 +262,19 @@ struct IMFS_jnode_tt {
 
 #define IMFS_NODE_FLAG_NAME_ALLOCATED 0x1
 
+/*
+ *  Directories with more entries than this threshold get an index to speed
+ *  up the name lookup.  Smaller directories use a linear search.
+ */
+
+#define IMFS_DIRECTORY_INDEX_THRESHOLD 16
+
 typedef struct {
   IMFS_jnode_t                          Node;
-  rtems_chain_control                   Entries;
+  rtems_chain_control                   Entries;     /* in creation order */
   rtems_filesystem_mount_table_entry_t *mt_fs;
+  rtems_rbtree_control                  Index;       /* empty if not indexed */
+  size_t                                entry_count;
 } IMFS_directory_t;
 
 typedef struct {
@@ -299,6 +310,24 @@ typedef struct {
   block_p         direct;           /* pointer to file image */
 } IMFS_linearfile_t;
 
+/*
+ *  IMFS "extfile" information
+ *
+ *  An extent file stores its data in a list of contiguous extents.  The
+ *  extent sizes grow geometrically, so the extent count is logarithmic in the
+ *  file size.  Extents are never moved or freed before the file is destroyed,
+ *  so shared mappings of the file data via mmap() stay valid.
+ */
+
+struct IMFS_extent;
+
+typedef struct {
+  IMFS_filebase_t     File;
+  struct IMFS_extent *extents;      /* first extent, ordered by offset */
+  struct IMFS_extent *last;         /* last extent */
+  off_t               capacity;     /* sum of all extent sizes in bytes */
+} IMFS_extfile_t;
+
 /* Support copy on write for linear files */
 typedef union {
   IMFS_jnode_t      Node;
@@ -339,6 +368,11 @@ static inline IMFS_memfile_t *IMFS_iop_to_memfile( const rtems_libio_t *iop )
   return (IMFS_memfile_t *) iop->pathinfo.node_access;
 }
 
+static inline IMFS_extfile_t *IMFS_iop_to_extfile( const rtems_libio_t *iop )
+{
+  return (IMFS_extfile_t *) iop->pathinfo.node_access;
+}
+
 static inline time_t _IMFS_get_time( void )
 {
   struct bintime now;
@@ -400,6 +434,7 @@ extern const IMFS_mknod_control IMFS_mknod_control_dir_default;
 extern const IMFS_mknod_control IMFS_mknod_control_dir_minimal;
 extern const IMFS_mknod_control IMFS_mknod_control_device;
 extern const IMFS_mknod_control IMFS_mknod_control_memfile;
+extern const IMFS_mknod_control IMFS_mknod_control_extfile;
 extern const IMFS_node_control IMFS_node_control_linfile;
 extern const IMFS_mknod_control IMFS_mknod_control_fifo;
 extern const IMFS_mknod_control IMFS_mknod_control_enosys;
@@ -866,23 +901,43 @@ static inline void IMFS_Set_handlers( rtems_filesystem_location_info_t *loc )
   loc->handlers = node->control->handlers;
 }
 
-static inline void IMFS_add_to_directory(
+/**
+ * @brief Adds the entry node to the directory.
+ *
+ * The directory index is created once the entry count exceeds
+ * IMFS_DIRECTORY_INDEX_THRESHOLD.
+ *
+ * @param[in] dir_node The directory node.
+ * @param[in] entry_node The entry node.  It must not be a member of another
+ *   directory.
+ */
+void IMFS_add_to_directory(
   IMFS_jnode_t *dir_node,
   IMFS_jnode_t *entry_node
-)
-{
-  IMFS_directory_t *dir = (IMFS_directory_t *) dir_node;
+);
 
-  entry_node->Parent = dir_node;
-  rtems_chain_append_unprotected( &dir->Entries, &entry_node->Node );
-}
+/**
+ * @brief Removes the node from its parent directory.
+ *
+ * @param[in] node The node.  It must be a member of a directory.
+ */
+void IMFS_remove_from_directory( IMFS_jnode_t *node );
 
-static inline void IMFS_remove_from_directory( IMFS_jnode_t *node )
-{
-  IMFS_assert( node->Parent != NULL );
-  node->Parent = NULL;
-  rtems_chain_extract_unprotected( &node->Node );
-}
+/**
+ * @brief Searches for an entry with the specified name in the directory.
+ *
+ * @param[in] dir The directory.
+ * @param[in] name The entry name (not \0 terminated).
+ * @param[in] namelen The length of the entry name.
+ *
+ * @retval NULL No such entry exists.
+ * @retval entry The entry with the specified name.
+ */
+IMFS_jnode_t *IMFS_find_in_directory(
+  const IMFS_directory_t *dir,
+  const char             *name,
+  size_t                  namelen
+);
 
 static inline bool IMFS_is_directory( const IMFS_jnode_t *node )
 {
@@ -75,12 +75,155 @@ void *rtems_heap_null_extend(
 
 extern const rtems_heap_extend_handler rtems_malloc_extend_handler;
 
+/**
+ * @brief The heap initialization handler of the C program heap.
+ *
+ * This is either _Heap_Initialize() or _Heap_Initialize_segregated_fit(),
+ * see CONFIGURE_MALLOC_SEGREGATED_FIT.
+ */
+extern const Heap_Initialization_or_extend_handler
+  rtems_malloc_heap_initialize_handler;
+
 /*
  * Malloc Plugin to Dirty Memory at Allocation Time
  */
 typedef void (*rtems_malloc_dirtier_t)(void *, size_t);
 extern rtems_malloc_dirtier_t rtems_malloc_dirty_helper;
 
+/**
+ * @brief Count of size classes of the per-processor malloc cache.
+ */
+#define RTEMS_MALLOC_CACHE_CLASS_COUNT 8
+
+/**
+ * @brief Size class granularity of the per-processor malloc cache in bytes.
+ *
+ * The size class with index i serves allocation requests up to
+ * (i + 1) * RTEMS_MALLOC_CACHE_CLASS_SIZE bytes.
+ */
+#define RTEMS_MALLOC_CACHE_CLASS_SIZE 32
+
+/**
+ * @brief Count of memory areas in one magazine of the per-processor malloc
+ * cache.
+ *
+ * Each processor has two magazines per size class.  Refills take this count
+ * of memory areas from the heap and flushes return this count of memory
+ * areas to the heap.
+ */
+#define RTEMS_MALLOC_CACHE_MAGAZINE_SIZE 8
+
+/**
+ * @brief Statistics of a size class of the per-processor malloc cache.
+ */
+typedef struct {
+  /**
+   * @brief The maximum allocation size served by this size class in bytes.
+   */
+  size_t size;
+
+  /**
+   * @brief Count of memory areas currently cached on all processors.
+   */
+  uint32_t cached;
+
+  /**
+   * @brief Count of allocations satisfied by the cache.
+   */
+  uint32_t hits;
+
+  /**
+   * @brief Count of allocations which had to refill the cache.
+   */
+  uint32_t misses;
+
+  /**
+   * @brief Count of frees absorbed by the cache.
+   */
+  uint32_t frees;
+
+  /**
+   * @brief Count of batch refills from the heap.
+   */
+  uint32_t refills;
+
+  /**
+   * @brief Count of batch returns to the heap.
+   */
+  uint32_t flushes;
+} rtems_malloc_cache_class_info;
+
+/**
+ * @brief Statistics of the per-processor malloc cache.
+ */
+typedef struct {
+  rtems_malloc_cache_class_info classes[ RTEMS_MALLOC_CACHE_CLASS_COUNT ];
+} rtems_malloc_cache_info;
+
+/**
+ * @brief Handlers of a cache in front of the C program heap.
+ */
+typedef struct {
+  /**
+   * @brief Allocates a memory area of the specified size from the cache.
+   *
+   * @retval NULL The cache cannot satisfy the request.
+   * @retval otherwise The begin address of the allocated memory area.
+   */
+  void *( *allocate )( size_t size );
+
+  /**
+   * @brief Returns a memory area allocated from the C program heap to the
+   * cache.
+   *
+   * @retval true The cache took the memory area.
+   * @retval false The memory area must be freed to the heap.
+   */
+  bool ( *free )( void *ptr );
+
+  /**
+   * @brief Returns all memory areas held by the cache to the heap.
+   *
+   * This handler is called with the allocator lock held if an allocation
+   * from the heap failed.  The allocation is retried afterwards.
+   */
+  void ( *flush )( void );
+
+  /**
+   * @brief Gets the cache statistics.
+   */
+  void ( *get_information )( rtems_malloc_cache_info *info );
+} rtems_malloc_cache_handlers;
+
+/**
+ * @brief The per-processor malloc cache handlers.
+ *
+ * The allocations from this cache are satisfied and the frees are taken by
+ * per-processor magazines of fixed size classes without the allocator lock.
+ * Empty magazines are refilled in batches from the C program heap, full
+ * magazines are returned in batches.  Only these batch operations obtain the
+ * allocator lock.
+ */
+extern const rtems_malloc_cache_handlers rtems_malloc_per_cpu_cache_handlers;
+
+/**
+ * @brief The cache in front of the C program heap.
+ *
+ * This is NULL or &rtems_malloc_per_cpu_cache_handlers, see
+ * CONFIGURE_MALLOC_PER_CPU_CACHE.
+ */
+extern const rtems_malloc_cache_handlers * const rtems_malloc_cache;
+
+/**
+ * @brief Gets the statistics of the cache in front of the C program heap.
+ *
+ * @param[out] the_info The cache statistics.
+ *
+ * @retval 0 Successful operation.
+ * @retval -1 No cache is configured or @a the_info is NULL.
+ */
+int malloc_cache_info( rtems_malloc_cache_info *the_info );
+
 /**
  *  @brief Dirty Memory Function
  *
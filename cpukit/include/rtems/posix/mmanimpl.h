@@ -35,6 +35,15 @@ typedef struct mmap_mappings_s {
   size_t             len;   /**< The length of memory mapped */
   int                flags; /**< The mapping flags */
   POSIX_Shm_Control *shm;   /**< The shared memory object or NULL */
+
+  /**
+   * @brief The location of a shared file mapping.
+   *
+   * It holds a node reference, so that the file stays valid after a close()
+   * or unlink() until the mapping is removed by munmap().  The mount table
+   * entry is NULL for other mappings.
+   */
+  rtems_filesystem_location_info_t location;
 } mmap_mapping;
 
 extern rtems_chain_control mmap_mappings;
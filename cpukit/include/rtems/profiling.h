@@ -50,8 +50,10 @@ extern "C" {
  *
  * Profiling information includes critical timing values such as the maximum
  * time of disabled thread dispatching which is a measure for the thread
- * dispatch latency.  On SMP configurations statistics of all SMP locks in the
- * system are available.
+ * dispatch latency.  The duration of the scheduler block, unblock and update
+ * priority operations and of thread dispatches is available as histograms per
+ * processor and per scheduler instance.  On SMP configurations statistics of
+ * all SMP locks in the system are available.
  *
  * Profiling information can be retrieved via rtems_profiling_iterate() and
  * reported as an XML dump via rtems_profiling_report_xml().  These functions
@@ -77,7 +79,14 @@ typedef enum {
    *
    * @see rtems_profiling_smp_lock.
    */
-  RTEMS_PROFILING_SMP_LOCK
+  RTEMS_PROFILING_SMP_LOCK,
+
+  /**
+   * @brief Type of scheduler profiling data.
+   *
+   * @see rtems_profiling_scheduler.
+   */
+  RTEMS_PROFILING_SCHEDULER
 } rtems_profiling_type;
 
 /**
@@ -90,6 +99,86 @@ typedef struct {
   rtems_profiling_type type;
 } rtems_profiling_header;
 
+/**
+ * @brief Profiled operations.
+ */
+typedef enum {
+  /**
+   * @brief The scheduler block operation.
+   */
+  RTEMS_PROFILING_OPERATION_SCHEDULER_BLOCK,
+
+  /**
+   * @brief The scheduler unblock operation.
+   */
+  RTEMS_PROFILING_OPERATION_SCHEDULER_UNBLOCK,
+
+  /**
+   * @brief The scheduler update priority operation.
+   */
+  RTEMS_PROFILING_OPERATION_SCHEDULER_UPDATE_PRIORITY,
+
+  /**
+   * @brief The thread dispatch with a context switch.
+   *
+   * This is the time interval between the begin of the heir thread selection
+   * and the return from the context switch on the processor which executes
+   * the heir thread.
+   */
+  RTEMS_PROFILING_OPERATION_THREAD_DISPATCH,
+
+  /**
+   * @brief Count of profiled operations.
+   */
+  RTEMS_PROFILING_OPERATION_COUNT
+} rtems_profiling_operation;
+
+/**
+ * @brief Count of histogram bins of the operation profiling data.
+ */
+#define RTEMS_PROFILING_HISTOGRAM_BINS 24
+
+/**
+ * @brief Operation profiling data.
+ */
+typedef struct {
+  /**
+   * @brief The maximum operation duration in nanoseconds.
+   */
+  uint32_t max_time;
+
+  /**
+   * @brief Count of operations.
+   *
+   * This value may overflow.
+   */
+  uint64_t count;
+
+  /**
+   * @brief Total operation duration in nanoseconds.
+   *
+   * The average operation duration is the total duration divided by the
+   * count of operations.
+   *
+   * This value may overflow.
+   */
+  uint64_t total_time;
+
+  /**
+   * @brief Operation counts by duration.
+   *
+   * The bins are logarithmically scaled in CPU counter ticks.  The bin with
+   * index zero counts durations of zero or one CPU counter ticks.  The bin with
+   * index N counts durations in the interval [2^N, 2^(N + 1)) CPU counter
+   * ticks.  The last bin counts all greater durations.  Use
+   * rtems_counter_ticks_to_nanoseconds() to get the bin bounds in
+   * nanoseconds.
+   *
+   * The values may overflow.
+   */
+  uint64_t histogram[RTEMS_PROFILING_HISTOGRAM_BINS];
+} rtems_profiling_operation_stats;
+
 /**
  * @brief Per-CPU profiling data.
  *
@@ -178,6 +267,14 @@ typedef struct {
    * This value may overflow.
    */
   uint64_t total_interrupt_time;
+
+  /**
+   * @brief The profiling data of the operations carried out by this
+   * processor.
+   *
+   * @see rtems_profiling_operation.
+   */
+  rtems_profiling_operation_stats operations[RTEMS_PROFILING_OPERATION_COUNT];
 } rtems_profiling_per_cpu;
 
 /**
@@ -185,6 +282,12 @@ typedef struct {
  */
 #define RTEMS_PROFILING_SMP_LOCK_CONTENTION_COUNTS 4
 
+/**
+ * @brief Count of histogram bins of the lock acquire times for SMP lock
+ * profiling.
+ */
+#define RTEMS_PROFILING_SMP_LOCK_ACQUIRE_TIME_BINS 16
+
 /**
  * @brief SMP lock profiling data.
  *
@@ -263,8 +366,89 @@ typedef struct {
    * The values may overflow.
    */
   uint64_t contention_counts[RTEMS_PROFILING_SMP_LOCK_CONTENTION_COUNTS];
+
+  /**
+   * @brief The counts of lock acquire operations by acquire time.
+   *
+   * The bins are logarithmically scaled in CPU counter ticks.  The bin with
+   * index zero counts acquire times of zero or one CPU counter ticks.  The bin
+   * with index N counts acquire times in the interval [2^N, 2^(N + 1)) CPU
+   * counter ticks.  The last bin counts all greater acquire times.  Use
+   * rtems_counter_ticks_to_nanoseconds() to get the bin bounds in
+   * nanoseconds.
+   *
+   * The values may overflow.
+   */
+  uint64_t acquire_time_histogram[RTEMS_PROFILING_SMP_LOCK_ACQUIRE_TIME_BINS];
+
+  /**
+   * @brief The count of lock acquire operations on a processor cluster other
+   * than the cluster of the previous lock owner.
+   *
+   * The processor clusters are defined by the application configuration
+   * option CONFIGURE_PROCESSORS_PER_CLUSTER.
+   *
+   * This value may overflow.
+   */
+  uint64_t other_cluster_count;
 } rtems_profiling_smp_lock;
 
+/**
+ * @brief Scheduler profiling data.
+ *
+ * The values are the combined per-CPU profiling data of the processors owned
+ * by the scheduler instance at the time of the iteration.
+ */
+typedef struct {
+  /**
+   * @brief The profiling data header.
+   */
+  rtems_profiling_header header;
+
+  /**
+   * @brief The scheduler name.
+   */
+  uint32_t name;
+
+  /**
+   * @brief The index of the scheduler instance.
+   */
+  uint32_t scheduler_index;
+
+  /**
+   * @brief Count of processors owned by the scheduler instance.
+   */
+  uint32_t processor_count;
+
+  /**
+   * @brief The maximum time of disabled thread dispatching in nanoseconds.
+   */
+  uint32_t max_thread_dispatch_disabled_time;
+
+  /**
+   * @brief Count of times when the thread dispatch disable level changes from
+   * zero to one in thread context.
+   *
+   * This value may overflow.
+   */
+  uint64_t thread_dispatch_disabled_count;
+
+  /**
+   * @brief Total time of disabled thread dispatching in nanoseconds.
+   *
+   * This value may overflow.
+   */
+  uint64_t total_thread_dispatch_disabled_time;
+
+  /**
+   * @brief The profiling data of the operations carried out by the
+   * processors owned by the scheduler instance.
+   *
+   * @see rtems_profiling_operation.
+   */
+  rtems_profiling_operation_stats operations[RTEMS_PROFILING_OPERATION_COUNT];
+} rtems_profiling_scheduler;
+
 /**
  * @brief Collection of profiling data.
  */
@@ -283,6 +467,11 @@ typedef union {
    * @brief SMP lock profiling data if indicated by the header.
    */
   rtems_profiling_smp_lock smp_lock;
+
+  /**
+   * @brief Scheduler profiling data if indicated by the header.
+   */
+  rtems_profiling_scheduler scheduler;
 } rtems_profiling_data;
 
 /**
@@ -148,6 +148,40 @@ RTEMS_INLINE_ROUTINE unsigned int _Record_Capacity(
   return ( tail - head - 1U ) & control->mask;
 }
 
+extern Atomic_Uint _Record_Watermark;
+
+void _Record_Watermark_reached( void );
+
+void _Record_Arm_watermark(
+  unsigned int   watermark,
+  void        ( *handler )( void * ),
+  void          *arg
+);
+
+void _Record_Disarm_watermark( void );
+
+/*
+ * Items committed with interrupts disabled cannot call the watermark handler,
+ * since the producer may be a thread switch extension or an interrupt entry.
+ * The next commit with interrupts enabled calls it.
+ */
+RTEMS_INLINE_ROUTINE void _Record_Check_watermark(
+  const rtems_record_context *context
+)
+{
+  unsigned int watermark;
+
+  watermark = _Atomic_Load_uint( &_Record_Watermark, ATOMIC_ORDER_RELAXED );
+
+  if (
+    RTEMS_PREDICT_FALSE( watermark != 0 )
+      && context->head - _Record_Tail( context->control ) >= watermark
+      && _ISR_Is_enabled( context->level )
+  ) {
+    _Record_Watermark_reached();
+  }
+}
+
 RTEMS_INLINE_ROUTINE rtems_counter_ticks _Record_Now( void )
 {
   return rtems_counter_read();
@@ -594,6 +628,7 @@ RTEMS_INLINE_ROUTINE void rtems_record_commit( rtems_record_context *context )
   rtems_record_commit_critical( context );
   RTEMS_COMPILER_MEMORY_BARRIER();
   _CPU_ISR_Enable( context->level );
+  _Record_Check_watermark( context );
 }
 
 /**
@@ -1905,6 +1940,63 @@ void _Record_Drain(
  */
 void rtems_record_drain( rtems_record_drain_visitor visitor, void *arg );
 
+/**
+ * @brief The compact format encoder state.
+ *
+ * @see RTEMS_RECORD_FORMAT_COMPACT_32.
+ */
+typedef struct {
+  uint32_t cpu;
+
+  struct {
+    uint32_t          time;
+    rtems_record_data data;
+  } Per_CPU[ RTEMS_RECORD_COMPACT_CPU_COUNT ];
+} rtems_record_compact_encoder;
+
+/**
+ * @brief Initializes the compact format encoder.
+ *
+ * @param encoder The encoder to initialize.
+ */
+void rtems_record_compact_encoder_initialize(
+  rtems_record_compact_encoder *encoder
+);
+
+/**
+ * @brief Gets the format of the stream header for the compact format encoding.
+ *
+ * @return The stream header format.
+ */
+uint32_t rtems_record_compact_format( void );
+
+/**
+ * @brief Encodes the record item in the compact format.
+ *
+ * @param encoder The encoder.
+ * @param item The record item to encode.
+ * @param[out] buf The buffer for the encoded item.  It shall have a size of
+ *   at least RTEMS_RECORD_COMPACT_ITEM_SIZE_MAX bytes.
+ *
+ * @return The size of the encoded item in bytes.
+ */
+size_t rtems_record_compact_encode(
+  rtems_record_compact_encoder *encoder,
+  const rtems_record_item      *item,
+  void                         *buf
+);
+
+/**
+ * @brief Gets the maximum count of not drained items of all processors.
+ *
+ * This function may be called from interrupt context.  It does not drain the
+ * items.  In case of an overflow, the returned count is greater than or equal
+ * to the ring buffer item count.
+ *
+ * @return The maximum count of not drained items of all processors.
+ */
+unsigned int rtems_record_get_maximum_content( void );
+
 /** @} */
 
 #ifdef __cplusplus
@@ -61,7 +61,8 @@ typedef enum {
   RTEMS_RECORD_CLIENT_ERROR_DOUBLE_PER_CPU_COUNT,
   RTEMS_RECORD_CLIENT_ERROR_NO_CPU_MAX,
   RTEMS_RECORD_CLIENT_ERROR_NO_MEMORY,
-  RTEMS_RECORD_CLIENT_ERROR_PER_CPU_ITEMS_OVERFLOW
+  RTEMS_RECORD_CLIENT_ERROR_PER_CPU_ITEMS_OVERFLOW,
+  RTEMS_RECORD_CLIENT_ERROR_INVALID_COMPACT_ITEM
 } rtems_record_client_status;
 
 typedef rtems_record_client_status ( *rtems_record_client_handler )(
@@ -158,6 +159,21 @@ typedef struct rtems_record_client_context {
   size_t data_size;
   uint32_t header[ 2 ];
   rtems_record_client_status status;
+
+  /**
+   * @brief The compact format decoder state.
+   *
+   * @see RTEMS_RECORD_FORMAT_COMPACT_32.
+   */
+  struct {
+    uint64_t value;
+    uint64_t first;
+    uint32_t shift;
+    bool has_first;
+    uint32_t cpu;
+    uint32_t time[ RTEMS_RECORD_COMPACT_CPU_COUNT ];
+    uint64_t data[ RTEMS_RECORD_COMPACT_CPU_COUNT ];
+  } compact;
 } rtems_record_client_context;
 
 /**
@@ -77,6 +77,66 @@ extern "C" {
  */
 #define RTEMS_RECORD_FORMAT_BE_64 0x44444444
 
+/**
+ * @brief The items are in the compact format with 32-bit data.
+ *
+ * Each item is encoded as two unsigned LEB128 variable-length integers.  The
+ * first integer is the time delta shifted left by
+ * RTEMS_RECORD_COMPACT_FLAG_BITS plus RTEMS_RECORD_EVENT_BITS, ored with the
+ * event shifted left by RTEMS_RECORD_COMPACT_FLAG_BITS, ored with the
+ * RTEMS_RECORD_COMPACT_TIME_ZERO and RTEMS_RECORD_COMPACT_DATA_DELTA flags.
+ * The second integer is either the data or, if
+ * RTEMS_RECORD_COMPACT_DATA_DELTA is set, the zigzag encoded difference of
+ * the data and the data of the previous item.
+ *
+ * The time delta and the previous data are maintained per processor.  The
+ * current processor is selected by RTEMS_RECORD_PROCESSOR items with a data
+ * value less than RTEMS_RECORD_COMPACT_CPU_COUNT.  The initial
+ * previous time and data are zero.  Items with a time of zero do not update
+ * the previous time.  The byte order of the stream header is the native byte
+ * order of the producer.
+ */
+#define RTEMS_RECORD_FORMAT_COMPACT_32 0x55555555
+
+/**
+ * @brief The items are in the compact format with 64-bit data.
+ *
+ * @see RTEMS_RECORD_FORMAT_COMPACT_32.
+ */
+#define RTEMS_RECORD_FORMAT_COMPACT_64 0x66666666
+
+/**
+ * @brief Flag of the compact format to indicate an item time of zero.
+ */
+#define RTEMS_RECORD_COMPACT_TIME_ZERO 0x1
+
+/**
+ * @brief Flag of the compact format to indicate a data difference.
+ */
+#define RTEMS_RECORD_COMPACT_DATA_DELTA 0x2
+
+/**
+ * @brief Count of flag bits of the compact format.
+ */
+#define RTEMS_RECORD_COMPACT_FLAG_BITS 2
+
+/**
+ * @brief Count of processors with a time delta and previous data state in the
+ * compact format.
+ *
+ * The encoder and the decoder use this count, so that both select the same
+ * state for an item.
+ */
+#define RTEMS_RECORD_COMPACT_CPU_COUNT 32
+
+/**
+ * @brief Maximum size of an item in the compact format in bytes.
+ *
+ * This is five bytes for the time, event, and flags plus ten bytes for the
+ * data.
+ */
+#define RTEMS_RECORD_COMPACT_ITEM_SIZE_MAX 15
+
 /**
  * @brief Magic number to identify a record item stream.
  *
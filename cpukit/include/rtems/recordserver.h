@@ -28,7 +28,7 @@
 #ifndef _RTEMS_RECORDSERVER_H
 #define _RTEMS_RECORDSERVER_H
 
-#include "recorddata.h"
+#include "record.h"
 
 #include <sys/types.h>
 #include <rtems.h>
@@ -70,6 +70,106 @@ rtems_status_code rtems_record_start_server(
   rtems_interval      period
 );
 
+/**
+ * @brief Runs a record TCP server loop in streaming mode.
+ *
+ * In contrast to rtems_record_server(), the server is not only woken up
+ * periodically.  The producer which commits items with interrupts enabled and
+ * finds the content of its processor ring buffer at or above the watermark
+ * wakes up the server.  Items produced with interrupts disabled, for example
+ * by the thread switch extension, are detected by the next such commit.  The
+ * period timer bounds the latency in case no such commit follows.  The server
+ * then sends the items straight from the ring buffers via writev() until the
+ * content of all ring buffers is below the watermark.
+ *
+ * Items overwritten by the producers during a transfer are reported per
+ * processor in-band through the RTEMS_RECORD_PER_CPU_TAIL and
+ * RTEMS_RECORD_PER_CPU_HEAD items of the next drain.  The record client turns
+ * them into RTEMS_RECORD_PER_CPU_OVERFLOW events.
+ *
+ * @param port The TCP port to listen in host byte order.
+ * @param period The maximum latency in clock ticks.
+ * @param watermark The item count of a processor ring buffer which wakes up
+ *   the server.  It is limited to the half of the ring buffer item count.
+ */
+void rtems_record_stream_server(
+  uint16_t       port,
+  rtems_interval period,
+  unsigned int   watermark
+);
+
+/**
+ * @brief Starts a record TCP server task in streaming mode.
+ *
+ * @param priority The task priority.
+ * @param port The TCP port to listen in host byte order.
+ * @param period The maximum latency in clock ticks.
+ * @param watermark The item count of a processor ring buffer which wakes up
+ *   the server.
+ *
+ * @see rtems_record_stream_server().
+ */
+rtems_status_code rtems_record_start_stream_server(
+  rtems_task_priority priority,
+  uint16_t            port,
+  rtems_interval      period,
+  unsigned int        watermark
+);
+
+/**
+ * @brief Drains the record items on all processors, encodes them in the
+ * compact format, and writes them to the file descriptor.
+ *
+ * In contrast to rtems_record_writev(), the items are copied.  Use this
+ * function for slow links.
+ *
+ * @param fd The file descriptor.
+ * @param encoder The compact format encoder of the stream.
+ * @param written Set to true if items were drained, otherwise set to false.
+ *
+ * @retval -1 A write error occurred.
+ * @retval The bytes written to the file descriptor.
+ *
+ * @see RTEMS_RECORD_FORMAT_COMPACT_32.
+ */
+ssize_t rtems_record_write_compact(
+  int                           fd,
+  rtems_record_compact_encoder *encoder,
+  bool                         *written
+);
+
+/**
+ * @brief Runs a record TCP server loop which sends the items in the compact
+ * format.
+ *
+ * @param port The TCP port to listen in host byte order.
+ * @param period The drain period or the maximum latency in clock ticks.
+ * @param watermark If zero, then the server drains the items periodically,
+ *   otherwise see rtems_record_stream_server().
+ */
+void rtems_record_compact_server(
+  uint16_t       port,
+  rtems_interval period,
+  unsigned int   watermark
+);
+
+/**
+ * @brief Starts a record TCP server task which sends the items in the compact
+ * format.
+ *
+ * @param priority The task priority.
+ * @param port The TCP port to listen in host byte order.
+ * @param period The drain period or the maximum latency in clock ticks.
+ * @param watermark If zero, then the server drains the items periodically,
+ *   otherwise see rtems_record_stream_server().
+ */
+rtems_status_code rtems_record_start_compact_server(
+  rtems_task_priority priority,
+  uint16_t            port,
+  rtems_interval      period,
+  unsigned int        watermark
+);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -164,6 +164,15 @@ typedef uint32_t   rtems_attribute;
  */
 #define RTEMS_BARRIER_MANUAL_RELEASE    0x00000000
 
+/***************** RTEMS Message Queue Specific Attributes *****************/
+
+/**
+ *  This attribute constant indicates that the Classic API Message Queue
+ *  instance created passes message buffers by reference instead of copying
+ *  the message content, see rtems_message_queue_send_reference().
+ */
+#define RTEMS_MESSAGE_BY_REFERENCE    0x00000200
+
 /**************** RTEMS Internal Task Specific Attributes ****************/
 
 /**
@@ -94,6 +94,20 @@ RTEMS_INLINE_ROUTINE bool _Attributes_Is_floating_point(
    return ( attribute_set & RTEMS_FLOATING_POINT ) ? true : false;
 }
 
+/**
+ *  @brief Checks if the message by reference attribute is enabled in the
+ *  attribute_set.
+ *
+ *  This function returns TRUE if the message by reference attribute is
+ *  enabled in the attribute_set and FALSE otherwise.
+ */
+RTEMS_INLINE_ROUTINE bool _Attributes_Is_message_by_reference(
+  rtems_attribute attribute_set
+)
+{
+   return ( attribute_set & RTEMS_MESSAGE_BY_REFERENCE ) ? true : false;
+}
+
 #if defined(RTEMS_MULTIPROCESSING)
 /**
  *  @brief Checks if the global object attribute is enabled in
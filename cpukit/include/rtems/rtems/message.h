@@ -46,6 +46,12 @@ extern "C" {
  * messages that will be held. It returns the id of the created
  * message queue in @a id.
  *
+ * If the @a attribute_set contains RTEMS_MESSAGE_BY_REFERENCE, then the
+ * message queue passes message buffers by reference, see
+ * rtems_message_queue_send_reference().  In this case, the
+ * @a max_message_size is the size of each of the @a count buffers of the
+ * buffer pool of the message queue.  A size of zero creates no buffer pool.
+ *
  * @param[in] name is the user defined queue name
  * @param[in] count is the maximum message and reserved buffer count
  * @param[in] max_message_size is the maximum size of each message
@@ -222,6 +228,161 @@ rtems_status_code rtems_message_queue_flush(
   uint32_t *count
 );
 
+/**
+ * @brief Gets a buffer from the buffer pool of the message queue.
+ *
+ * The message queue must pass messages by reference.  The calling task owns
+ * the buffer.  It may return it with rtems_message_queue_return_buffer() or
+ * pass the ownership on with rtems_message_queue_send_reference() and the
+ * related directives.  This directive does not block.
+ *
+ * @param id The message queue ID.
+ * @param[out] buffer The buffer.  It provides the maximum message size
+ *   specified at message queue creation.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ID Invalid message queue ID.
+ * @retval RTEMS_INVALID_ADDRESS The buffer pointer is @c NULL.
+ * @retval RTEMS_NOT_DEFINED The message queue copies the message content.
+ * @retval RTEMS_UNSATISFIED No free buffer is available.
+ */
+rtems_status_code rtems_message_queue_get_buffer(
+  rtems_id   id,
+  void     **buffer
+);
+
+/**
+ * @brief Returns a buffer to the buffer pool of the message queue.
+ *
+ * The calling task gives up its ownership of the buffer.  A buffer received
+ * by several tasks through rtems_message_queue_broadcast_reference() is
+ * free once all receivers returned it.
+ *
+ * @param id The message queue ID.
+ * @param buffer The buffer.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ID Invalid message queue ID.
+ * @retval RTEMS_INVALID_ADDRESS The buffer is not a buffer of the buffer pool
+ *   of the message queue.
+ * @retval RTEMS_NOT_DEFINED The message queue copies the message content.
+ */
+rtems_status_code rtems_message_queue_return_buffer(
+  rtems_id  id,
+  void     *buffer
+);
+
+/**
+ * @brief Sends a message buffer by reference to the message queue.
+ *
+ * This directive has the same behavior as rtems_message_queue_send() except
+ * that the message content is not copied.  Only the buffer address and the
+ * message size are queued.  The ownership of a buffer of the buffer pool
+ * moves to the receiver.  Other buffers may be sent as well, in this case
+ * the application is responsible to manage their life time.
+ *
+ * @param id The message queue ID.
+ * @param buffer The message buffer.
+ * @param size The size of the message.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ID Invalid message queue ID.
+ * @retval RTEMS_INVALID_ADDRESS The message buffer pointer is @c NULL.
+ * @retval RTEMS_INVALID_SIZE The message size is larger than the size of the
+ *   buffers of the buffer pool.
+ * @retval RTEMS_NOT_DEFINED The message queue copies the message content.
+ * @retval RTEMS_TOO_MANY The new message would exceed the message queue limit
+ *   for pending messages.
+ */
+rtems_status_code rtems_message_queue_send_reference(
+  rtems_id  id,
+  void     *buffer,
+  size_t    size
+);
+
+/**
+ * @brief Sends an urgent message buffer by reference to the message queue.
+ *
+ * This directive has the same behavior as
+ * rtems_message_queue_send_reference() except that if no tasks are waiting,
+ * the message is placed at the front of the chain of pending messages.
+ *
+ * @param id The message queue ID.
+ * @param buffer The message buffer.
+ * @param size The size of the message.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ID Invalid message queue ID.
+ * @retval RTEMS_INVALID_ADDRESS The message buffer pointer is @c NULL.
+ * @retval RTEMS_INVALID_SIZE The message size is larger than the size of the
+ *   buffers of the buffer pool.
+ * @retval RTEMS_NOT_DEFINED The message queue copies the message content.
+ * @retval RTEMS_TOO_MANY The new message would exceed the message queue limit
+ *   for pending messages.
+ */
+rtems_status_code rtems_message_queue_urgent_reference(
+  rtems_id  id,
+  void     *buffer,
+  size_t    size
+);
+
+/**
+ * @brief Broadcasts a message buffer by reference to the message queue.
+ *
+ * All tasks waiting on the message queue receive the same buffer.  Each
+ * receiver owns a reference to a buffer of the buffer pool and must return
+ * it with rtems_message_queue_return_buffer().  The calling task gives up its
+ * ownership.  Without receivers, the buffer returns to the buffer pool.
+ *
+ * @param id The message queue ID.
+ * @param buffer The message buffer.
+ * @param size The size of the message.
+ * @param[out] count The count of tasks which received the message.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ID Invalid message queue ID.
+ * @retval RTEMS_INVALID_ADDRESS The message buffer pointer or the count
+ *   pointer is @c NULL.
+ * @retval RTEMS_INVALID_SIZE The message size is larger than the size of the
+ *   buffers of the buffer pool.
+ * @retval RTEMS_NOT_DEFINED The message queue copies the message content.
+ */
+rtems_status_code rtems_message_queue_broadcast_reference(
+  rtems_id  id,
+  void     *buffer,
+  size_t    size,
+  uint32_t *count
+);
+
+/**
+ * @brief Receives a message buffer by reference from the message queue.
+ *
+ * This directive has the same behavior as rtems_message_queue_receive()
+ * except that the message content is not copied.  The calling task owns a
+ * received buffer of the buffer pool.
+ *
+ * @param id The message queue ID.
+ * @param[out] buffer The message buffer.
+ * @param[out] size The size of the message.
+ * @param option_set The option set, e.g. RTEMS_NO_WAIT or RTEMS_WAIT.
+ * @param timeout The number of ticks to wait if the RTEMS_WAIT is set.  Use
+ *   RTEMS_NO_TIMEOUT to wait indefinitely.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ID Invalid message queue ID.
+ * @retval RTEMS_INVALID_ADDRESS The message buffer pointer or the message size
+ *   pointer is @c NULL.
+ * @retval RTEMS_NOT_DEFINED The message queue copies the message content.
+ * @retval RTEMS_TIMEOUT A timeout occurred and no message was received.
+ */
+rtems_status_code rtems_message_queue_receive_reference(
+  rtems_id         id,
+  void           **buffer,
+  size_t          *size,
+  rtems_option     option_set,
+  rtems_interval   timeout
+);
+
 /**
  *  @brief RTEMS Message Queue Get Number Pending
  *
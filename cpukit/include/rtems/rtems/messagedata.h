@@ -31,6 +31,49 @@ extern "C" {
  * @{
  */
 
+/**
+ *  The following records define the message content of a message queue
+ *  which passes messages by reference (RTEMS_MESSAGE_BY_REFERENCE).  Only
+ *  this reference is copied by the SuperCore Message Queue.
+ */
+typedef struct {
+  /** This field is the message buffer passed by reference. */
+  void   *buffer;
+  /** This field is the size of the message in the buffer. */
+  size_t  size;
+}   Message_queue_Reference;
+
+/**
+ *  The following records define the header of each buffer of a message
+ *  queue buffer pool.
+ */
+typedef union {
+  /** This field is used to chain the buffer while it is free. */
+  Chain_Node  Node;
+  /**
+   *  This field is the count of owners while the buffer is in use.  A
+   *  broadcast gives the buffer to each receiver.
+   */
+  uint32_t    reference_count;
+}   Message_queue_Buffer_header;
+
+/**
+ *  The following records define the buffer pool of a message queue which
+ *  passes messages by reference.
+ */
+typedef struct {
+  /** This field is the chain of free buffers. */
+  Chain_Control  Free;
+  /** This field is the begin of the buffer area. */
+  char          *begin;
+  /** This field is the end of the buffer area. */
+  char          *end;
+  /** This field is the distance between two consecutive buffer headers. */
+  size_t         stride;
+  /** This field is the size available in each buffer. */
+  size_t         buffer_size;
+}   Message_queue_Buffer_pool;
+
 /**
  *  The following records define the control block used to manage
  *  each message queue.
@@ -42,6 +85,11 @@ typedef struct {
   CORE_message_queue_Control  message_queue;
   /** This field is the attribute set as defined by the API. */
   rtems_attribute             attribute_set;
+  /**
+   *  This field is the buffer pool if the message queue passes messages by
+   *  reference.  It is protected by the lock of the SuperCore Message Queue.
+   */
+  Message_queue_Buffer_pool   Buffer_pool;
 }   Message_queue_Control;
 
 /**
@@ -18,6 +18,8 @@
 #define _RTEMS_RTEMS_MESSAGEIMPL_H
 
 #include <rtems/rtems/messagedata.h>
+#include <rtems/rtems/attrimpl.h>
+#include <rtems/score/chainimpl.h>
 #include <rtems/score/objectimpl.h>
 #include <rtems/score/coremsgimpl.h>
 
@@ -101,6 +103,100 @@ RTEMS_INLINE_ROUTINE Message_queue_Control *_Message_queue_Allocate( void )
     _Objects_Allocate( &_Message_queue_Information );
 }
 
+/**
+ *  @brief Checks if the message queue passes messages by reference.
+ *
+ *  @param the_message_queue The message queue.
+ *
+ *  @retval true The message queue passes messages by reference.
+ *  @retval false The message queue copies the message content.
+ */
+RTEMS_INLINE_ROUTINE bool _Message_queue_Is_by_reference(
+  const Message_queue_Control *the_message_queue
+)
+{
+  return _Attributes_Is_message_by_reference(
+    the_message_queue->attribute_set
+  );
+}
+
+/**
+ *  This is the size of the header in front of each buffer of a message queue
+ *  buffer pool.  The buffers are aligned like workspace allocations.
+ */
+#define MESSAGE_QUEUE_BUFFER_HEADER_SIZE \
+  ( ( sizeof( Message_queue_Buffer_header ) + CPU_HEAP_ALIGNMENT - 1 ) \
+    & ~( (size_t) CPU_HEAP_ALIGNMENT - 1 ) )
+
+/**
+ *  This reference count is held by a broadcast of a pool buffer until the
+ *  count of receivers is known.
+ */
+#define MESSAGE_QUEUE_BUFFER_BROADCAST_HOLD 0x80000000U
+
+/**
+ *  @brief Returns the pool buffer header of the buffer.
+ *
+ *  @param the_message_queue The message queue.
+ *  @param buffer The buffer.
+ *
+ *  @retval header The header of the buffer.
+ *  @retval NULL The buffer is not a buffer of the pool of this message queue.
+ */
+RTEMS_INLINE_ROUTINE Message_queue_Buffer_header *
+_Message_queue_Get_buffer_header(
+  const Message_queue_Control *the_message_queue,
+  const void                  *buffer
+)
+{
+  const Message_queue_Buffer_pool *pool;
+  const char                      *begin;
+  uintptr_t                        offset;
+
+  pool = &the_message_queue->Buffer_pool;
+  begin = buffer;
+
+  if ( begin < pool->begin || begin >= pool->end ) {
+    return NULL;
+  }
+
+  offset = (uintptr_t) ( begin - pool->begin );
+
+  if ( offset % pool->stride != MESSAGE_QUEUE_BUFFER_HEADER_SIZE ) {
+    return NULL;
+  }
+
+  return (Message_queue_Buffer_header *)
+    RTEMS_DECONST( char *, begin - MESSAGE_QUEUE_BUFFER_HEADER_SIZE );
+}
+
+/**
+ *  @brief Releases references of the pool buffer.
+ *
+ *  The buffer is returned to the pool if the reference count drops to zero.
+ *  The caller must own the lock of the SuperCore Message Queue.
+ *
+ *  @param[in, out] the_message_queue The message queue.
+ *  @param[in, out] header The header of the pool buffer.
+ *  @param count The count of references to release.
+ */
+RTEMS_INLINE_ROUTINE void _Message_queue_Release_buffer(
+  Message_queue_Control       *the_message_queue,
+  Message_queue_Buffer_header *header,
+  uint32_t                     count
+)
+{
+  _Assert( header->reference_count >= count );
+  header->reference_count -= count;
+
+  if ( header->reference_count == 0 ) {
+    _Chain_Append_unprotected(
+      &the_message_queue->Buffer_pool.Free,
+      &header->Node
+    );
+  }
+}
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -54,6 +54,26 @@ extern "C" {
   #define CONTEXT_FP_SIZE 0
 #endif
 
+/*
+ * The lazy floating point context switch is optional.  Ports which support it
+ * define CPU_USE_LAZY_FP_SWITCH to TRUE and provide
+ * _CPU_Context_Set_fp_enabled().  The floating point unavailable exception
+ * handler of the port must call _Thread_Lazy_fp_switch().
+ */
+#if !defined(CPU_USE_LAZY_FP_SWITCH)
+  #define CPU_USE_LAZY_FP_SWITCH FALSE
+#endif
+
+#if CPU_USE_LAZY_FP_SWITCH == TRUE
+  #if CPU_HARDWARE_FP != TRUE
+    #error "lazy FP switch requires a hardware floating point unit"
+  #endif
+
+  #if CPU_USE_DEFERRED_FP_SWITCH == TRUE
+    #error "lazy and deferred FP switch cannot be used together"
+  #endif
+#endif
+
 /**
  *  @brief Initialize context area.
  *
@@ -151,6 +171,23 @@ extern "C" {
 #define _Context_Save_fp( _fp ) \
    _CPU_Context_save_fp( _fp )
 
+#if CPU_USE_LAZY_FP_SWITCH == TRUE
+/**
+ *  @brief Enables or disables the floating point unit for a context.
+ *
+ *  This routine is invoked by the thread dispatch right before the context
+ *  switch to @a _the_context.  If the floating point unit is disabled, then
+ *  the first floating point instruction of the context must raise an exception
+ *  which is handled by _Thread_Lazy_fp_switch().  The port may either update
+ *  the context or the processor state directly.
+ *
+ *  @param[in] _the_context is the context of the heir thread.
+ *  @param[in] _enabled indicates if the floating point unit is enabled.
+ */
+#define _Context_Set_fp_enabled( _the_context, _enabled ) \
+   _CPU_Context_Set_fp_enabled( _the_context, _enabled )
+#endif
+
 #if defined(_CPU_Context_Destroy)
   #define _Context_Destroy( _the_thread, _the_context ) \
     _CPU_Context_Destroy( _the_thread, _the_context )
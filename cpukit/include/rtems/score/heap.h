@@ -127,6 +127,15 @@ extern "C" {
  * last block appears as used for the _Heap_Is_used() and _Heap_Is_free()
  * functions.
  *
+ * A heap initialized by _Heap_Initialize_segregated_fit() uses a segregated
+ * fit index in addition to the free list (see @ref Heap_Segregated_fit).  The
+ * free blocks are grouped into size classes with a two-level mapping similar
+ * to the TLSF allocator.  The free list is kept sorted by size class and the
+ * index points to the first free block of each non-empty size class.  Two
+ * bitmaps indicate the non-empty size classes.  This yields constant time
+ * allocations without alignment or boundary constraints and constant time
+ * frees.  The block layout is identical for both kinds of heaps.
+ *
  * @{
  */
 
@@ -250,6 +259,61 @@ struct Heap_Block {
   Heap_Block *prev;
 };
 
+/**
+ * @brief Count of bits used to select the second level size class of the
+ * segregated fit index.
+ */
+#define HEAP_SEGREGATED_FIT_SECOND_LEVEL_BITS 3
+
+/**
+ * @brief Count of second level size classes per first level size class of
+ * the segregated fit index.
+ */
+#define HEAP_SEGREGATED_FIT_SECOND_LEVEL_COUNT \
+  ( 1U << HEAP_SEGREGATED_FIT_SECOND_LEVEL_BITS )
+
+/**
+ * @brief Count of first level size classes of the segregated fit index.
+ *
+ * The first level size class of a block is the index of the most significant
+ * bit set in the block size.
+ */
+#define HEAP_SEGREGATED_FIT_FIRST_LEVEL_COUNT ( 8 * sizeof( uintptr_t ) )
+
+/**
+ * @brief Segregated fit index of a heap.
+ *
+ * A block of size @c s belongs to the first level size class @c f which is
+ * the index of the most significant bit set in @c s.  The second level size
+ * class is defined by the next @ref HEAP_SEGREGATED_FIT_SECOND_LEVEL_BITS
+ * bits of @c s.  The free list of the heap is sorted by size class in
+ * ascending order.  Within a size class the free blocks are unordered.
+ *
+ * The index is placed at the begin of the first heap area by
+ * _Heap_Initialize_segregated_fit().
+ */
+typedef struct {
+  /**
+   * @brief Indicates the first level size classes which contain at least one
+   * non-empty second level size class.
+   */
+  uintptr_t first_level_map;
+
+  /**
+   * @brief Indicates the non-empty second level size classes for each first
+   * level size class.
+   */
+  uint32_t second_level_map[ HEAP_SEGREGATED_FIT_FIRST_LEVEL_COUNT ];
+
+  /**
+   * @brief The first free block in the free list of each size class.
+   *
+   * This pointer is @c NULL for an empty size class.
+   */
+  Heap_Block *first[ HEAP_SEGREGATED_FIT_FIRST_LEVEL_COUNT ]
+    [ HEAP_SEGREGATED_FIT_SECOND_LEVEL_COUNT ];
+} Heap_Segregated_fit;
+
 /**
  * @brief Control block used to manage a heap.
  */
@@ -261,6 +325,14 @@ struct Heap_Control {
   uintptr_t area_end;
   Heap_Block *first_block;
   Heap_Block *last_block;
+
+  /**
+   * @brief The segregated fit index.
+   *
+   * This pointer is @c NULL for heaps using the first fit method.
+   */
+  Heap_Segregated_fit *segregated_fit;
+
   Heap_Statistics stats;
   #ifdef HEAP_PROTECTION
     Heap_Protection Protection;
@@ -321,6 +393,31 @@ uintptr_t _Heap_Extend(
   uintptr_t unused
 );
 
+/**
+ * @brief Initializes a heap which uses a segregated fit index.
+ *
+ * The segregated fit index is placed at the begin of the heap area.  The
+ * remaining area is initialized with _Heap_Initialize().  Allocations without
+ * an alignment or boundary constraint and frees take constant time.  The heap
+ * may be extended with _Heap_Extend().
+ *
+ * @param[out] heap The heap control block to manage the area.
+ * @param area_begin The starting address of the area.
+ * @param area_size The size of the area in bytes.
+ * @param page_size The page size for the calculation
+ *
+ * @retval some_value The maximum memory available.
+ * @retval 0 The initialization failed.
+ *
+ * @see Heap_Initialization_or_extend_handler.
+ */
+uintptr_t _Heap_Initialize_segregated_fit(
+  Heap_Control *heap,
+  void *area_begin,
+  uintptr_t area_size,
+  uintptr_t page_size
+);
+
 /**
  * @brief This function returns always zero.
  *
@@ -394,6 +491,19 @@ RTEMS_INLINE_ROUTINE uintptr_t _Heap_Area_overhead(
   return 2 * (page_size - 1) + HEAP_BLOCK_HEADER_SIZE;
 }
 
+/**
+ * @brief Returns the worst case overhead of the segregated fit index in a
+ * memory area.
+ *
+ * @return The worst case overhead of the segregated fit index.
+ *
+ * @see _Heap_Initialize_segregated_fit().
+ */
+RTEMS_INLINE_ROUTINE uintptr_t _Heap_Segregated_fit_overhead( void )
+{
+  return sizeof( Heap_Segregated_fit ) + CPU_ALIGNMENT - 1;
+}
+
 /**
  * @brief Returns the size with administration and alignment overhead for one
  * allocation.
@@ -748,6 +748,321 @@ RTEMS_INLINE_ROUTINE bool _Heap_Is_block_in_heap(
     && (uintptr_t) block <= (uintptr_t) heap->last_block;
 }
 
+/**
+ * @brief Returns the size of an allocated area owned by the caller.
+ *
+ * In contrast to _Heap_Size_of_alloc_area() only the size of the block of the
+ * allocated area is read and the next block is not inspected.  The block size
+ * of an allocated block does not change while the area is allocated, so no
+ * protection against concurrent heap operations is necessary.  The price is
+ * that an area which is not allocated is not detected.
+ *
+ * @param heap The heap of the allocated area.
+ * @param alloc_begin_ptr The begin of the allocated area.
+ * @param[out] alloc_size The size of the allocated area.
+ *
+ * @retval true The block of the allocated area is in the heap and the size
+ *   was returned.
+ * @retval false The block of the allocated area is not in the heap.
+ */
+RTEMS_INLINE_ROUTINE bool _Heap_Size_of_owned_alloc_area(
+  const Heap_Control *heap,
+  const void         *alloc_begin_ptr,
+  uintptr_t          *alloc_size
+)
+{
+  uintptr_t         alloc_begin;
+  const Heap_Block *block;
+  const Heap_Block *next_block;
+
+  alloc_begin = (uintptr_t) alloc_begin_ptr;
+  block = _Heap_Block_of_alloc_area( alloc_begin, heap->page_size );
+
+  if ( !_Heap_Is_block_in_heap( heap, block ) ) {
+    return false;
+  }
+
+  next_block = _Heap_Block_at( block, _Heap_Block_size( block ) );
+
+  if ( !_Heap_Is_block_in_heap( heap, next_block ) ) {
+    return false;
+  }
+
+  *alloc_size = (uintptr_t) next_block + HEAP_ALLOC_BONUS - alloc_begin;
+  return true;
+}
+
+/**
+ * @brief Returns the index of the most significant bit set in the value.
+ *
+ * @param value The value.  It shall not be zero.
+ *
+ * @return The index of the most significant bit set in @a value.
+ */
+RTEMS_INLINE_ROUTINE unsigned int _Heap_Segregated_fit_msb( uintptr_t value )
+{
+  return (unsigned int) ( 8 * sizeof( unsigned long ) - 1 )
+    - (unsigned int) __builtin_clzl( (unsigned long) value );
+}
+
+/**
+ * @brief Returns the index of the least significant bit set in the value.
+ *
+ * @param value The value.  It shall not be zero.
+ *
+ * @return The index of the least significant bit set in @a value.
+ */
+RTEMS_INLINE_ROUTINE unsigned int _Heap_Segregated_fit_lsb( uintptr_t value )
+{
+  return (unsigned int) __builtin_ctzl( (unsigned long) value );
+}
+
+/**
+ * @brief Maps the block size to the size class of the segregated fit index.
+ *
+ * @param block_size The block size.  It shall be greater than or equal to
+ *   the minimum block size of the heap.
+ * @param[out] first_level The first level size class.
+ * @param[out] second_level The second level size class.
+ */
+RTEMS_INLINE_ROUTINE void _Heap_Segregated_fit_map(
+  uintptr_t     block_size,
+  unsigned int *first_level,
+  unsigned int *second_level
+)
+{
+  unsigned int fl;
+
+  fl = _Heap_Segregated_fit_msb( block_size );
+  *first_level = fl;
+  *second_level = (unsigned int)
+    ( block_size >> ( fl - HEAP_SEGREGATED_FIT_SECOND_LEVEL_BITS ) )
+      & ( HEAP_SEGREGATED_FIT_SECOND_LEVEL_COUNT - 1 );
+}
+
+/**
+ * @brief Returns the first free block of the first non-empty size class
+ * greater than or equal to the specified size class.
+ *
+ * @param index The segregated fit index.
+ * @param first_level The first level size class.
+ * @param second_level The second level size class.
+ *
+ * @retval NULL There is no such size class.
+ * @retval block The first free block of the size class.
+ */
+RTEMS_INLINE_ROUTINE Heap_Block *_Heap_Segregated_fit_find(
+  const Heap_Segregated_fit *index,
+  unsigned int               first_level,
+  unsigned int               second_level
+)
+{
+  uint32_t second_level_map;
+
+  second_level_map = index->second_level_map[ first_level ]
+    & ( UINT32_MAX << second_level );
+
+  if ( second_level_map == 0 ) {
+    uintptr_t first_level_map;
+
+    ++first_level;
+
+    if ( first_level >= HEAP_SEGREGATED_FIT_FIRST_LEVEL_COUNT ) {
+      return NULL;
+    }
+
+    first_level_map = index->first_level_map
+      & ( ~( (uintptr_t) 0 ) << first_level );
+
+    if ( first_level_map == 0 ) {
+      return NULL;
+    }
+
+    first_level = _Heap_Segregated_fit_lsb( first_level_map );
+    second_level_map = index->second_level_map[ first_level ];
+  }
+
+  second_level = _Heap_Segregated_fit_lsb( second_level_map );
+
+  return index->first[ first_level ][ second_level ];
+}
+
+/**
+ * @brief Inserts the free block into the free list of its size class.
+ *
+ * @param[in, out] heap The heap using a segregated fit index.
+ * @param new_block The block to insert.
+ * @param new_block_size The size of the block to insert.
+ */
+RTEMS_INLINE_ROUTINE void _Heap_Segregated_fit_insert(
+  Heap_Control *heap,
+  Heap_Block   *new_block,
+  uintptr_t     new_block_size
+)
+{
+  Heap_Segregated_fit *index;
+  Heap_Block          *next;
+  unsigned int         fl;
+  unsigned int         sl;
+
+  index = heap->segregated_fit;
+  _Heap_Segregated_fit_map( new_block_size, &fl, &sl );
+  next = index->first[ fl ][ sl ];
+
+  if ( next == NULL ) {
+    next = _Heap_Segregated_fit_find( index, fl, sl + 1 );
+
+    if ( next == NULL ) {
+      next = _Heap_Free_list_tail( heap );
+    }
+
+    index->first_level_map |= (uintptr_t) 1 << fl;
+    index->second_level_map[ fl ] |= (uint32_t) 1 << sl;
+  }
+
+  index->first[ fl ][ sl ] = new_block;
+  _Heap_Free_list_insert_before( next, new_block );
+}
+
+/**
+ * @brief Removes the free block from the free list of its size class.
+ *
+ * @param[in, out] heap The heap using a segregated fit index.
+ * @param block The block to remove.  The block size shall be the size used
+ *   to insert the block.
+ */
+RTEMS_INLINE_ROUTINE void _Heap_Segregated_fit_remove(
+  Heap_Control *heap,
+  Heap_Block   *block
+)
+{
+  Heap_Segregated_fit *index;
+  unsigned int         fl;
+  unsigned int         sl;
+
+  index = heap->segregated_fit;
+  _Heap_Segregated_fit_map( _Heap_Block_size( block ), &fl, &sl );
+
+  if ( index->first[ fl ][ sl ] == block ) {
+    Heap_Block   *next;
+    unsigned int  next_fl;
+    unsigned int  next_sl;
+
+    next = block->next;
+
+    if ( next != _Heap_Free_list_tail( heap ) ) {
+      _Heap_Segregated_fit_map( _Heap_Block_size( next ), &next_fl, &next_sl );
+    } else {
+      next_fl = HEAP_SEGREGATED_FIT_FIRST_LEVEL_COUNT;
+      next_sl = 0;
+    }
+
+    if ( next_fl == fl && next_sl == sl ) {
+      index->first[ fl ][ sl ] = next;
+    } else {
+      index->first[ fl ][ sl ] = NULL;
+      index->second_level_map[ fl ] &= ~( (uint32_t) 1 << sl );
+
+      if ( index->second_level_map[ fl ] == 0 ) {
+        index->first_level_map &= ~( (uintptr_t) 1 << fl );
+      }
+    }
+  }
+
+  _Heap_Free_list_remove( block );
+}
+
+/**
+ * @brief Inserts a free block into the free list of the heap.
+ *
+ * In case the heap uses the first fit method, then the block is inserted
+ * after @a block_before, otherwise it is inserted into the free list of its
+ * size class.
+ *
+ * @param[in, out] heap The heap to operate upon.
+ * @param block_before The block that is already in the free list.
+ * @param new_block The block to insert.
+ * @param new_block_size The size of the block to insert.
+ */
+RTEMS_INLINE_ROUTINE void _Heap_Free_list_insert_block(
+  Heap_Control *heap,
+  Heap_Block   *block_before,
+  Heap_Block   *new_block,
+  uintptr_t     new_block_size
+)
+{
+  if ( heap->segregated_fit == NULL ) {
+    _Heap_Free_list_insert_after( block_before, new_block );
+  } else {
+    _Heap_Segregated_fit_insert( heap, new_block, new_block_size );
+  }
+}
+
+/**
+ * @brief Removes a free block from the free list of the heap.
+ *
+ * @param[in, out] heap The heap to operate upon.
+ * @param block The block to remove.  The block size shall be valid.
+ */
+RTEMS_INLINE_ROUTINE void _Heap_Free_list_remove_block(
+  Heap_Control *heap,
+  Heap_Block   *block
+)
+{
+  if ( heap->segregated_fit == NULL ) {
+    _Heap_Free_list_remove( block );
+  } else {
+    _Heap_Segregated_fit_remove( heap, block );
+  }
+}
+
+/**
+ * @brief Replaces a free block in the free list of the heap by another.
+ *
+ * @param[in, out] heap The heap to operate upon.
+ * @param old_block The block in the free list to replace.  The block size
+ *   shall be valid.
+ * @param new_block The block that should replace @a old_block.
+ * @param new_block_size The size of the block that should replace
+ *   @a old_block.
+ */
+RTEMS_INLINE_ROUTINE void _Heap_Free_list_replace_block(
+  Heap_Control *heap,
+  Heap_Block   *old_block,
+  Heap_Block   *new_block,
+  uintptr_t     new_block_size
+)
+{
+  if ( heap->segregated_fit == NULL ) {
+    _Heap_Free_list_replace( old_block, new_block );
+  } else {
+    _Heap_Segregated_fit_remove( heap, old_block );
+    _Heap_Segregated_fit_insert( heap, new_block, new_block_size );
+  }
+}
+
+/**
+ * @brief Updates the free list of the heap for a free block which changes its
+ * size.
+ *
+ * This function must be called before the new block size is set.
+ *
+ * @param[in, out] heap The heap to operate upon.
+ * @param block The block in the free list.  The block size shall be valid.
+ * @param new_block_size The new size of the block.
+ */
+RTEMS_INLINE_ROUTINE void _Heap_Free_list_resize_block(
+  Heap_Control *heap,
+  Heap_Block   *block,
+  uintptr_t     new_block_size
+)
+{
+  if ( heap->segregated_fit != NULL ) {
+    _Heap_Segregated_fit_remove( heap, block );
+    _Heap_Segregated_fit_insert( heap, block, new_block_size );
+  }
+}
+
 /**
  * @brief Sets the size of the last block for the heap.
  *
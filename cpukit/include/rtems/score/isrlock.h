@@ -25,6 +25,7 @@
 
 #include <rtems/score/isrlevel.h>
 #include <rtems/score/smplock.h>
+#include <rtems/score/smplockcohort.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -371,6 +372,183 @@ RTEMS_INLINE_ROUTINE void _ISR_lock_Context_set_level(
   #endif
 #endif
 
+/**
+ * @brief ISR cohort lock control.
+ *
+ * The ISR cohort locks are an alternative to the ISR locks for hot objects
+ * accessed by many processors.  On SMP configurations, they use an SMP cohort
+ * lock which prefers lock hand overs within a processor cluster, see
+ * CONFIGURE_PROCESSORS_PER_CLUSTER.  They use the ISR lock context.
+ *
+ * @warning Empty structures are implementation-defined in C.  GCC gives them a
+ * size of zero.  In C++ empty structures have a non-zero size.
+ */
+typedef struct {
+#if defined( RTEMS_SMP )
+  SMP_cohort_lock_Control Lock;
+#endif
+} ISR_cohort_lock_Control;
+
+/**
+ * @brief Defines an ISR cohort lock member.
+ *
+ * Do not add a ';' after this macro.
+ *
+ * @param _designator The designator for the interrupt cohort lock.
+ */
+#if defined( RTEMS_SMP )
+  #define ISR_COHORT_LOCK_MEMBER( _designator ) \
+    ISR_cohort_lock_Control _designator;
+#else
+  #define ISR_COHORT_LOCK_MEMBER( _designator )
+#endif
+
+/**
+ * @brief Defines an ISR cohort lock variable.
+ *
+ * Do not add a ';' after this macro.
+ *
+ * @param _qualifier The qualifier for the interrupt cohort lock, e.g. static.
+ * @param _designator The designator for the interrupt cohort lock.
+ * @param _name The name for the interrupt cohort lock.  It must be a string.
+ * The name is only used if profiling is enabled.
+ */
+#if defined( RTEMS_SMP )
+  #define ISR_COHORT_LOCK_DEFINE( _qualifier, _designator, _name ) \
+    _qualifier ISR_cohort_lock_Control _designator = \
+      { SMP_COHORT_LOCK_INITIALIZER( _name ) };
+#else
+  #define ISR_COHORT_LOCK_DEFINE( _qualifier, _designator, _name )
+#endif
+
+/**
+ * @brief Initializer for static initialization of ISR cohort locks.
+ *
+ * @param _name The name for the interrupt cohort lock.  It must be a string.
+ * The name is only used if profiling is enabled.
+ */
+#if defined( RTEMS_SMP )
+  #define ISR_COHORT_LOCK_INITIALIZER( _name ) \
+    { SMP_COHORT_LOCK_INITIALIZER( _name ) }
+#else
+  #define ISR_COHORT_LOCK_INITIALIZER( _name ) \
+    { }
+#endif
+
+/**
+ * @brief Initializes an ISR cohort lock.
+ *
+ * Concurrent initialization leads to unpredictable results.
+ *
+ * @param[in] _lock The ISR cohort lock control.
+ * @param[in] _name The name for the ISR cohort lock.  This name must be a
+ * string persistent throughout the life time of this lock.  The name is only
+ * used if profiling is enabled.
+ */
+#if defined( RTEMS_SMP )
+  #define _ISR_cohort_lock_Initialize( _lock, _name ) \
+    _SMP_cohort_lock_Initialize( &( _lock )->Lock, _name )
+#else
+  #define _ISR_cohort_lock_Initialize( _lock, _name )
+#endif
+
+/**
+ * @brief Destroys an ISR cohort lock.
+ *
+ * Concurrent destruction leads to unpredictable results.
+ *
+ * @param[in] _lock The ISR cohort lock control.
+ */
+#if defined( RTEMS_SMP )
+  #define _ISR_cohort_lock_Destroy( _lock ) \
+    _SMP_cohort_lock_Destroy( &( _lock )->Lock )
+#else
+  #define _ISR_cohort_lock_Destroy( _lock )
+#endif
+
+/**
+ * @brief Acquires an ISR cohort lock.
+ *
+ * @param[in] _lock The ISR cohort lock control.
+ * @param[in] _context The local ISR lock context for an acquire and release
+ * pair.
+ *
+ * @see _ISR_lock_ISR_disable_and_acquire().
+ */
+#if defined( RTEMS_SMP )
+  #define _ISR_cohort_lock_ISR_disable_and_acquire( _lock, _context ) \
+    _SMP_cohort_lock_ISR_disable_and_acquire( \
+      &( _lock )->Lock, \
+      &( _context )->Lock_context \
+    )
+#else
+  #define _ISR_cohort_lock_ISR_disable_and_acquire( _lock, _context ) \
+    _ISR_Local_disable( ( _context )->isr_level )
+#endif
+
+/**
+ * @brief Releases an ISR cohort lock.
+ *
+ * @param[in] _lock The ISR cohort lock control.
+ * @param[in] _context The local ISR lock context for an acquire and release
+ * pair.
+ *
+ * @see _ISR_lock_Release_and_ISR_enable().
+ */
+#if defined( RTEMS_SMP )
+  #define _ISR_cohort_lock_Release_and_ISR_enable( _lock, _context ) \
+    _SMP_cohort_lock_Release_and_ISR_enable( \
+      &( _lock )->Lock, \
+      &( _context )->Lock_context \
+    )
+#else
+  #define _ISR_cohort_lock_Release_and_ISR_enable( _lock, _context ) \
+    _ISR_Local_enable( ( _context )->isr_level )
+#endif
+
+/**
+ * @brief Acquires an ISR cohort lock inside an ISR disabled section.
+ *
+ * @param[in] _lock The ISR cohort lock control.
+ * @param[in] _context The local ISR lock context for an acquire and release
+ * pair.
+ *
+ * @see _ISR_lock_Acquire().
+ */
+#if defined( RTEMS_SMP )
+  #define _ISR_cohort_lock_Acquire( _lock, _context ) \
+    do { \
+      _Assert( _ISR_Get_level() != 0 ); \
+      _SMP_cohort_lock_Acquire( \
+        &( _lock )->Lock, \
+        &( _context )->Lock_context \
+      ); \
+    } while ( 0 )
+#else
+  #define _ISR_cohort_lock_Acquire( _lock, _context ) \
+    do { (void) _context; } while ( 0 )
+#endif
+
+/**
+ * @brief Releases an ISR cohort lock inside an ISR disabled section.
+ *
+ * @param[in] _lock The ISR cohort lock control.
+ * @param[in] _context The local ISR lock context for an acquire and release
+ * pair.
+ *
+ * @see _ISR_lock_Release().
+ */
+#if defined( RTEMS_SMP )
+  #define _ISR_cohort_lock_Release( _lock, _context ) \
+    _SMP_cohort_lock_Release( \
+      &( _lock )->Lock, \
+      &( _context )->Lock_context \
+    )
+#else
+  #define _ISR_cohort_lock_Release( _lock, _context ) \
+    do { (void) _context; } while ( 0 )
+#endif
+
 #if defined( RTEMS_PROFILING )
   #define _ISR_lock_ISR_disable_profile( _context ) \
     ( _context )->ISR_disable_instant = _CPU_Counter_read();
@@ -23,6 +23,7 @@
 #ifndef _RTEMS_SCORE_MUTEXIMPL_H
 #define _RTEMS_SCORE_MUTEXIMPL_H
 
+#include <rtems/score/atomic.h>
 #include <rtems/score/threadqimpl.h>
 
 /**
@@ -44,6 +45,27 @@ typedef struct {
   unsigned int nest_level;
 } Mutex_recursive_Control;
 
+/**
+ * @brief Indicates that threads may wait for the mutex in the owner word of a
+ * fast mutex.
+ */
+#define MUTEX_FAST_WAITERS ( (uintptr_t) 1 )
+
+/**
+ * @brief Fast mutex control.
+ *
+ * The owner word is zero if the mutex is not owned.  Otherwise, it contains
+ * the owner thread and the MUTEX_FAST_WAITERS flag.  An uncontended acquire
+ * and release is a compare and swap of the owner word.  Once a thread blocks
+ * on the mutex, the flag is set and the release goes through the thread queue
+ * until no thread waits for the mutex.  The thread queue owner is only valid
+ * while the flag is set.
+ */
+typedef struct {
+  Mutex_Control Mutex;
+  Atomic_Uintptr owner;
+} Mutex_fast_Control;
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
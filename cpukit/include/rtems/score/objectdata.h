@@ -100,6 +100,33 @@ typedef enum {
  */
 #define OBJECTS_NO_STRING_NAME 0
 
+/**
+ * @brief The hash index to look up the local objects of an object information
+ * by name.
+ *
+ * The index is optional, see _Objects_Name_index_initialize().  The local
+ * objects are chained through their local index.  A chain link of zero
+ * terminates a chain, otherwise it is the local index plus one.
+ */
+typedef struct {
+  /**
+   * @brief This is the bucket count minus one.
+   *
+   * The bucket count is a power of two.
+   */
+  uint32_t bucket_mask;
+
+  /**
+   * @brief This is the table of bucket chain heads.
+   */
+  Objects_Maximum *buckets;
+
+  /**
+   * @brief This is the table of chain links indexed by the local index.
+   */
+  Objects_Maximum *next;
+} Objects_Name_index;
+
 #if defined( RTEMS_MULTIPROCESSING )
 struct _Thread_Control;
 
@@ -254,6 +281,17 @@ typedef struct {
    */
   Objects_Control *initial_objects;
 
+  /**
+   * @brief This is the optional name index of the local objects.
+   *
+   * This member is statically initialized to NULL.  The
+   * _Objects_Name_index_initialize() function creates the index if
+   * CONFIGURE_OBJECT_NAME_INDEX is defined.  All index operations must be
+   * carried out by the owner of the object allocator mutex.  If this member is
+   * NULL, then the name lookups search the local table.
+   */
+  Objects_Name_index *name_index;
+
 #if defined(RTEMS_MULTIPROCESSING)
   /**
    * @brief This method is used by _Thread_queue_Extract_with_proxy().
@@ -315,6 +353,7 @@ Objects_Information name##_Information = { \
   CHAIN_INITIALIZER_EMPTY( name##_Information.Inactive ), \
   NULL, \
   NULL, \
+  NULL, \
   NULL \
   OBJECTS_INFORMATION_MP( name##_Information, NULL ) \
 }
@@ -351,7 +390,8 @@ Objects_Information name##_Information = { \
   CHAIN_INITIALIZER_EMPTY( name##_Information.Inactive ), \
   NULL, \
   NULL, \
-  &name##_Objects[ 0 ].Object \
+  &name##_Objects[ 0 ].Object, \
+  NULL \
   OBJECTS_INFORMATION_MP( name##_Information, ex ) \
 }
 
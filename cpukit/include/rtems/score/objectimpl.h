@@ -519,6 +519,95 @@ bool _Objects_Set_name(
   const char                *name
 );
 
+/**
+ * @brief Creates the name index of each object information with local
+ * objects.
+ *
+ * This is the system initialization handler installed by
+ * CONFIGURE_OBJECT_NAME_INDEX.  The thread classes are excluded.  Objects
+ * opened before the index creation are added to the index.  In case there is
+ * not enough workspace available for an index, then the name lookups of this
+ * object information search the local table.
+ */
+void _Objects_Name_index_initialize( void );
+
+/**
+ * @brief Creates or re-creates the name index of the object information.
+ *
+ * The index is sized according to the current maximum index and contains all
+ * named local objects.  A previous index is freed.
+ *
+ * @param[in, out] information The object information.
+ *
+ * @retval true The operation succeeded.
+ * @retval false Not enough workspace available, the object information has no
+ *   name index afterwards.
+ */
+bool _Objects_Name_index_create( Objects_Information *information );
+
+/**
+ * @brief Adds the object to the name index of the object information.
+ *
+ * Objects without a name are not added.  The object must not be in the index.
+ *
+ * @param information The object information.  Its name index must not be
+ *   NULL.
+ * @param the_object The object to add.
+ */
+void _Objects_Name_index_insert(
+  const Objects_Information *information,
+  const Objects_Control     *the_object
+);
+
+/**
+ * @brief Removes the object from the name index of the object information.
+ *
+ * The lookup uses the current object name.  Nothing happens if the object is
+ * not in the index.
+ *
+ * @param information The object information.  Its name index must not be
+ *   NULL.
+ * @param the_object The object to remove.
+ */
+void _Objects_Name_index_remove(
+  const Objects_Information *information,
+  const Objects_Control     *the_object
+);
+
+/**
+ * @brief Gets the local object with the 32-bit integer name via the name
+ * index.
+ *
+ * @param information The object information.  Its name index must not be
+ *   NULL.
+ * @param name The object name.
+ *
+ * @retval pointer The object with the lowest index of all local objects with
+ *   this name.
+ * @retval NULL No local object exists for this name.
+ */
+Objects_Control *_Objects_Name_index_find_u32(
+  const Objects_Information *information,
+  uint32_t                   name
+);
+
+/**
+ * @brief Gets the local object with the string name via the name index.
+ *
+ * @param information The object information.  Its name index must not be
+ *   NULL.
+ * @param name The object name.  The length must not exceed the maximum name
+ *   length of the object information.
+ *
+ * @retval pointer The object with the lowest index of all local objects with
+ *   this name.
+ * @retval NULL No local object exists for this name.
+ */
+Objects_Control *_Objects_Name_index_find_string(
+  const Objects_Information *information,
+  const char                *name
+);
+
 /**
  * @brief Removes object with a 32-bit integer name from its namespace.
  *
@@ -804,6 +893,10 @@ RTEMS_INLINE_ROUTINE void _Objects_Open(
     _Objects_Get_index( the_object->id ),
     the_object
   );
+
+  if ( information->name_index != NULL ) {
+    _Objects_Name_index_insert( information, the_object );
+  }
 }
 
 /**
@@ -830,6 +923,10 @@ RTEMS_INLINE_ROUTINE void _Objects_Open_u32(
     _Objects_Get_index( the_object->id ),
     the_object
   );
+
+  if ( information->name_index != NULL ) {
+    _Objects_Name_index_insert( information, the_object );
+  }
 }
 
 /**
@@ -856,6 +953,10 @@ RTEMS_INLINE_ROUTINE void _Objects_Open_string(
     _Objects_Get_index( the_object->id ),
     the_object
   );
+
+  if ( information->name_index != NULL ) {
+    _Objects_Name_index_insert( information, the_object );
+  }
 }
 
 /**
@@ -26,6 +26,7 @@
 #else
   #include <rtems/score/assert.h>
   #include <rtems/score/chain.h>
+  #include <rtems/score/context.h>
   #include <rtems/score/isrlock.h>
   #include <rtems/score/smp.h>
   #include <rtems/score/timestamp.h>
@@ -36,16 +37,25 @@
 extern "C" {
 #endif
 
+#if defined(RTEMS_PROFILING) || defined(RTEMS_THREAD_ACCOUNTING)
+  /*
+   * The interrupt entry and exit instants of the outer-most interrupts are
+   * passed by the CPU port to _Profiling_Outer_most_interrupt_entry_and_exit()
+   * if supported.  This define can be used in assembler code.
+   */
+  #define RTEMS_SCORE_INTERRUPT_INSTANTS
+#endif
+
 #if defined(RTEMS_SMP)
   #if defined(RTEMS_PROFILING)
     #define PER_CPU_CONTROL_SIZE_APPROX \
-      ( 512 + CPU_PER_CPU_CONTROL_SIZE + CPU_INTERRUPT_FRAME_SIZE )
+      ( 544 + CPU_PER_CPU_CONTROL_SIZE + CPU_INTERRUPT_FRAME_SIZE )
   #elif defined(RTEMS_DEBUG) || CPU_SIZEOF_POINTER > 4
     #define PER_CPU_CONTROL_SIZE_APPROX \
-      ( 256 + CPU_PER_CPU_CONTROL_SIZE + CPU_INTERRUPT_FRAME_SIZE )
+      ( 288 + CPU_PER_CPU_CONTROL_SIZE + CPU_INTERRUPT_FRAME_SIZE )
   #else
     #define PER_CPU_CONTROL_SIZE_APPROX \
-      ( 180 + CPU_PER_CPU_CONTROL_SIZE + CPU_INTERRUPT_FRAME_SIZE )
+      ( 208 + CPU_PER_CPU_CONTROL_SIZE + CPU_INTERRUPT_FRAME_SIZE )
   #endif
 
   /*
@@ -54,7 +64,14 @@ extern "C" {
    * used in assembler code to easily get the per-CPU control for a particular
    * processor.
    */
-  #if PER_CPU_CONTROL_SIZE_APPROX > 1024
+  #if defined(RTEMS_WATCHDOG_TIMER_WHEEL)
+    /* The timer wheels of the watchdog headers dominate the size */
+    #if CPU_SIZEOF_POINTER > 4
+      #define PER_CPU_CONTROL_SIZE_LOG2 16
+    #else
+      #define PER_CPU_CONTROL_SIZE_LOG2 15
+    #endif
+  #elif PER_CPU_CONTROL_SIZE_APPROX > 1024
     #define PER_CPU_CONTROL_SIZE_LOG2 11
   #elif PER_CPU_CONTROL_SIZE_APPROX > 512
     #define PER_CPU_CONTROL_SIZE_LOG2 10
@@ -230,6 +247,85 @@ typedef struct Per_CPU_Job {
 
 #endif /* defined( RTEMS_SMP ) */
 
+/**
+ * @brief Per-CPU profiled operation index.
+ */
+typedef enum {
+  /**
+   * @brief Index for the scheduler block operation statistics.
+   */
+  PER_CPU_OPERATION_SCHEDULER_BLOCK,
+
+  /**
+   * @brief Index for the scheduler unblock operation statistics.
+   */
+  PER_CPU_OPERATION_SCHEDULER_UNBLOCK,
+
+  /**
+   * @brief Index for the scheduler update priority operation statistics.
+   */
+  PER_CPU_OPERATION_SCHEDULER_UPDATE_PRIORITY,
+
+  /**
+   * @brief Index for the thread dispatch statistics.
+   *
+   * This is the time interval between the selection of the heir thread in
+   * _Thread_Do_dispatch() and the return from the context switch on the
+   * processor which executes the heir thread.  Dispatches without a context
+   * switch and the first context switch to a new thread are not accounted.
+   */
+  PER_CPU_OPERATION_THREAD_DISPATCH,
+
+  /**
+   * @brief Count of profiled operations.
+   */
+  PER_CPU_OPERATION_COUNT
+} Per_CPU_Operation;
+
+/**
+ * @brief Count of histogram bins of the per-CPU operation statistics.
+ *
+ * The bin with index zero counts durations of zero or one CPU counter ticks.
+ * The bin with index N counts durations in the interval [2^N, 2^(N + 1)) CPU
+ * counter ticks.  The last bin counts all greater durations.
+ */
+#define PER_CPU_OPERATION_HISTOGRAM_BINS 24
+
+#if defined( RTEMS_PROFILING )
+/**
+ * @brief Per-CPU statistics of a profiled operation.
+ */
+typedef struct {
+  /**
+   * @brief The maximum operation duration in CPU counter ticks.
+   */
+  CPU_Counter_ticks max_time;
+
+  /**
+   * @brief Count of operations.
+   *
+   * This value may overflow.
+   */
+  uint64_t count;
+
+  /**
+   * @brief Total operation duration in CPU counter ticks.
+   *
+   * This value may overflow.
+   */
+  uint64_t total_time;
+
+  /**
+   * @brief Operation counts by duration.
+   *
+   * The values may overflow.
+   *
+   * @see PER_CPU_OPERATION_HISTOGRAM_BINS.
+   */
+  uint64_t histogram[ PER_CPU_OPERATION_HISTOGRAM_BINS ];
+} Per_CPU_Operation_stats;
+#endif /* defined( RTEMS_PROFILING ) */
+
 /**
  * @brief Per-CPU statistics.
  */
@@ -299,6 +395,19 @@ typedef struct {
    * This value may overflow.
    */
   uint64_t total_interrupt_time;
+
+  /**
+   * @brief The thread dispatch begin instant in CPU counter ticks.
+   *
+   * This value is used to measure the time of thread dispatches.
+   */
+  CPU_Counter_ticks thread_dispatch_instant;
+
+  /**
+   * @brief Statistics of the scheduler operations and thread dispatches
+   * carried out by this processor.
+   */
+  Per_CPU_Operation_stats Operations[ PER_CPU_OPERATION_COUNT ];
 #endif /* defined( RTEMS_PROFILING ) */
 } Per_CPU_Stats;
 
@@ -451,6 +560,18 @@ typedef struct Per_CPU_Control {
    */
   Timestamp_Control cpu_usage_timestamp;
 
+#if CPU_USE_LAZY_FP_SWITCH == TRUE
+  /**
+   * @brief The thread owning the floating point registers of this processor.
+   *
+   * This member is only accessed by this processor with interrupts disabled
+   * or thread dispatching disabled.
+   *
+   * @see _Thread_Lazy_fp_switch().
+   */
+  struct _Thread_Control *fp_owner;
+#endif
+
   /**
    * @brief Watchdog state for this processor.
    */
@@ -466,6 +587,31 @@ typedef struct Per_CPU_Control {
      */
     uint64_t ticks;
 
+    /**
+     * @brief Clock tick suppression state of this processor.
+     *
+     * @see _Watchdog_Suppress_ticks().
+     */
+    struct {
+      /**
+       * @brief The watchdog ticks value of the next clock tick interrupt in
+       * case clock ticks are suppressed, otherwise zero.
+       */
+      uint64_t until;
+
+      /**
+       * @brief The watchdog ticks value at the begin of the clock tick
+       * suppression.
+       */
+      uint64_t ticks;
+
+      /**
+       * @brief The uptime in nanoseconds at the begin of the clock tick
+       * suppression.
+       */
+      uint64_t uptime;
+    } Suppressed;
+
     /**
      * @brief Header for watchdogs.
      *
@@ -504,6 +650,19 @@ typedef struct Per_CPU_Control {
      */
     Atomic_Ulong message;
 
+    /**
+     * @brief Set of processors with a deferred thread dispatch request.
+     *
+     * In case this pointer is not NULL, then thread dispatch requests issued
+     * by this processor for other processors are collected in this set.  The
+     * inter-processor interrupts are sent later in one go.
+     *
+     * This member is only accessed by this processor.
+     *
+     * @see _Thread_Dispatch_defer_requests().
+     */
+    struct Processor_mask *deferred_dispatch_requests;
+
     struct {
       /**
        * @brief The scheduler control of the scheduler owning this processor.
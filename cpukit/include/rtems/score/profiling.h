@@ -25,6 +25,7 @@
 
 #include <rtems/score/percpu.h>
 #include <rtems/score/isrlock.h>
+#include <rtems/score/profilinghistogram.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -155,6 +156,117 @@ static inline void _Profiling_Update_max_interrupt_delay(
 #endif
 }
 
+/**
+ * @brief Gets the begin instant of a profiled operation.
+ *
+ * @return The current CPU counter value if profiling is enabled, otherwise
+ *   zero.
+ */
+static inline CPU_Counter_ticks _Profiling_Operation_begin( void )
+{
+#if defined( RTEMS_PROFILING )
+  return _CPU_Counter_read();
+#else
+  return 0;
+#endif
+}
+
+#if defined( RTEMS_PROFILING )
+/**
+ * @brief Adds the operation duration to the operation statistics.
+ *
+ * @param[in, out] stats The operation statistics.
+ * @param delta The operation duration in CPU counter ticks.
+ */
+static inline void _Profiling_Operation_update(
+  Per_CPU_Operation_stats *stats,
+  CPU_Counter_ticks        delta
+)
+{
+  size_t bin;
+
+  bin = _Profiling_Operation_histogram_bin(
+    delta,
+    PER_CPU_OPERATION_HISTOGRAM_BINS
+  );
+  ++stats->count;
+  stats->total_time += delta;
+  ++stats->histogram[ bin ];
+
+  if ( stats->max_time < delta ) {
+    stats->max_time = delta;
+  }
+}
+#endif
+
+/**
+ * @brief Ends a profiled operation and updates the operation statistics of
+ * the current processor.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param operation The profiled operation.
+ * @param begin_instant The begin instant returned by
+ *   _Profiling_Operation_begin().
+ */
+static inline void _Profiling_Operation_end(
+  Per_CPU_Operation operation,
+  CPU_Counter_ticks begin_instant
+)
+{
+#if defined( RTEMS_PROFILING )
+  _Profiling_Operation_update(
+    &_Per_CPU_Get()->Stats.Operations[ operation ],
+    _CPU_Counter_difference( _CPU_Counter_read(), begin_instant )
+  );
+#else
+  (void) operation;
+  (void) begin_instant;
+#endif
+}
+
+/**
+ * @brief Starts the thread dispatch time measurement.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param[out] cpu The cpu control.
+ */
+static inline void _Profiling_Thread_dispatch_begin( Per_CPU_Control *cpu )
+{
+#if defined( RTEMS_PROFILING )
+  cpu->Stats.thread_dispatch_instant = _CPU_Counter_read();
+#else
+  (void) cpu;
+#endif
+}
+
+/**
+ * @brief Ends the thread dispatch time measurement.
+ *
+ * Must be called with interrupts disabled on the processor which executes
+ * the heir thread.  The begin instant was recorded by the thread dispatch
+ * of this processor which selected the heir thread.
+ *
+ * @param[in, out] cpu The cpu control.
+ */
+static inline void _Profiling_Thread_dispatch_end( Per_CPU_Control *cpu )
+{
+#if defined( RTEMS_PROFILING )
+  Per_CPU_Stats *stats = &cpu->Stats;
+
+  _Profiling_Operation_update(
+    &stats->Operations[ PER_CPU_OPERATION_THREAD_DISPATCH ],
+    _CPU_Counter_difference(
+      _CPU_Counter_read(),
+      stats->thread_dispatch_instant
+    )
+  );
+#else
+  (void) cpu;
+#endif
+}
+
 /**
  * @brief Updates the interrupt profiling statistics.
  *
@@ -0,0 +1,90 @@
+/**
+ * @file
+ *
+ * @ingroup RTEMSScoreProfiling
+ *
+ * @brief Profiling Histogram Support
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTEMS_SCORE_PROFILINGHISTOGRAM_H
+#define _RTEMS_SCORE_PROFILINGHISTOGRAM_H
+
+#include <rtems/score/cpu.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @addtogroup RTEMSScoreProfiling
+ *
+ * @{
+ */
+
+/**
+ * @brief Gets the histogram bin index for the operation duration.
+ *
+ * The bin with index zero counts durations of zero or one CPU counter ticks.
+ * The bin with index N counts durations in the interval [2^N, 2^(N + 1)) CPU
+ * counter ticks.  The last bin counts all greater durations.
+ *
+ * This header has no dependencies on the per-processor control, so that the
+ * SMP lock statistics may use it.
+ *
+ * @param delta The operation duration in CPU counter ticks.
+ * @param bin_count The count of histogram bins.
+ *
+ * @return The histogram bin index.
+ */
+static inline size_t _Profiling_Operation_histogram_bin(
+  CPU_Counter_ticks delta,
+  size_t            bin_count
+)
+{
+  size_t bin;
+
+  if ( delta <= 1 ) {
+    return 0;
+  }
+
+  bin = 31 - (size_t) __builtin_clz( (unsigned int) delta );
+
+  if ( bin >= bin_count ) {
+    bin = bin_count - 1;
+  }
+
+  return bin;
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* _RTEMS_SCORE_PROFILINGHISTOGRAM_H */
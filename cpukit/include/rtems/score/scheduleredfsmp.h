@@ -67,15 +67,30 @@ typedef struct {
 
 typedef struct {
   /**
-   * @brief Chain node for Scheduler_SMP_Context::Affine_queues.
+   * @brief Red-black tree node for Scheduler_EDF_SMP_Context::Affine_queues.
    */
-  Chain_Node Node;
+  RBTree_Node Node;
+
+  /**
+   * @brief Indicates if this ready queue is an element of
+   * Scheduler_EDF_SMP_Context::Affine_queues.
+   */
+  bool affine_queued;
 
   /**
    * @brief The ready threads of the corresponding affinity.
    */
   RBTree_Control Queue;
 
+  /**
+   * @brief The highest priority ready node of this queue, or NULL if the
+   * queue is empty.
+   *
+   * This avoids a tree traversal to determine the highest priority ready
+   * node.
+   */
+  Scheduler_EDF_SMP_Node *minimum;
+
   /**
    * @brief The scheduled thread of the corresponding processor.
    */
@@ -91,10 +106,20 @@ typedef struct {
   int64_t generations[ 2 ];
 
   /**
-   * @brief Chain of ready queues with affine threads to determine the highest
-   * priority ready thread.
+   * @brief Red-black tree of the non-empty ready queues with affine threads
+   * whose processor is not allocated to an affine thread.
+   *
+   * The tree is ordered by the highest priority ready node of each queue.  It
+   * is used to determine the highest priority ready thread without a scan
+   * over all processors.
+   */
+  RBTree_Control Affine_queues;
+
+  /**
+   * @brief The minimum ready queue of Affine_queues, or NULL if the tree is
+   * empty.
    */
-  Chain_Control Affine_queues;
+  Scheduler_EDF_SMP_Ready_queue *affine_minimum;
 
   /**
    * @brief A table with ready queues.
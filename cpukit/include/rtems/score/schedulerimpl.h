@@ -25,6 +25,7 @@
 #include <rtems/score/scheduler.h>
 #include <rtems/score/assert.h>
 #include <rtems/score/priorityimpl.h>
+#include <rtems/score/profiling.h>
 #include <rtems/score/smpimpl.h>
 #include <rtems/score/status.h>
 #include <rtems/score/threadimpl.h>
@@ -230,6 +231,7 @@ RTEMS_INLINE_ROUTINE void _Scheduler_Block( Thread_Control *the_thread )
   Scheduler_Node          *scheduler_node;
   const Scheduler_Control *scheduler;
   ISR_lock_Context         lock_context;
+  CPU_Counter_ticks        begin_instant;
 
   node = _Chain_First( &the_thread->Scheduler.Scheduler_nodes );
   tail = _Chain_Immutable_tail( &the_thread->Scheduler.Scheduler_nodes );
@@ -238,11 +240,16 @@ RTEMS_INLINE_ROUTINE void _Scheduler_Block( Thread_Control *the_thread )
   scheduler = _Scheduler_Node_get_scheduler( scheduler_node );
 
   _Scheduler_Acquire_critical( scheduler, &lock_context );
+  begin_instant = _Profiling_Operation_begin();
   ( *scheduler->Operations.block )(
     scheduler,
     the_thread,
     scheduler_node
   );
+  _Profiling_Operation_end(
+    PER_CPU_OPERATION_SCHEDULER_BLOCK,
+    begin_instant
+  );
   _Scheduler_Release_critical( scheduler, &lock_context );
 
   node = _Chain_Next( node );
@@ -264,13 +271,19 @@ RTEMS_INLINE_ROUTINE void _Scheduler_Block( Thread_Control *the_thread )
   }
 #else
   const Scheduler_Control *scheduler;
+  CPU_Counter_ticks        begin_instant;
 
   scheduler = _Thread_Scheduler_get_home( the_thread );
+  begin_instant = _Profiling_Operation_begin();
   ( *scheduler->Operations.block )(
     scheduler,
     the_thread,
     _Thread_Scheduler_get_home_node( the_thread )
   );
+  _Profiling_Operation_end(
+    PER_CPU_OPERATION_SCHEDULER_BLOCK,
+    begin_instant
+  );
 #endif
 }
 
@@ -289,6 +302,7 @@ RTEMS_INLINE_ROUTINE void _Scheduler_Unblock( Thread_Control *the_thread )
   Scheduler_Node          *scheduler_node;
   const Scheduler_Control *scheduler;
   ISR_lock_Context         lock_context;
+  CPU_Counter_ticks        begin_instant;
 
 #if defined(RTEMS_SMP)
   scheduler_node = SCHEDULER_NODE_OF_THREAD_SCHEDULER_NODE(
@@ -301,7 +315,12 @@ RTEMS_INLINE_ROUTINE void _Scheduler_Unblock( Thread_Control *the_thread )
 #endif
 
   _Scheduler_Acquire_critical( scheduler, &lock_context );
+  begin_instant = _Profiling_Operation_begin();
   ( *scheduler->Operations.unblock )( scheduler, the_thread, scheduler_node );
+  _Profiling_Operation_end(
+    PER_CPU_OPERATION_SCHEDULER_UNBLOCK,
+    begin_instant
+  );
   _Scheduler_Release_critical( scheduler, &lock_context );
 }
 
@@ -334,29 +353,41 @@ RTEMS_INLINE_ROUTINE void _Scheduler_Update_priority( Thread_Control *the_thread
     Scheduler_Node          *scheduler_node;
     const Scheduler_Control *scheduler;
     ISR_lock_Context         lock_context;
+    CPU_Counter_ticks        begin_instant;
 
     scheduler_node = SCHEDULER_NODE_OF_THREAD_SCHEDULER_NODE( node );
     scheduler = _Scheduler_Node_get_scheduler( scheduler_node );
 
     _Scheduler_Acquire_critical( scheduler, &lock_context );
+    begin_instant = _Profiling_Operation_begin();
     ( *scheduler->Operations.update_priority )(
       scheduler,
       the_thread,
       scheduler_node
     );
+    _Profiling_Operation_end(
+      PER_CPU_OPERATION_SCHEDULER_UPDATE_PRIORITY,
+      begin_instant
+    );
     _Scheduler_Release_critical( scheduler, &lock_context );
 
     node = _Chain_Next( node );
   } while ( node != tail );
 #else
   const Scheduler_Control *scheduler;
+  CPU_Counter_ticks        begin_instant;
 
   scheduler = _Thread_Scheduler_get_home( the_thread );
+  begin_instant = _Profiling_Operation_begin();
   ( *scheduler->Operations.update_priority )(
     scheduler,
     the_thread,
     _Thread_Scheduler_get_home_node( the_thread )
   );
+  _Profiling_Operation_end(
+    PER_CPU_OPERATION_SCHEDULER_UPDATE_PRIORITY,
+    begin_instant
+  );
 #endif
 }
 
@@ -56,6 +56,43 @@ extern "C" {
   #define _SMP_Get_current_processor() UINT32_C(0)
 #endif
 
+#if defined( RTEMS_SMP )
+  /**
+   * @brief The count of processors per cluster.
+   *
+   * The processors of a cluster share a cache level or a memory node.  The
+   * processor clusters are the processor index ranges of this size.
+   *
+   * This constant is provided by the application configuration via
+   * <rtems/confdefs.h>, see CONFIGURE_PROCESSORS_PER_CLUSTER.
+   */
+  extern const uint32_t _SMP_Processors_per_cluster;
+
+  /**
+   * @brief Gets the cluster index of the processor.
+   *
+   * @param cpu_index The processor index.
+   *
+   * @return The cluster index of the processor.
+   */
+  static inline uint32_t _SMP_Get_cluster_of_processor( uint32_t cpu_index )
+  {
+    return cpu_index / _SMP_Processors_per_cluster;
+  }
+
+  /**
+   * @brief Gets the cluster index of the current processor.
+   *
+   * @return The cluster index of the current processor.
+   */
+  static inline uint32_t _SMP_Get_current_cluster( void )
+  {
+    return _SMP_Get_cluster_of_processor( _SMP_Get_current_processor() );
+  }
+#else
+  #define _SMP_Get_current_cluster() UINT32_C(0)
+#endif
+
 /** @} */
 
 #ifdef __cplusplus
@@ -21,6 +21,7 @@
 #include <rtems/score/smp.h>
 #include <rtems/score/percpu.h>
 #include <rtems/score/processormask.h>
+#include <rtems/score/watchdogimpl.h>
 #include <rtems/fatal.h>
 
 #ifdef __cplusplus
@@ -49,6 +50,13 @@ extern "C" {
  */
 #define SMP_MESSAGE_PERFORM_JOBS 0x2UL
 
+/**
+ * @brief SMP message to resume the periodic clock tick.
+ *
+ * @see _SMP_Send_message() and _Watchdog_Resume_ticks().
+ */
+#define SMP_MESSAGE_RESUME_CLOCK_TICKS 0x4UL
+
 /**
  * @brief SMP fatal codes.
  */
@@ -162,6 +170,10 @@ static inline long unsigned _SMP_Inter_processor_interrupt_handler(
     if ( ( message & SMP_MESSAGE_PERFORM_JOBS ) != 0 ) {
       _Per_CPU_Perform_jobs( cpu_self );
     }
+
+    if ( ( message & SMP_MESSAGE_RESUME_CLOCK_TICKS ) != 0 ) {
+      _Watchdog_Resume_ticks( cpu_self );
+    }
   }
 
   return message;
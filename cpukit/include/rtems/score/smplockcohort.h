@@ -0,0 +1,483 @@
+/**
+ * @file
+ *
+ * @ingroup RTEMSScoreSMPLock
+ *
+ * @brief SMP Lock API
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTEMS_SCORE_SMPLOCKCOHORT_H
+#define _RTEMS_SCORE_SMPLOCKCOHORT_H
+
+#include <rtems/score/cpuopts.h>
+
+#if defined(RTEMS_SMP)
+
+#include <rtems/score/smplock.h>
+#include <rtems/score/smp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @addtogroup RTEMSScoreSMPLock
+ *
+ * @{
+ */
+
+/**
+ * @brief Count of cluster locks of an SMP cohort lock.
+ *
+ * Processor clusters with a cluster index greater than or equal to this
+ * count share the cluster locks modulo this count.
+ *
+ * @see _SMP_Get_current_cluster().
+ */
+#define SMP_COHORT_LOCK_CLUSTERS 4
+
+/**
+ * @brief Maximum count of consecutive lock hand overs within a cluster.
+ *
+ * This bounds the time a processor of another cluster has to wait for the
+ * global lock.
+ */
+#define SMP_COHORT_LOCK_PASS_MAXIMUM 64
+
+/**
+ * @brief SMP cohort lock cluster control.
+ *
+ * Each cluster control occupies at least one cache line so that the waiting
+ * processors of a cluster spin on a cache line local to the cluster.
+ */
+typedef union {
+  struct {
+    /**
+     * @brief The ticket lock of the cluster.
+     */
+    SMP_ticket_lock_Control Lock;
+
+    /**
+     * @brief Indicates if the global lock was handed over to the next owner
+     * of the cluster lock.
+     *
+     * This member is protected by the cluster lock.
+     */
+    bool global_lock_passed;
+
+    /**
+     * @brief The count of consecutive lock hand overs within this cluster.
+     *
+     * This member is protected by the cluster lock.
+     */
+    unsigned int pass_count;
+  } Cluster;
+
+  /**
+   * @brief Padding to separate the clusters into distinct cache lines.
+   */
+  char cache_line[ CPU_CACHE_LINE_BYTES ];
+} SMP_cohort_lock_Cluster;
+
+/**
+ * @brief SMP cohort lock control.
+ *
+ * The SMP cohort lock is a ticket lock of ticket locks.  A processor acquires
+ * the ticket lock of its cluster and then the global ticket lock, unless the
+ * previous owner of the cluster lock handed over the global lock.  The owner
+ * hands over the global lock to the next processor of its cluster as long as
+ * processors of its cluster wait for the lock, see
+ * SMP_COHORT_LOCK_PASS_MAXIMUM.  This reduces the cache line transfers between
+ * clusters under contention at the cost of a bounded unfairness.
+ */
+typedef struct {
+  /**
+   * @brief The global ticket lock.
+   */
+  SMP_ticket_lock_Control Global;
+
+  /**
+   * @brief The cluster index of the lock owner.
+   *
+   * This member is protected by the lock.
+   */
+  unsigned int owner_cluster;
+
+#if defined(RTEMS_PROFILING)
+  /**
+   * @brief The lock statistics.
+   */
+  SMP_lock_Stats Stats;
+#endif
+
+  /**
+   * @brief The cluster controls.
+   */
+  SMP_cohort_lock_Cluster Clusters[ SMP_COHORT_LOCK_CLUSTERS ];
+} SMP_cohort_lock_Control;
+
+#define SMP_COHORT_LOCK_CLUSTER_INITIALIZER \
+  { { SMP_TICKET_LOCK_INITIALIZER, false, 0 } }
+
+#define SMP_COHORT_LOCK_CLUSTERS_INITIALIZER \
+  { \
+    SMP_COHORT_LOCK_CLUSTER_INITIALIZER, \
+    SMP_COHORT_LOCK_CLUSTER_INITIALIZER, \
+    SMP_COHORT_LOCK_CLUSTER_INITIALIZER, \
+    SMP_COHORT_LOCK_CLUSTER_INITIALIZER \
+  }
+
+/**
+ * @brief SMP cohort lock control initializer for static initialization.
+ */
+#if defined(RTEMS_PROFILING)
+  #define SMP_COHORT_LOCK_INITIALIZER( name ) \
+    { \
+      SMP_TICKET_LOCK_INITIALIZER, \
+      0, \
+      SMP_LOCK_STATS_INITIALIZER( name ), \
+      SMP_COHORT_LOCK_CLUSTERS_INITIALIZER \
+    }
+#else
+  #define SMP_COHORT_LOCK_INITIALIZER( name ) \
+    { \
+      SMP_TICKET_LOCK_INITIALIZER, \
+      0, \
+      SMP_COHORT_LOCK_CLUSTERS_INITIALIZER \
+    }
+#endif
+
+/**
+ * @brief Initializes the SMP cohort lock.
+ *
+ * Concurrent initialization leads to unpredictable results.
+ *
+ * @param[out] lock The SMP cohort lock control.
+ * @param name The name for the SMP lock statistics.  This name must be
+ *   persistent throughout the life time of this statistics block.
+ */
+static inline void _SMP_cohort_lock_Initialize(
+  SMP_cohort_lock_Control *lock,
+  const char              *name
+)
+{
+  size_t i;
+
+  _SMP_ticket_lock_Initialize( &lock->Global );
+  lock->owner_cluster = 0;
+
+  for ( i = 0; i < SMP_COHORT_LOCK_CLUSTERS; ++i ) {
+    SMP_cohort_lock_Cluster *cluster;
+
+    cluster = &lock->Clusters[ i ];
+    _SMP_ticket_lock_Initialize( &cluster->Cluster.Lock );
+    cluster->Cluster.global_lock_passed = false;
+    cluster->Cluster.pass_count = 0;
+  }
+
+#if defined(RTEMS_PROFILING)
+  _SMP_lock_Stats_initialize( &lock->Stats, name );
+#else
+  (void) name;
+#endif
+}
+
+/**
+ * @brief Destroys the SMP cohort lock.
+ *
+ * Concurrent destruction leads to unpredictable results.
+ *
+ * @param[in, out] lock The SMP cohort lock control.
+ */
+static inline void _SMP_cohort_lock_Destroy( SMP_cohort_lock_Control *lock )
+{
+  _SMP_lock_Stats_destroy( &lock->Stats );
+}
+
+/**
+ * @brief Acquires the ticket lock without statistics.
+ *
+ * @param[in, out] lock The ticket lock to acquire.
+ *
+ * @return The initial queue length of the ticket lock.
+ */
+static inline unsigned int _SMP_cohort_lock_Acquire_ticket(
+  SMP_ticket_lock_Control *lock
+)
+{
+  unsigned int my_ticket;
+  unsigned int now_serving;
+  unsigned int initial_queue_length;
+
+  my_ticket =
+    _Atomic_Fetch_add_uint( &lock->next_ticket, 1U, ATOMIC_ORDER_RELAXED );
+  now_serving =
+    _Atomic_Load_uint( &lock->now_serving, ATOMIC_ORDER_ACQUIRE );
+  initial_queue_length = my_ticket - now_serving;
+
+  while ( now_serving != my_ticket ) {
+    now_serving =
+      _Atomic_Load_uint( &lock->now_serving, ATOMIC_ORDER_ACQUIRE );
+  }
+
+  return initial_queue_length;
+}
+
+/**
+ * @brief Releases the ticket lock without statistics.
+ *
+ * @param[in, out] lock The ticket lock to release.
+ */
+static inline void _SMP_cohort_lock_Release_ticket(
+  SMP_ticket_lock_Control *lock
+)
+{
+  unsigned int current_ticket;
+
+  current_ticket =
+    _Atomic_Load_uint( &lock->now_serving, ATOMIC_ORDER_RELAXED );
+  _Atomic_Store_uint(
+    &lock->now_serving,
+    current_ticket + 1U,
+    ATOMIC_ORDER_RELEASE
+  );
+}
+
+/**
+ * @brief Checks if processors wait for the owned ticket lock.
+ *
+ * @param lock The owned ticket lock.
+ *
+ * @retval true There are waiting processors.
+ * @retval false Otherwise.
+ */
+static inline bool _SMP_cohort_lock_Has_waiters(
+  SMP_ticket_lock_Control *lock
+)
+{
+  unsigned int next_ticket;
+  unsigned int now_serving;
+
+  next_ticket =
+    _Atomic_Load_uint( &lock->next_ticket, ATOMIC_ORDER_RELAXED );
+  now_serving =
+    _Atomic_Load_uint( &lock->now_serving, ATOMIC_ORDER_RELAXED );
+
+  return next_ticket - now_serving > 1U;
+}
+
+/**
+ * @brief Acquires the SMP cohort lock.
+ *
+ * This function will not disable interrupts.  The caller must ensure that the
+ * current thread of execution is not interrupted indefinite once it obtained
+ * the SMP cohort lock.
+ *
+ * @param[in, out] lock The SMP cohort lock to acquire.
+ * @param[out] stats_context The SMP lock statistics context.
+ */
+static inline void _SMP_cohort_lock_Do_acquire(
+  SMP_cohort_lock_Control *lock
+#if defined(RTEMS_PROFILING)
+  ,
+  SMP_lock_Stats_context  *stats_context
+#endif
+)
+{
+  unsigned int             cluster_index;
+  SMP_cohort_lock_Cluster *cluster;
+  unsigned int             initial_queue_length;
+#if defined(RTEMS_PROFILING)
+  SMP_lock_Stats_acquire_context acquire_context;
+
+  _SMP_lock_Stats_acquire_begin( &acquire_context );
+#endif
+
+  cluster_index = _SMP_Get_current_cluster() % SMP_COHORT_LOCK_CLUSTERS;
+  cluster = &lock->Clusters[ cluster_index ];
+  initial_queue_length =
+    _SMP_cohort_lock_Acquire_ticket( &cluster->Cluster.Lock );
+
+  if ( !cluster->Cluster.global_lock_passed ) {
+    initial_queue_length += _SMP_cohort_lock_Acquire_ticket( &lock->Global );
+  }
+
+  lock->owner_cluster = cluster_index;
+
+#if defined(RTEMS_PROFILING)
+  _SMP_lock_Stats_acquire_end(
+    &acquire_context,
+    &lock->Stats,
+    stats_context,
+    initial_queue_length
+  );
+#else
+  (void) initial_queue_length;
+#endif
+}
+
+/**
+ * @brief Acquires the SMP cohort lock inline.
+ *
+ * @param[in, out] lock The SMP cohort lock to acquire.
+ * @param[in, out] context The lock context.
+ */
+static inline void _SMP_cohort_lock_Acquire_inline(
+  SMP_cohort_lock_Control *lock,
+  SMP_lock_Context        *context
+)
+{
+#if defined(RTEMS_PROFILING)
+  _SMP_cohort_lock_Do_acquire( lock, &context->Stats_context );
+#else
+  (void) context;
+  _SMP_cohort_lock_Do_acquire( lock );
+#endif
+}
+
+/**
+ * @brief Releases the SMP cohort lock.
+ *
+ * The global lock is handed over to the next owner of the cluster lock, if
+ * processors of the cluster of the owner wait for the lock and the maximum
+ * count of consecutive hand overs within the cluster is not reached.
+ *
+ * @param[in, out] lock The SMP cohort lock to release.
+ * @param stats_context The SMP lock statistics context.
+ */
+static inline void _SMP_cohort_lock_Do_release(
+  SMP_cohort_lock_Control *lock
+#if defined(RTEMS_PROFILING)
+  ,
+  const SMP_lock_Stats_context *stats_context
+#endif
+)
+{
+  SMP_cohort_lock_Cluster *cluster;
+
+  cluster = &lock->Clusters[ lock->owner_cluster ];
+
+#if defined(RTEMS_PROFILING)
+  _SMP_lock_Stats_release_update( stats_context );
+#endif
+
+  if (
+    cluster->Cluster.pass_count < SMP_COHORT_LOCK_PASS_MAXIMUM
+      && _SMP_cohort_lock_Has_waiters( &cluster->Cluster.Lock )
+  ) {
+    ++cluster->Cluster.pass_count;
+    cluster->Cluster.global_lock_passed = true;
+  } else {
+    cluster->Cluster.pass_count = 0;
+    cluster->Cluster.global_lock_passed = false;
+    _SMP_cohort_lock_Release_ticket( &lock->Global );
+  }
+
+  _SMP_cohort_lock_Release_ticket( &cluster->Cluster.Lock );
+}
+
+/**
+ * @brief Releases the SMP cohort lock inline.
+ *
+ * @param[in, out] lock The SMP cohort lock to release.
+ * @param[in, out] context The lock context.
+ */
+static inline void _SMP_cohort_lock_Release_inline(
+  SMP_cohort_lock_Control *lock,
+  SMP_lock_Context        *context
+)
+{
+#if defined(RTEMS_PROFILING)
+  _SMP_cohort_lock_Do_release( lock, &context->Stats_context );
+#else
+  (void) context;
+  _SMP_cohort_lock_Do_release( lock );
+#endif
+}
+
+/**
+ * @brief Acquires an SMP cohort lock.
+ *
+ * This function will not disable interrupts.  The caller must ensure that the
+ * current thread of execution is not interrupted indefinite once it obtained
+ * the SMP cohort lock.
+ *
+ * @param[in, out] lock The SMP cohort lock control.
+ * @param[in, out] context The local SMP lock context for an acquire and
+ *   release pair.
+ */
+void _SMP_cohort_lock_Acquire(
+  SMP_cohort_lock_Control *lock,
+  SMP_lock_Context        *context
+);
+
+/**
+ * @brief Releases an SMP cohort lock.
+ *
+ * @param[in, out] lock The SMP cohort lock control.
+ * @param[in, out] context The local SMP lock context for an acquire and
+ *   release pair.
+ */
+void _SMP_cohort_lock_Release(
+  SMP_cohort_lock_Control *lock,
+  SMP_lock_Context        *context
+);
+
+/**
+ * @brief Disables interrupts and acquires the SMP cohort lock.
+ *
+ * @param[in, out] lock The SMP cohort lock control.
+ * @param[in, out] context The local SMP lock context for an acquire and
+ *   release pair.
+ */
+void _SMP_cohort_lock_ISR_disable_and_acquire(
+  SMP_cohort_lock_Control *lock,
+  SMP_lock_Context        *context
+);
+
+/**
+ * @brief Releases the SMP cohort lock and enables interrupts.
+ *
+ * @param[in, out] lock The SMP cohort lock control.
+ * @param[in, out] context The local SMP lock context for an acquire and
+ *   release pair.
+ */
+void _SMP_cohort_lock_Release_and_ISR_enable(
+  SMP_cohort_lock_Control *lock,
+  SMP_lock_Context        *context
+);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RTEMS_SMP */
+
+#endif /* _RTEMS_SCORE_SMPLOCKCOHORT_H */
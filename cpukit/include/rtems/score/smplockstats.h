@@ -22,6 +22,8 @@
 #if defined(RTEMS_SMP)
 
 #include <rtems/score/chain.h>
+#include <rtems/score/profilinghistogram.h>
+#include <rtems/score/smp.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +42,17 @@ extern "C" {
  */
 #define SMP_LOCK_STATS_CONTENTION_COUNTS 4
 
+/**
+ * @brief Count of histogram bins of the lock acquire times for lock
+ * statistics.
+ *
+ * The bin with index zero counts acquire times of zero or one CPU counter
+ * ticks.  The bin with index N counts acquire times in the interval
+ * [2^N, 2^(N + 1)) CPU counter ticks.  The last bin counts all greater acquire
+ * times.
+ */
+#define SMP_LOCK_STATS_ACQUIRE_TIME_BINS 16
+
 /**
  * @brief SMP lock statistics.
  *
@@ -114,6 +127,33 @@ typedef struct {
    */
   uint64_t total_section_time;
 
+  /**
+   * @brief The counts of lock acquire operations by acquire time.
+   *
+   * The values may overflow.
+   *
+   * @see SMP_LOCK_STATS_ACQUIRE_TIME_BINS.
+   */
+  uint64_t acquire_time_histogram[SMP_LOCK_STATS_ACQUIRE_TIME_BINS];
+
+  /**
+   * @brief The count of lock acquire operations on a processor cluster other
+   * than the cluster of the previous lock owner.
+   *
+   * A high ratio of this count and the usage count indicates that the lock
+   * cache lines move frequently between the processor clusters.
+   *
+   * This value may overflow.
+   *
+   * @see _SMP_Get_current_cluster().
+   */
+  uint64_t other_cluster_count;
+
+  /**
+   * @brief The cluster index of the last lock owner.
+   */
+  uint32_t last_cluster;
+
   /**
    * @brief The lock name.
    */
@@ -141,7 +181,7 @@ typedef struct {
  * @brief SMP lock statistics initializer for static initialization.
  */
 #define SMP_LOCK_STATS_INITIALIZER( name ) \
-  { { NULL, NULL }, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, name }
+  { { NULL, NULL }, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, { 0 }, 0, 0, name }
 
 /**
  * @brief Initializes an SMP lock statistics block.
@@ -183,6 +223,23 @@ typedef struct {
   CPU_Counter_ticks first;
 } SMP_lock_Stats_acquire_context;
 
+/**
+ * @brief Gets the acquire time histogram bin index for the acquire time.
+ *
+ * @param delta The lock acquire time in CPU counter ticks.
+ *
+ * @return The histogram bin index.
+ */
+static inline size_t _SMP_lock_Stats_acquire_time_bin(
+  CPU_Counter_ticks delta
+)
+{
+  return _Profiling_Operation_histogram_bin(
+    delta,
+    SMP_LOCK_STATS_ACQUIRE_TIME_BINS
+  );
+}
+
 /**
  * @brief Starts the lock stats for acquire.
  *
@@ -212,6 +269,7 @@ static inline void _SMP_lock_Stats_acquire_end(
 {
   CPU_Counter_ticks second;
   CPU_Counter_ticks delta;
+  uint32_t          cluster;
 
   second = _CPU_Counter_read();
   stats_context->acquire_instant = second;
@@ -220,6 +278,7 @@ static inline void _SMP_lock_Stats_acquire_end(
   ++stats->usage_count;
 
   stats->total_acquire_time += delta;
+  ++stats->acquire_time_histogram[ _SMP_lock_Stats_acquire_time_bin( delta ) ];
 
   if ( stats->max_acquire_time < delta ) {
     stats->max_acquire_time = delta;
@@ -230,6 +289,13 @@ static inline void _SMP_lock_Stats_acquire_end(
   }
   ++stats->contention_counts[ queue_length ];
 
+  cluster = _SMP_Get_current_cluster();
+
+  if ( stats->last_cluster != cluster ) {
+    stats->last_cluster = cluster;
+    ++stats->other_cluster_count;
+  }
+
   stats_context->stats = stats;
 }
 
@@ -721,6 +721,99 @@ typedef struct  {
   void *        control;
 }Thread_Capture_control;
 
+#if defined(RTEMS_THREAD_ACCOUNTING)
+/**
+ * @brief Count of thread queues with an individual wait time account per
+ * thread.
+ */
+#define THREAD_ACCOUNTING_WAIT_QUEUES 4
+
+/**
+ * @brief Size of the thread queue name copy in a wait time account.
+ */
+#define THREAD_ACCOUNTING_NAME_SIZE 16
+
+/**
+ * @brief Wait time account of a thread for one thread queue.
+ *
+ * The thread queue may be deleted after the wait, so the account identifies
+ * the thread queue by a copy of its name and identifier.
+ */
+typedef struct {
+  /**
+   * @brief The identifier of the object owning the thread queue or zero.
+   *
+   * This is the key of the account if it is not zero, otherwise the name is
+   * the key.
+   */
+  Objects_Id id;
+
+  /**
+   * @brief The thread queue name.
+   */
+  char name[ THREAD_ACCOUNTING_NAME_SIZE ];
+
+  /**
+   * @brief Count of waits on the thread queue.
+   *
+   * A zero value indicates an unused account.
+   */
+  uint32_t count;
+
+  /**
+   * @brief Accumulated wait time on the thread queue.
+   */
+  Timestamp_Control time;
+} Thread_Accounting_wait;
+
+/**
+ * @brief Thread accounting control.
+ *
+ * The accounting is done in the thread dispatch, in the thread state changes
+ * and in the thread queue wait claim and restore default operations.
+ */
+typedef struct {
+  /**
+   * @brief Accumulated time the thread was ready but not executing.
+   */
+  Timestamp_Control ready_time;
+
+  /**
+   * @brief Instant the thread became ready without executing.
+   *
+   * It is zero if the thread executes or is not ready.
+   */
+  Timestamp_Control ready_instant;
+
+  /**
+   * @brief Accumulated time the thread waited on thread queues.
+   */
+  Timestamp_Control wait_time;
+
+  /**
+   * @brief Instant the thread claimed its current thread queue.
+   */
+  Timestamp_Control wait_instant;
+
+  /**
+   * @brief Accumulated interrupt time in CPU counter ticks.
+   *
+   * These are the outer-most interrupts of the processor executing the thread.
+   */
+  uint64_t isr_ticks;
+
+  /**
+   * @brief Wait time accounts of the thread queues with the most wait time.
+   */
+  Thread_Accounting_wait Waits[ THREAD_ACCOUNTING_WAIT_QUEUES ];
+
+  /**
+   * @brief Wait time account for all other thread queues.
+   */
+  Thread_Accounting_wait Other_waits;
+} Thread_Accounting_control;
+#endif
+
 /**
  *  This structure defines the Thread Control Block (TCB).
  *
@@ -827,6 +920,13 @@ struct _Thread_Control {
    */
   Timestamp_Control                     cpu_time_used;
 
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  /**
+   * @brief The ready, wait and interrupt time accounts of this thread.
+   */
+  Thread_Accounting_control             Accounting;
+#endif
+
   /** This field contains information about the starting state of
    *  this thread.
    */
@@ -841,6 +941,19 @@ struct _Thread_Control {
    *  If NULL, the thread is integer only.
    */
   Context_Control_fp                   *fp_context;
+#endif
+#if defined(RTEMS_SMP) && CPU_USE_LAZY_FP_SWITCH == TRUE
+  /**
+   * @brief The processor which loaded the floating point context of this
+   * thread last time.
+   *
+   * The floating point registers of this processor contain the context of
+   * this thread if this thread is also the floating point owner of this
+   * processor.
+   *
+   * @see _Thread_Lazy_fp_switch().
+   */
+  struct Per_CPU_Control               *fp_cpu;
 #endif
   /** This field points to the newlib reentrancy structure for this thread. */
   struct _reent                        *libc_reent;
@@ -1033,6 +1146,7 @@ Thread_Information name##_Information = { \
     CHAIN_INITIALIZER_EMPTY( name##_Information.Objects.Inactive ), \
     NULL, \
     NULL, \
+    NULL, \
     NULL \
     OBJECTS_INFORMATION_MP( name##_Information.Objects, NULL ), \
   }, { \
@@ -1058,7 +1172,8 @@ Thread_Information name##_Information = { \
     CHAIN_INITIALIZER_EMPTY( name##_Information.Objects.Inactive ), \
     NULL, \
     NULL, \
-    &name##_Objects[ 0 ].Control.Object \
+    &name##_Objects[ 0 ].Control.Object, \
+    NULL \
     OBJECTS_INFORMATION_MP( name##_Information.Objects, NULL ) \
   }, { \
     &name##_Heads[ 0 ] \
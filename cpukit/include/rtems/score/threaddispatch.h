@@ -19,6 +19,7 @@
 #define _RTEMS_SCORE_THREADDISPATCH_H
 
 #include <rtems/score/percpu.h>
+#include <rtems/score/processormask.h>
 #include <rtems/score/isrlock.h>
 #include <rtems/score/profiling.h>
 
@@ -240,6 +241,11 @@ RTEMS_INLINE_ROUTINE void _Thread_Dispatch_request(
 #if defined( RTEMS_SMP )
   if ( cpu_self == cpu_target ) {
     cpu_self->dispatch_necessary = true;
+  } else if ( cpu_self->deferred_dispatch_requests != NULL ) {
+    _Processor_mask_Set(
+      cpu_self->deferred_dispatch_requests,
+      _Per_CPU_Get_index( cpu_target )
+    );
   } else {
     _Atomic_Fetch_or_ulong( &cpu_target->message, 0, ATOMIC_ORDER_RELEASE );
     _CPU_SMP_Send_interrupt( _Per_CPU_Get_index( cpu_target ) );
@@ -250,6 +256,52 @@ RTEMS_INLINE_ROUTINE void _Thread_Dispatch_request(
 #endif
 }
 
+#if defined( RTEMS_SMP )
+/**
+ * @brief Defers the thread dispatch requests of the current processor for
+ * other processors.
+ *
+ * Use this function to unblock a batch of threads with at most one
+ * inter-processor interrupt per target processor.  Thread dispatching must be
+ * disabled until the deferred requests are sent by
+ * _Thread_Dispatch_send_deferred_requests().  Thread dispatch requests issued
+ * by interrupts on the current processor in the meantime are deferred as well.
+ * The deferrals may be nested.
+ *
+ * @param[in, out] cpu_self The current processor.
+ * @param[out] targets The set to collect the target processors.
+ *
+ * @return The previous set to collect the target processors.  Pass it to
+ *   _Thread_Dispatch_send_deferred_requests().
+ */
+RTEMS_INLINE_ROUTINE Processor_mask *_Thread_Dispatch_defer_requests(
+  Per_CPU_Control *cpu_self,
+  Processor_mask  *targets
+)
+{
+  Processor_mask *previous;
+
+  _Assert( cpu_self->thread_dispatch_disable_level > 0 );
+  _Processor_mask_Zero( targets );
+  previous = cpu_self->deferred_dispatch_requests;
+  cpu_self->deferred_dispatch_requests = targets;
+
+  return previous;
+}
+
+/**
+ * @brief Sends the deferred thread dispatch requests of the current processor.
+ *
+ * @param[in, out] cpu_self The current processor.
+ * @param previous The previous set to collect the target processors returned
+ *   by _Thread_Dispatch_defer_requests().
+ */
+void _Thread_Dispatch_send_deferred_requests(
+  Per_CPU_Control *cpu_self,
+  Processor_mask  *previous
+);
+#endif
+
 /** @} */
 
 #ifdef __cplusplus
@@ -959,6 +959,48 @@ RTEMS_INLINE_ROUTINE bool _Thread_Is_allocated_fp (
 }
 #endif
 
+#if ( CPU_USE_LAZY_FP_SWITCH == TRUE )
+/**
+ * @brief Loads the floating point context of the executing thread into the
+ * floating point registers of the current processor.
+ *
+ * This function must be called by the floating point unavailable exception
+ * handler of the CPU port with interrupts disabled.  The floating point unit
+ * must be enabled for the interrupted context.  The floating point context of
+ * the previous owner is saved on uniprocessor configurations.  On SMP
+ * configurations, it was already saved when the previous owner was switched
+ * out.
+ *
+ * In case the executing thread has no floating point context, then the
+ * INTERNAL_ERROR_ILLEGAL_USE_OF_FLOATING_POINT_UNIT fatal error occurs.
+ *
+ * @param[in, out] cpu_self The current processor.
+ */
+void _Thread_Lazy_fp_switch( Per_CPU_Control *cpu_self );
+
+/**
+ * @brief Checks if the floating point registers of the processor contain the
+ * floating point context of the thread.
+ *
+ * @param cpu The processor.
+ * @param the_thread The thread.
+ *
+ * @retval true The thread owns the floating point registers.
+ * @retval false Otherwise.
+ */
+RTEMS_INLINE_ROUTINE bool _Thread_Lazy_fp_is_owner(
+  const Per_CPU_Control *cpu,
+  const Thread_Control  *the_thread
+)
+{
+#if defined(RTEMS_SMP)
+  return cpu->fp_owner == the_thread && the_thread->fp_cpu == cpu;
+#else
+  return cpu->fp_owner == the_thread;
+#endif
+}
+#endif
+
 /*
  * If the CPU has hardware floating point, then we must address saving
  * and restoring it as part of the context switch.
@@ -980,7 +1022,20 @@ RTEMS_INLINE_ROUTINE bool _Thread_Is_allocated_fp (
 RTEMS_INLINE_ROUTINE void _Thread_Save_fp( Thread_Control *executing )
 {
 #if ( CPU_HARDWARE_FP == TRUE ) || ( CPU_SOFTWARE_FP == TRUE )
-#if ( CPU_USE_DEFERRED_FP_SWITCH != TRUE )
+#if ( CPU_USE_LAZY_FP_SWITCH == TRUE )
+#if defined(RTEMS_SMP)
+  /*
+   * The thread may continue on another processor, so save the floating point
+   * context if it was loaded on this processor.  The registers stay valid in
+   * case the thread continues on this processor, so the save operation of the
+   * port must not alter them.
+   */
+  if ( _Thread_Lazy_fp_is_owner( _Per_CPU_Get(), executing ) )
+    _Context_Save_fp( &executing->fp_context );
+#else
+  (void) executing;
+#endif
+#elif ( CPU_USE_DEFERRED_FP_SWITCH != TRUE )
   if ( executing->fp_context != NULL )
     _Context_Save_fp( &executing->fp_context );
 #endif
@@ -995,7 +1050,10 @@ RTEMS_INLINE_ROUTINE void _Thread_Save_fp( Thread_Control *executing )
 RTEMS_INLINE_ROUTINE void _Thread_Restore_fp( Thread_Control *executing )
 {
 #if ( CPU_HARDWARE_FP == TRUE ) || ( CPU_SOFTWARE_FP == TRUE )
-#if ( CPU_USE_DEFERRED_FP_SWITCH == TRUE )
+#if ( CPU_USE_LAZY_FP_SWITCH == TRUE )
+  /* The floating point context is restored on demand */
+  (void) executing;
+#elif ( CPU_USE_DEFERRED_FP_SWITCH == TRUE )
   if ( (executing->fp_context != NULL) &&
        !_Thread_Is_allocated_fp( executing ) ) {
     if ( _Thread_Allocated_fp != NULL )
@@ -1010,6 +1068,69 @@ RTEMS_INLINE_ROUTINE void _Thread_Restore_fp( Thread_Control *executing )
 #endif
 }
 
+/**
+ * @brief Enables or disables the floating point unit for the heir thread.
+ *
+ * With the lazy floating point context switch the floating point unit is
+ * only enabled for the heir thread, if it owns the floating point registers of
+ * the processor.  Without the lazy floating point context switch, this
+ * function does nothing.
+ *
+ * @param cpu_self The current processor.
+ * @param[in, out] heir The heir thread.
+ */
+RTEMS_INLINE_ROUTINE void _Thread_Lazy_fp_prepare_switch(
+  const Per_CPU_Control *cpu_self,
+  Thread_Control        *heir
+)
+{
+#if ( CPU_USE_LAZY_FP_SWITCH == TRUE )
+  _Context_Set_fp_enabled(
+    &heir->Registers,
+    _Thread_Lazy_fp_is_owner( cpu_self, heir )
+  );
+#else
+  (void) cpu_self;
+  (void) heir;
+#endif
+}
+
+/**
+ * @brief Releases the floating point registers owned by the thread.
+ *
+ * This function must be called if the floating point context of the thread
+ * is initialized again or freed.  Without the lazy floating point context
+ * switch, this function does nothing.
+ *
+ * @param[in, out] the_thread The thread.
+ */
+RTEMS_INLINE_ROUTINE void _Thread_Lazy_fp_release( Thread_Control *the_thread )
+{
+#if ( CPU_USE_LAZY_FP_SWITCH == TRUE )
+#if defined(RTEMS_SMP)
+  /*
+   * Do not touch the floating point owner of the processor, it may change
+   * concurrently.  The owner check fails without the processor.
+   */
+  the_thread->fp_cpu = NULL;
+#else
+  Per_CPU_Control *cpu_self;
+  ISR_Level        level;
+
+  _ISR_Local_disable( level );
+  cpu_self = _Per_CPU_Get();
+
+  if ( cpu_self->fp_owner == the_thread ) {
+    cpu_self->fp_owner = NULL;
+  }
+
+  _ISR_Local_enable( level );
+#endif
+#else
+  (void) the_thread;
+#endif
+}
+
 /**
  * @brief Deallocates the currently loaded floating point context.
  *
@@ -1149,6 +1270,150 @@ RTEMS_INLINE_ROUTINE void _Thread_Update_CPU_time_used(
   _Timestamp_Add_to( &the_thread->cpu_time_used, &ran );
 }
 
+#if defined(RTEMS_THREAD_ACCOUNTING)
+/**
+ * @brief Adds the wait time on the thread queue to the wait time accounts of
+ * the thread.
+ *
+ * The caller must be the owner of the default thread wait lock and the thread
+ * queue lock.  The name and identifier of the thread queue are copied, since
+ * the thread queue may be deleted afterwards.
+ *
+ * @param[in, out] the_thread The thread.
+ * @param queue The thread queue.
+ * @param wait_time The wait time to add.
+ */
+void _Thread_Accounting_add_wait(
+  Thread_Control           *the_thread,
+  const Thread_queue_Queue *queue,
+  const Timestamp_Control  *wait_time
+);
+
+/**
+ * @brief Ends the ready time of the thread.
+ *
+ * @param[in, out] the_thread The thread.
+ * @param now The current uptime.
+ */
+RTEMS_INLINE_ROUTINE void _Thread_Accounting_ready_end(
+  Thread_Control          *the_thread,
+  const Timestamp_Control *now
+)
+{
+  Timestamp_Control ready;
+
+  if ( the_thread->Accounting.ready_instant != 0 ) {
+    _Timestamp_Subtract( &the_thread->Accounting.ready_instant, now, &ready );
+    _Timestamp_Add_to( &the_thread->Accounting.ready_time, &ready );
+    _Timestamp_Set_to_zero( &the_thread->Accounting.ready_instant );
+  }
+}
+#endif
+
+/**
+ * @brief Begins the ready time of the thread if thread accounting is enabled.
+ *
+ * The caller must be the owner of the thread state lock.  The thread must be
+ * ready.  A thread which still executes on a processor begins its ready time
+ * once it is no longer executing, see _Thread_Accounting_switch().
+ *
+ * @param[in, out] the_thread The thread.
+ */
+RTEMS_INLINE_ROUTINE void _Thread_Accounting_ready( Thread_Control *the_thread )
+{
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  bool executing;
+
+#if defined(RTEMS_SMP)
+  executing = _Thread_Is_executing_on_a_processor( the_thread );
+#else
+  executing = _Thread_Is_executing( the_thread );
+#endif
+
+  if ( executing ) {
+    _Timestamp_Set_to_zero( &the_thread->Accounting.ready_instant );
+  } else {
+    _TOD_Get_uptime( &the_thread->Accounting.ready_instant );
+  }
+#else
+  (void) the_thread;
+#endif
+}
+
+/**
+ * @brief Ends the ready time of the thread if thread accounting is enabled.
+ *
+ * The caller must be the owner of the thread state lock.  The thread is no
+ * longer ready.
+ *
+ * @param[in, out] the_thread The thread.
+ */
+RTEMS_INLINE_ROUTINE void _Thread_Accounting_block( Thread_Control *the_thread )
+{
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  if ( the_thread->Accounting.ready_instant != 0 ) {
+    Timestamp_Control now;
+
+    _TOD_Get_uptime( &now );
+    _Thread_Accounting_ready_end( the_thread, &now );
+  }
+#else
+  (void) the_thread;
+#endif
+}
+
+/**
+ * @brief Updates the ready time of the executing and heir thread if thread
+ * accounting is enabled.
+ *
+ * This function is used by the thread dispatch right before the context
+ * switch with interrupts disabled.  In SMP configurations, other processors
+ * may change the thread states concurrently, so the thread state locks are
+ * acquired.  They are acquired one after another, since the heir may still
+ * execute on another processor which switches to the executing thread.
+ *
+ * @param[in, out] executing The thread which no longer executes.
+ * @param[in, out] heir The thread which executes next.
+ */
+RTEMS_INLINE_ROUTINE void _Thread_Accounting_switch(
+  Thread_Control *executing,
+  Thread_Control *heir
+)
+{
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  Timestamp_Control now;
+#if defined(RTEMS_SMP)
+  ISR_lock_Context  lock_context;
+#endif
+
+  _TOD_Get_uptime( &now );
+
+#if defined(RTEMS_SMP)
+  _Thread_State_acquire_critical( executing, &lock_context );
+#endif
+
+  if ( _States_Is_ready( executing->current_state ) ) {
+    executing->Accounting.ready_instant = now;
+  } else {
+    _Timestamp_Set_to_zero( &executing->Accounting.ready_instant );
+  }
+
+#if defined(RTEMS_SMP)
+  _Thread_State_release_critical( executing, &lock_context );
+  _Thread_State_acquire_critical( heir, &lock_context );
+#endif
+
+  _Thread_Accounting_ready_end( heir, &now );
+
+#if defined(RTEMS_SMP)
+  _Thread_State_release_critical( heir, &lock_context );
+#endif
+#else
+  (void) executing;
+  (void) heir;
+#endif
+}
+
 /**
  * @brief Updates the used cpu time for the heir and dispatches a new heir.
  *
@@ -1951,6 +2216,10 @@ RTEMS_INLINE_ROUTINE void _Thread_Wait_claim(
 
   the_thread->Wait.queue = queue;
 
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  _TOD_Get_uptime( &the_thread->Accounting.wait_instant );
+#endif
+
   _Thread_Wait_release_default_critical( the_thread, &lock_context );
 }
 
@@ -2017,7 +2286,13 @@ RTEMS_INLINE_ROUTINE void _Thread_Wait_restore_default(
   ISR_lock_Context  lock_context;
   Chain_Node       *node;
   const Chain_Node *tail;
+#endif
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  Timestamp_Control now;
+  Timestamp_Control wait_time;
+#endif
 
+#if defined(RTEMS_SMP)
   _Thread_Wait_acquire_default_critical( the_thread, &lock_context );
 
   node = _Chain_First( &the_thread->Wait.Lock.Pending_requests );
@@ -2042,6 +2317,12 @@ RTEMS_INLINE_ROUTINE void _Thread_Wait_restore_default(
   }
 #endif
 
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  _TOD_Get_uptime( &now );
+  _Timestamp_Subtract( &the_thread->Accounting.wait_instant, &now, &wait_time );
+  _Thread_Accounting_add_wait( the_thread, the_thread->Wait.queue, &wait_time );
+#endif
+
   the_thread->Wait.queue = NULL;
   the_thread->Wait.operations = &_Thread_queue_Operations_default;
 
@@ -65,6 +65,65 @@ typedef void Watchdog_Service_routine;
 typedef Watchdog_Service_routine
   ( *Watchdog_Service_routine_entry )( Watchdog_Control * );
 
+#if defined(RTEMS_WATCHDOG_TIMER_WHEEL)
+/**
+ * @brief The count of expiration time bits covered by one timer wheel level.
+ */
+#define WATCHDOG_WHEEL_LEVEL_BITS 6
+
+/**
+ * @brief The count of slots of one timer wheel level.
+ */
+#define WATCHDOG_WHEEL_SLOTS ( 1 << WATCHDOG_WHEEL_LEVEL_BITS )
+
+/**
+ * @brief The count of timer wheel levels to cover 64-bit expiration times.
+ */
+#define WATCHDOG_WHEEL_LEVELS \
+  ( ( 64 + WATCHDOG_WHEEL_LEVEL_BITS - 1 ) / WATCHDOG_WHEEL_LEVEL_BITS )
+
+/**
+ * @brief A timer wheel slot.
+ */
+typedef struct {
+  /**
+   * @brief The first watchdog of this slot or NULL in case the slot is empty.
+   */
+  Watchdog_Control *first;
+
+  /**
+   * @brief The last watchdog of this slot or NULL in case the slot is empty.
+   */
+  Watchdog_Control *last;
+} Watchdog_Wheel_slot;
+
+/**
+ * @brief The watchdog header to manage scheduled watchdogs.
+ *
+ * The scheduled watchdogs are managed by a hierarchical timer wheel.  The
+ * watchdogs of level zero expire at the time point of their slot.  The
+ * watchdogs of higher levels are moved to lower levels once the time of the
+ * wheel reaches their slot.  An all zero header is an empty header.
+ */
+typedef struct {
+  /**
+   * @brief The current time of the timer wheel.
+   *
+   * This is the time point of the last tickle.
+   */
+  uint64_t now;
+
+  /**
+   * @brief Bit field of non-empty slots for each level.
+   */
+  uint64_t occupied[ WATCHDOG_WHEEL_LEVELS ];
+
+  /**
+   * @brief The slots of each level.
+   */
+  Watchdog_Wheel_slot slots[ WATCHDOG_WHEEL_LEVELS ][ WATCHDOG_WHEEL_SLOTS ];
+} Watchdog_Header;
+#else
 /**
  * @brief The watchdog header to manage scheduled watchdogs.
  */
@@ -80,6 +139,7 @@ typedef struct {
    */
   RBTree_Node *first;
 } Watchdog_Header;
+#endif
 
 /**
  *  @brief The control block used to manage each watchdog timer.
@@ -103,6 +163,25 @@ struct Watchdog_Control {
      * on a chain used to manage pending watchdogs by the timer server.
      */
     Chain_Node Chain;
+
+#if defined(RTEMS_WATCHDOG_TIMER_WHEEL)
+    /**
+     * @brief This field is a timer wheel slot node.
+     *
+     * It must not overlap with the color of the red-black tree node which is
+     * used for the watchdog state.
+     */
+    struct {
+      /** @brief The next watchdog of the slot. */
+      Watchdog_Control *next;
+
+      /** @brief The previous watchdog of the slot. */
+      Watchdog_Control *previous;
+
+      /** @brief The slot of this watchdog. */
+      Watchdog_Wheel_slot *slot;
+    } Wheel;
+#endif
   } Node;
 
 #if defined(RTEMS_SMP)
@@ -28,6 +28,7 @@
 #include <rtems/score/percpu.h>
 #include <rtems/score/rbtreeimpl.h>
 
+#include <string.h>
 #include <sys/types.h>
 #include <sys/timespec.h>
 
@@ -47,6 +48,9 @@ extern "C" {
 typedef enum {
   /**
    * @brief The watchdog is scheduled and a black node in the red-black tree.
+   *
+   * In the timer wheel configuration, all scheduled watchdogs have this
+   * state.
    */
   WATCHDOG_SCHEDULED_BLACK,
 
@@ -101,13 +105,72 @@ RTEMS_INLINE_ROUTINE void _Watchdog_Header_initialize(
   Watchdog_Header *header
 )
 {
+#if defined(RTEMS_WATCHDOG_TIMER_WHEEL)
+  memset( header, 0, sizeof( *header ) );
+#else
   _RBTree_Initialize_empty( &header->Watchdogs );
   header->first = NULL;
+#endif
+}
+
+#if defined(RTEMS_WATCHDOG_TIMER_WHEEL)
+/**
+ * @brief Returns the earliest non-empty slot of the timer wheel.
+ *
+ * @param header The watchdog header.
+ * @param[out] begin The begin of the time interval of the slot.  This is the
+ *   next time point at which watchdogs expire (level zero) or move to a lower
+ *   level (higher levels).
+ *
+ * @retval NULL The timer wheel is empty.
+ * @return The earliest non-empty slot.
+ */
+RTEMS_INLINE_ROUTINE Watchdog_Wheel_slot *_Watchdog_Wheel_first_slot(
+  const Watchdog_Header *header,
+  uint64_t              *begin
+)
+{
+  size_t level;
+
+  for ( level = 0; level < WATCHDOG_WHEEL_LEVELS; ++level ) {
+    uint64_t occupied;
+
+    occupied = header->occupied[ level ];
+
+    if ( occupied != 0 ) {
+      size_t   index;
+      size_t   shift;
+      uint64_t time;
+
+      index = (size_t) __builtin_ctzll( occupied );
+      shift = level * WATCHDOG_WHEEL_LEVEL_BITS;
+
+      if ( shift + WATCHDOG_WHEEL_LEVEL_BITS < 64 ) {
+        time = header->now >> ( shift + WATCHDOG_WHEEL_LEVEL_BITS );
+        time <<= shift + WATCHDOG_WHEEL_LEVEL_BITS;
+      } else {
+        time = 0;
+      }
+
+      *begin = time | ( (uint64_t) index << shift );
+      return RTEMS_DECONST(
+        Watchdog_Wheel_slot *,
+        &header->slots[ level ][ index ]
+      );
+    }
+  }
+
+  return NULL;
 }
+#endif
 
 /**
  * @brief Returns the first of the watchdog header.
  *
+ * In the timer wheel configuration, this is the first watchdog of the
+ * earliest non-empty slot.  Its expiration time is the earliest one if the
+ * slot is on level zero.
+ *
  * @param header The watchdog header to remove the first of.
  *
  * @return The first of @a header.
@@ -116,7 +179,20 @@ RTEMS_INLINE_ROUTINE Watchdog_Control *_Watchdog_Header_first(
   const Watchdog_Header *header
 )
 {
+#if defined(RTEMS_WATCHDOG_TIMER_WHEEL)
+  Watchdog_Wheel_slot *slot;
+  uint64_t             begin;
+
+  slot = _Watchdog_Wheel_first_slot( header, &begin );
+
+  if ( slot == NULL ) {
+    return NULL;
+  }
+
+  return slot->first;
+#else
   return (Watchdog_Control *) header->first;
+#endif
 }
 
 /**
@@ -139,6 +215,133 @@ RTEMS_INLINE_ROUTINE void _Watchdog_Header_destroy(
  */
 void _Watchdog_Tick( struct Per_CPU_Control *cpu );
 
+/**
+ * @brief Clock driver operations to suppress and resume clock ticks.
+ *
+ * @see _Watchdog_Enable_tick_suppression().
+ */
+typedef struct {
+  /**
+   * @brief Programs the next clock tick interrupt of the current processor.
+   *
+   * The next clock tick interrupt shall occur the specified count of clock
+   * ticks after the last clock tick interrupt.  This handler is called with
+   * interrupts disabled and the watchdog lock of the processor owned.
+   *
+   * @param cpu_self The current processor.
+   * @param ticks The count of clock ticks.  It is greater than one and less
+   *   than or equal to the maximum suppressed ticks.
+   */
+  void ( *suppress )( Per_CPU_Control *cpu_self, uint32_t ticks );
+
+  /**
+   * @brief Programs the next clock tick interrupt of the current processor to
+   * occur at the next clock tick.
+   *
+   * This handler is called with interrupts disabled and the watchdog lock of
+   * the processor owned.
+   *
+   * @param cpu_self The current processor.
+   * @param ticks The count of clock ticks passed to the last suppress handler
+   *   call.
+   *
+   * @return Returns the count of clock ticks which elapsed since the last
+   *   clock tick interrupt and precede the next clock tick interrupt.  It
+   *   shall be less than @a ticks.
+   */
+  uint32_t ( *resume )( Per_CPU_Control *cpu_self, uint32_t ticks );
+} Watchdog_Tick_suppression_operations;
+
+/**
+ * @brief Indicates if the application enabled the clock tick suppression.
+ *
+ * This constant is provided by the application configuration via
+ * <rtems/confdefs.h>, see CONFIGURE_CLOCK_TICK_SUPPRESSION.
+ */
+extern const bool _Watchdog_Tick_suppression_configured;
+
+/**
+ * @brief Enables the clock tick suppression.
+ *
+ * The clock driver calls this function during its initialization if it is
+ * able to suppress clock ticks.  It has no effect in case the application
+ * configuration did not enable the clock tick suppression.
+ *
+ * Clock ticks are suppressed on processors which run the idle thread.  In SMP
+ * configurations, clock ticks are also suppressed on isolated processors
+ * which run a single thread without a CPU budget algorithm.  The boot
+ * processor maintains the timecounter and the ticks since boot, so it
+ * suppresses clock ticks only in uniprocessor configurations.  The timecounter
+ * must not overflow within the maximum suppressed ticks.
+ *
+ * @param operations The clock driver operations.
+ * @param maximum_ticks The maximum count of clock ticks which may be
+ *   suppressed at once.
+ */
+void _Watchdog_Enable_tick_suppression(
+  const Watchdog_Tick_suppression_operations *operations,
+  uint32_t                                    maximum_ticks
+);
+
+/**
+ * @brief Checks if the clock tick suppression is enabled.
+ *
+ * @retval true The clock tick suppression is enabled.
+ * @retval false Otherwise.
+ */
+bool _Watchdog_Is_tick_suppression_enabled( void );
+
+/**
+ * @brief Suppresses the clock ticks of the current processor up to the next
+ * watchdog expiration if possible.
+ *
+ * The clock driver calls this function at the end of its clock tick
+ * interrupt service routine.
+ *
+ * @param cpu_self The current processor.
+ */
+void _Watchdog_Suppress_ticks( Per_CPU_Control *cpu_self );
+
+/**
+ * @brief Resumes the periodic clock tick of the current processor if clock
+ * ticks are suppressed.
+ *
+ * @param cpu_self The current processor.
+ */
+void _Watchdog_Resume_ticks( Per_CPU_Control *cpu_self );
+
+/**
+ * @brief Updates the watchdog ticks of the processor which suppresses clock
+ * ticks according to the uptime.
+ *
+ * The watchdog lock of the processor must be owned by the caller.
+ *
+ * @param cpu The processor.
+ */
+void _Watchdog_Update_suppressed_ticks( Per_CPU_Control *cpu );
+
+/**
+ * @brief Resumes the periodic clock tick of the processor which suppresses
+ * clock ticks if a watchdog expires before the next clock tick interrupt.
+ *
+ * The watchdog lock of the processor must be owned by the caller.  In case
+ * the processor is not the current processor, an inter-processor interrupt
+ * is used to resume the periodic clock tick.
+ *
+ * @param cpu The processor.
+ */
+void _Watchdog_Check_suppressed_ticks( Per_CPU_Control *cpu );
+
+/**
+ * @brief Accounts the clock ticks suppressed up to the current clock tick
+ * interrupt.
+ *
+ * The watchdog lock of the processor must be owned by the caller.
+ *
+ * @param cpu The processor of the clock tick interrupt.
+ */
+void _Watchdog_Finish_tick_suppression( Per_CPU_Control *cpu );
+
 /**
  * @brief Gets the state of the watchdog.
  *
@@ -352,6 +555,7 @@ RTEMS_INLINE_ROUTINE bool _Watchdog_Is_scheduled(
   return _Watchdog_Get_state( the_watchdog ) < WATCHDOG_INACTIVE;
 }
 
+#if !defined(RTEMS_WATCHDOG_TIMER_WHEEL)
 /**
  * @brief Sets the first node of the header.
  *
@@ -382,6 +586,7 @@ RTEMS_INLINE_ROUTINE void _Watchdog_Next_first(
     header->first = _RBTree_Parent( &the_watchdog->Node.RBTree );
   }
 }
+#endif
 
 /**
  * @brief The maximum watchdog ticks value for the far future.
@@ -564,6 +769,10 @@ RTEMS_INLINE_ROUTINE void _Watchdog_Per_CPU_acquire_critical(
 )
 {
   _ISR_lock_Acquire( &cpu->Watchdog.Lock, lock_context );
+
+  if ( RTEMS_PREDICT_FALSE( cpu->Watchdog.Suppressed.until != 0 ) ) {
+    _Watchdog_Update_suppressed_ticks( cpu );
+  }
 }
 
 /**
@@ -577,6 +786,10 @@ RTEMS_INLINE_ROUTINE void _Watchdog_Per_CPU_release_critical(
   ISR_lock_Context *lock_context
 )
 {
+  if ( RTEMS_PREDICT_FALSE( cpu->Watchdog.Suppressed.until != 0 ) ) {
+    _Watchdog_Check_suppressed_ticks( cpu );
+  }
+
   _ISR_lock_Release( &cpu->Watchdog.Lock, lock_context );
 }
 
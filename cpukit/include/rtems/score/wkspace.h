@@ -48,6 +48,15 @@ extern "C" {
  */
 extern Heap_Control _Workspace_Area;
 
+/**
+ * @brief The heap initialization handler of the workspace.
+ *
+ * This is either _Heap_Initialize() or _Heap_Initialize_segregated_fit(),
+ * see CONFIGURE_WORKSPACE_SEGREGATED_FIT.
+ */
+extern const Heap_Initialization_or_extend_handler
+  _Workspace_Initialize_handler;
+
 /**
  * @brief Initilizes the workspace handler.
  *
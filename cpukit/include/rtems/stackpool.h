@@ -0,0 +1,269 @@
+/**
+ * @file
+ *
+ * @ingroup libmisc_stackpool
+ *
+ * @brief Task Stack Pool
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _RTEMS_STACKPOOL_H
+#define _RTEMS_STACKPOOL_H
+
+#include <rtems.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup libmisc_stackpool Task Stack Pool
+ *
+ * @ingroup RTEMSAPIClassic
+ *
+ * @brief Task stack allocator with size classes.
+ *
+ * The task stack pool provides preallocated task stacks in a small set of
+ * size classes.  Stacks are taken from and returned to a free list of their
+ * class in constant time, so that the creation and deletion of short-lived
+ * threads does not fragment the workspace.  A request which fits in no class
+ * or which finds all suitable classes empty is satisfied by the workspace.
+ * The pool is enabled by the CONFIGURE_TASK_STACK_POOL configuration option.
+ *
+ * Each pool stack has a sanity pattern at its limit.  The pattern is checked
+ * when the stack returns to the pool and when the stack is sampled.  A damaged
+ * pattern results in a fatal error with the RTEMS_FATAL_SOURCE_STACK_CHECKER
+ * source.  The pattern is compatible with the stack checker.
+ *
+ * Optionally, the pool stacks are painted with a byte pattern.  The high water
+ * mark of a stack is then searched from the stack limit toward the last known
+ * high water mark, so the search covers only the part of the stack which was
+ * unused at the last sample.  When a stack returns to the pool only its used
+ * part is repainted.
+ *
+ * @{
+ */
+
+/**
+ * @brief Workspace size in bytes to manage one stack of the task stack pool.
+ *
+ * This is used by <rtems/confdefs.h> to account for the pool in the workspace
+ * size.
+ */
+#define RTEMS_STACK_POOL_SLOT_SIZE ( 4 * sizeof( void * ) )
+
+/**
+ * @brief Workspace size in bytes to manage one size class of the task stack
+ * pool.
+ *
+ * This is used by <rtems/confdefs.h> to account for the pool in the workspace
+ * size.
+ */
+#define RTEMS_STACK_POOL_CLASS_CONTROL_SIZE \
+  ( 8 * sizeof( void * ) + sizeof( rtems_stack_pool_class_information ) )
+
+/**
+ * @brief Size class of the task stack pool.
+ */
+typedef struct {
+  /**
+   * @brief The stack size of this class in bytes.
+   */
+  size_t stack_size;
+
+  /**
+   * @brief The count of stacks of this class.
+   */
+  uint32_t stack_count;
+} rtems_stack_pool_class;
+
+/**
+ * @brief Information about a size class of the task stack pool.
+ */
+typedef struct {
+  /**
+   * @brief The stack size of this class in bytes.
+   */
+  size_t stack_size;
+
+  /**
+   * @brief The count of stacks of this class.
+   */
+  uint32_t stack_count;
+
+  /**
+   * @brief The count of stacks of this class currently in use.
+   */
+  uint32_t used;
+
+  /**
+   * @brief The maximum count of stacks of this class in use at the same time.
+   */
+  uint32_t max_used;
+
+  /**
+   * @brief The count of allocations satisfied by this class.
+   */
+  uint32_t allocations;
+
+  /**
+   * @brief The maximum high water mark in bytes observed for stacks of this
+   * class.
+   *
+   * It is zero if the stack painting is disabled.
+   */
+  size_t max_high_water;
+} rtems_stack_pool_class_information;
+
+/**
+ * @brief The size classes of the task stack pool.
+ *
+ * Defined by <rtems/confdefs.h>.
+ */
+extern const rtems_stack_pool_class rtems_stack_pool_classes[];
+
+/**
+ * @brief The count of size classes of the task stack pool.
+ *
+ * Defined by <rtems/confdefs.h>.
+ */
+extern const size_t rtems_stack_pool_class_count;
+
+/**
+ * @brief Indicates if the pool stacks are painted.
+ *
+ * Defined by <rtems/confdefs.h>.
+ */
+extern const bool rtems_stack_pool_painting;
+
+/**
+ * @brief Allocates the stacks of the task stack pool from the workspace.
+ *
+ * This is the task stack allocator initialization hook of the pool.
+ *
+ * @param stack_space_size The configured stack space size.
+ */
+void rtems_stack_pool_initialize( size_t stack_space_size );
+
+/**
+ * @brief Allocates a task stack.
+ *
+ * This is the task stack allocator hook of the pool.  It must be called with
+ * the object allocator lock held or before multitasking starts.
+ *
+ * @param stack_size The requested stack size.
+ *
+ * @retval NULL Not enough resources.
+ * @retval other The stack area begin.
+ */
+void *rtems_stack_pool_allocate( size_t stack_size );
+
+/**
+ * @brief Frees a task stack.
+ *
+ * This is the task stack deallocator hook of the pool.  It must be called
+ * with the object allocator lock held.
+ *
+ * @param addr The stack area begin returned by rtems_stack_pool_allocate().
+ */
+void rtems_stack_pool_free( void *addr );
+
+/**
+ * @brief Samples the pool stacks of all threads.
+ *
+ * Checks the sanity pattern of each pool stack and updates its high water
+ * mark if the stack painting is enabled.
+ */
+void rtems_stack_pool_sample( void );
+
+/**
+ * @brief Gets the high water mark of the pool stack of a task.
+ *
+ * The high water mark is updated incrementally before it is returned.
+ *
+ * @param id The task identifier.  Use RTEMS_SELF for the executing task.
+ * @param[out] high_water The maximum stack usage in bytes.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ADDRESS The high water parameter is NULL.
+ * @retval RTEMS_INVALID_ID Invalid task identifier.
+ * @retval RTEMS_NOT_CONFIGURED The stack painting is disabled.
+ * @retval RTEMS_NOT_DEFINED The task stack is not from the pool.
+ */
+rtems_status_code rtems_stack_pool_get_high_water(
+  rtems_id  id,
+  size_t   *high_water
+);
+
+/**
+ * @brief Gets information about a size class of the task stack pool.
+ *
+ * @param class_index The size class index.
+ * @param[out] info The size class information.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ADDRESS The information parameter is NULL.
+ * @retval RTEMS_INVALID_NUMBER Invalid size class index.
+ */
+rtems_status_code rtems_stack_pool_get_class_information(
+  size_t                              class_index,
+  rtems_stack_pool_class_information *info
+);
+
+/**
+ * @brief Gets the count of task stack allocations satisfied by the workspace
+ * instead of the pool.
+ */
+uint32_t rtems_stack_pool_get_workspace_allocations( void );
+
+/**
+ * @brief Creates and starts a task which periodically calls
+ * rtems_stack_pool_sample().
+ *
+ * @param priority The sampler task priority.
+ * @param interval The sample interval in clock ticks.
+ * @param[out] id The sampler task identifier.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ADDRESS The identifier parameter is NULL.
+ * @retval RTEMS_INVALID_NUMBER The interval is zero.
+ * @retval other See rtems_task_create() and rtems_task_start().
+ */
+rtems_status_code rtems_stack_pool_start_sampler(
+  rtems_task_priority  priority,
+  rtems_interval       interval,
+  rtems_id            *id
+);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTEMS_STACKPOOL_H */
@@ -111,6 +111,64 @@ static __inline void rtems_recursive_mutex_destroy(
   _Mutex_recursive_Destroy( mutex );
 }
 
+struct _Mutex_fast_Control {
+  struct _Mutex_Control _Mutex;
+  uintptr_t _owner;
+};
+
+void _Mutex_fast_Acquire(struct _Mutex_fast_Control *);
+
+int _Mutex_fast_Try_acquire(struct _Mutex_fast_Control *);
+
+void _Mutex_fast_Release(struct _Mutex_fast_Control *);
+
+typedef struct _Mutex_fast_Control rtems_fast_mutex;
+
+#define RTEMS_FAST_MUTEX_INITIALIZER( name ) \
+  { _MUTEX_NAMED_INITIALIZER( name ), 0 }
+
+static __inline void rtems_fast_mutex_init(
+  rtems_fast_mutex *mutex, const char *name
+)
+{
+  _Mutex_Initialize_named( &mutex->_Mutex, name );
+  mutex->_owner = 0;
+}
+
+static __inline const char *rtems_fast_mutex_get_name(
+  const rtems_fast_mutex *mutex
+)
+{
+  return mutex->_Mutex._Queue._name;
+}
+
+static __inline void rtems_fast_mutex_set_name(
+  rtems_fast_mutex *mutex, const char *name
+)
+{
+  mutex->_Mutex._Queue._name = name;
+}
+
+static __inline void rtems_fast_mutex_lock( rtems_fast_mutex *mutex )
+{
+  _Mutex_fast_Acquire( mutex );
+}
+
+static __inline int rtems_fast_mutex_try_lock( rtems_fast_mutex *mutex )
+{
+  return _Mutex_fast_Try_acquire( mutex );
+}
+
+static __inline void rtems_fast_mutex_unlock( rtems_fast_mutex *mutex )
+{
+  _Mutex_fast_Release( mutex );
+}
+
+static __inline void rtems_fast_mutex_destroy( rtems_fast_mutex *mutex )
+{
+  _Mutex_Destroy( &mutex->_Mutex );
+}
+
 typedef struct _Condition_Control rtems_condition_variable;
 
 #define RTEMS_CONDITION_VARIABLE_INITIALIZER( name ) \
@@ -0,0 +1,279 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTEMS_WORKPOOL_H
+#define _RTEMS_WORKPOOL_H
+
+#include <rtems.h>
+#include <rtems/chain.h>
+#include <rtems/score/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @defgroup RTEMSAPIWorkPool Work Pool
+ *
+ * @ingroup RTEMSAPI
+ *
+ * @brief A work-stealing executor for fork/join parallelism.
+ *
+ * A work pool has one worker task per processor of a processor set.  Each
+ * worker is pinned to its processor via the scheduler instance owning the
+ * processor and a processor affinity of exactly this processor.  Each worker
+ * has a Chase-Lev work-stealing deque.  Work items forked by a worker are
+ * pushed to the bottom of its deque and taken back in last-in first-out
+ * order.  Idle workers steal work items from the top of other deques.  Work
+ * items forked by other tasks are added to a shared injection queue.  Workers
+ * without work wait for the @ref RTEMS_EVENT_SYSTEM_SERVER event.
+ *
+ * A work group tracks the completion of the work items forked into it.  A
+ * worker joining a work group executes other work items until all work items
+ * of the group completed.  Tasks other than the workers block on the
+ * @ref RTEMS_EVENT_SYSTEM_TRANSIENT event until all work items of the group
+ * completed.
+ *
+ * @{
+ */
+
+/**
+ * @brief Count of work items each worker deque can hold.
+ *
+ * If the deque of a worker is full, then forked work items are executed
+ * immediately by the forking worker.
+ */
+#define RTEMS_WORK_POOL_DEQUE_SIZE 256
+
+typedef struct rtems_work_pool rtems_work_pool;
+
+typedef struct rtems_work_item rtems_work_item;
+
+/**
+ * @brief A work group.
+ *
+ * The members are private.  Use rtems_work_group_initialize() to initialize a
+ * work group.
+ */
+typedef struct {
+  Atomic_Ulong pending;
+  rtems_id waiter;
+} rtems_work_group;
+
+/**
+ * @brief Work item handler.
+ *
+ * @param pool The work pool executing the work item.
+ * @param item The work item.
+ */
+typedef void ( *rtems_work_handler )(
+  rtems_work_pool *pool,
+  rtems_work_item *item
+);
+
+/**
+ * @brief A work item.
+ *
+ * Embed the work item in a structure to pass arguments to the handler.  The
+ * members are private.  The work item must not be modified or freed until
+ * the work group join returns.
+ */
+struct rtems_work_item {
+  rtems_chain_node node;
+  rtems_work_handler handler;
+  rtems_work_group *group;
+};
+
+/**
+ * @brief Range handler for rtems_work_pool_parallel_for().
+ *
+ * @param arg The handler argument.
+ * @param begin The first index of the range.
+ * @param end The index after the last index of the range.
+ */
+typedef void ( *rtems_work_range_handler )(
+  void *arg,
+  size_t begin,
+  size_t end
+);
+
+/**
+ * @brief Work pool configuration.
+ */
+typedef struct {
+  /**
+   * @brief The name of the worker tasks.
+   */
+  rtems_name name;
+
+  /**
+   * @brief The priority of the worker tasks with respect to the scheduler
+   * instance of their processor.
+   *
+   * A value of zero selects the current priority of the calling task.
+   */
+  rtems_task_priority priority;
+
+  /**
+   * @brief The stack size of the worker tasks.
+   *
+   * A value of zero selects RTEMS_MINIMUM_STACK_SIZE.
+   */
+  size_t stack_size;
+
+  /**
+   * @brief The attributes of the worker tasks, for example
+   * RTEMS_FLOATING_POINT.
+   */
+  rtems_attribute attributes;
+
+  /**
+   * @brief Size of the processor set buffer in bytes.
+   */
+  size_t cpusetsize;
+
+  /**
+   * @brief The processor set of the work pool.
+   *
+   * A worker is created for each processor of the set which is owned by a
+   * scheduler instance.  If this member is NULL, then the processor set of
+   * the scheduler instance of the calling task is used.
+   */
+  const cpu_set_t *cpuset;
+} rtems_work_pool_config;
+
+/**
+ * @brief Creates a work pool.
+ *
+ * The worker tasks are accounted for in the configured maximum count of
+ * Classic API tasks.
+ *
+ * @param config The work pool configuration.
+ * @param[out] pool The created work pool.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ADDRESS The @a config or @a pool parameter is
+ *   @c NULL.
+ * @retval RTEMS_INVALID_SIZE Invalid processor set size.
+ * @retval RTEMS_INVALID_NAME The processor set contains no processor owned by
+ *   a scheduler instance.
+ * @retval RTEMS_INCORRECT_STATE A processor of the processor set was removed
+ *   from its scheduler instance during the work pool creation.
+ * @retval RTEMS_NO_MEMORY Not enough memory to allocate the work pool.
+ * @retval other The status of a failed worker task creation.
+ */
+rtems_status_code rtems_work_pool_create(
+  const rtems_work_pool_config *config,
+  rtems_work_pool **pool
+);
+
+/**
+ * @brief Deletes a work pool.
+ *
+ * The work pool must have no pending work items.  Must be called from a task
+ * other than the workers of the work pool.
+ *
+ * @param pool The work pool.
+ */
+void rtems_work_pool_delete( rtems_work_pool *pool );
+
+/**
+ * @brief Gets the count of workers of the work pool.
+ *
+ * @param pool The work pool.
+ *
+ * @return The count of workers.
+ */
+uint32_t rtems_work_pool_get_worker_count( const rtems_work_pool *pool );
+
+/**
+ * @brief Initializes a work group.
+ *
+ * The task which initializes the work group must fork the work items of the
+ * group and join the group.
+ *
+ * @param[out] group The work group.
+ */
+void rtems_work_group_initialize( rtems_work_group *group );
+
+/**
+ * @brief Forks a work item into a work group.
+ *
+ * @param pool The work pool.
+ * @param group The work group.
+ * @param item The work item.
+ * @param handler The handler of the work item.
+ */
+void rtems_work_pool_fork(
+  rtems_work_pool *pool,
+  rtems_work_group *group,
+  rtems_work_item *item,
+  rtems_work_handler handler
+);
+
+/**
+ * @brief Waits for the completion of all work items of the work group.
+ *
+ * A worker executes work items of the work pool while it waits.  A task
+ * other than a worker blocks on the @ref RTEMS_EVENT_SYSTEM_TRANSIENT event,
+ * so this event must not be in use by the calling task.  Afterwards, the work
+ * group may be initialized again.
+ *
+ * @param pool The work pool.
+ * @param group The work group.
+ */
+void rtems_work_pool_join( rtems_work_pool *pool, rtems_work_group *group );
+
+/**
+ * @brief Executes the range handler for all indices of the range in parallel.
+ *
+ * The range is split recursively in halves until the size is at most the
+ * grain size.  The halves are forked into the work pool.  Returns after all
+ * indices of the range were processed.
+ *
+ * @param pool The work pool.
+ * @param begin The first index of the range.
+ * @param end The index after the last index of the range.
+ * @param grain The maximum range size processed by one handler call.  A value
+ *   of zero is treated as one.
+ * @param handler The range handler.
+ * @param arg The range handler argument.
+ */
+void rtems_work_pool_parallel_for(
+  rtems_work_pool *pool,
+  size_t begin,
+  size_t end,
+  size_t grain,
+  rtems_work_range_handler handler,
+  void *arg
+);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* _RTEMS_WORKPOOL_H */
@@ -87,6 +87,34 @@ typedef struct rtems_bdbuf_waiters {
   rtems_condition_variable cond_var;
 } rtems_bdbuf_waiters;
 
+/**
+ * A shard of the BD buffer cache. The groups and their BDs are partitioned
+ * into shards. Each dd/block pair is mapped by a hash function to exactly one
+ * shard and only BDs of this shard are used to cache the block. Operations on
+ * blocks of different shards do not contend for a lock.
+ */
+typedef struct rtems_bdbuf_shard
+{
+  rtems_mutex          lock;             /**< The shard lock. It locks the BDs
+                                          * and groups of the shard, the hash
+                                          * table and the lists. */
+  rtems_bdbuf_buffer** hash;             /**< Buffer descriptor lookup hash
+                                          * table. */
+  size_t               hash_mask;        /**< The hash table size minus one. */
+  rtems_chain_control  lru;              /**< Least recently used list */
+  rtems_chain_control  modified;         /**< Modified buffers list */
+  rtems_chain_control  sync;             /**< Buffers to sync list */
+
+  rtems_bdbuf_waiters  access_waiters;   /**< Wait for a buffer in
+                                          * ACCESS_CACHED, ACCESS_MODIFIED or
+                                          * ACCESS_EMPTY
+                                          * state. */
+  rtems_bdbuf_waiters  transfer_waiters; /**< Wait for a buffer in TRANSFER
+                                          * state. */
+  rtems_bdbuf_waiters  buffer_waiters;   /**< Wait for a buffer and no one is
+                                          * available. */
+} rtems_bdbuf_shard;
+
 /**
  * The BD buffer cache.
  */
@@ -108,8 +136,11 @@ typedef struct rtems_bdbuf_cache
                                           * buffer size that fit in a group. */
   uint32_t            flags;             /**< Configuration flags. */
 
-  rtems_mutex         lock;              /**< The cache lock. It locks all
-                                          * cache data, BD and lists. */
+  rtems_mutex         lock;              /**< The cache lock. It locks the
+                                          * swapout and read-ahead state and
+                                          * the device statistics. A shard
+                                          * lock must not be obtained while
+                                          * owning the cache lock. */
   rtems_mutex         sync_lock;         /**< Sync calls block writes. */
   bool                sync_active;       /**< True if a sync is active. */
   rtems_id            sync_requester;    /**< The sync requester. */
@@ -117,20 +148,8 @@ typedef struct rtems_bdbuf_cache
                                           * BDBUF_INVALID_DEV not a device
                                           * sync. */
 
-  rtems_bdbuf_buffer* tree;              /**< Buffer descriptor lookup AVL tree
-                                          * root. There is only one. */
-  rtems_chain_control lru;               /**< Least recently used list */
-  rtems_chain_control modified;          /**< Modified buffers list */
-  rtems_chain_control sync;              /**< Buffers to sync list */
-
-  rtems_bdbuf_waiters access_waiters;    /**< Wait for a buffer in
-                                          * ACCESS_CACHED, ACCESS_MODIFIED or
-                                          * ACCESS_EMPTY
-                                          * state. */
-  rtems_bdbuf_waiters transfer_waiters;  /**< Wait for a buffer in TRANSFER
-                                          * state. */
-  rtems_bdbuf_waiters buffer_waiters;    /**< Wait for a buffer and no one is
-                                          * available. */
+  rtems_bdbuf_shard*  shards;            /**< The shards. */
+  size_t              shard_count;       /**< The number of shards. */
 
   rtems_bdbuf_swapout_transfer *swapout_transfer;
   rtems_bdbuf_swapout_worker *swapout_workers;
@@ -139,6 +158,11 @@ typedef struct rtems_bdbuf_cache
   rtems_bdbuf_group*  groups;            /**< The groups. */
   rtems_id            read_ahead_task;   /**< Read-ahead task */
   rtems_chain_control read_ahead_chain;  /**< Read-ahead request chain */
+  rtems_disk_device  *read_ahead_device; /**< The device processed by the
+                                          * read-ahead task. */
+  rtems_bdbuf_waiters read_ahead_waiters; /**< Wait for the read-ahead task
+                                           * to finish the processing of a
+                                           * device. */
   bool                read_ahead_enabled; /**< Read-ahead enabled */
   rtems_status_code   init_status;       /**< The initialization status */
   pthread_once_t      once;
@@ -165,7 +189,7 @@ typedef enum {
   RTEMS_BDBUF_FATAL_STATE_10,
   RTEMS_BDBUF_FATAL_STATE_11,
   RTEMS_BDBUF_FATAL_SWAPOUT_RE,
-  RTEMS_BDBUF_FATAL_TREE_RM,
+  RTEMS_BDBUF_FATAL_HASH_RM,
   RTEMS_BDBUF_FATAL_WAIT_EVNT,
   RTEMS_BDBUF_FATAL_WAIT_TRANS_EVNT
 } rtems_bdbuf_fatal_code;
@@ -177,6 +201,12 @@ typedef enum {
 #define RTEMS_BDBUF_SWAPOUT_SYNC   RTEMS_EVENT_2
 #define RTEMS_BDBUF_READ_AHEAD_WAKE_UP RTEMS_EVENT_1
 
+/**
+ * The read-ahead window of a new stream in blocks.  It is limited by the
+ * maximum read-ahead blocks.
+ */
+#define RTEMS_BDBUF_READ_AHEAD_INITIAL_WINDOW 4
+
 static rtems_task rtems_bdbuf_swapout_task(rtems_task_argument arg);
 
 static rtems_task rtems_bdbuf_read_ahead_task(rtems_task_argument arg);
@@ -187,11 +217,6 @@ static rtems_task rtems_bdbuf_read_ahead_task(rtems_task_argument arg);
 static rtems_bdbuf_cache bdbuf_cache = {
   .lock = RTEMS_MUTEX_INITIALIZER(NULL),
   .sync_lock = RTEMS_MUTEX_INITIALIZER(NULL),
-  .access_waiters = { .cond_var = RTEMS_CONDITION_VARIABLE_INITIALIZER(NULL) },
-  .transfer_waiters = {
-    .cond_var = RTEMS_CONDITION_VARIABLE_INITIALIZER(NULL)
-  },
-  .buffer_waiters = { .cond_var = RTEMS_CONDITION_VARIABLE_INITIALIZER(NULL) },
   .once = PTHREAD_ONCE_INIT
 };
 
@@ -228,20 +253,26 @@ rtems_bdbuf_show_usage (void)
 {
   uint32_t group;
   uint32_t total = 0;
-  uint32_t val;
+  size_t   s;
+  uint32_t lru = 0;
+  uint32_t modified = 0;
+  uint32_t sync = 0;
 
   for (group = 0; group < bdbuf_cache.group_count; group++)
     total += bdbuf_cache.groups[group].users;
   printf ("bdbuf:group users=%lu", total);
-  val = rtems_bdbuf_list_count (&bdbuf_cache.lru);
-  printf (", lru=%lu", val);
-  total = val;
-  val = rtems_bdbuf_list_count (&bdbuf_cache.modified);
-  printf (", mod=%lu", val);
-  total += val;
-  val = rtems_bdbuf_list_count (&bdbuf_cache.sync);
-  printf (", sync=%lu", val);
-  total += val;
+  for (s = 0; s < bdbuf_cache.shard_count; s++)
+  {
+    lru += rtems_bdbuf_list_count (&bdbuf_cache.shards[s].lru);
+    modified += rtems_bdbuf_list_count (&bdbuf_cache.shards[s].modified);
+    sync += rtems_bdbuf_list_count (&bdbuf_cache.shards[s].sync);
+  }
+  printf (", lru=%lu", lru);
+  total = lru;
+  printf (", mod=%lu", modified);
+  total += modified;
+  printf (", sync=%lu", sync);
+  total += sync;
   printf (", total=%lu\n", total);
 }
 
@@ -271,15 +302,6 @@ rtems_bdbuf_show_users (const char* where, rtems_bdbuf_buffer* bd)
 #define rtems_bdbuf_show_users(_w, _b) ((void) 0)
 #endif
 
-/**
- * The default maximum height of 32 allows for AVL trees having between
- * 5,704,880 and 4,294,967,295 nodes, depending on order of insertion.  You may
- * change this compile-time constant as you wish.
- */
-#ifndef RTEMS_BDBUF_AVL_MAX_HEIGHT
-#define RTEMS_BDBUF_AVL_MAX_HEIGHT (32)
-#endif
-
 static void
 rtems_bdbuf_fatal (rtems_fatal_code error)
 {
@@ -293,493 +315,134 @@ rtems_bdbuf_fatal_with_state (rtems_bdbuf_buf_state state,
   rtems_bdbuf_fatal ((((uint32_t) state) << 16) | error);
 }
 
+static uint32_t
+rtems_bdbuf_hash (const rtems_disk_device *dd, rtems_blkdev_bnum block)
+{
+  /*
+   * Fibonacci hashing. The low order bits select the hash bucket and the high
+   * order bits select the shard.
+   */
+  return (((uint32_t) ((uintptr_t) dd >> 4)) ^ block) * UINT32_C (0x9e3779b1);
+}
+
+static rtems_bdbuf_shard *
+rtems_bdbuf_shard_of_block (const rtems_disk_device *dd,
+                            rtems_blkdev_bnum        block)
+{
+  uint32_t hash = rtems_bdbuf_hash (dd, block);
+
+  return &bdbuf_cache.shards [(hash >> 16) % bdbuf_cache.shard_count];
+}
+
+/**
+ * The groups are initially distributed evenly to the shards in ascending
+ * order.
+ */
+static size_t
+rtems_bdbuf_shard_index_of_group (size_t group_index)
+{
+  return (group_index * bdbuf_cache.shard_count) / bdbuf_cache.group_count;
+}
+
+/**
+ * Returns the shard which owns the BD. The owner of a group changes only if
+ * the group has no users and all its BDs are on the LRU list, so the owner of
+ * a BD in use is stable.
+ */
+static rtems_bdbuf_shard *
+rtems_bdbuf_shard_of_bd (const rtems_bdbuf_buffer *bd)
+{
+  return &bdbuf_cache.shards [bd->group->shard_index];
+}
+
+static rtems_bdbuf_buffer **
+rtems_bdbuf_hash_bucket (rtems_bdbuf_shard       *shard,
+                         const rtems_disk_device *dd,
+                         rtems_blkdev_bnum        block)
+{
+  return &shard->hash [rtems_bdbuf_hash (dd, block) & shard->hash_mask];
+}
+
 /**
- * Searches for the node with specified dd/block.
+ * Searches for the BD with specified dd/block.
  *
- * @param root pointer to the root node of the AVL-Tree
+ * @param shard The shard of the dd/block.
  * @param dd disk device search key
  * @param block block search key
- * @retval NULL node with the specified dd/block is not found
- * @return pointer to the node with specified dd/block
+ * @retval NULL BD with the specified dd/block is not found
+ * @return pointer to the BD with specified dd/block
  */
 static rtems_bdbuf_buffer *
-rtems_bdbuf_avl_search (rtems_bdbuf_buffer** root,
-                        const rtems_disk_device *dd,
-                        rtems_blkdev_bnum    block)
+rtems_bdbuf_hash_search (rtems_bdbuf_shard       *shard,
+                         const rtems_disk_device *dd,
+                         rtems_blkdev_bnum        block)
 {
-  rtems_bdbuf_buffer* p = *root;
+  rtems_bdbuf_buffer *bd = *rtems_bdbuf_hash_bucket (shard, dd, block);
 
-  while ((p != NULL) && ((p->dd != dd) || (p->block != block)))
-  {
-    if (((uintptr_t) p->dd < (uintptr_t) dd)
-        || ((p->dd == dd) && (p->block < block)))
-    {
-      p = p->avl.right;
-    }
-    else
-    {
-      p = p->avl.left;
-    }
-  }
+  while (bd != NULL && (bd->dd != dd || bd->block != block))
+    bd = bd->hash_next;
 
-  return p;
+  return bd;
 }
 
 /**
- * Inserts the specified node to the AVl-Tree.
+ * Inserts the BD into the hash table.
  *
- * @param root pointer to the root node of the AVL-Tree
- * @param node Pointer to the node to add.
- * @retval 0 The node added successfully
- * @retval -1 An error occured
+ * @param shard The shard of the BD.
+ * @param bd The BD to insert.
+ * @retval 0 The BD was inserted.
+ * @retval -1 A BD with the same dd/block is already in the hash table.
  */
 static int
-rtems_bdbuf_avl_insert(rtems_bdbuf_buffer** root,
-                       rtems_bdbuf_buffer*  node)
+rtems_bdbuf_hash_insert (rtems_bdbuf_shard *shard, rtems_bdbuf_buffer *bd)
 {
-  const rtems_disk_device *dd = node->dd;
-  rtems_blkdev_bnum block = node->block;
-
-  rtems_bdbuf_buffer*  p = *root;
-  rtems_bdbuf_buffer*  q;
-  rtems_bdbuf_buffer*  p1;
-  rtems_bdbuf_buffer*  p2;
-  rtems_bdbuf_buffer*  buf_stack[RTEMS_BDBUF_AVL_MAX_HEIGHT];
-  rtems_bdbuf_buffer** buf_prev = buf_stack;
-
-  bool modified = false;
-
-  if (p == NULL)
-  {
-    *root = node;
-    node->avl.left = NULL;
-    node->avl.right = NULL;
-    node->avl.bal = 0;
-    return 0;
-  }
+  rtems_bdbuf_buffer **bucket = rtems_bdbuf_hash_bucket (shard,
+                                                          bd->dd,
+                                                          bd->block);
+  rtems_bdbuf_buffer  *p = *bucket;
 
   while (p != NULL)
   {
-    *buf_prev++ = p;
-
-    if (((uintptr_t) p->dd < (uintptr_t) dd)
-        || ((p->dd == dd) && (p->block < block)))
-    {
-      p->avl.cache = 1;
-      q = p->avl.right;
-      if (q == NULL)
-      {
-        q = node;
-        p->avl.right = q = node;
-        break;
-      }
-    }
-    else if ((p->dd != dd) || (p->block != block))
-    {
-      p->avl.cache = -1;
-      q = p->avl.left;
-      if (q == NULL)
-      {
-        q = node;
-        p->avl.left = q;
-        break;
-      }
-    }
-    else
-    {
+    if (p->dd == bd->dd && p->block == bd->block)
       return -1;
-    }
 
-    p = q;
+    p = p->hash_next;
   }
 
-  q->avl.left = q->avl.right = NULL;
-  q->avl.bal = 0;
-  modified = true;
-  buf_prev--;
-
-  while (modified)
-  {
-    if (p->avl.cache == -1)
-    {
-      switch (p->avl.bal)
-      {
-        case 1:
-          p->avl.bal = 0;
-          modified = false;
-          break;
-
-        case 0:
-          p->avl.bal = -1;
-          break;
-
-        case -1:
-          p1 = p->avl.left;
-          if (p1->avl.bal == -1) /* simple LL-turn */
-          {
-            p->avl.left = p1->avl.right;
-            p1->avl.right = p;
-            p->avl.bal = 0;
-            p = p1;
-          }
-          else /* double LR-turn */
-          {
-            p2 = p1->avl.right;
-            p1->avl.right = p2->avl.left;
-            p2->avl.left = p1;
-            p->avl.left = p2->avl.right;
-            p2->avl.right = p;
-            if (p2->avl.bal == -1) p->avl.bal = +1; else p->avl.bal = 0;
-            if (p2->avl.bal == +1) p1->avl.bal = -1; else p1->avl.bal = 0;
-            p = p2;
-          }
-          p->avl.bal = 0;
-          modified = false;
-          break;
-
-        default:
-          break;
-      }
-    }
-    else
-    {
-      switch (p->avl.bal)
-      {
-        case -1:
-          p->avl.bal = 0;
-          modified = false;
-          break;
-
-        case 0:
-          p->avl.bal = 1;
-          break;
-
-        case 1:
-          p1 = p->avl.right;
-          if (p1->avl.bal == 1) /* simple RR-turn */
-          {
-            p->avl.right = p1->avl.left;
-            p1->avl.left = p;
-            p->avl.bal = 0;
-            p = p1;
-          }
-          else /* double RL-turn */
-          {
-            p2 = p1->avl.left;
-            p1->avl.left = p2->avl.right;
-            p2->avl.right = p1;
-            p->avl.right = p2->avl.left;
-            p2->avl.left = p;
-            if (p2->avl.bal == +1) p->avl.bal = -1; else p->avl.bal = 0;
-            if (p2->avl.bal == -1) p1->avl.bal = +1; else p1->avl.bal = 0;
-            p = p2;
-          }
-          p->avl.bal = 0;
-          modified = false;
-          break;
-
-        default:
-          break;
-      }
-    }
-    q = p;
-    if (buf_prev > buf_stack)
-    {
-      p = *--buf_prev;
-
-      if (p->avl.cache == -1)
-      {
-        p->avl.left = q;
-      }
-      else
-      {
-        p->avl.right = q;
-      }
-    }
-    else
-    {
-      *root = p;
-      break;
-    }
-  };
+  bd->hash_next = *bucket;
+  *bucket = bd;
 
   return 0;
 }
 
-
 /**
- * Removes the node from the tree.
+ * Removes the BD from the hash table.
  *
- * @param root Pointer to pointer to the root node
- * @param node Pointer to the node to remove
- * @retval 0 Item removed
- * @retval -1 No such item found
+ * @param shard The shard of the BD.
+ * @param bd The BD to remove.
+ * @retval 0 The BD was removed.
+ * @retval -1 The BD is not in the hash table.
  */
 static int
-rtems_bdbuf_avl_remove(rtems_bdbuf_buffer**      root,
-                       const rtems_bdbuf_buffer* node)
+rtems_bdbuf_hash_remove (rtems_bdbuf_shard *shard, rtems_bdbuf_buffer *bd)
 {
-  const rtems_disk_device *dd = node->dd;
-  rtems_blkdev_bnum block = node->block;
-
-  rtems_bdbuf_buffer*  p = *root;
-  rtems_bdbuf_buffer*  q;
-  rtems_bdbuf_buffer*  r;
-  rtems_bdbuf_buffer*  s;
-  rtems_bdbuf_buffer*  p1;
-  rtems_bdbuf_buffer*  p2;
-  rtems_bdbuf_buffer*  buf_stack[RTEMS_BDBUF_AVL_MAX_HEIGHT];
-  rtems_bdbuf_buffer** buf_prev = buf_stack;
-
-  bool modified = false;
-
-  memset (buf_stack, 0, sizeof(buf_stack));
-
-  while (p != NULL)
-  {
-    *buf_prev++ = p;
-
-    if (((uintptr_t) p->dd < (uintptr_t) dd)
-        || ((p->dd == dd) && (p->block < block)))
-    {
-      p->avl.cache = 1;
-      p = p->avl.right;
-    }
-    else if ((p->dd != dd) || (p->block != block))
-    {
-      p->avl.cache = -1;
-      p = p->avl.left;
-    }
-    else
-    {
-      /* node found */
-      break;
-    }
-  }
-
-  if (p == NULL)
-  {
-    /* there is no such node */
-    return -1;
-  }
-
-  q = p;
-
-  buf_prev--;
-  if (buf_prev > buf_stack)
-  {
-    p = *(buf_prev - 1);
-  }
-  else
-  {
-    p = NULL;
-  }
-
-  /* at this moment q - is a node to delete, p is q's parent */
-  if (q->avl.right == NULL)
-  {
-    r = q->avl.left;
-    if (r != NULL)
-    {
-      r->avl.bal = 0;
-    }
-    q = r;
-  }
-  else
-  {
-    rtems_bdbuf_buffer **t;
-
-    r = q->avl.right;
-
-    if (r->avl.left == NULL)
-    {
-      r->avl.left = q->avl.left;
-      r->avl.bal = q->avl.bal;
-      r->avl.cache = 1;
-      *buf_prev++ = q = r;
-    }
-    else
-    {
-      t = buf_prev++;
-      s = r;
-
-      while (s->avl.left != NULL)
-      {
-        *buf_prev++ = r = s;
-        s = r->avl.left;
-        r->avl.cache = -1;
-      }
-
-      s->avl.left = q->avl.left;
-      r->avl.left = s->avl.right;
-      s->avl.right = q->avl.right;
-      s->avl.bal = q->avl.bal;
-      s->avl.cache = 1;
-
-      *t = q = s;
-    }
-  }
-
-  if (p != NULL)
-  {
-    if (p->avl.cache == -1)
-    {
-      p->avl.left = q;
-    }
-    else
-    {
-      p->avl.right = q;
-    }
-  }
-  else
-  {
-    *root = q;
-  }
-
-  modified = true;
+  rtems_bdbuf_buffer **link = rtems_bdbuf_hash_bucket (shard,
+                                                        bd->dd,
+                                                        bd->block);
 
-  while (modified)
+  while (*link != NULL)
   {
-    if (buf_prev > buf_stack)
-    {
-      p = *--buf_prev;
-    }
-    else
-    {
-      break;
-    }
-
-    if (p->avl.cache == -1)
-    {
-      /* rebalance left branch */
-      switch (p->avl.bal)
-      {
-        case -1:
-          p->avl.bal = 0;
-          break;
-        case  0:
-          p->avl.bal = 1;
-          modified = false;
-          break;
-
-        case +1:
-          p1 = p->avl.right;
-
-          if (p1->avl.bal >= 0) /* simple RR-turn */
-          {
-            p->avl.right = p1->avl.left;
-            p1->avl.left = p;
-
-            if (p1->avl.bal == 0)
-            {
-              p1->avl.bal = -1;
-              modified = false;
-            }
-            else
-            {
-              p->avl.bal = 0;
-              p1->avl.bal = 0;
-            }
-            p = p1;
-          }
-          else /* double RL-turn */
-          {
-            p2 = p1->avl.left;
-
-            p1->avl.left = p2->avl.right;
-            p2->avl.right = p1;
-            p->avl.right = p2->avl.left;
-            p2->avl.left = p;
-
-            if (p2->avl.bal == +1) p->avl.bal = -1; else p->avl.bal = 0;
-            if (p2->avl.bal == -1) p1->avl.bal = 1; else p1->avl.bal = 0;
-
-            p = p2;
-            p2->avl.bal = 0;
-          }
-          break;
-
-        default:
-          break;
-      }
-    }
-    else
-    {
-      /* rebalance right branch */
-      switch (p->avl.bal)
-      {
-        case +1:
-          p->avl.bal = 0;
-          break;
-
-        case  0:
-          p->avl.bal = -1;
-          modified = false;
-          break;
-
-        case -1:
-          p1 = p->avl.left;
-
-          if (p1->avl.bal <= 0) /* simple LL-turn */
-          {
-            p->avl.left = p1->avl.right;
-            p1->avl.right = p;
-            if (p1->avl.bal == 0)
-            {
-              p1->avl.bal = 1;
-              modified = false;
-            }
-            else
-            {
-              p->avl.bal = 0;
-              p1->avl.bal = 0;
-            }
-            p = p1;
-          }
-          else /* double LR-turn */
-          {
-            p2 = p1->avl.right;
-
-            p1->avl.right = p2->avl.left;
-            p2->avl.left = p1;
-            p->avl.left = p2->avl.right;
-            p2->avl.right = p;
-
-            if (p2->avl.bal == -1) p->avl.bal = 1; else p->avl.bal = 0;
-            if (p2->avl.bal == +1) p1->avl.bal = -1; else p1->avl.bal = 0;
-
-            p = p2;
-            p2->avl.bal = 0;
-          }
-          break;
-
-        default:
-          break;
-      }
-    }
-
-    if (buf_prev > buf_stack)
-    {
-      q = *(buf_prev - 1);
-
-      if (q->avl.cache == -1)
-      {
-        q->avl.left = p;
-      }
-      else
-      {
-        q->avl.right = p;
-      }
-    }
-    else
+    if (*link == bd)
     {
-      *root = p;
-      break;
+      *link = bd->hash_next;
+      bd->hash_next = NULL;
+      return 0;
     }
 
+    link = &(*link)->hash_next;
   }
 
-  return 0;
+  return -1;
 }
 
 static void
@@ -842,6 +505,48 @@ rtems_bdbuf_unlock_cache (void)
   rtems_bdbuf_unlock (&bdbuf_cache.lock);
 }
 
+/**
+ * Lock the shard.
+ */
+static void
+rtems_bdbuf_lock_shard (rtems_bdbuf_shard *shard)
+{
+  rtems_bdbuf_lock (&shard->lock);
+}
+
+/**
+ * Unlock the shard.
+ */
+static void
+rtems_bdbuf_unlock_shard (rtems_bdbuf_shard *shard)
+{
+  rtems_bdbuf_unlock (&shard->lock);
+}
+
+/**
+ * Lock all shards. The shards are locked in ascending index order.
+ */
+static void
+rtems_bdbuf_lock_all_shards (void)
+{
+  size_t s;
+
+  for (s = 0; s < bdbuf_cache.shard_count; ++s)
+    rtems_bdbuf_lock_shard (&bdbuf_cache.shards [s]);
+}
+
+/**
+ * Unlock all shards.
+ */
+static void
+rtems_bdbuf_unlock_all_shards (void)
+{
+  size_t s = bdbuf_cache.shard_count;
+
+  while (s > 0)
+    rtems_bdbuf_unlock_shard (&bdbuf_cache.shards [--s]);
+}
+
 /**
  * Lock the cache's sync. A single task can nest calls.
  */
@@ -884,28 +589,31 @@ rtems_bdbuf_group_release (rtems_bdbuf_buffer *bd)
  *
  * A counter is used to save the release call when no one is waiting.
  *
- * The function assumes the cache is locked on entry and it will be locked on
+ * The function assumes the shard is locked on entry and it will be locked on
  * exit.
  */
 static void
-rtems_bdbuf_anonymous_wait (rtems_bdbuf_waiters *waiters)
+rtems_bdbuf_anonymous_wait (rtems_bdbuf_shard   *shard,
+                            rtems_bdbuf_waiters *waiters)
 {
   /*
    * Indicate we are waiting.
    */
   ++waiters->count;
 
-  rtems_condition_variable_wait (&waiters->cond_var, &bdbuf_cache.lock);
+  rtems_condition_variable_wait (&waiters->cond_var, &shard->lock);
 
   --waiters->count;
 }
 
 static void
-rtems_bdbuf_wait (rtems_bdbuf_buffer *bd, rtems_bdbuf_waiters *waiters)
+rtems_bdbuf_wait (rtems_bdbuf_shard   *shard,
+                  rtems_bdbuf_buffer  *bd,
+                  rtems_bdbuf_waiters *waiters)
 {
   rtems_bdbuf_group_obtain (bd);
   ++bd->waiters;
-  rtems_bdbuf_anonymous_wait (waiters);
+  rtems_bdbuf_anonymous_wait (shard, waiters);
   --bd->waiters;
   rtems_bdbuf_group_release (bd);
 }
@@ -933,27 +641,43 @@ rtems_bdbuf_wake_swapper (void)
 }
 
 static bool
-rtems_bdbuf_has_buffer_waiters (void)
+rtems_bdbuf_has_buffer_waiters (const rtems_bdbuf_shard *shard)
+{
+  return shard->buffer_waiters.count;
+}
+
+static void
+rtems_bdbuf_remove_from_hash (rtems_bdbuf_shard  *shard,
+                              rtems_bdbuf_buffer *bd)
 {
-  return bdbuf_cache.buffer_waiters.count;
+  if (rtems_bdbuf_hash_remove (shard, bd) != 0)
+    rtems_bdbuf_fatal_with_state (bd->state, RTEMS_BDBUF_FATAL_HASH_RM);
 }
 
+/**
+ * Accounts blocks transfered by read-ahead requests which are discarded or
+ * recycled without an access.
+ */
 static void
-rtems_bdbuf_remove_from_tree (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_read_ahead_wasted (rtems_disk_device *dd, uint32_t count)
 {
-  if (rtems_bdbuf_avl_remove (&bdbuf_cache.tree, bd) != 0)
-    rtems_bdbuf_fatal_with_state (bd->state, RTEMS_BDBUF_FATAL_TREE_RM);
+  rtems_bdbuf_lock_cache ();
+  dd->stats.read_ahead_wasted += count;
+  rtems_bdbuf_unlock_cache ();
 }
 
 static void
-rtems_bdbuf_remove_from_tree_and_lru_list (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_remove_from_hash_and_lru_list (rtems_bdbuf_shard  *shard,
+                                           rtems_bdbuf_buffer *bd)
 {
   switch (bd->state)
   {
     case RTEMS_BDBUF_STATE_FREE:
       break;
     case RTEMS_BDBUF_STATE_CACHED:
-      rtems_bdbuf_remove_from_tree (bd);
+      if (bd->read_ahead)
+        rtems_bdbuf_read_ahead_wasted (bd->dd, 1);
+      rtems_bdbuf_remove_from_hash (shard, bd);
       break;
     default:
       rtems_bdbuf_fatal_with_state (bd->state, RTEMS_BDBUF_FATAL_STATE_10);
@@ -963,10 +687,11 @@ rtems_bdbuf_remove_from_tree_and_lru_list (rtems_bdbuf_buffer *bd)
 }
 
 static void
-rtems_bdbuf_make_free_and_add_to_lru_list (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_make_free_and_add_to_lru_list (rtems_bdbuf_shard  *shard,
+                                           rtems_bdbuf_buffer *bd)
 {
   rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_FREE);
-  rtems_chain_prepend_unprotected (&bdbuf_cache.lru, &bd->link);
+  rtems_chain_prepend_unprotected (&shard->lru, &bd->link);
 }
 
 static void
@@ -976,30 +701,44 @@ rtems_bdbuf_make_empty (rtems_bdbuf_buffer *bd)
 }
 
 static void
-rtems_bdbuf_make_cached_and_add_to_lru_list (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_make_cached_and_add_to_lru_list (rtems_bdbuf_shard  *shard,
+                                             rtems_bdbuf_buffer *bd)
 {
   rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_CACHED);
-  rtems_chain_append_unprotected (&bdbuf_cache.lru, &bd->link);
+  rtems_chain_append_unprotected (&shard->lru, &bd->link);
 }
 
 static void
-rtems_bdbuf_discard_buffer (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_discard_buffer (rtems_bdbuf_shard *shard, rtems_bdbuf_buffer *bd)
 {
   rtems_bdbuf_make_empty (bd);
 
   if (bd->waiters == 0)
   {
-    rtems_bdbuf_remove_from_tree (bd);
-    rtems_bdbuf_make_free_and_add_to_lru_list (bd);
+    rtems_bdbuf_remove_from_hash (shard, bd);
+    rtems_bdbuf_make_free_and_add_to_lru_list (shard, bd);
   }
 }
 
+static bool
+rtems_bdbuf_is_sync_active_for_device (const rtems_disk_device *dd)
+{
+  bool sync_active;
+
+  rtems_bdbuf_lock_cache ();
+  sync_active = bdbuf_cache.sync_active && bdbuf_cache.sync_device == dd;
+  rtems_bdbuf_unlock_cache ();
+
+  return sync_active;
+}
+
 static void
-rtems_bdbuf_add_to_modified_list_after_access (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_add_to_modified_list_after_access (rtems_bdbuf_shard  *shard,
+                                               rtems_bdbuf_buffer *bd)
 {
-  if (bdbuf_cache.sync_active && bdbuf_cache.sync_device == bd->dd)
+  if (rtems_bdbuf_is_sync_active_for_device (bd->dd))
   {
-    rtems_bdbuf_unlock_cache ();
+    rtems_bdbuf_unlock_shard (shard);
 
     /*
      * Wait for the sync lock.
@@ -1007,7 +746,7 @@ rtems_bdbuf_add_to_modified_list_after_access (rtems_bdbuf_buffer *bd)
     rtems_bdbuf_lock_sync ();
 
     rtems_bdbuf_unlock_sync ();
-    rtems_bdbuf_lock_cache ();
+    rtems_bdbuf_lock_shard (shard);
   }
 
   /*
@@ -1026,24 +765,25 @@ rtems_bdbuf_add_to_modified_list_after_access (rtems_bdbuf_buffer *bd)
     bd->hold_timer = bdbuf_config.swap_block_hold;
 
   rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_MODIFIED);
-  rtems_chain_append_unprotected (&bdbuf_cache.modified, &bd->link);
+  rtems_chain_append_unprotected (&shard->modified, &bd->link);
 
   if (bd->waiters)
-    rtems_bdbuf_wake (&bdbuf_cache.access_waiters);
-  else if (rtems_bdbuf_has_buffer_waiters ())
+    rtems_bdbuf_wake (&shard->access_waiters);
+  else if (rtems_bdbuf_has_buffer_waiters (shard))
     rtems_bdbuf_wake_swapper ();
 }
 
 static void
-rtems_bdbuf_add_to_lru_list_after_access (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_add_to_lru_list_after_access (rtems_bdbuf_shard  *shard,
+                                          rtems_bdbuf_buffer *bd)
 {
   rtems_bdbuf_group_release (bd);
-  rtems_bdbuf_make_cached_and_add_to_lru_list (bd);
+  rtems_bdbuf_make_cached_and_add_to_lru_list (shard, bd);
 
   if (bd->waiters)
-    rtems_bdbuf_wake (&bdbuf_cache.access_waiters);
+    rtems_bdbuf_wake (&shard->access_waiters);
   else
-    rtems_bdbuf_wake (&bdbuf_cache.buffer_waiters);
+    rtems_bdbuf_wake (&shard->buffer_waiters);
 }
 
 /**
@@ -1071,28 +811,32 @@ rtems_bdbuf_bds_per_group (size_t size)
 }
 
 static void
-rtems_bdbuf_discard_buffer_after_access (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_discard_buffer_after_access (rtems_bdbuf_shard  *shard,
+                                         rtems_bdbuf_buffer *bd)
 {
   rtems_bdbuf_group_release (bd);
-  rtems_bdbuf_discard_buffer (bd);
+  rtems_bdbuf_discard_buffer (shard, bd);
 
   if (bd->waiters)
-    rtems_bdbuf_wake (&bdbuf_cache.access_waiters);
+    rtems_bdbuf_wake (&shard->access_waiters);
   else
-    rtems_bdbuf_wake (&bdbuf_cache.buffer_waiters);
+    rtems_bdbuf_wake (&shard->buffer_waiters);
 }
 
 /**
  * Reallocate a group. The BDs currently allocated in the group are removed
- * from the ALV tree and any lists then the new BD's are prepended to the ready
- * list of the cache.
+ * from the hash table and any lists then the new BD's are prepended to the
+ * ready list of the shard.
  *
+ * @param shard The shard of the group.
  * @param group The group to reallocate.
  * @param new_bds_per_group The new count of BDs per group.
  * @return A buffer of this group.
  */
 static rtems_bdbuf_buffer *
-rtems_bdbuf_group_realloc (rtems_bdbuf_group* group, size_t new_bds_per_group)
+rtems_bdbuf_group_realloc (rtems_bdbuf_shard *shard,
+                           rtems_bdbuf_group *group,
+                           size_t             new_bds_per_group)
 {
   rtems_bdbuf_buffer* bd;
   size_t              b;
@@ -1108,7 +852,7 @@ rtems_bdbuf_group_realloc (rtems_bdbuf_group* group, size_t new_bds_per_group)
   for (b = 0, bd = group->bdbuf;
        b < group->bds_per_group;
        b++, bd += bufs_per_bd)
-    rtems_bdbuf_remove_from_tree_and_lru_list (bd);
+    rtems_bdbuf_remove_from_hash_and_lru_list (shard, bd);
 
   group->bds_per_group = new_bds_per_group;
   bufs_per_bd = bdbuf_cache.max_bds_per_group / new_bds_per_group;
@@ -1116,38 +860,40 @@ rtems_bdbuf_group_realloc (rtems_bdbuf_group* group, size_t new_bds_per_group)
   for (b = 1, bd = group->bdbuf + bufs_per_bd;
        b < group->bds_per_group;
        b++, bd += bufs_per_bd)
-    rtems_bdbuf_make_free_and_add_to_lru_list (bd);
+    rtems_bdbuf_make_free_and_add_to_lru_list (shard, bd);
 
   if (b > 1)
-    rtems_bdbuf_wake (&bdbuf_cache.buffer_waiters);
+    rtems_bdbuf_wake (&shard->buffer_waiters);
 
   return group->bdbuf;
 }
 
 static void
-rtems_bdbuf_setup_empty_buffer (rtems_bdbuf_buffer *bd,
+rtems_bdbuf_setup_empty_buffer (rtems_bdbuf_shard  *shard,
+                                rtems_bdbuf_buffer *bd,
                                 rtems_disk_device  *dd,
                                 rtems_blkdev_bnum   block)
 {
   bd->dd        = dd ;
   bd->block     = block;
-  bd->avl.left  = NULL;
-  bd->avl.right = NULL;
+  bd->hash_next = NULL;
   bd->waiters   = 0;
+  bd->read_ahead = false;
 
-  if (rtems_bdbuf_avl_insert (&bdbuf_cache.tree, bd) != 0)
+  if (rtems_bdbuf_hash_insert (shard, bd) != 0)
     rtems_bdbuf_fatal (RTEMS_BDBUF_FATAL_RECYCLE);
 
   rtems_bdbuf_make_empty (bd);
 }
 
 static rtems_bdbuf_buffer *
-rtems_bdbuf_get_buffer_from_lru_list (rtems_disk_device *dd,
+rtems_bdbuf_get_buffer_from_lru_list (rtems_bdbuf_shard *shard,
+                                      rtems_disk_device *dd,
                                       rtems_blkdev_bnum  block)
 {
-  rtems_chain_node *node = rtems_chain_first (&bdbuf_cache.lru);
+  rtems_chain_node *node = rtems_chain_first (&shard->lru);
 
-  while (!rtems_chain_is_tail (&bdbuf_cache.lru, node))
+  while (!rtems_chain_is_tail (&shard->lru, node))
   {
     rtems_bdbuf_buffer *bd = (rtems_bdbuf_buffer *) node;
     rtems_bdbuf_buffer *empty_bd = NULL;
@@ -1165,17 +911,19 @@ rtems_bdbuf_get_buffer_from_lru_list (rtems_disk_device *dd,
     {
       if (bd->group->bds_per_group == dd->bds_per_group)
       {
-        rtems_bdbuf_remove_from_tree_and_lru_list (bd);
+        rtems_bdbuf_remove_from_hash_and_lru_list (shard, bd);
 
         empty_bd = bd;
       }
       else if (bd->group->users == 0)
-        empty_bd = rtems_bdbuf_group_realloc (bd->group, dd->bds_per_group);
+        empty_bd = rtems_bdbuf_group_realloc (shard,
+                                              bd->group,
+                                              dd->bds_per_group);
     }
 
     if (empty_bd != NULL)
     {
-      rtems_bdbuf_setup_empty_buffer (empty_bd, dd, block);
+      rtems_bdbuf_setup_empty_buffer (shard, empty_bd, dd, block);
 
       return empty_bd;
     }
@@ -1296,6 +1044,83 @@ rtems_bdbuf_read_request_size (uint32_t transfer_count)
     + sizeof (rtems_blkdev_sg_buffer) * transfer_count;
 }
 
+static size_t
+rtems_bdbuf_hash_size (size_t bd_count)
+{
+  size_t hash_size = 1;
+
+  while (hash_size < bd_count)
+    hash_size <<= 1;
+
+  return hash_size;
+}
+
+static rtems_status_code
+rtems_bdbuf_shards_create (void)
+{
+  size_t shard_count = bdbuf_config.shard_count;
+  size_t s;
+
+  if (shard_count == 0)
+    shard_count = 1;
+
+  if (shard_count > bdbuf_cache.group_count)
+    shard_count = bdbuf_cache.group_count;
+
+  bdbuf_cache.shards = calloc (shard_count, sizeof (rtems_bdbuf_shard));
+  if (bdbuf_cache.shards == NULL)
+    return RTEMS_NO_MEMORY;
+
+  bdbuf_cache.shard_count = shard_count;
+
+  for (s = 0; s < shard_count; ++s)
+  {
+    rtems_bdbuf_shard *shard = &bdbuf_cache.shards [s];
+    size_t             group_begin = (s * bdbuf_cache.group_count
+                                      + shard_count - 1) / shard_count;
+    size_t             group_end = ((s + 1) * bdbuf_cache.group_count
+                                    + shard_count - 1) / shard_count;
+    size_t             hash_size = rtems_bdbuf_hash_size (
+      (group_end - group_begin) * bdbuf_cache.max_bds_per_group);
+
+    shard->hash = calloc (hash_size, sizeof (shard->hash [0]));
+    if (shard->hash == NULL)
+      return RTEMS_NO_MEMORY;
+
+    shard->hash_mask = hash_size - 1;
+
+    rtems_chain_initialize_empty (&shard->lru);
+    rtems_chain_initialize_empty (&shard->modified);
+    rtems_chain_initialize_empty (&shard->sync);
+
+    rtems_mutex_init (&shard->lock, "bdbuf shard");
+    rtems_condition_variable_init (&shard->access_waiters.cond_var,
+                                   "bdbuf access");
+    rtems_condition_variable_init (&shard->transfer_waiters.cond_var,
+                                   "bdbuf transfer");
+    rtems_condition_variable_init (&shard->buffer_waiters.cond_var,
+                                   "bdbuf buffer");
+  }
+
+  return RTEMS_SUCCESSFUL;
+}
+
+static void
+rtems_bdbuf_shards_destroy (void)
+{
+  size_t s;
+
+  if (bdbuf_cache.shards == NULL)
+    return;
+
+  for (s = 0; s < bdbuf_cache.shard_count; ++s)
+    free (bdbuf_cache.shards [s].hash);
+
+  free (bdbuf_cache.shards);
+  bdbuf_cache.shards = NULL;
+  bdbuf_cache.shard_count = 0;
+}
+
 static rtems_status_code
 rtems_bdbuf_do_init (void)
 {
@@ -1325,19 +1150,12 @@ rtems_bdbuf_do_init (void)
   bdbuf_cache.sync_device = BDBUF_INVALID_DEV;
 
   rtems_chain_initialize_empty (&bdbuf_cache.swapout_free_workers);
-  rtems_chain_initialize_empty (&bdbuf_cache.lru);
-  rtems_chain_initialize_empty (&bdbuf_cache.modified);
-  rtems_chain_initialize_empty (&bdbuf_cache.sync);
   rtems_chain_initialize_empty (&bdbuf_cache.read_ahead_chain);
 
   rtems_mutex_set_name (&bdbuf_cache.lock, "bdbuf lock");
   rtems_mutex_set_name (&bdbuf_cache.sync_lock, "bdbuf sync lock");
-  rtems_condition_variable_set_name (&bdbuf_cache.access_waiters.cond_var,
-                                     "bdbuf access");
-  rtems_condition_variable_set_name (&bdbuf_cache.transfer_waiters.cond_var,
-                                     "bdbuf transfer");
-  rtems_condition_variable_set_name (&bdbuf_cache.buffer_waiters.cond_var,
-                                     "bdbuf buffer");
+  rtems_condition_variable_set_name (&bdbuf_cache.read_ahead_waiters.cond_var,
+                                     "bdbuf read-ahead");
 
   rtems_bdbuf_lock_cache ();
 
@@ -1351,6 +1169,13 @@ rtems_bdbuf_do_init (void)
   bdbuf_cache.group_count =
     bdbuf_cache.buffer_min_count / bdbuf_cache.max_bds_per_group;
 
+  if (bdbuf_cache.group_count == 0)
+    goto error;
+
+  sc = rtems_bdbuf_shards_create ();
+  if (sc != RTEMS_SUCCESSFUL)
+    goto error;
+
   /*
    * Allocate the memory for the buffer descriptors.
    */
@@ -1390,7 +1215,10 @@ rtems_bdbuf_do_init (void)
     bd->group  = group;
     bd->buffer = buffer;
 
-    rtems_chain_append_unprotected (&bdbuf_cache.lru, &bd->link);
+    group->shard_index =
+      rtems_bdbuf_shard_index_of_group ((size_t) (group - bdbuf_cache.groups));
+    rtems_chain_append_unprotected (&rtems_bdbuf_shard_of_bd (bd)->lru,
+                                    &bd->link);
 
     if ((b % bdbuf_cache.max_bds_per_group) ==
         (bdbuf_cache.max_bds_per_group - 1))
@@ -1488,6 +1316,7 @@ error:
     }
   }
 
+  rtems_bdbuf_shards_destroy ();
   free (bdbuf_cache.buffers);
   free (bdbuf_cache.groups);
   free (bdbuf_cache.bds);
@@ -1543,7 +1372,7 @@ rtems_bdbuf_wait_for_transient_event (void)
 }
 
 static void
-rtems_bdbuf_wait_for_access (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_wait_for_access (rtems_bdbuf_shard *shard, rtems_bdbuf_buffer *bd)
 {
   while (true)
   {
@@ -1561,12 +1390,12 @@ rtems_bdbuf_wait_for_access (rtems_bdbuf_buffer *bd)
       case RTEMS_BDBUF_STATE_ACCESS_EMPTY:
       case RTEMS_BDBUF_STATE_ACCESS_MODIFIED:
       case RTEMS_BDBUF_STATE_ACCESS_PURGED:
-        rtems_bdbuf_wait (bd, &bdbuf_cache.access_waiters);
+        rtems_bdbuf_wait (shard, bd, &shard->access_waiters);
         break;
       case RTEMS_BDBUF_STATE_SYNC:
       case RTEMS_BDBUF_STATE_TRANSFER:
       case RTEMS_BDBUF_STATE_TRANSFER_PURGED:
-        rtems_bdbuf_wait (bd, &bdbuf_cache.transfer_waiters);
+        rtems_bdbuf_wait (shard, bd, &shard->transfer_waiters);
         break;
       default:
         rtems_bdbuf_fatal_with_state (bd->state, RTEMS_BDBUF_FATAL_STATE_7);
@@ -1575,11 +1404,12 @@ rtems_bdbuf_wait_for_access (rtems_bdbuf_buffer *bd)
 }
 
 static void
-rtems_bdbuf_request_sync_for_modified_buffer (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_request_sync_for_modified_buffer (rtems_bdbuf_shard  *shard,
+                                              rtems_bdbuf_buffer *bd)
 {
   rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_SYNC);
   rtems_chain_extract_unprotected (&bd->link);
-  rtems_chain_append_unprotected (&bdbuf_cache.sync, &bd->link);
+  rtems_chain_append_unprotected (&shard->sync, &bd->link);
   rtems_bdbuf_wake_swapper ();
 }
 
@@ -1590,7 +1420,7 @@ rtems_bdbuf_request_sync_for_modified_buffer (rtems_bdbuf_buffer *bd)
  * @retval @c false Buffer is invalid and has to searched again.
  */
 static bool
-rtems_bdbuf_wait_for_recycle (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_wait_for_recycle (rtems_bdbuf_shard *shard, rtems_bdbuf_buffer *bd)
 {
   while (true)
   {
@@ -1599,7 +1429,7 @@ rtems_bdbuf_wait_for_recycle (rtems_bdbuf_buffer *bd)
       case RTEMS_BDBUF_STATE_FREE:
         return true;
       case RTEMS_BDBUF_STATE_MODIFIED:
-        rtems_bdbuf_request_sync_for_modified_buffer (bd);
+        rtems_bdbuf_request_sync_for_modified_buffer (shard, bd);
         break;
       case RTEMS_BDBUF_STATE_CACHED:
       case RTEMS_BDBUF_STATE_EMPTY:
@@ -1613,19 +1443,19 @@ rtems_bdbuf_wait_for_recycle (rtems_bdbuf_buffer *bd)
            * pong with another recycle waiter.  The state of the buffer is
            * arbitrary afterwards.
            */
-          rtems_bdbuf_anonymous_wait (&bdbuf_cache.buffer_waiters);
+          rtems_bdbuf_anonymous_wait (shard, &shard->buffer_waiters);
           return false;
         }
       case RTEMS_BDBUF_STATE_ACCESS_CACHED:
       case RTEMS_BDBUF_STATE_ACCESS_EMPTY:
       case RTEMS_BDBUF_STATE_ACCESS_MODIFIED:
       case RTEMS_BDBUF_STATE_ACCESS_PURGED:
-        rtems_bdbuf_wait (bd, &bdbuf_cache.access_waiters);
+        rtems_bdbuf_wait (shard, bd, &shard->access_waiters);
         break;
       case RTEMS_BDBUF_STATE_SYNC:
       case RTEMS_BDBUF_STATE_TRANSFER:
       case RTEMS_BDBUF_STATE_TRANSFER_PURGED:
-        rtems_bdbuf_wait (bd, &bdbuf_cache.transfer_waiters);
+        rtems_bdbuf_wait (shard, bd, &shard->transfer_waiters);
         break;
       default:
         rtems_bdbuf_fatal_with_state (bd->state, RTEMS_BDBUF_FATAL_STATE_8);
@@ -1634,7 +1464,8 @@ rtems_bdbuf_wait_for_recycle (rtems_bdbuf_buffer *bd)
 }
 
 static void
-rtems_bdbuf_wait_for_sync_done (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_wait_for_sync_done (rtems_bdbuf_shard  *shard,
+                                rtems_bdbuf_buffer *bd)
 {
   while (true)
   {
@@ -1651,7 +1482,7 @@ rtems_bdbuf_wait_for_sync_done (rtems_bdbuf_buffer *bd)
       case RTEMS_BDBUF_STATE_SYNC:
       case RTEMS_BDBUF_STATE_TRANSFER:
       case RTEMS_BDBUF_STATE_TRANSFER_PURGED:
-        rtems_bdbuf_wait (bd, &bdbuf_cache.transfer_waiters);
+        rtems_bdbuf_wait (shard, bd, &shard->transfer_waiters);
         break;
       default:
         rtems_bdbuf_fatal_with_state (bd->state, RTEMS_BDBUF_FATAL_STATE_9);
@@ -1660,26 +1491,27 @@ rtems_bdbuf_wait_for_sync_done (rtems_bdbuf_buffer *bd)
 }
 
 static void
-rtems_bdbuf_wait_for_buffer (void)
+rtems_bdbuf_wait_for_buffer (rtems_bdbuf_shard *shard)
 {
-  if (!rtems_chain_is_empty (&bdbuf_cache.modified))
+  if (!rtems_chain_is_empty (&shard->modified))
     rtems_bdbuf_wake_swapper ();
 
-  rtems_bdbuf_anonymous_wait (&bdbuf_cache.buffer_waiters);
+  rtems_bdbuf_anonymous_wait (shard, &shard->buffer_waiters);
 }
 
 static void
-rtems_bdbuf_sync_after_access (rtems_bdbuf_buffer *bd)
+rtems_bdbuf_sync_after_access (rtems_bdbuf_shard  *shard,
+                               rtems_bdbuf_buffer *bd)
 {
   rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_SYNC);
 
-  rtems_chain_append_unprotected (&bdbuf_cache.sync, &bd->link);
+  rtems_chain_append_unprotected (&shard->sync, &bd->link);
 
   if (bd->waiters)
-    rtems_bdbuf_wake (&bdbuf_cache.access_waiters);
+    rtems_bdbuf_wake (&shard->access_waiters);
 
   rtems_bdbuf_wake_swapper ();
-  rtems_bdbuf_wait_for_sync_done (bd);
+  rtems_bdbuf_wait_for_sync_done (shard, bd);
 
   /*
    * We may have created a cached or empty buffer which may be recycled.
@@ -1690,24 +1522,147 @@ rtems_bdbuf_sync_after_access (rtems_bdbuf_buffer *bd)
   {
     if (bd->state == RTEMS_BDBUF_STATE_EMPTY)
     {
-      rtems_bdbuf_remove_from_tree (bd);
-      rtems_bdbuf_make_free_and_add_to_lru_list (bd);
+      rtems_bdbuf_remove_from_hash (shard, bd);
+      rtems_bdbuf_make_free_and_add_to_lru_list (shard, bd);
     }
-    rtems_bdbuf_wake (&bdbuf_cache.buffer_waiters);
+    rtems_bdbuf_wake (&shard->buffer_waiters);
+  }
+}
+
+/**
+ * Returns true if the group has no users and all BDs of the group are free or
+ * cached without waiters, otherwise false.
+ */
+static bool
+rtems_bdbuf_group_is_idle (const rtems_bdbuf_group *group)
+{
+  const rtems_bdbuf_buffer *bd;
+  size_t                    b;
+  size_t                    bufs_per_bd;
+
+  if (group->users != 0)
+    return false;
+
+  bufs_per_bd = bdbuf_cache.max_bds_per_group / group->bds_per_group;
+
+  for (b = 0, bd = group->bdbuf;
+       b < group->bds_per_group;
+       b++, bd += bufs_per_bd)
+  {
+    if (bd->waiters != 0
+        || (bd->state != RTEMS_BDBUF_STATE_FREE
+          && bd->state != RTEMS_BDBUF_STATE_CACHED))
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Takes the least recently used idle group of the shard. The BDs of the group
+ * are removed from the hash table and the LRU list of the shard.
+ *
+ * @param shard The locked shard.
+ * @retval NULL The shard has no idle group.
+ * @return The group. It is owned by no shard.
+ */
+static rtems_bdbuf_group *
+rtems_bdbuf_take_idle_group (rtems_bdbuf_shard *shard)
+{
+  rtems_chain_node *node = rtems_chain_first (&shard->lru);
+
+  while (!rtems_chain_is_tail (&shard->lru, node))
+  {
+    rtems_bdbuf_group *group = ((rtems_bdbuf_buffer *) node)->group;
+
+    if (rtems_bdbuf_group_is_idle (group))
+    {
+      rtems_bdbuf_buffer *bd;
+      size_t              b;
+      size_t              bufs_per_bd;
+
+      bufs_per_bd = bdbuf_cache.max_bds_per_group / group->bds_per_group;
+
+      for (b = 0, bd = group->bdbuf;
+           b < group->bds_per_group;
+           b++, bd += bufs_per_bd)
+        rtems_bdbuf_remove_from_hash_and_lru_list (shard, bd);
+
+      return group;
+    }
+
+    node = rtems_chain_next (node);
+  }
+
+  return NULL;
+}
+
+/**
+ * Moves an idle group of another shard to the shard. The shard lock is
+ * released while the other shards are searched, since only one shard lock
+ * may be owned at a time. The caller must search the shard again afterwards.
+ *
+ * @param shard The locked shard. It is locked on return.
+ */
+static void
+rtems_bdbuf_borrow_group (rtems_bdbuf_shard *shard)
+{
+  size_t             shard_index = (size_t) (shard - bdbuf_cache.shards);
+  rtems_bdbuf_group *group = NULL;
+  size_t             s;
+
+  if (bdbuf_cache.shard_count == 1)
+    return;
+
+  rtems_bdbuf_unlock_shard (shard);
+
+  for (s = 1; s < bdbuf_cache.shard_count && group == NULL; ++s)
+  {
+    rtems_bdbuf_shard *other =
+      &bdbuf_cache.shards [(shard_index + s) % bdbuf_cache.shard_count];
+
+    rtems_bdbuf_lock_shard (other);
+    group = rtems_bdbuf_take_idle_group (other);
+    if (group != NULL)
+      group->shard_index = shard_index;
+    rtems_bdbuf_unlock_shard (other);
+  }
+
+  rtems_bdbuf_lock_shard (shard);
+
+  if (group != NULL)
+  {
+    rtems_bdbuf_buffer *bd;
+    size_t              b;
+    size_t              bufs_per_bd;
+
+    if (rtems_bdbuf_tracer)
+      printf ("bdbuf:borrow: %tu -> %zu\n",
+              group - bdbuf_cache.groups, shard_index);
+
+    bufs_per_bd = bdbuf_cache.max_bds_per_group / group->bds_per_group;
+
+    for (b = 0, bd = group->bdbuf;
+         b < group->bds_per_group;
+         b++, bd += bufs_per_bd)
+      rtems_bdbuf_make_free_and_add_to_lru_list (shard, bd);
+
+    rtems_bdbuf_wake (&shard->buffer_waiters);
   }
 }
 
 static rtems_bdbuf_buffer *
-rtems_bdbuf_get_buffer_for_read_ahead (rtems_disk_device *dd,
+rtems_bdbuf_get_buffer_for_read_ahead (rtems_bdbuf_shard *shard,
+                                       rtems_disk_device *dd,
                                        rtems_blkdev_bnum  block)
 {
   rtems_bdbuf_buffer *bd = NULL;
 
-  bd = rtems_bdbuf_avl_search (&bdbuf_cache.tree, dd, block);
+  bd = rtems_bdbuf_hash_search (shard, dd, block);
 
   if (bd == NULL)
   {
-    bd = rtems_bdbuf_get_buffer_from_lru_list (dd, block);
+    bd = rtems_bdbuf_get_buffer_from_lru_list (shard, dd, block);
 
     if (bd != NULL)
       rtems_bdbuf_group_obtain (bd);
@@ -1723,39 +1678,57 @@ rtems_bdbuf_get_buffer_for_read_ahead (rtems_disk_device *dd,
 }
 
 static rtems_bdbuf_buffer *
-rtems_bdbuf_get_buffer_for_access (rtems_disk_device *dd,
+rtems_bdbuf_get_buffer_for_access (rtems_bdbuf_shard *shard,
+                                   rtems_disk_device *dd,
                                    rtems_blkdev_bnum  block)
 {
   rtems_bdbuf_buffer *bd = NULL;
+  bool                borrowed = false;
 
   do
   {
-    bd = rtems_bdbuf_avl_search (&bdbuf_cache.tree, dd, block);
+    bd = rtems_bdbuf_hash_search (shard, dd, block);
 
     if (bd != NULL)
     {
       if (bd->group->bds_per_group != dd->bds_per_group)
       {
-        if (rtems_bdbuf_wait_for_recycle (bd))
+        if (rtems_bdbuf_wait_for_recycle (shard, bd))
         {
-          rtems_bdbuf_remove_from_tree_and_lru_list (bd);
-          rtems_bdbuf_make_free_and_add_to_lru_list (bd);
-          rtems_bdbuf_wake (&bdbuf_cache.buffer_waiters);
+          rtems_bdbuf_remove_from_hash_and_lru_list (shard, bd);
+          rtems_bdbuf_make_free_and_add_to_lru_list (shard, bd);
+          rtems_bdbuf_wake (&shard->buffer_waiters);
         }
         bd = NULL;
       }
     }
     else
     {
-      bd = rtems_bdbuf_get_buffer_from_lru_list (dd, block);
+      bd = rtems_bdbuf_get_buffer_from_lru_list (shard, dd, block);
 
       if (bd == NULL)
-        rtems_bdbuf_wait_for_buffer ();
+      {
+        /*
+         * Try to borrow a group from another shard before we wait.  The shard
+         * was unlocked in between, so search it again.  We wait only if this
+         * search fails, so no wake up can be lost.
+         */
+        if (!borrowed)
+        {
+          rtems_bdbuf_borrow_group (shard);
+          borrowed = true;
+        }
+        else
+        {
+          rtems_bdbuf_wait_for_buffer (shard);
+          borrowed = false;
+        }
+      }
     }
   }
   while (bd == NULL);
 
-  rtems_bdbuf_wait_for_access (bd);
+  rtems_bdbuf_wait_for_access (shard, bd);
   rtems_bdbuf_group_obtain (bd);
 
   return bd;
@@ -1785,6 +1758,57 @@ rtems_bdbuf_get_media_block (const rtems_disk_device *dd,
   return sc;
 }
 
+/**
+ * Computes the media block number of the block and locks the shard of the
+ * media block. The block size of the device changes only while all shards are
+ * locked, so the media block number is checked again once the shard is locked.
+ *
+ * @param dd The disk device.
+ * @param block The block number relative to the disk device.
+ * @param media_block_ptr The media block number.
+ * @param shard_ptr The locked shard of the media block.
+ * @retval RTEMS_SUCCESSFUL The shard is locked.
+ * @retval RTEMS_INVALID_ID The block number is invalid. No shard is locked.
+ */
+static rtems_status_code
+rtems_bdbuf_lock_shard_of_block (const rtems_disk_device *dd,
+                                 rtems_blkdev_bnum        block,
+                                 rtems_blkdev_bnum       *media_block_ptr,
+                                 rtems_bdbuf_shard      **shard_ptr)
+{
+  while (true)
+  {
+    uint32_t           block_size = dd->block_size;
+    rtems_blkdev_bnum  media_block;
+    rtems_blkdev_bnum  locked_media_block;
+    rtems_bdbuf_shard *shard;
+    rtems_status_code  sc;
+
+    sc = rtems_bdbuf_get_media_block (dd, block, &media_block);
+    if (sc != RTEMS_SUCCESSFUL)
+      return sc;
+
+    shard = rtems_bdbuf_shard_of_block (dd, media_block);
+    rtems_bdbuf_lock_shard (shard);
+
+    sc = rtems_bdbuf_get_media_block (dd, block, &locked_media_block);
+    if (sc != RTEMS_SUCCESSFUL)
+    {
+      rtems_bdbuf_unlock_shard (shard);
+      return sc;
+    }
+
+    if (dd->block_size == block_size && locked_media_block == media_block)
+    {
+      *media_block_ptr = media_block;
+      *shard_ptr = shard;
+      return RTEMS_SUCCESSFUL;
+    }
+
+    rtems_bdbuf_unlock_shard (shard);
+  }
+}
+
 rtems_status_code
 rtems_bdbuf_get (rtems_disk_device   *dd,
                  rtems_blkdev_bnum    block,
@@ -1792,11 +1816,10 @@ rtems_bdbuf_get (rtems_disk_device   *dd,
 {
   rtems_status_code   sc = RTEMS_SUCCESSFUL;
   rtems_bdbuf_buffer *bd = NULL;
+  rtems_bdbuf_shard  *shard = NULL;
   rtems_blkdev_bnum   media_block;
 
-  rtems_bdbuf_lock_cache ();
-
-  sc = rtems_bdbuf_get_media_block (dd, block, &media_block);
+  sc = rtems_bdbuf_lock_shard_of_block (dd, block, &media_block, &shard);
   if (sc == RTEMS_SUCCESSFUL)
   {
     /*
@@ -1806,7 +1829,15 @@ rtems_bdbuf_get (rtems_disk_device   *dd,
       printf ("bdbuf:get: %" PRIu32 " (%" PRIu32 ") (dev = %08x)\n",
               media_block, block, (unsigned) dd->dev);
 
-    bd = rtems_bdbuf_get_buffer_for_access (dd, media_block);
+    bd = rtems_bdbuf_get_buffer_for_access (shard, dd, media_block);
+
+    if (bd->read_ahead)
+    {
+      bd->read_ahead = false;
+      rtems_bdbuf_lock_cache ();
+      ++dd->stats.read_ahead_hits;
+      rtems_bdbuf_unlock_cache ();
+    }
 
     switch (bd->state)
     {
@@ -1836,9 +1867,9 @@ rtems_bdbuf_get (rtems_disk_device   *dd,
       rtems_bdbuf_show_users ("get", bd);
       rtems_bdbuf_show_usage ();
     }
-  }
 
-  rtems_bdbuf_unlock_cache ();
+    rtems_bdbuf_unlock_shard (shard);
+  }
 
   *bd_ptr = bd;
 
@@ -1862,19 +1893,37 @@ rtems_bdbuf_transfer_done (rtems_blkdev_request* req, rtems_status_code status)
   rtems_event_transient_send (req->io_task);
 }
 
+static void
+rtems_bdbuf_wake_after_transfer (rtems_bdbuf_shard *shard,
+                                 bool               wake_transfer_waiters,
+                                 bool               wake_buffer_waiters)
+{
+  if (wake_transfer_waiters)
+    rtems_bdbuf_wake (&shard->transfer_waiters);
+
+  if (wake_buffer_waiters)
+    rtems_bdbuf_wake (&shard->buffer_waiters);
+}
+
+/**
+ * Executes the transfer request. The caller must not own a shard lock.
+ *
+ * @param dd The disk device.
+ * @param req The transfer request.
+ * @param locked_shard If not NULL, then this shard is locked on return. It
+ * must be the shard of the first buffer of the request.
+ */
 static rtems_status_code
 rtems_bdbuf_execute_transfer_request (rtems_disk_device    *dd,
                                       rtems_blkdev_request *req,
-                                      bool                  cache_locked)
+                                      rtems_bdbuf_shard    *locked_shard)
 {
   rtems_status_code sc = RTEMS_SUCCESSFUL;
+  rtems_bdbuf_shard *shard = NULL;
   uint32_t transfer_index = 0;
   bool wake_transfer_waiters = false;
   bool wake_buffer_waiters = false;
 
-  if (cache_locked)
-    rtems_bdbuf_unlock_cache ();
-
   /* The return value will be ignored for transfer requests */
   dd->ioctl (dd->phys_dev, RTEMS_BLKIO_REQUEST, req);
 
@@ -1899,10 +1948,35 @@ rtems_bdbuf_execute_transfer_request (rtems_disk_device    *dd,
       ++dd->stats.write_errors;
   }
 
-  for (transfer_index = 0; transfer_index < req->bufnum; ++transfer_index)
+  rtems_bdbuf_unlock_cache ();
+
+  /*
+   * The first buffer is processed last.  So, the shard of the first buffer is
+   * locked on return and the first buffer cannot be recycled in between.
+   */
+  for (transfer_index = 1; transfer_index <= req->bufnum; ++transfer_index)
   {
-    rtems_bdbuf_buffer *bd = req->bufs [transfer_index].user;
-    bool waiters = bd->waiters;
+    rtems_bdbuf_buffer *bd = req->bufs [transfer_index % req->bufnum].user;
+    rtems_bdbuf_shard *bd_shard = rtems_bdbuf_shard_of_bd (bd);
+    bool waiters;
+
+    if (bd_shard != shard)
+    {
+      if (shard != NULL)
+      {
+        rtems_bdbuf_wake_after_transfer (shard,
+                                         wake_transfer_waiters,
+                                         wake_buffer_waiters);
+        rtems_bdbuf_unlock_shard (shard);
+        wake_transfer_waiters = false;
+        wake_buffer_waiters = false;
+      }
+
+      shard = bd_shard;
+      rtems_bdbuf_lock_shard (shard);
+    }
+
+    waiters = bd->waiters;
 
     if (waiters)
       wake_transfer_waiters = true;
@@ -1912,22 +1986,34 @@ rtems_bdbuf_execute_transfer_request (rtems_disk_device    *dd,
     rtems_bdbuf_group_release (bd);
 
     if (sc == RTEMS_SUCCESSFUL && bd->state == RTEMS_BDBUF_STATE_TRANSFER)
-      rtems_bdbuf_make_cached_and_add_to_lru_list (bd);
+      rtems_bdbuf_make_cached_and_add_to_lru_list (shard, bd);
     else
-      rtems_bdbuf_discard_buffer (bd);
+    {
+      /*
+       * A buffer with a failed read-ahead transfer provides no data.  So, a
+       * waiter which gets it as an empty buffer must not count it as a
+       * read-ahead hit.
+       */
+      bd->read_ahead = false;
+      rtems_bdbuf_discard_buffer (shard, bd);
+    }
 
     if (rtems_bdbuf_tracer)
       rtems_bdbuf_show_users ("transfer", bd);
   }
 
-  if (wake_transfer_waiters)
-    rtems_bdbuf_wake (&bdbuf_cache.transfer_waiters);
+  if (shard != NULL)
+  {
+    rtems_bdbuf_wake_after_transfer (shard,
+                                     wake_transfer_waiters,
+                                     wake_buffer_waiters);
 
-  if (wake_buffer_waiters)
-    rtems_bdbuf_wake (&bdbuf_cache.buffer_waiters);
+    if (shard != locked_shard)
+      rtems_bdbuf_unlock_shard (shard);
+  }
 
-  if (!cache_locked)
-    rtems_bdbuf_unlock_cache ();
+  if (locked_shard != NULL && locked_shard != shard)
+    rtems_bdbuf_lock_shard (locked_shard);
 
   if (sc == RTEMS_SUCCESSFUL || sc == RTEMS_UNSATISFIED)
     return sc;
@@ -1935,96 +2021,178 @@ rtems_bdbuf_execute_transfer_request (rtems_disk_device    *dd,
     return RTEMS_IO_ERROR;
 }
 
+/**
+ * Executes a read request for the buffer. The shard of the buffer must be
+ * locked on entry and it will be locked on exit. No other shard lock may be
+ * owned by the caller.
+ */
 static rtems_status_code
 rtems_bdbuf_execute_read_request (rtems_disk_device  *dd,
-                                  rtems_bdbuf_buffer *bd,
-                                  uint32_t            transfer_count)
+                                  rtems_bdbuf_buffer *bd)
 {
   rtems_blkdev_request *req = NULL;
-  rtems_blkdev_bnum media_block = bd->block;
-  uint32_t media_blocks_per_block = dd->media_blocks_per_block;
-  uint32_t block_size = dd->block_size;
-  uint32_t transfer_index = 1;
+  rtems_bdbuf_shard *shard = rtems_bdbuf_shard_of_bd (bd);
 
   /*
    * TODO: This type of request structure is wrong and should be removed.
    */
 #define bdbuf_alloc(size) __builtin_alloca (size)
 
-  req = bdbuf_alloc (rtems_bdbuf_read_request_size (transfer_count));
+  req = bdbuf_alloc (rtems_bdbuf_read_request_size (1));
 
   req->req = RTEMS_BLKDEV_REQ_READ;
   req->done = rtems_bdbuf_transfer_done;
   req->io_task = rtems_task_self ();
-  req->bufnum = 0;
+  req->bufnum = 1;
 
   rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_TRANSFER);
 
   req->bufs [0].user   = bd;
-  req->bufs [0].block  = media_block;
-  req->bufs [0].length = block_size;
+  req->bufs [0].block  = bd->block;
+  req->bufs [0].length = dd->block_size;
   req->bufs [0].buffer = bd->buffer;
 
   if (rtems_bdbuf_tracer)
     rtems_bdbuf_show_users ("read", bd);
 
-  while (transfer_index < transfer_count)
-  {
-    media_block += media_blocks_per_block;
+  rtems_bdbuf_unlock_shard (shard);
+
+  return rtems_bdbuf_execute_transfer_request (dd, req, shard);
+}
+
+static void
+rtems_bdbuf_execute_read_ahead_request (rtems_disk_device    *dd,
+                                        rtems_blkdev_request *req)
+{
+  rtems_bdbuf_lock_cache ();
+  ++dd->stats.read_ahead_transfers;
+  rtems_bdbuf_unlock_cache ();
+
+  rtems_bdbuf_execute_transfer_request (dd, req, NULL);
+}
+
+/**
+ * Reads the blocks of a read-ahead window which are not in the cache. Cached
+ * blocks are skipped, so the request may be a scatter/gather request. Devices
+ * which need continuous blocks get one request for each run of consecutive
+ * blocks. The caller must not own a shard lock.
+ */
+static void
+rtems_bdbuf_read_ahead_window (rtems_disk_device *dd,
+                               rtems_blkdev_bnum  block,
+                               uint32_t           transfer_count)
+{
+  rtems_blkdev_request *req = NULL;
+  bool need_continuous_blocks =
+    (dd->phys_dev->capabilities & RTEMS_BLKDEV_CAP_MULTISECTOR_CONT) != 0;
+  uint32_t block_size = 0;
+  uint32_t transfer_index;
+
+  req = bdbuf_alloc (rtems_bdbuf_read_request_size (transfer_count));
+
+  req->req = RTEMS_BLKDEV_REQ_READ;
+  req->done = rtems_bdbuf_transfer_done;
+  req->io_task = rtems_task_self ();
+  req->bufnum = 0;
+
+  for (transfer_index = 0; transfer_index < transfer_count; ++transfer_index)
+  {
+    rtems_bdbuf_shard  *shard = NULL;
+    rtems_bdbuf_buffer *bd = NULL;
+    rtems_blkdev_bnum   media_block = 0;
+    rtems_status_code   sc;
+
+    sc = rtems_bdbuf_lock_shard_of_block (dd,
+                                          block + transfer_index,
+                                          &media_block,
+                                          &shard);
+    if (sc != RTEMS_SUCCESSFUL)
+      break;
+
+    /*
+     * The buffers already in the request are in the TRANSFER state and their
+     * groups are in use, so only one shard is locked at a time.  A block size
+     * change in between purged them, so stop here.
+     */
+    if (req->bufnum == 0)
+      block_size = dd->block_size;
+    else if (dd->block_size != block_size)
+    {
+      rtems_bdbuf_unlock_shard (shard);
+      break;
+    }
+
+    bd = rtems_bdbuf_get_buffer_for_read_ahead (shard, dd, media_block);
 
-    bd = rtems_bdbuf_get_buffer_for_read_ahead (dd, media_block);
+    if (bd != NULL)
+    {
+      uint32_t bufnum = req->bufnum;
 
-    if (bd == NULL)
-      break;
+      rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_TRANSFER);
+      bd->read_ahead = true;
 
-    rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_TRANSFER);
+      req->bufs [bufnum].user   = bd;
+      req->bufs [bufnum].block  = media_block;
+      req->bufs [bufnum].length = block_size;
+      req->bufs [bufnum].buffer = bd->buffer;
+      req->bufnum = bufnum + 1;
 
-    req->bufs [transfer_index].user   = bd;
-    req->bufs [transfer_index].block  = media_block;
-    req->bufs [transfer_index].length = block_size;
-    req->bufs [transfer_index].buffer = bd->buffer;
+      if (rtems_bdbuf_tracer)
+        rtems_bdbuf_show_users ("read-ahead", bd);
+    }
 
-    if (rtems_bdbuf_tracer)
-      rtems_bdbuf_show_users ("read", bd);
+    rtems_bdbuf_unlock_shard (shard);
 
-    ++transfer_index;
+    if (bd == NULL && need_continuous_blocks && req->bufnum > 0)
+    {
+      rtems_bdbuf_execute_read_ahead_request (dd, req);
+      req->bufnum = 0;
+    }
   }
 
-  req->bufnum = transfer_index;
-
-  return rtems_bdbuf_execute_transfer_request (dd, req, true);
+  if (req->bufnum > 0)
+    rtems_bdbuf_execute_read_ahead_request (dd, req);
 }
 
 static bool
-rtems_bdbuf_is_read_ahead_active (const rtems_disk_device *dd)
+rtems_bdbuf_is_read_ahead_active (const rtems_blkdev_read_ahead *ra)
 {
-  return !rtems_chain_is_node_off_chain (&dd->read_ahead.node);
+  return !rtems_chain_is_node_off_chain (&ra->node);
 }
 
 static void
-rtems_bdbuf_read_ahead_cancel (rtems_disk_device *dd)
+rtems_bdbuf_read_ahead_cancel (rtems_blkdev_read_ahead *ra)
 {
-  if (rtems_bdbuf_is_read_ahead_active (dd))
+  if (rtems_bdbuf_is_read_ahead_active (ra))
   {
-    rtems_chain_extract_unprotected (&dd->read_ahead.node);
-    rtems_chain_set_off_chain (&dd->read_ahead.node);
+    rtems_chain_extract_unprotected (&ra->node);
+    rtems_chain_set_off_chain (&ra->node);
   }
 }
 
 static void
 rtems_bdbuf_read_ahead_reset (rtems_disk_device *dd)
 {
-  rtems_bdbuf_read_ahead_cancel (dd);
-  dd->read_ahead.trigger = RTEMS_DISK_READ_AHEAD_NO_TRIGGER;
+  size_t i;
+
+  for (i = 0; i < RTEMS_DISK_READ_AHEAD_STREAM_COUNT; ++i)
+  {
+    rtems_blkdev_read_ahead *ra = &dd->read_ahead [i];
+
+    rtems_bdbuf_read_ahead_cancel (ra);
+    ra->trigger = RTEMS_DISK_READ_AHEAD_NO_TRIGGER;
+    ra->expected = RTEMS_DISK_READ_AHEAD_NO_TRIGGER;
+    ra->window = 0;
+  }
 }
 
 static void
-rtems_bdbuf_check_read_ahead_trigger (rtems_disk_device *dd,
-                                      rtems_blkdev_bnum  block)
+rtems_bdbuf_check_read_ahead_trigger (rtems_blkdev_read_ahead *ra,
+                                      rtems_blkdev_bnum        block)
 {
   if (bdbuf_cache.read_ahead_task != 0
-      && dd->read_ahead.trigger == block
-      && !rtems_bdbuf_is_read_ahead_active (dd))
+      && ra->trigger == block
+      && !rtems_bdbuf_is_read_ahead_active (ra))
   {
     rtems_status_code sc;
     rtems_chain_control *chain = &bdbuf_cache.read_ahead_chain;
@@ -2037,20 +2205,140 @@ rtems_bdbuf_check_read_ahead_trigger (rtems_disk_device *dd,
         rtems_bdbuf_fatal (RTEMS_BDBUF_FATAL_RA_WAKE_UP);
     }
 
-    rtems_chain_append_unprotected (chain, &dd->read_ahead.node);
+    rtems_chain_append_unprotected (chain, &ra->node);
   }
 }
 
-static void
-rtems_bdbuf_set_read_ahead_trigger (rtems_disk_device *dd,
+/**
+ * Returns the stream of the device which expects the block or which has the
+ * block in its current read-ahead window, otherwise NULL.
+ */
+static rtems_blkdev_read_ahead *
+rtems_bdbuf_read_ahead_find_stream (rtems_disk_device *dd,
                                     rtems_blkdev_bnum  block)
 {
-  if (dd->read_ahead.trigger != block)
+  size_t i;
+
+  for (i = 0; i < RTEMS_DISK_READ_AHEAD_STREAM_COUNT; ++i)
+  {
+    if (dd->read_ahead [i].expected == block)
+      return &dd->read_ahead [i];
+  }
+
+  for (i = 0; i < RTEMS_DISK_READ_AHEAD_STREAM_COUNT; ++i)
+  {
+    rtems_blkdev_read_ahead *ra = &dd->read_ahead [i];
+
+    if (block < ra->next && ra->next - block <= ra->window)
+      return ra;
+  }
+
+  return NULL;
+}
+
+/**
+ * Replaces the least recently used stream of the device.
+ */
+static rtems_blkdev_read_ahead *
+rtems_bdbuf_read_ahead_new_stream (rtems_disk_device *dd)
+{
+  rtems_blkdev_read_ahead *lru = &dd->read_ahead [0];
+  size_t i;
+
+  for (i = 1; i < RTEMS_DISK_READ_AHEAD_STREAM_COUNT; ++i)
+  {
+    rtems_blkdev_read_ahead *ra = &dd->read_ahead [i];
+
+    if ((int32_t) (ra->last_use - lru->last_use) < 0)
+      lru = ra;
+  }
+
+  rtems_bdbuf_read_ahead_cancel (lru);
+  lru->window = 0;
+
+  return lru;
+}
+
+/**
+ * Updates the read statistics and the read-ahead streams of the device in one
+ * cache lock section.
+ *
+ * A read miss which belongs to no stream starts a new stream.  The read-ahead
+ * of a stream starts with a read of its trigger block.  The window grows with
+ * each trigger hit.  A read miss of a stream with read-ahead restarts the
+ * read-ahead with the next block.  In case the block was in the last
+ * read-ahead window, the read-ahead blocks were recycled before the stream
+ * reached them, so the window shrinks.
+ */
+static void
+rtems_bdbuf_update_read_ahead (rtems_disk_device *dd,
+                               rtems_blkdev_bnum  block,
+                               bool               miss,
+                               bool               read_ahead_hit)
+{
+  rtems_blkdev_read_ahead *ra;
+
+  rtems_bdbuf_lock_cache ();
+
+  if (miss)
+    ++dd->stats.read_misses;
+  else
+    ++dd->stats.read_hits;
+
+  if (read_ahead_hit)
+    ++dd->stats.read_ahead_hits;
+
+  ra = rtems_bdbuf_read_ahead_find_stream (dd, block);
+
+  if (ra == NULL)
+  {
+    if (miss)
+    {
+      ra = rtems_bdbuf_read_ahead_new_stream (dd);
+      ra->trigger = block + 1;
+      ra->next = block + 2;
+    }
+  }
+  else if (miss && ra->window > 0)
+  {
+    /*
+     * Only a block of the last read-ahead window is a read-ahead miss.  A
+     * block at or after the next read-ahead block is part of a read-ahead
+     * which is still queued or which was not issued yet.
+     */
+    if (block < ra->next)
+    {
+      ++dd->stats.read_ahead_misses;
+
+      if (ra->window > 1)
+        ra->window /= 2;
+    }
+
+    rtems_bdbuf_read_ahead_cancel (ra);
+    ra->trigger = block;
+    ra->next = block + 1;
+  }
+  else if (ra->trigger == block)
+  {
+    uint32_t max_window = bdbuf_config.max_read_ahead_blocks;
+    uint32_t window;
+
+    if (ra->window == 0)
+      window = RTEMS_BDBUF_READ_AHEAD_INITIAL_WINDOW;
+    else
+      window = 2 * ra->window;
+
+    ra->window = window < max_window ? window : max_window;
+  }
+
+  if (ra != NULL)
   {
-    rtems_bdbuf_read_ahead_cancel (dd);
-    dd->read_ahead.trigger = block + 1;
-    dd->read_ahead.next = block + 2;
+    ra->expected = block + 1;
+    ra->last_use = ++dd->read_ahead_clock;
+    rtems_bdbuf_check_read_ahead_trigger (ra, block);
   }
+
+  rtems_bdbuf_unlock_cache ();
 }
 
 rtems_status_code
@@ -2060,32 +2348,34 @@ rtems_bdbuf_read (rtems_disk_device   *dd,
 {
   rtems_status_code     sc = RTEMS_SUCCESSFUL;
   rtems_bdbuf_buffer   *bd = NULL;
+  rtems_bdbuf_shard    *shard = NULL;
   rtems_blkdev_bnum     media_block;
 
-  rtems_bdbuf_lock_cache ();
-
-  sc = rtems_bdbuf_get_media_block (dd, block, &media_block);
+  sc = rtems_bdbuf_lock_shard_of_block (dd, block, &media_block, &shard);
   if (sc == RTEMS_SUCCESSFUL)
   {
     if (rtems_bdbuf_tracer)
       printf ("bdbuf:read: %" PRIu32 " (%" PRIu32 ") (dev = %08x)\n",
               media_block, block, (unsigned) dd->dev);
 
-    bd = rtems_bdbuf_get_buffer_for_access (dd, media_block);
+    bd = rtems_bdbuf_get_buffer_for_access (shard, dd, media_block);
+
+    rtems_bdbuf_update_read_ahead (dd,
+                                   block,
+                                   bd->state == RTEMS_BDBUF_STATE_EMPTY,
+                                   bd->read_ahead);
+    bd->read_ahead = false;
+
     switch (bd->state)
     {
       case RTEMS_BDBUF_STATE_CACHED:
-        ++dd->stats.read_hits;
         rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_ACCESS_CACHED);
         break;
       case RTEMS_BDBUF_STATE_MODIFIED:
-        ++dd->stats.read_hits;
         rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_ACCESS_MODIFIED);
         break;
       case RTEMS_BDBUF_STATE_EMPTY:
-        ++dd->stats.read_misses;
-        rtems_bdbuf_set_read_ahead_trigger (dd, block);
-        sc = rtems_bdbuf_execute_read_request (dd, bd, 1);
+        sc = rtems_bdbuf_execute_read_request (dd, bd);
         if (sc == RTEMS_SUCCESSFUL)
         {
           rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_ACCESS_CACHED);
@@ -2102,51 +2392,52 @@ rtems_bdbuf_read (rtems_disk_device   *dd,
         break;
     }
 
-    rtems_bdbuf_check_read_ahead_trigger (dd, block);
+    rtems_bdbuf_unlock_shard (shard);
   }
 
-  rtems_bdbuf_unlock_cache ();
-
   *bd_ptr = bd;
 
   return sc;
 }
 
-static rtems_status_code
-rtems_bdbuf_check_bd_and_lock_cache (rtems_bdbuf_buffer *bd, const char *kind)
+static rtems_bdbuf_shard *
+rtems_bdbuf_check_bd_and_lock_shard (rtems_bdbuf_buffer *bd, const char *kind)
 {
+  rtems_bdbuf_shard *shard;
+
   if (bd == NULL)
-    return RTEMS_INVALID_ADDRESS;
+    return NULL;
   if (rtems_bdbuf_tracer)
   {
     printf ("bdbuf:%s: %" PRIu32 "\n", kind, bd->block);
     rtems_bdbuf_show_users (kind, bd);
   }
-  rtems_bdbuf_lock_cache();
+  shard = rtems_bdbuf_shard_of_bd (bd);
+  rtems_bdbuf_lock_shard (shard);
 
-  return RTEMS_SUCCESSFUL;
+  return shard;
 }
 
 rtems_status_code
 rtems_bdbuf_release (rtems_bdbuf_buffer *bd)
 {
-  rtems_status_code sc = RTEMS_SUCCESSFUL;
+  rtems_bdbuf_shard *shard;
 
-  sc = rtems_bdbuf_check_bd_and_lock_cache (bd, "release");
-  if (sc != RTEMS_SUCCESSFUL)
-    return sc;
+  shard = rtems_bdbuf_check_bd_and_lock_shard (bd, "release");
+  if (shard == NULL)
+    return RTEMS_INVALID_ADDRESS;
 
   switch (bd->state)
   {
     case RTEMS_BDBUF_STATE_ACCESS_CACHED:
-      rtems_bdbuf_add_to_lru_list_after_access (bd);
+      rtems_bdbuf_add_to_lru_list_after_access (shard, bd);
       break;
     case RTEMS_BDBUF_STATE_ACCESS_EMPTY:
     case RTEMS_BDBUF_STATE_ACCESS_PURGED:
-      rtems_bdbuf_discard_buffer_after_access (bd);
+      rtems_bdbuf_discard_buffer_after_access (shard, bd);
       break;
     case RTEMS_BDBUF_STATE_ACCESS_MODIFIED:
-      rtems_bdbuf_add_to_modified_list_after_access (bd);
+      rtems_bdbuf_add_to_modified_list_after_access (shard, bd);
       break;
     default:
       rtems_bdbuf_fatal_with_state (bd->state, RTEMS_BDBUF_FATAL_STATE_0);
@@ -2156,7 +2447,7 @@ rtems_bdbuf_release (rtems_bdbuf_buffer *bd)
   if (rtems_bdbuf_tracer)
     rtems_bdbuf_show_usage ();
 
-  rtems_bdbuf_unlock_cache ();
+  rtems_bdbuf_unlock_shard (shard);
 
   return RTEMS_SUCCESSFUL;
 }
@@ -2164,21 +2455,21 @@ rtems_bdbuf_release (rtems_bdbuf_buffer *bd)
 rtems_status_code
 rtems_bdbuf_release_modified (rtems_bdbuf_buffer *bd)
 {
-  rtems_status_code sc = RTEMS_SUCCESSFUL;
+  rtems_bdbuf_shard *shard;
 
-  sc = rtems_bdbuf_check_bd_and_lock_cache (bd, "release modified");
-  if (sc != RTEMS_SUCCESSFUL)
-    return sc;
+  shard = rtems_bdbuf_check_bd_and_lock_shard (bd, "release modified");
+  if (shard == NULL)
+    return RTEMS_INVALID_ADDRESS;
 
   switch (bd->state)
   {
     case RTEMS_BDBUF_STATE_ACCESS_CACHED:
     case RTEMS_BDBUF_STATE_ACCESS_EMPTY:
     case RTEMS_BDBUF_STATE_ACCESS_MODIFIED:
-      rtems_bdbuf_add_to_modified_list_after_access (bd);
+      rtems_bdbuf_add_to_modified_list_after_access (shard, bd);
       break;
     case RTEMS_BDBUF_STATE_ACCESS_PURGED:
-      rtems_bdbuf_discard_buffer_after_access (bd);
+      rtems_bdbuf_discard_buffer_after_access (shard, bd);
       break;
     default:
       rtems_bdbuf_fatal_with_state (bd->state, RTEMS_BDBUF_FATAL_STATE_6);
@@ -2188,7 +2479,7 @@ rtems_bdbuf_release_modified (rtems_bdbuf_buffer *bd)
   if (rtems_bdbuf_tracer)
     rtems_bdbuf_show_usage ();
 
-  rtems_bdbuf_unlock_cache ();
+  rtems_bdbuf_unlock_shard (shard);
 
   return RTEMS_SUCCESSFUL;
 }
@@ -2196,21 +2487,21 @@ rtems_bdbuf_release_modified (rtems_bdbuf_buffer *bd)
 rtems_status_code
 rtems_bdbuf_sync (rtems_bdbuf_buffer *bd)
 {
-  rtems_status_code sc = RTEMS_SUCCESSFUL;
+  rtems_bdbuf_shard *shard;
 
-  sc = rtems_bdbuf_check_bd_and_lock_cache (bd, "sync");
-  if (sc != RTEMS_SUCCESSFUL)
-    return sc;
+  shard = rtems_bdbuf_check_bd_and_lock_shard (bd, "sync");
+  if (shard == NULL)
+    return RTEMS_INVALID_ADDRESS;
 
   switch (bd->state)
   {
     case RTEMS_BDBUF_STATE_ACCESS_CACHED:
     case RTEMS_BDBUF_STATE_ACCESS_EMPTY:
     case RTEMS_BDBUF_STATE_ACCESS_MODIFIED:
-      rtems_bdbuf_sync_after_access (bd);
+      rtems_bdbuf_sync_after_access (shard, bd);
       break;
     case RTEMS_BDBUF_STATE_ACCESS_PURGED:
-      rtems_bdbuf_discard_buffer_after_access (bd);
+      rtems_bdbuf_discard_buffer_after_access (shard, bd);
       break;
     default:
       rtems_bdbuf_fatal_with_state (bd->state, RTEMS_BDBUF_FATAL_STATE_5);
@@ -2220,7 +2511,7 @@ rtems_bdbuf_sync (rtems_bdbuf_buffer *bd)
   if (rtems_bdbuf_tracer)
     rtems_bdbuf_show_usage ();
 
-  rtems_bdbuf_unlock_cache ();
+  rtems_bdbuf_unlock_shard (shard);
 
   return RTEMS_SUCCESSFUL;
 }
@@ -2259,15 +2550,176 @@ rtems_bdbuf_syncdev (rtems_disk_device *dd)
   return RTEMS_SUCCESSFUL;
 }
 
+/**
+ * Sorts the buffers of the transfer list in ascending block order with a
+ * bottom-up merge sort. This is the elevator of the write stage. Adjacent
+ * blocks end up next to each other, so that they can be merged into one
+ * request, and the device is written in one direction.
+ *
+ * @param bds The transfer list of BDs.
+ */
+static void
+rtems_bdbuf_swapout_sort (rtems_chain_control* bds)
+{
+  rtems_chain_node* list;
+  size_t            run = 1;
+  size_t            merges;
+
+  if (rtems_chain_is_empty (bds) || rtems_chain_has_only_one_node (bds))
+    return;
+
+  /*
+   * Use the next pointers of the nodes as a NULL terminated singly linked
+   * list.
+   */
+  list = rtems_chain_first (bds);
+  rtems_chain_last (bds)->next = NULL;
+
+  do
+  {
+    rtems_chain_node* p = list;
+    rtems_chain_node* tail = NULL;
+
+    list = NULL;
+    merges = 0;
+
+    while (p != NULL)
+    {
+      rtems_chain_node* q = p;
+      size_t            psize = 0;
+      size_t            qsize = run;
+
+      ++merges;
+
+      while (psize < run && q != NULL)
+      {
+        ++psize;
+        q = q->next;
+      }
+
+      while (psize > 0 || (qsize > 0 && q != NULL))
+      {
+        rtems_chain_node* e;
+
+        if (psize == 0)
+        {
+          e = q;
+          q = q->next;
+          --qsize;
+        }
+        else if (qsize == 0 || q == NULL
+                 || ((rtems_bdbuf_buffer*) p)->block
+                      <= ((rtems_bdbuf_buffer*) q)->block)
+        {
+          e = p;
+          p = p->next;
+          --psize;
+        }
+        else
+        {
+          e = q;
+          q = q->next;
+          --qsize;
+        }
+
+        if (tail != NULL)
+          tail->next = e;
+        else
+          list = e;
+
+        tail = e;
+      }
+
+      p = q;
+    }
+
+    tail->next = NULL;
+    run *= 2;
+  }
+  while (merges > 1);
+
+  rtems_chain_initialize_empty (bds);
+
+  while (list != NULL)
+  {
+    rtems_chain_node* node = list;
+
+    list = node->next;
+    rtems_chain_set_off_chain (node);
+    rtems_chain_append_unprotected (bds, node);
+  }
+}
+
+/**
+ * Returns true if a sync of another device waits for the swapout task.
+ */
+static bool
+rtems_bdbuf_swapout_is_preempted (const rtems_disk_device *dd)
+{
+  bool preempted;
+
+  rtems_bdbuf_lock_cache ();
+  preempted = bdbuf_cache.sync_active && bdbuf_cache.sync_device != dd;
+  rtems_bdbuf_unlock_cache ();
+
+  return preempted;
+}
+
+/**
+ * Gives the buffers of the transfer list which were not written back to the
+ * sync lists of their shards. They are written before other modified buffers
+ * once the sync is done. The buffers of a sync in progress are not on these
+ * lists, since the sync device selects the buffers. Purged buffers are
+ * discarded. The cache is not locked.
+ *
+ * @param bds The transfer list of BDs.
+ */
+static void
+rtems_bdbuf_swapout_requeue (rtems_chain_control* bds)
+{
+  rtems_chain_node *node;
+
+  while ((node = rtems_chain_get_unprotected (bds)) != NULL)
+  {
+    rtems_bdbuf_buffer *bd = (rtems_bdbuf_buffer *) node;
+    rtems_bdbuf_shard *shard = rtems_bdbuf_shard_of_bd (bd);
+
+    rtems_bdbuf_lock_shard (shard);
+
+    if (bd->state == RTEMS_BDBUF_STATE_TRANSFER)
+    {
+      rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_SYNC);
+      rtems_chain_append_unprotected (&shard->sync, &bd->link);
+    }
+    else
+    {
+      bool waiters = bd->waiters != 0;
+
+      rtems_bdbuf_group_release (bd);
+      rtems_bdbuf_discard_buffer (shard, bd);
+      rtems_bdbuf_wake_after_transfer (shard, waiters, !waiters);
+    }
+
+    rtems_bdbuf_unlock_shard (shard);
+  }
+}
+
 /**
  * Swapout transfer to the driver. The driver will break this I/O into groups
  * of consecutive write requests is multiple consecutive buffers are required
  * by the driver. The cache is not locked.
  *
+ * The buffers are sorted by block and adjacent buffers are merged into one
+ * request up to the maximum write blocks. A preemptible transfer stops after
+ * a request in case a sync of another device is active, so that the sync does
+ * not have to wait for the complete transfer.
+ *
  * @param transfer The transfer transaction.
+ * @param preemptible If true the transfer may be preempted by a sync.
  */
 static void
-rtems_bdbuf_swapout_write (rtems_bdbuf_swapout_transfer* transfer)
+rtems_bdbuf_swapout_write (rtems_bdbuf_swapout_transfer* transfer,
+                           bool                          preemptible)
 {
   rtems_chain_node *node;
 
@@ -2299,6 +2751,8 @@ rtems_bdbuf_swapout_write (rtems_bdbuf_swapout_transfer* transfer)
      * removed. Merging members of a struct into the first member is
      * trouble waiting to happen.
      */
+    rtems_bdbuf_swapout_sort (&transfer->bds);
+
     transfer->write_req.status = RTEMS_RESOURCE_IN_USE;
     transfer->write_req.bufnum = 0;
 
@@ -2348,10 +2802,17 @@ rtems_bdbuf_swapout_write (rtems_bdbuf_swapout_transfer* transfer)
 
       if (write)
       {
-        rtems_bdbuf_execute_transfer_request (dd, &transfer->write_req, false);
+        rtems_bdbuf_execute_transfer_request (dd, &transfer->write_req, NULL);
 
         transfer->write_req.status = RTEMS_RESOURCE_IN_USE;
         transfer->write_req.bufnum = 0;
+
+        if (preemptible
+            && !rtems_chain_is_empty (&transfer->bds)
+            && rtems_bdbuf_swapout_is_preempted (dd))
+        {
+          rtems_bdbuf_swapout_requeue (&transfer->bds);
+        }
       }
     }
 
@@ -2372,6 +2833,7 @@ rtems_bdbuf_swapout_write (rtems_bdbuf_swapout_transfer* transfer)
  * Process the modified list of buffers. There is a sync or modified list that
  * needs to be handled so we have a common function to do the work.
  *
+ * @param shard The shard of the modified chain. It must be locked.
  * @param dd_ptr Pointer to the device to handle. If BDBUF_INVALID_DEV no
  * device is selected so select the device of the first buffer to be written to
  * disk.
@@ -2383,7 +2845,8 @@ rtems_bdbuf_swapout_write (rtems_bdbuf_swapout_transfer* transfer)
  *                    amount.
  */
 static void
-rtems_bdbuf_swapout_modified_processing (rtems_disk_device  **dd_ptr,
+rtems_bdbuf_swapout_modified_processing (rtems_bdbuf_shard   *shard,
+                                         rtems_disk_device  **dd_ptr,
                                          rtems_chain_control* chain,
                                          rtems_chain_control* transfer,
                                          bool                 sync_active,
@@ -2417,7 +2880,7 @@ rtems_bdbuf_swapout_modified_processing (rtems_disk_device  **dd_ptr,
        *       on TOD to be accurate. Does it matter ?
        */
       if (sync_all || (sync_active && (*dd_ptr == bd->dd))
-          || rtems_bdbuf_has_buffer_waiters ())
+          || rtems_bdbuf_has_buffer_waiters (shard))
         bd->hold_timer = 0;
 
       if (bd->hold_timer)
@@ -2448,36 +2911,15 @@ rtems_bdbuf_swapout_modified_processing (rtems_disk_device  **dd_ptr,
       if (bd->dd == *dd_ptr)
       {
         rtems_chain_node* next_node = node->next;
-        rtems_chain_node* tnode = rtems_chain_tail (transfer);
 
         /*
-         * The blocks on the transfer list are sorted in block order. This
-         * means multi-block transfers for drivers that require consecutive
-         * blocks perform better with sorted blocks and for real disks it may
-         * help lower head movement.
+         * The transfer list is sorted in block order by the write stage, see
+         * rtems_bdbuf_swapout_sort().
          */
-
         rtems_bdbuf_set_state (bd, RTEMS_BDBUF_STATE_TRANSFER);
 
         rtems_chain_extract_unprotected (node);
-
-        tnode = tnode->previous;
-
-        while (node && !rtems_chain_is_head (transfer, tnode))
-        {
-          rtems_bdbuf_buffer* tbd = (rtems_bdbuf_buffer*) tnode;
-
-          if (bd->block > tbd->block)
-          {
-            rtems_chain_insert_unprotected (tnode, node);
-            node = NULL;
-          }
-          else
-            tnode = tnode->previous;
-        }
-
-        if (node)
-          rtems_chain_prepend_unprotected (transfer, node);
+        rtems_chain_append_unprotected (transfer, node);
 
         node = next_node;
       }
@@ -2494,8 +2936,9 @@ rtems_bdbuf_swapout_modified_processing (rtems_disk_device  **dd_ptr,
  * modified list extracting the buffers suitable to be written to disk. We have
  * a device at a time. The task level loop will repeat this operation while
  * there are buffers to be written. If the transfer fails place the buffers
- * back on the modified list and try again later. The cache is unlocked while
- * the buffers are being written to disk.
+ * back on the modified list and try again later. The shards are processed one
+ * after the other and no lock is owned while the buffers are being written to
+ * disk.
  *
  * @param timer_delta It update_timers is true update the timers by this
  *                    amount.
@@ -2513,6 +2956,7 @@ rtems_bdbuf_swapout_processing (unsigned long                 timer_delta,
   rtems_bdbuf_swapout_worker* worker;
   bool                        transfered_buffers = false;
   bool                        sync_active;
+  size_t                      s;
 
   rtems_bdbuf_lock_cache ();
 
@@ -2552,32 +2996,44 @@ rtems_bdbuf_swapout_processing (unsigned long                 timer_delta,
   if (sync_active)
     transfer->dd = bdbuf_cache.sync_device;
 
-  /*
-   * If we have any buffers in the sync queue move them to the modified
-   * list. The first sync buffer will select the device we use.
-   */
-  rtems_bdbuf_swapout_modified_processing (&transfer->dd,
-                                           &bdbuf_cache.sync,
-                                           &transfer->bds,
-                                           true, false,
-                                           timer_delta);
+  rtems_bdbuf_unlock_cache ();
 
   /*
-   * Process the cache's modified list.
+   * If we have any buffers in the sync queues move them to the modified
+   * list. The first sync buffer will select the device we use.
    */
-  rtems_bdbuf_swapout_modified_processing (&transfer->dd,
-                                           &bdbuf_cache.modified,
-                                           &transfer->bds,
-                                           sync_active,
-                                           update_timers,
-                                           timer_delta);
+  for (s = 0; s < bdbuf_cache.shard_count; ++s)
+  {
+    rtems_bdbuf_shard *shard = &bdbuf_cache.shards [s];
+
+    rtems_bdbuf_lock_shard (shard);
+    rtems_bdbuf_swapout_modified_processing (shard,
+                                             &transfer->dd,
+                                             &shard->sync,
+                                             &transfer->bds,
+                                             true, false,
+                                             timer_delta);
+    rtems_bdbuf_unlock_shard (shard);
+  }
 
   /*
-   * We have all the buffers that have been modified for this device so the
-   * cache can be unlocked because the state of each buffer has been set to
-   * TRANSFER.
+   * Process the modified lists of the shards. The shards can be unlocked
+   * afterwards because the state of each buffer has been set to TRANSFER.
    */
-  rtems_bdbuf_unlock_cache ();
+  for (s = 0; s < bdbuf_cache.shard_count; ++s)
+  {
+    rtems_bdbuf_shard *shard = &bdbuf_cache.shards [s];
+
+    rtems_bdbuf_lock_shard (shard);
+    rtems_bdbuf_swapout_modified_processing (shard,
+                                             &transfer->dd,
+                                             &shard->modified,
+                                             &transfer->bds,
+                                             sync_active,
+                                             update_timers,
+                                             timer_delta);
+    rtems_bdbuf_unlock_shard (shard);
+  }
 
   /*
    * If there are buffers to transfer to the media transfer them.
@@ -2593,7 +3049,7 @@ rtems_bdbuf_swapout_processing (unsigned long                 timer_delta,
     }
     else
     {
-      rtems_bdbuf_swapout_write (transfer);
+      rtems_bdbuf_swapout_write (transfer, !transfer->syncing);
     }
 
     transfered_buffers = true;
@@ -2629,7 +3085,7 @@ rtems_bdbuf_swapout_worker_task (rtems_task_argument arg)
   {
     rtems_bdbuf_wait_for_event (RTEMS_BDBUF_SWAPOUT_SYNC);
 
-    rtems_bdbuf_swapout_write (&worker->transfer);
+    rtems_bdbuf_swapout_write (&worker->transfer, false);
 
     rtems_bdbuf_lock_cache ();
 
@@ -2750,7 +3206,8 @@ rtems_bdbuf_swapout_task (rtems_task_argument arg)
 }
 
 static void
-rtems_bdbuf_purge_list (rtems_chain_control *purge_list)
+rtems_bdbuf_purge_list (rtems_bdbuf_shard   *shard,
+                        rtems_chain_control *purge_list)
 {
   bool wake_buffer_waiters = false;
   rtems_chain_node *node = NULL;
@@ -2762,27 +3219,35 @@ rtems_bdbuf_purge_list (rtems_chain_control *purge_list)
     if (bd->waiters == 0)
       wake_buffer_waiters = true;
 
-    rtems_bdbuf_discard_buffer (bd);
+    rtems_bdbuf_discard_buffer (shard, bd);
   }
 
   if (wake_buffer_waiters)
-    rtems_bdbuf_wake (&bdbuf_cache.buffer_waiters);
+    rtems_bdbuf_wake (&shard->buffer_waiters);
 }
 
-static void
-rtems_bdbuf_gather_for_purge (rtems_chain_control *purge_list,
+/**
+ * Gathers the buffers of the device in the shard for the purge. Returns the
+ * count of cached buffers transfered by read-ahead requests which were not
+ * accessed.
+ */
+static uint32_t
+rtems_bdbuf_gather_for_purge (rtems_bdbuf_shard       *shard,
+                              rtems_chain_control     *purge_list,
                               const rtems_disk_device *dd)
 {
-  rtems_bdbuf_buffer *stack [RTEMS_BDBUF_AVL_MAX_HEIGHT];
-  rtems_bdbuf_buffer **prev = stack;
-  rtems_bdbuf_buffer *cur = bdbuf_cache.tree;
+  uint32_t wasted = 0;
+  size_t i;
 
-  *prev = NULL;
-
-  while (cur != NULL)
+  for (i = 0; i <= shard->hash_mask; ++i)
   {
-    if (cur->dd == dd)
+    rtems_bdbuf_buffer *cur;
+
+    for (cur = shard->hash [i]; cur != NULL; cur = cur->hash_next)
     {
+      if (cur->dd != dd)
+        continue;
+
       switch (cur->state)
       {
         case RTEMS_BDBUF_STATE_FREE:
@@ -2791,12 +3256,17 @@ rtems_bdbuf_gather_for_purge (rtems_chain_control *purge_list,
         case RTEMS_BDBUF_STATE_TRANSFER_PURGED:
           break;
         case RTEMS_BDBUF_STATE_SYNC:
-          rtems_bdbuf_wake (&bdbuf_cache.transfer_waiters);
+          rtems_bdbuf_wake (&shard->transfer_waiters);
           /* Fall through */
         case RTEMS_BDBUF_STATE_MODIFIED:
           rtems_bdbuf_group_release (cur);
           /* Fall through */
         case RTEMS_BDBUF_STATE_CACHED:
+          if (cur->read_ahead)
+          {
+            cur->read_ahead = false;
+            ++wasted;
+          }
           rtems_chain_extract_unprotected (&cur->link);
           rtems_chain_append_unprotected (purge_list, &cur->link);
           break;
@@ -2812,57 +3282,58 @@ rtems_bdbuf_gather_for_purge (rtems_chain_control *purge_list,
           rtems_bdbuf_fatal (RTEMS_BDBUF_FATAL_STATE_11);
       }
     }
-
-    if (cur->avl.left != NULL)
-    {
-      /* Left */
-      ++prev;
-      *prev = cur;
-      cur = cur->avl.left;
-    }
-    else if (cur->avl.right != NULL)
-    {
-      /* Right */
-      ++prev;
-      *prev = cur;
-      cur = cur->avl.right;
-    }
-    else
-    {
-      while (*prev != NULL
-             && (cur == (*prev)->avl.right || (*prev)->avl.right == NULL))
-      {
-        /* Up */
-        cur = *prev;
-        --prev;
-      }
-      if (*prev != NULL)
-        /* Right */
-        cur = (*prev)->avl.right;
-      else
-        /* Finished */
-        cur = NULL;
-    }
   }
+
+  return wasted;
 }
 
+/**
+ * Purges the buffers of the device in the shard. The shard must be locked.
+ */
 static void
-rtems_bdbuf_do_purge_dev (rtems_disk_device *dd)
+rtems_bdbuf_purge_shard (rtems_bdbuf_shard *shard, rtems_disk_device *dd)
 {
   rtems_chain_control purge_list;
+  uint32_t wasted;
 
   rtems_chain_initialize_empty (&purge_list);
-  rtems_bdbuf_read_ahead_reset (dd);
-  rtems_bdbuf_gather_for_purge (&purge_list, dd);
-  rtems_bdbuf_purge_list (&purge_list);
+  wasted = rtems_bdbuf_gather_for_purge (shard, &purge_list, dd);
+  rtems_bdbuf_purge_list (shard, &purge_list);
+
+  if (wasted > 0)
+    rtems_bdbuf_read_ahead_wasted (dd, wasted);
 }
 
 void
 rtems_bdbuf_purge_dev (rtems_disk_device *dd)
 {
+  size_t s;
+
   rtems_bdbuf_lock_cache ();
-  rtems_bdbuf_do_purge_dev (dd);
+
+  /*
+   * The device may be deleted after the purge, so wait until the read-ahead
+   * task no longer uses it.
+   */
+  while (bdbuf_cache.read_ahead_device == dd)
+  {
+    ++bdbuf_cache.read_ahead_waiters.count;
+    rtems_condition_variable_wait (&bdbuf_cache.read_ahead_waiters.cond_var,
+                                   &bdbuf_cache.lock);
+    --bdbuf_cache.read_ahead_waiters.count;
+  }
+
+  rtems_bdbuf_read_ahead_reset (dd);
   rtems_bdbuf_unlock_cache ();
+
+  for (s = 0; s < bdbuf_cache.shard_count; ++s)
+  {
+    rtems_bdbuf_shard *shard = &bdbuf_cache.shards [s];
+
+    rtems_bdbuf_lock_shard (shard);
+    rtems_bdbuf_purge_shard (shard, dd);
+    rtems_bdbuf_unlock_shard (shard);
+  }
 }
 
 rtems_status_code
@@ -2879,7 +3350,7 @@ rtems_bdbuf_set_block_size (rtems_disk_device *dd,
   if (sync)
     rtems_bdbuf_syncdev (dd);
 
-  rtems_bdbuf_lock_cache ();
+  rtems_bdbuf_lock_all_shards ();
 
   if (block_size > 0)
   {
@@ -2890,6 +3361,7 @@ rtems_bdbuf_set_block_size (rtems_disk_device *dd,
       int block_to_media_block_shift = 0;
       uint32_t media_blocks_per_block = block_size / dd->media_block_size;
       uint32_t one = 1;
+      size_t s;
 
       while ((one << block_to_media_block_shift) < media_blocks_per_block)
       {
@@ -2899,13 +3371,20 @@ rtems_bdbuf_set_block_size (rtems_disk_device *dd,
       if ((dd->media_block_size << block_to_media_block_shift) != block_size)
         block_to_media_block_shift = -1;
 
+      /*
+       * The read-ahead task uses the block count under the cache lock.
+       */
+      rtems_bdbuf_lock_cache ();
       dd->block_size = block_size;
       dd->block_count = dd->size / media_blocks_per_block;
       dd->media_blocks_per_block = media_blocks_per_block;
       dd->block_to_media_block_shift = block_to_media_block_shift;
       dd->bds_per_group = bds_per_group;
+      rtems_bdbuf_read_ahead_reset (dd);
+      rtems_bdbuf_unlock_cache ();
 
-      rtems_bdbuf_do_purge_dev (dd);
+      for (s = 0; s < bdbuf_cache.shard_count; ++s)
+        rtems_bdbuf_purge_shard (&bdbuf_cache.shards [s], dd);
     }
     else
     {
@@ -2917,7 +3396,7 @@ rtems_bdbuf_set_block_size (rtems_disk_device *dd,
     sc = RTEMS_INVALID_NUMBER;
   }
 
-  rtems_bdbuf_unlock_cache ();
+  rtems_bdbuf_unlock_all_shards ();
 
   return sc;
 }
@@ -2936,43 +3415,45 @@ rtems_bdbuf_read_ahead_task (rtems_task_argument arg)
 
     while ((node = rtems_chain_get_unprotected (chain)) != NULL)
     {
-      rtems_disk_device *dd =
-        RTEMS_CONTAINER_OF (node, rtems_disk_device, read_ahead.node);
-      rtems_blkdev_bnum block = dd->read_ahead.next;
-      rtems_blkdev_bnum media_block = 0;
-      rtems_status_code sc =
-        rtems_bdbuf_get_media_block (dd, block, &media_block);
+      rtems_blkdev_read_ahead *ra =
+        RTEMS_CONTAINER_OF (node, rtems_blkdev_read_ahead, node);
+      rtems_disk_device *dd = ra->dd;
+      rtems_blkdev_bnum block = ra->next;
+      rtems_blkdev_bnum block_count = dd->block_count;
+      uint32_t transfer_count = 0;
 
-      rtems_chain_set_off_chain (&dd->read_ahead.node);
+      rtems_chain_set_off_chain (&ra->node);
 
-      if (sc == RTEMS_SUCCESSFUL)
+      if (block < block_count)
       {
-        rtems_bdbuf_buffer *bd =
-          rtems_bdbuf_get_buffer_for_read_ahead (dd, media_block);
+        transfer_count = block_count - block;
 
-        if (bd != NULL)
+        if (transfer_count >= ra->window)
         {
-          uint32_t transfer_count = dd->block_count - block;
-          uint32_t max_transfer_count = bdbuf_config.max_read_ahead_blocks;
-
-          if (transfer_count >= max_transfer_count)
-          {
-            transfer_count = max_transfer_count;
-            dd->read_ahead.trigger = block + transfer_count / 2;
-            dd->read_ahead.next = block + transfer_count;
-          }
-          else
-          {
-            dd->read_ahead.trigger = RTEMS_DISK_READ_AHEAD_NO_TRIGGER;
-          }
-
-          ++dd->stats.read_ahead_transfers;
-          rtems_bdbuf_execute_read_request (dd, bd, transfer_count);
+          transfer_count = ra->window;
+          ra->trigger = block + transfer_count / 2;
+          ra->next = block + transfer_count;
+        }
+        else
+        {
+          ra->trigger = RTEMS_DISK_READ_AHEAD_NO_TRIGGER;
         }
       }
       else
       {
-        dd->read_ahead.trigger = RTEMS_DISK_READ_AHEAD_NO_TRIGGER;
+        ra->trigger = RTEMS_DISK_READ_AHEAD_NO_TRIGGER;
+      }
+
+      if (transfer_count > 0)
+      {
+        bdbuf_cache.read_ahead_device = dd;
+        rtems_bdbuf_unlock_cache ();
+
+        rtems_bdbuf_read_ahead_window (dd, block, transfer_count);
+
+        rtems_bdbuf_lock_cache ();
+        bdbuf_cache.read_ahead_device = NULL;
+        rtems_bdbuf_wake (&bdbuf_cache.read_ahead_waiters);
       }
     }
 
@@ -51,6 +51,9 @@ void rtems_blkdev_print_stats(
      " WRITE TRANSFERS      | %" PRIu32 "\n"
      " WRITE BLOCKS         | %" PRIu32 "\n"
      " WRITE ERRORS         | %" PRIu32 "\n"
+     " READ AHEAD HITS      | %" PRIu32 "\n"
+     " READ AHEAD MISSES    | %" PRIu32 "\n"
+     " READ AHEAD WASTED    | %" PRIu32 "\n"
      "----------------------+--------------------------------------------------------\n",
      media_block_size,
      media_block_count,
@@ -62,6 +65,9 @@ void rtems_blkdev_print_stats(
      stats->read_errors,
      stats->write_transfers,
      stats->write_blocks,
-     stats->write_errors
+     stats->write_errors,
+     stats->read_ahead_hits,
+     stats->read_ahead_misses,
+     stats->read_ahead_wasted
   );
 }
@@ -37,6 +37,10 @@ void free(
       return;
   }
 
+  if ( rtems_malloc_cache != NULL && ( *rtems_malloc_cache->free )( ptr ) ) {
+    return;
+  }
+
   if ( !_Protected_heap_Free( RTEMS_Malloc_Heap, ptr ) ) {
     rtems_fatal( RTEMS_FATAL_SOURCE_INVALID_HEAP_FREE, (rtems_fatal_code) ptr );
   }
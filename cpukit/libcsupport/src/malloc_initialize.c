@@ -31,7 +31,8 @@ void RTEMS_Malloc_Initialize(
   Heap_Control *heap = RTEMS_Malloc_Heap;
 
   if ( !rtems_configuration_get_unified_work_area() ) {
-    Heap_Initialization_or_extend_handler init_or_extend = _Heap_Initialize;
+    Heap_Initialization_or_extend_handler init_or_extend =
+      rtems_malloc_heap_initialize_handler;
     uintptr_t page_size = CPU_HEAP_ALIGNMENT;
     size_t i;
 
@@ -49,7 +50,7 @@ void RTEMS_Malloc_Initialize(
       }
     }
 
-    if ( init_or_extend == _Heap_Initialize ) {
+    if ( init_or_extend == rtems_malloc_heap_initialize_handler ) {
       _Internal_error( INTERNAL_ERROR_NO_MEMORY_FOR_HEAP );
     }
   }
@@ -0,0 +1,374 @@
+/**
+ * @file
+ *
+ * @ingroup MallocSupport
+ *
+ * @brief Per-processor malloc cache implementation.
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef RTEMS_NEWLIB
+#include "malloc_p.h"
+
+#include <string.h>
+
+#include <rtems/score/apimutex.h>
+#include <rtems/score/chainimpl.h>
+#include <rtems/score/heapimpl.h>
+#include <rtems/score/isrlock.h>
+#include <rtems/score/percpudata.h>
+#include <rtems/score/smpimpl.h>
+#include <rtems/score/threaddispatch.h>
+
+#define MALLOC_CACHE_MAX_SIZE \
+  ( RTEMS_MALLOC_CACHE_CLASS_COUNT * RTEMS_MALLOC_CACHE_CLASS_SIZE )
+
+typedef struct {
+  uint32_t rounds;
+  void *objects[ RTEMS_MALLOC_CACHE_MAGAZINE_SIZE ];
+} Malloc_Cache_magazine;
+
+/*
+ * The magazines are addressed by index and not by pointer, since the initial
+ * per-processor data content is copied to the secondary processors.
+ */
+typedef struct {
+  uint32_t loaded;
+  uint32_t hits;
+  uint32_t misses;
+  uint32_t frees;
+  uint32_t refills;
+  uint32_t flushes;
+  Malloc_Cache_magazine magazines[ 2 ];
+} Malloc_Cache_class;
+
+typedef struct {
+  Malloc_Cache_class classes[ RTEMS_MALLOC_CACHE_CLASS_COUNT ];
+} Malloc_Cache;
+
+static PER_CPU_DATA_ITEM( Malloc_Cache, _Malloc_Cache );
+
+static Malloc_Cache_class *_Malloc_Cache_get_class(
+  const Per_CPU_Control *cpu,
+  size_t                 index
+)
+{
+  Malloc_Cache *cache;
+
+  cache = PER_CPU_DATA_GET( cpu, Malloc_Cache, _Malloc_Cache );
+  return &cache->classes[ index ];
+}
+
+static void *_Malloc_Cache_refill( size_t index )
+{
+  Heap_Control          *heap;
+  uintptr_t              size;
+  void                  *objects[ RTEMS_MALLOC_CACHE_MAGAZINE_SIZE ];
+  size_t                 count;
+  size_t                 i;
+  ISR_Level              level;
+  Malloc_Cache_class    *cache_class;
+  Malloc_Cache_magazine *loaded;
+
+  heap = RTEMS_Malloc_Heap;
+  size = ( index + 1 ) * RTEMS_MALLOC_CACHE_CLASS_SIZE;
+
+  _RTEMS_Lock_allocator();
+  _Malloc_Process_deferred_frees();
+
+  for ( count = 0; count < RTEMS_MALLOC_CACHE_MAGAZINE_SIZE; ++count ) {
+    objects[ count ] = _Heap_Allocate( heap, size );
+
+    if ( objects[ count ] == NULL ) {
+      break;
+    }
+  }
+
+  /*
+   * The first memory area is for the caller.  Put the others into the loaded
+   * magazine of the processor we execute on now.  This may be another
+   * processor, or another thread may have refilled it in the meantime, so
+   * there may be no room for all of them.
+   */
+  i = 1;
+
+  if ( count > 1 ) {
+    _ISR_Local_disable( level );
+    cache_class = _Malloc_Cache_get_class( _Per_CPU_Get(), index );
+    ++cache_class->refills;
+    loaded = &cache_class->magazines[ cache_class->loaded ];
+
+    while ( i < count && loaded->rounds < RTEMS_MALLOC_CACHE_MAGAZINE_SIZE ) {
+      loaded->objects[ loaded->rounds ] = objects[ i ];
+      ++loaded->rounds;
+      ++i;
+    }
+
+    _ISR_Local_enable( level );
+  }
+
+  while ( i < count ) {
+    _Heap_Free( heap, objects[ i ] );
+    ++i;
+  }
+
+  _RTEMS_Unlock_allocator();
+
+  return count > 0 ? objects[ 0 ] : NULL;
+}
+
+static void *_Malloc_Cache_allocate( size_t size )
+{
+  size_t                 index;
+  ISR_Level              level;
+  Malloc_Cache_class    *cache_class;
+  Malloc_Cache_magazine *loaded;
+  void                  *p;
+
+  if ( size == 0 || size > MALLOC_CACHE_MAX_SIZE ) {
+    return NULL;
+  }
+
+  index = ( size - 1 ) / RTEMS_MALLOC_CACHE_CLASS_SIZE;
+
+  _ISR_Local_disable( level );
+  cache_class = _Malloc_Cache_get_class( _Per_CPU_Get(), index );
+  loaded = &cache_class->magazines[ cache_class->loaded ];
+
+  if ( loaded->rounds == 0 ) {
+    cache_class->loaded ^= 1;
+    loaded = &cache_class->magazines[ cache_class->loaded ];
+  }
+
+  if ( loaded->rounds > 0 ) {
+    --loaded->rounds;
+    p = loaded->objects[ loaded->rounds ];
+    ++cache_class->hits;
+    _ISR_Local_enable( level );
+    return p;
+  }
+
+  ++cache_class->misses;
+  _ISR_Local_enable( level );
+
+  return _Malloc_Cache_refill( index );
+}
+
+static bool _Malloc_Cache_free( void *ptr )
+{
+  uintptr_t              size;
+  size_t                 index;
+  ISR_Level              level;
+  Malloc_Cache_class    *cache_class;
+  Malloc_Cache_magazine *loaded;
+  void                  *objects[ RTEMS_MALLOC_CACHE_MAGAZINE_SIZE ];
+  bool                   flush;
+  size_t                 i;
+
+  /*
+   * The caller owns the memory area, so its block size is stable and the size
+   * can be obtained without the allocator lock.  Invalid memory areas which
+   * are not detected here are reported once the magazine is flushed.
+   */
+  if ( !_Heap_Size_of_owned_alloc_area( RTEMS_Malloc_Heap, ptr, &size ) ) {
+    return false;
+  }
+
+  /*
+   * Use the size class which is guaranteed to fit into the memory area.
+   * Memory areas which are considerably larger than their size class are
+   * left to the heap.
+   */
+  index = size / RTEMS_MALLOC_CACHE_CLASS_SIZE;
+
+  if ( index == 0 || index > RTEMS_MALLOC_CACHE_CLASS_COUNT ) {
+    return false;
+  }
+
+  --index;
+  flush = false;
+
+  _ISR_Local_disable( level );
+  cache_class = _Malloc_Cache_get_class( _Per_CPU_Get(), index );
+  loaded = &cache_class->magazines[ cache_class->loaded ];
+
+  if ( loaded->rounds == RTEMS_MALLOC_CACHE_MAGAZINE_SIZE ) {
+    cache_class->loaded ^= 1;
+    loaded = &cache_class->magazines[ cache_class->loaded ];
+
+    if ( loaded->rounds == RTEMS_MALLOC_CACHE_MAGAZINE_SIZE ) {
+      memcpy( objects, loaded->objects, sizeof( objects ) );
+      loaded->rounds = 0;
+      ++cache_class->flushes;
+      flush = true;
+    }
+  }
+
+  loaded->objects[ loaded->rounds ] = ptr;
+  ++loaded->rounds;
+  ++cache_class->frees;
+  _ISR_Local_enable( level );
+
+  if ( flush ) {
+    _RTEMS_Lock_allocator();
+
+    for ( i = 0; i < RTEMS_MALLOC_CACHE_MAGAZINE_SIZE; ++i ) {
+      if ( !_Heap_Free( RTEMS_Malloc_Heap, objects[ i ] ) ) {
+        rtems_fatal(
+          RTEMS_FATAL_SOURCE_INVALID_HEAP_FREE,
+          (rtems_fatal_code) objects[ i ]
+        );
+      }
+    }
+
+    _RTEMS_Unlock_allocator();
+  }
+
+  return true;
+}
+
+ISR_LOCK_DEFINE( static, _Malloc_Cache_drain_lock, "Malloc Cache Drain" )
+
+/*
+ * The magazines of a processor are only protected by disabled interrupts on
+ * this processor, so each processor must drain its own magazines.  The
+ * memory areas are large enough to serve as chain nodes.
+ */
+static void _Malloc_Cache_drain_processor( void *arg )
+{
+  Chain_Control   *areas;
+  ISR_lock_Context lock_context;
+  Malloc_Cache    *cache;
+  size_t           index;
+  size_t           m;
+  uint32_t         i;
+
+  areas = arg;
+
+  _ISR_lock_ISR_disable_and_acquire( &_Malloc_Cache_drain_lock, &lock_context );
+  cache = PER_CPU_DATA_GET( _Per_CPU_Get(), Malloc_Cache, _Malloc_Cache );
+
+  for ( index = 0; index < RTEMS_MALLOC_CACHE_CLASS_COUNT; ++index ) {
+    Malloc_Cache_class *cache_class;
+
+    cache_class = &cache->classes[ index ];
+
+    for ( m = 0; m < RTEMS_ARRAY_SIZE( cache_class->magazines ); ++m ) {
+      Malloc_Cache_magazine *magazine;
+
+      magazine = &cache_class->magazines[ m ];
+
+      for ( i = 0; i < magazine->rounds; ++i ) {
+        Chain_Node *node;
+
+        node = magazine->objects[ i ];
+        _Chain_Initialize_node( node );
+        _Chain_Append_unprotected( areas, node );
+      }
+
+      if ( magazine->rounds > 0 ) {
+        magazine->rounds = 0;
+        ++cache_class->flushes;
+      }
+    }
+  }
+
+  _ISR_lock_Release_and_ISR_enable( &_Malloc_Cache_drain_lock, &lock_context );
+}
+
+static void _Malloc_Cache_flush( void )
+{
+  Chain_Control areas;
+  Chain_Node   *node;
+
+  _Chain_Initialize_empty( &areas );
+
+#if defined(RTEMS_SMP)
+  {
+    Per_CPU_Control *cpu_self;
+
+    cpu_self = _Thread_Dispatch_disable();
+    _SMP_Broadcast_action( _Malloc_Cache_drain_processor, &areas );
+    _Thread_Dispatch_enable( cpu_self );
+  }
+#else
+  _Malloc_Cache_drain_processor( &areas );
+#endif
+
+  while ( ( node = _Chain_Get_unprotected( &areas ) ) != NULL ) {
+    _Heap_Free( RTEMS_Malloc_Heap, node );
+  }
+}
+
+static void _Malloc_Cache_get_information( rtems_malloc_cache_info *info )
+{
+  uint32_t cpu_max;
+  uint32_t cpu_index;
+  size_t   index;
+
+  memset( info, 0, sizeof( *info ) );
+
+  for ( index = 0; index < RTEMS_MALLOC_CACHE_CLASS_COUNT; ++index ) {
+    info->classes[ index ].size =
+      ( index + 1 ) * RTEMS_MALLOC_CACHE_CLASS_SIZE;
+  }
+
+  cpu_max = _SMP_Get_processor_maximum();
+
+  for ( cpu_index = 0; cpu_index < cpu_max; ++cpu_index ) {
+    const Per_CPU_Control *cpu;
+
+    cpu = _Per_CPU_Get_by_index( cpu_index );
+
+    for ( index = 0; index < RTEMS_MALLOC_CACHE_CLASS_COUNT; ++index ) {
+      const Malloc_Cache_class      *cache_class;
+      rtems_malloc_cache_class_info *class_info;
+
+      cache_class = _Malloc_Cache_get_class( cpu, index );
+      class_info = &info->classes[ index ];
+      class_info->cached += cache_class->magazines[ 0 ].rounds
+        + cache_class->magazines[ 1 ].rounds;
+      class_info->hits += cache_class->hits;
+      class_info->misses += cache_class->misses;
+      class_info->frees += cache_class->frees;
+      class_info->refills += cache_class->refills;
+      class_info->flushes += cache_class->flushes;
+    }
+  }
+}
+
+const rtems_malloc_cache_handlers rtems_malloc_per_cpu_cache_handlers = {
+  .allocate = _Malloc_Cache_allocate,
+  .free = _Malloc_Cache_free,
+  .flush = _Malloc_Cache_flush,
+  .get_information = _Malloc_Cache_get_information
+};
+#endif
@@ -31,3 +31,14 @@ int malloc_info(
   _Protected_heap_Get_information( RTEMS_Malloc_Heap, the_info );
   return 0;
 }
+
+int malloc_cache_info(
+  rtems_malloc_cache_info *the_info
+)
+{
+  if ( !the_info || rtems_malloc_cache == NULL )
+    return -1;
+
+  ( *rtems_malloc_cache->get_information )( the_info );
+  return 0;
+}
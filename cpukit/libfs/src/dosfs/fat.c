@@ -23,9 +23,11 @@
 #include <stdint.h>
 
 #include <rtems/libio_.h>
+#include <rtems/dosfs.h>
 
 #include "fat.h"
 #include "fat_fat_operations.h"
+#include "fat_file.h"
 
 static int
  _fat_block_release(fat_fs_info_t *fs_info);
@@ -48,6 +50,31 @@ fat_cluster_num_to_block_num (const fat_fs_info_t *fs_info,
     return blk;
 }
 
+uint32_t rtems_dosfs_fat_cache_sectors = FAT_FAT_CACHE_DEFAULT_SECTORS;
+
+static int
+fat_buf_release_block(fat_fs_info_t *fs_info)
+{
+    rtems_status_code sc = RTEMS_SUCCESSFUL;
+
+    if (fs_info->c.state == FAT_CACHE_EMPTY)
+        return RC_OK;
+
+    if (fs_info->c.modified)
+    {
+        sc = rtems_bdbuf_release_modified(fs_info->c.buf);
+        fs_info->c.modified = 0;
+    }
+    else
+    {
+        sc = rtems_bdbuf_release(fs_info->c.buf);
+    }
+    fs_info->c.state = FAT_CACHE_EMPTY;
+    if (sc != RTEMS_SUCCESSFUL)
+        rtems_set_errno_and_return_minus_one(EIO);
+    return RC_OK;
+}
+
 int
 fat_buf_access(fat_fs_info_t   *fs_info,
                const uint32_t   sec_num,
@@ -63,7 +90,7 @@ fat_buf_access(fat_fs_info_t   *fs_info,
 
     if (fs_info->c.state == FAT_CACHE_EMPTY || fs_info->c.blk_num != sec_num)
     {
-        fat_buf_release(fs_info);
+        fat_buf_release_block(fs_info);
 
         if (op_type == FAT_OP_TYPE_READ)
             sc = rtems_bdbuf_read(fs_info->vol.dd, blk, &fs_info->c.buf);
@@ -79,76 +106,194 @@ fat_buf_access(fat_fs_info_t   *fs_info,
     return RC_OK;
 }
 
-int
-fat_buf_release(fat_fs_info_t *fs_info)
+/* fat_fat_cache_write --
+ *     Write a modified FAT sector cache entry to all FAT copies or only to
+ *     the active FAT if mirroring is disabled
+ *
+ * PARAMETERS:
+ *     fs_info  - FS info
+ *     entry    - the cache entry
+ *
+ * RETURNS:
+ *     RC_OK on success, or -1 if error occured
+ *     and errno set appropriately
+ */
+static int
+fat_fat_cache_write(fat_fs_info_t *fs_info, fat_fat_cache_entry_t *entry)
 {
-    rtems_status_code sc = RTEMS_SUCCESSFUL;
+    uint32_t fat_sec = entry->sec_num - fs_info->vol.afat_loc;
+    uint8_t  fats = fs_info->vol.mirror ? 1 : fs_info->vol.fats;
+    uint8_t  i;
 
-    if (fs_info->c.state == FAT_CACHE_EMPTY)
-        return RC_OK;
-
-    if (fs_info->c.modified)
+    for (i = 0; i < fats; i++)
     {
-        uint32_t sec_num = fs_info->c.blk_num;
-        bool     sec_of_fat = ((sec_num >= fs_info->vol.fat_loc) &&
-                              (sec_num < fs_info->vol.rdir_loc));
-        uint32_t blk = fat_sector_num_to_block_num(fs_info, sec_num);
-        uint32_t blk_ofs = fat_sector_offset_to_block_offset(fs_info,
-                                                             sec_num,
-                                                             0);
-
-        if (sec_of_fat && !fs_info->vol.mirror)
-            memcpy(fs_info->sec_buf,
-                   fs_info->c.buf->buffer + blk_ofs,
-                   fs_info->vol.bps);
+        rtems_status_code   sc;
+        rtems_bdbuf_buffer *bd;
+        uint32_t            sec_num;
+        uint32_t            blk;
+        uint32_t            blk_ofs;
+
+        if (fs_info->vol.mirror)
+            sec_num = entry->sec_num;
+        else
+            sec_num = fs_info->vol.fat_loc + fs_info->vol.fat_length * i +
+                      fat_sec;
 
-        sc = rtems_bdbuf_release_modified(fs_info->c.buf);
-        if (sc != RTEMS_SUCCESSFUL)
-            rtems_set_errno_and_return_minus_one(EIO);
-        fs_info->c.modified = 0;
+        blk = fat_sector_num_to_block_num(fs_info, sec_num);
+        blk_ofs = fat_sector_offset_to_block_offset(fs_info, sec_num, 0);
 
-        if (sec_of_fat && !fs_info->vol.mirror)
+        if (blk_ofs == 0
+            && fs_info->vol.bps == fs_info->vol.bytes_per_block)
         {
-            uint8_t i;
+            sc = rtems_bdbuf_get(fs_info->vol.dd, blk, &bd);
+        }
+        else
+        {
+            sc = rtems_bdbuf_read(fs_info->vol.dd, blk, &bd);
+        }
+        if (sc != RTEMS_SUCCESSFUL)
+            rtems_set_errno_and_return_minus_one(EIO);
+        memcpy(bd->buffer + blk_ofs, entry->buf, fs_info->vol.bps);
+        sc = rtems_bdbuf_release_modified(bd);
+        if (sc != RTEMS_SUCCESSFUL)
+            rtems_set_errno_and_return_minus_one(EIO);
+    }
 
-            for (i = 1; i < fs_info->vol.fats; i++)
-            {
-                rtems_bdbuf_buffer *bd;
+    entry->modified = false;
+    return RC_OK;
+}
 
-                sec_num = fs_info->c.blk_num + fs_info->vol.fat_length * i,
-                blk = fat_sector_num_to_block_num(fs_info, sec_num);
-                blk_ofs = fat_sector_offset_to_block_offset(fs_info,
-                                                            sec_num,
-                                                            0);
+/* fat_fat_cache_access --
+ *     Provide the cached copy of a sector of the active FAT.  The sector
+ *     becomes the most recently used cache entry, so that it can be marked
+ *     as modified with fat_fat_cache_mark_modified().
+ *
+ * PARAMETERS:
+ *     fs_info  - FS info
+ *     sec_num  - sector number of the active FAT
+ *     sec_buf  - pointer to the sector copy
+ *
+ * RETURNS:
+ *     RC_OK on success, or -1 if error occured
+ *     and errno set appropriately
+ */
+int
+fat_fat_cache_access(fat_fs_info_t  *fs_info,
+                     uint32_t        sec_num,
+                     uint8_t       **sec_buf)
+{
+    fat_fat_cache_t       *cache = &fs_info->fat_cache;
+    fat_fat_cache_entry_t *entry;
+    rtems_status_code      sc;
+    rtems_bdbuf_buffer    *bd;
+    uint32_t               blk_ofs;
+    uint32_t               i;
+    int                    rc;
+
+    entry = &cache->entries[cache->last];
+    if (entry->sec_num == sec_num)
+    {
+        *sec_buf = entry->buf;
+        return RC_OK;
+    }
 
-                if (blk_ofs == 0
-                    && fs_info->vol.bps == fs_info->vol.bytes_per_block)
-                {
-                    sc = rtems_bdbuf_get(fs_info->vol.dd, blk, &bd);
-                }
-                else
-                {
-                    sc = rtems_bdbuf_read(fs_info->vol.dd, blk, &bd);
-                }
-                if ( sc != RTEMS_SUCCESSFUL)
-                    rtems_set_errno_and_return_minus_one(ENOMEM);
-                memcpy(bd->buffer + blk_ofs, fs_info->sec_buf, fs_info->vol.bps);
-                sc = rtems_bdbuf_release_modified(bd);
-                if ( sc != RTEMS_SUCCESSFUL)
-                    rtems_set_errno_and_return_minus_one(ENOMEM);
-            }
+    for (i = 0; i < cache->count; i++)
+    {
+        entry = &cache->entries[i];
+        if (entry->sec_num == sec_num)
+        {
+            cache->last = i;
+            *sec_buf = entry->buf;
+            return RC_OK;
         }
     }
-    else
+
+    /*
+     * The FAT sector may share a block with the sector currently held by the
+     * block cache, so release it before the block device buffers are used.
+     */
+    rc = fat_buf_release_block(fs_info);
+    if (rc != RC_OK)
+        return rc;
+
+    i = cache->victim;
+    if (i == cache->last && cache->count > 1)
+        i = (i + 1) % cache->count;
+    cache->victim = (i + 1) % cache->count;
+
+    entry = &cache->entries[i];
+    if (entry->modified)
     {
-        sc = rtems_bdbuf_release(fs_info->c.buf);
-        if (sc != RTEMS_SUCCESSFUL)
-            rtems_set_errno_and_return_minus_one(EIO);
+        rc = fat_fat_cache_write(fs_info, entry);
+        if (rc != RC_OK)
+            return rc;
     }
-    fs_info->c.state = FAT_CACHE_EMPTY;
+
+    entry->sec_num = FAT_UNDEFINED_VALUE;
+    blk_ofs = fat_sector_offset_to_block_offset(fs_info, sec_num, 0);
+    sc = rtems_bdbuf_read(fs_info->vol.dd,
+                          fat_sector_num_to_block_num(fs_info, sec_num),
+                          &bd);
+    if (sc != RTEMS_SUCCESSFUL)
+        rtems_set_errno_and_return_minus_one(EIO);
+    memcpy(entry->buf, bd->buffer + blk_ofs, fs_info->vol.bps);
+    sc = rtems_bdbuf_release(bd);
+    if (sc != RTEMS_SUCCESSFUL)
+        rtems_set_errno_and_return_minus_one(EIO);
+
+    entry->sec_num = sec_num;
+    cache->last = i;
+    *sec_buf = entry->buf;
     return RC_OK;
 }
 
+/* fat_fat_cache_flush --
+ *     Write all modified FAT sector cache entries
+ *
+ * PARAMETERS:
+ *     fs_info  - FS info
+ *
+ * RETURNS:
+ *     RC_OK on success, or -1 if error occured
+ *     and errno set appropriately
+ */
+static int
+fat_fat_cache_flush(fat_fs_info_t *fs_info)
+{
+    fat_fat_cache_t *cache = &fs_info->fat_cache;
+    int              rc = RC_OK;
+    uint32_t         i;
+
+    for (i = 0; i < cache->count; i++)
+    {
+        fat_fat_cache_entry_t *entry = &cache->entries[i];
+
+        if (entry->modified)
+        {
+            int rc1 = fat_fat_cache_write(fs_info, entry);
+
+            if (rc1 != RC_OK)
+                rc = rc1;
+        }
+    }
+
+    return rc;
+}
+
+int
+fat_buf_release(fat_fs_info_t *fs_info)
+{
+    int rc;
+    int rc1;
+
+    rc = fat_buf_release_block(fs_info);
+    rc1 = fat_fat_cache_flush(fs_info);
+    if (rc != RC_OK)
+        return rc;
+
+    return rc1;
+}
+
 /* _fat_block_read --
  *     This function reads 'count' bytes from device filesystem is mounted on,
  *     starts at 'start+offset' position where 'start' computed in sectors
@@ -747,6 +892,32 @@ fat_init_volume_info(fat_fs_info_t *fs_info, const char *device)
         rtems_set_errno_and_return_minus_one( ENOMEM );
     }
 
+    fs_info->fat_cache.count = MAX(rtems_dosfs_fat_cache_sectors, 1);
+    fs_info->fat_cache.last = 0;
+    fs_info->fat_cache.victim = 0;
+    fs_info->fat_cache.entries = calloc(fs_info->fat_cache.count,
+                                        sizeof(fat_fat_cache_entry_t) +
+                                        vol->bps);
+    if (fs_info->fat_cache.entries == NULL)
+    {
+        close(vol->fd);
+        free(fs_info->vhash);
+        free(fs_info->rhash);
+        free(fs_info->uino);
+        free(fs_info->sec_buf);
+        rtems_set_errno_and_return_minus_one( ENOMEM );
+    }
+    for (i = 0; i < (int) fs_info->fat_cache.count; i++)
+    {
+        fat_fat_cache_entry_t *entry = &fs_info->fat_cache.entries[i];
+
+        entry->sec_num = FAT_UNDEFINED_VALUE;
+        entry->modified = false;
+        entry->buf = (uint8_t *)(fs_info->fat_cache.entries +
+                                 fs_info->fat_cache.count) + i * vol->bps;
+    }
+    fs_info->free_map = NULL;
+
     /*
      * If possible we will use the cluster size as bdbuf block size for faster
      * file access. This requires that certain sectors are aligned to cluster
@@ -862,7 +1033,12 @@ fat_shutdown_drive(fat_fs_info_t *fs_info)
         rtems_chain_control *the_chain = fs_info->vhash + i;
 
         while ( (node = rtems_chain_get_unprotected(the_chain)) != NULL )
-            free(node);
+        {
+            fat_file_fd_t *fat_fd = (fat_file_fd_t *) node;
+
+            free(fat_fd->map.extents);
+            free(fat_fd);
+        }
     }
 
     for (i = 0; i < FAT_HASH_SIZE; i++)
@@ -871,7 +1047,12 @@ fat_shutdown_drive(fat_fs_info_t *fs_info)
         rtems_chain_control *the_chain = fs_info->rhash + i;
 
         while ( (node = rtems_chain_get_unprotected(the_chain)) != NULL )
-            free(node);
+        {
+            fat_file_fd_t *fat_fd = (fat_file_fd_t *) node;
+
+            free(fat_fd->map.extents);
+            free(fat_fd);
+        }
     }
 
     free(fs_info->vhash);
@@ -879,6 +1060,8 @@ fat_shutdown_drive(fat_fs_info_t *fs_info)
 
     free(fs_info->uino);
     free(fs_info->sec_buf);
+    free(fs_info->fat_cache.entries);
+    free(fs_info->free_map);
     close(fs_info->vol.fd);
 
     if (rc)
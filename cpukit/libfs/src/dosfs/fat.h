@@ -344,6 +344,25 @@ typedef struct fat_cache_s
     rtems_bdbuf_buffer *buf;
 } fat_cache_t;
 
+/*
+ * The FAT sector cache holds copies of sectors of the active FAT.  Modified
+ * sectors are written to all FAT copies at once in fat_buf_release().
+ */
+typedef struct fat_fat_cache_entry_s
+{
+    uint32_t            sec_num;       /* sector number or FAT_UNDEFINED_VALUE */
+    bool                modified;
+    uint8_t            *buf;
+} fat_fat_cache_entry_t;
+
+typedef struct fat_fat_cache_s
+{
+    fat_fat_cache_entry_t *entries;
+    uint32_t               count;      /* count of cache entries */
+    uint32_t               last;       /* most recently used entry */
+    uint32_t               victim;     /* next entry to replace */
+} fat_fat_cache_t;
+
 /*
  * This structure identifies the instance of the filesystem on the FAT
  * ("fat-file") level.
@@ -358,6 +377,9 @@ typedef struct fat_fs_info_s
     uint32_t             uino_pool_size; /* size */
     uint32_t             uino_base;
     fat_cache_t          c;             /* cache */
+    fat_fat_cache_t      fat_cache;     /* FAT sector cache */
+    uint32_t            *free_map;      /* bitmap of used data clusters or
+                                           NULL if not yet built */
     uint8_t             *sec_buf; /* just placeholder for anything */
 } fat_fs_info_t;
 
@@ -404,6 +426,12 @@ typedef struct fat_dir_pos_s
 #define FAT_CACHE_EMPTY   0x0
 #define FAT_CACHE_ACTUAL  0x1
 
+/* default count of FAT sectors in the FAT sector cache */
+#define FAT_FAT_CACHE_DEFAULT_SECTORS  16
+
+/* default maximum size in bytes of the free cluster bitmap */
+#define FAT_FREE_MAP_DEFAULT_MAX_SIZE  UINT32_MAX
+
 #define FAT_OP_TYPE_READ  0x1
 #define FAT_OP_TYPE_GET   0x2
 
@@ -492,6 +520,17 @@ fat_buf_access(fat_fs_info_t  *fs_info,
 int
 fat_buf_release(fat_fs_info_t *fs_info);
 
+int
+fat_fat_cache_access(fat_fs_info_t  *fs_info,
+                     uint32_t        sec_num,
+                     uint8_t       **sec_buf);
+
+static inline void
+fat_fat_cache_mark_modified(fat_fs_info_t *fs_info)
+{
+    fs_info->fat_cache.entries[fs_info->fat_cache.last].modified = true;
+}
+
 ssize_t
 _fat_block_read(fat_fs_info_t                        *fs_info,
                 uint32_t                              start,
@@ -20,12 +20,183 @@
 #include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 #include <rtems/libio_.h>
 
+#include <rtems/dosfs.h>
+
 #include "fat.h"
 #include "fat_fat_operations.h"
 
+#define FAT_FREE_MAP_BITS 32
+
+uint32_t rtems_dosfs_fat_free_map_max_size = FAT_FREE_MAP_DEFAULT_MAX_SIZE;
+
+static inline bool
+fat_free_map_is_used(const fat_fs_info_t *fs_info, uint32_t cln)
+{
+    uint32_t bit = cln - FAT_RSRVD_CLN;
+
+    return (fs_info->free_map[bit / FAT_FREE_MAP_BITS] &
+            (UINT32_C(1) << (bit % FAT_FREE_MAP_BITS))) != 0;
+}
+
+static inline void
+fat_free_map_set(fat_fs_info_t *fs_info, uint32_t cln, bool used)
+{
+    uint32_t bit = cln - FAT_RSRVD_CLN;
+    uint32_t mask = UINT32_C(1) << (bit % FAT_FREE_MAP_BITS);
+
+    if (used)
+        fs_info->free_map[bit / FAT_FREE_MAP_BITS] |= mask;
+    else
+        fs_info->free_map[bit / FAT_FREE_MAP_BITS] &= ~mask;
+}
+
+/* fat_free_map_build --
+ *     Build the bitmap of used data clusters from the active FAT.  This is
+ *     done once on the first allocation of the volume.  The free cluster
+ *     count of the volume is exact afterwards.  The bitmap is not built if
+ *     its size exceeds rtems_dosfs_fat_free_map_max_size, this is no error.
+ *
+ * PARAMETERS:
+ *     fs_info  - FS info
+ *
+ * RETURNS:
+ *     RC_OK on success, or -1 if error occured (errno set appropriately)
+ */
+static int
+fat_free_map_build(fat_fs_info_t *fs_info)
+{
+    uint32_t  data_cls = fs_info->vol.data_cls;
+    uint32_t  words = (data_cls + FAT_FREE_MAP_BITS - 1) / FAT_FREE_MAP_BITS;
+    uint32_t  free_cls = 0;
+    uint32_t  cln;
+    uint32_t  bit;
+
+    /* Without the bitmap the caller scans the FAT */
+    if (words > rtems_dosfs_fat_free_map_max_size / sizeof(*fs_info->free_map))
+        return RC_OK;
+
+    fs_info->free_map = calloc(words, sizeof(*fs_info->free_map));
+    if (fs_info->free_map == NULL)
+        rtems_set_errno_and_return_minus_one(ENOMEM);
+
+    for (cln = FAT_RSRVD_CLN; cln < data_cls + FAT_RSRVD_CLN; cln++)
+    {
+        uint32_t next_cln;
+        int      rc;
+
+        rc = fat_get_fat_cluster(fs_info, cln, &next_cln);
+        if (rc != RC_OK)
+        {
+            free(fs_info->free_map);
+            fs_info->free_map = NULL;
+            return rc;
+        }
+
+        if (next_cln == FAT_GENFAT_FREE)
+            ++free_cls;
+        else
+            fat_free_map_set(fs_info, cln, true);
+    }
+
+    /* The bits past the last data cluster are never free */
+    for (bit = data_cls; bit < words * FAT_FREE_MAP_BITS; bit++)
+        fs_info->free_map[bit / FAT_FREE_MAP_BITS] |=
+            UINT32_C(1) << (bit % FAT_FREE_MAP_BITS);
+
+    fs_info->vol.free_cls = free_cls;
+    return RC_OK;
+}
+
+/* fat_free_map_find_free --
+ *     Find the first free cluster greater than or equal to 'cln'
+ *
+ * RETURNS:
+ *     The free cluster number, or data_cls + 2 if there is no free cluster
+ *     up to the end of the volume
+ */
+static uint32_t
+fat_free_map_find_free(const fat_fs_info_t *fs_info, uint32_t cln)
+{
+    uint32_t end = fs_info->vol.data_cls + FAT_RSRVD_CLN;
+    uint32_t bit = cln - FAT_RSRVD_CLN;
+    uint32_t words = (fs_info->vol.data_cls + FAT_FREE_MAP_BITS - 1) /
+                     FAT_FREE_MAP_BITS;
+    uint32_t w = bit / FAT_FREE_MAP_BITS;
+    uint32_t used;
+
+    if (cln >= end)
+        return end;
+
+    /* Mark the bits below the start as used */
+    used = fs_info->free_map[w] |
+           ((UINT32_C(1) << (bit % FAT_FREE_MAP_BITS)) - 1);
+
+    while (used == UINT32_MAX)
+    {
+        ++w;
+        if (w >= words)
+            return end;
+
+        used = fs_info->free_map[w];
+    }
+
+    bit = w * FAT_FREE_MAP_BITS + (uint32_t) __builtin_ctz(~used);
+    return MIN(bit + FAT_RSRVD_CLN, end);
+}
+
+/* fat_free_map_find_run --
+ *     Find a run of 'count' contiguous free clusters which starts in the
+ *     range from 'cln' up to the end of the volume
+ *
+ * RETURNS:
+ *     The first cluster number of the run, or data_cls + 2 if there is no
+ *     such run
+ */
+static uint32_t
+fat_free_map_find_run(const fat_fs_info_t *fs_info,
+                      uint32_t             cln,
+                      uint32_t             count)
+{
+    uint32_t end = fs_info->vol.data_cls + FAT_RSRVD_CLN;
+
+    while (true)
+    {
+        uint32_t first = fat_free_map_find_free(fs_info, cln);
+        uint32_t run;
+
+        if (first >= end || end - first < count)
+            return end;
+
+        cln = first + 1;
+        run = 1;
+        while (run < count && !fat_free_map_is_used(fs_info, cln))
+        {
+            uint32_t bit = cln - FAT_RSRVD_CLN;
+
+            /* Skip completely free words */
+            if (bit % FAT_FREE_MAP_BITS == 0
+                && count - run >= FAT_FREE_MAP_BITS
+                && fs_info->free_map[bit / FAT_FREE_MAP_BITS] == 0)
+            {
+                cln += FAT_FREE_MAP_BITS;
+                run += FAT_FREE_MAP_BITS;
+            }
+            else
+            {
+                ++cln;
+                ++run;
+            }
+        }
+
+        if (run >= count)
+            return first;
+    }
+}
+
 /* fat_scan_fat_for_free_clusters --
  *     Allocate chain of free clusters from Files Allocation Table
  *
@@ -62,6 +233,28 @@ fat_scan_fat_for_free_clusters(
 
     *cls_added = 0;
 
+    /*
+     * Build the bitmap of used clusters on demand.  In case this fails, use
+     * the linear scan of the FAT.
+     */
+    if (fs_info->free_map == NULL)
+        (void) fat_free_map_build(fs_info);
+
+    /*
+     * Prefer a contiguous run of free clusters to keep the new chain
+     * unfragmented
+     */
+    if (fs_info->free_map != NULL && count > 1)
+    {
+        uint32_t run = fat_free_map_find_run(fs_info, cl4find, count);
+
+        if (run >= data_cls_val)
+            run = fat_free_map_find_run(fs_info, 2, count);
+
+        if (run < data_cls_val)
+            cl4find = run;
+    }
+
     /*
      * fs_info->vol.data_cls is exactly the count of data clusters
      * starting at cluster 2, so the maximum valid cluster number is
@@ -71,12 +264,30 @@ fat_scan_fat_for_free_clusters(
     {
         uint32_t next_cln = 0;
 
-        rc = fat_get_fat_cluster(fs_info, cl4find, &next_cln);
-        if ( rc != RC_OK )
+        if (fs_info->free_map != NULL)
         {
-            if (*cls_added != 0)
-                fat_free_fat_clusters_chain(fs_info, (*chain));
-            return rc;
+            uint32_t free_cln = fat_free_map_find_free(fs_info, cl4find);
+
+            i += free_cln - cl4find;
+            if (free_cln >= data_cls_val)
+            {
+                cl4find = 2;
+                continue;
+            }
+
+            cl4find = free_cln;
+            if (i >= data_cls_val)
+                break;
+        }
+        else
+        {
+            rc = fat_get_fat_cluster(fs_info, cl4find, &next_cln);
+            if ( rc != RC_OK )
+            {
+                if (*cls_added != 0)
+                    fat_free_fat_clusters_chain(fs_info, (*chain));
+                return rc;
+            }
         }
 
         if (next_cln == FAT_GENFAT_FREE)
@@ -247,7 +458,7 @@ fat_get_fat_cluster(
           fs_info->vol.afat_loc;
     ofs = FAT_FAT_OFFSET(fs_info->vol.type, cln) & (fs_info->vol.bps - 1);
 
-    rc = fat_buf_access(fs_info, sec, FAT_OP_TYPE_READ, &sec_buf);
+    rc = fat_fat_cache_access(fs_info, sec, &sec_buf);
     if (rc != RC_OK)
         return rc;
 
@@ -261,8 +472,7 @@ fat_get_fat_cluster(
             *ret_val = (*(sec_buf + ofs));
             if ( ofs == (fs_info->vol.bps - 1) )
             {
-                rc = fat_buf_access(fs_info, sec + 1, FAT_OP_TYPE_READ,
-                                    &sec_buf);
+                rc = fat_fat_cache_access(fs_info, sec + 1, &sec_buf);
                 if (rc != RC_OK)
                     return rc;
 
@@ -332,7 +542,7 @@ fat_set_fat_cluster(
           fs_info->vol.afat_loc;
     ofs = FAT_FAT_OFFSET(fs_info->vol.type, cln) & (fs_info->vol.bps - 1);
 
-    rc = fat_buf_access(fs_info, sec, FAT_OP_TYPE_READ, &sec_buf);
+    rc = fat_fat_cache_access(fs_info, sec, &sec_buf);
     if (rc != RC_OK)
         return rc;
 
@@ -346,12 +556,11 @@ fat_set_fat_cluster(
 
                 *(sec_buf + ofs) |= (uint8_t)(fat16_clv & 0x00F0);
 
-                fat_buf_mark_modified(fs_info);
+                fat_fat_cache_mark_modified(fs_info);
 
                 if ( ofs == (fs_info->vol.bps - 1) )
                 {
-                    rc = fat_buf_access(fs_info, sec + 1, FAT_OP_TYPE_READ,
-                                        &sec_buf);
+                    rc = fat_fat_cache_access(fs_info, sec + 1, &sec_buf);
                     if (rc != RC_OK)
                         return rc;
 
@@ -359,7 +568,7 @@ fat_set_fat_cluster(
 
                      *sec_buf |= (uint8_t)((fat16_clv & 0xFF00)>>8);
 
-                     fat_buf_mark_modified(fs_info);
+                     fat_fat_cache_mark_modified(fs_info);
                 }
                 else
                 {
@@ -375,12 +584,11 @@ fat_set_fat_cluster(
 
                 *(sec_buf + ofs) |= (uint8_t)(fat16_clv & 0x00FF);
 
-                fat_buf_mark_modified(fs_info);
+                fat_fat_cache_mark_modified(fs_info);
 
                 if ( ofs == (fs_info->vol.bps - 1) )
                 {
-                    rc = fat_buf_access(fs_info, sec + 1, FAT_OP_TYPE_READ,
-                                        &sec_buf);
+                    rc = fat_fat_cache_access(fs_info, sec + 1, &sec_buf);
                     if (rc != RC_OK)
                         return rc;
 
@@ -388,7 +596,7 @@ fat_set_fat_cluster(
 
                     *sec_buf |= (uint8_t)((fat16_clv & 0xFF00)>>8);
 
-                    fat_buf_mark_modified(fs_info);
+                    fat_fat_cache_mark_modified(fs_info);
                 }
                 else
                 {
@@ -402,7 +610,7 @@ fat_set_fat_cluster(
         case FAT_FAT16:
             *((uint16_t   *)(sec_buf + ofs)) =
                     (uint16_t  )(CT_LE_W(in_val));
-            fat_buf_mark_modified(fs_info);
+            fat_fat_cache_mark_modified(fs_info);
             break;
 
         case FAT_FAT32:
@@ -412,7 +620,7 @@ fat_set_fat_cluster(
 
             *((uint32_t *)(sec_buf + ofs)) |= fat32_clv;
 
-            fat_buf_mark_modified(fs_info);
+            fat_fat_cache_mark_modified(fs_info);
             break;
 
         default:
@@ -421,5 +629,8 @@ fat_set_fat_cluster(
 
     }
 
+    if (fs_info->free_map != NULL)
+        fat_free_map_set(fs_info, cln, in_val != FAT_GENFAT_FREE);
+
     return RC_OK;
 }
@@ -28,6 +28,7 @@
 #include <time.h>
 
 #include <rtems/libio_.h>
+#include <rtems/dosfs.h>
 
 #include "fat.h"
 #include "fat_fat_operations.h"
@@ -58,6 +59,11 @@ fat_file_lseek(
     uint32_t                              *disk_cln
 );
 
+static void
+fat_file_extent_trim(fat_file_fd_t *fat_fd, uint32_t file_cln);
+
+uint32_t rtems_dosfs_extent_cache_size = FAT_FILE_EXTENT_CACHE_DEFAULT_SIZE;
+
 /* fat_file_open --
  *     Open fat-file. Two hash tables are accessed by key
  *     constructed from cluster num and offset of the node (i.e.
@@ -103,6 +109,11 @@ fat_file_open(
     {
         /* return pointer to fat_file_descriptor allocated before */
         (*fat_fd) = lfat_fd;
+
+        /* the upper level sets up the map of an unused descriptor again */
+        if (lfat_fd->links_num == 0)
+            fat_file_extent_trim(lfat_fd, 0);
+
         lfat_fd->links_num++;
         return rc;
     }
@@ -241,6 +252,7 @@ fat_file_close(
                 if (fat_ino_is_unique(fs_info, fat_fd->ino))
                     fat_free_unique_ino(fs_info, fat_fd->ino);
 
+                free(fat_fd->map.extents);
                 free(fat_fd);
             }
         }
@@ -253,6 +265,7 @@ fat_file_close(
             else
             {
                 _hash_delete(fs_info->vhash, key, fat_fd->ino, fat_fd);
+                free(fat_fd->map.extents);
                 free(fat_fd);
             }
         }
@@ -755,6 +768,8 @@ fat_file_truncate(
     if (rc != RC_OK)
         return rc;
 
+    fat_file_extent_trim(fat_fd, cl_start);
+
     rc = fat_free_fat_clusters_chain(fs_info, cur_cln);
     if (rc != RC_OK)
         return rc;
@@ -1002,6 +1017,186 @@ _hash_search(
     return -1;
 }
 
+/* fat_file_extent_find --
+ *     Find the last cached extent which starts at or before 'file_cln'
+ *
+ * RETURNS:
+ *     the index of the extent, or -1 if there is no such extent
+ */
+static int
+fat_file_extent_find(const fat_file_fd_t *fat_fd, uint32_t file_cln)
+{
+    int lo = 0;
+    int hi = (int) fat_fd->map.extent_count - 1;
+
+    while (lo <= hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+
+        if (fat_fd->map.extents[mid].file_cln <= file_cln)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+
+    return hi;
+}
+
+/* fat_file_extent_add --
+ *     Add a run of contiguous clusters to the extent cache.  The run must
+ *     not overlap with cached extents which start after it.  Runs which
+ *     continue an extent are merged into it.  If the cache is full, then
+ *     the shortest extent is replaced.
+ *
+ * PARAMETERS:
+ *     fat_fd   - fat-file descriptor
+ *     file_cln - first cluster number of the run in the fat-file
+ *     disk_cln - first cluster number of the run on the volume
+ *     count    - count of clusters in the run
+ *
+ * RETURNS:
+ *     None
+ */
+static void
+fat_file_extent_add(
+    fat_file_fd_t                         *fat_fd,
+    uint32_t                               file_cln,
+    uint32_t                               disk_cln,
+    uint32_t                               count
+    )
+{
+    fat_file_map_t    *map = &fat_fd->map;
+    fat_file_extent_t *ext;
+    int                i;
+
+    if (map->extents == NULL)
+    {
+        if (rtems_dosfs_extent_cache_size == 0)
+            return;
+
+        map->extents = malloc(rtems_dosfs_extent_cache_size *
+                              sizeof(*map->extents));
+        if (map->extents == NULL)
+            return;
+
+        map->extent_capacity = rtems_dosfs_extent_cache_size;
+        map->extent_count = 0;
+    }
+
+    i = fat_file_extent_find(fat_fd, file_cln);
+    if (i >= 0)
+    {
+        uint32_t end;
+
+        ext = &map->extents[i];
+        end = ext->file_cln + ext->count;
+
+        /* skip the clusters already covered by the preceding extent */
+        if (end > file_cln)
+        {
+            uint32_t skip = end - file_cln;
+
+            if (skip >= count)
+                return;
+
+            file_cln += skip;
+            disk_cln += skip;
+            count -= skip;
+        }
+
+        if (end == file_cln && ext->disk_cln + ext->count == disk_cln)
+        {
+            ext->count += count;
+            return;
+        }
+    }
+
+    ++i;
+
+    if (map->extent_count == map->extent_capacity)
+    {
+        uint32_t victim = 0;
+        uint32_t j;
+
+        for (j = 1; j < map->extent_count; ++j)
+        {
+            if (map->extents[j].count < map->extents[victim].count)
+                victim = j;
+        }
+
+        if (map->extents[victim].count > count)
+            return;
+
+        memmove(&map->extents[victim], &map->extents[victim + 1],
+                (map->extent_count - victim - 1) * sizeof(*map->extents));
+        --map->extent_count;
+
+        if ((int) victim < i)
+            --i;
+    }
+
+    memmove(&map->extents[i + 1], &map->extents[i],
+            (map->extent_count - i) * sizeof(*map->extents));
+    ext = &map->extents[i];
+    ext->file_cln = file_cln;
+    ext->disk_cln = disk_cln;
+    ext->count = count;
+    ++map->extent_count;
+}
+
+/* fat_file_extent_trim --
+ *     Remove all clusters starting with 'file_cln' from the extent cache
+ *
+ * PARAMETERS:
+ *     fat_fd   - fat-file descriptor
+ *     file_cln - first cluster number in the fat-file to remove
+ *
+ * RETURNS:
+ *     None
+ */
+static void
+fat_file_extent_trim(fat_file_fd_t *fat_fd, uint32_t file_cln)
+{
+    fat_file_map_t *map = &fat_fd->map;
+    int             i;
+
+    i = fat_file_extent_find(fat_fd, file_cln);
+    if (i >= 0)
+    {
+        fat_file_extent_t *ext = &map->extents[i];
+
+        if (ext->file_cln == file_cln)
+        {
+            map->extent_count = (uint32_t) i;
+        }
+        else
+        {
+            ext->count = MIN(ext->count, file_cln - ext->file_cln);
+            map->extent_count = (uint32_t) i + 1;
+        }
+    }
+    else
+    {
+        map->extent_count = 0;
+    }
+}
+
+/* fat_file_lseek --
+ *     Map the cluster number 'file_cln' of the fat-file to the cluster
+ *     number on the volume.  The cluster chain is followed from the nearest
+ *     known cluster which is either the last mapped cluster or the end of a
+ *     cached extent.  Runs of contiguous clusters found on the way are added
+ *     to the extent cache.
+ *
+ * PARAMETERS:
+ *     fs_info  - FS info
+ *     fat_fd   - fat-file descriptor
+ *     file_cln - cluster number in the fat-file
+ *     disk_cln - placeholder for the cluster number on the volume
+ *
+ * RETURNS:
+ *     RC_OK on success, or -1 if error occured (errno set appropriately)
+ */
 static off_t
 fat_file_lseek(
     fat_fs_info_t                         *fs_info,
@@ -1016,29 +1211,70 @@ fat_file_lseek(
         *disk_cln = fat_fd->map.disk_cln;
     else
     {
-        uint32_t   cur_cln;
-        uint32_t   count;
-        uint32_t   i;
-
-        if (file_cln > fat_fd->map.file_cln)
+        uint32_t   cur_file_cln = 0;
+        uint32_t   cur_cln = fat_fd->cln;
+        uint32_t   run_file_cln;
+        uint32_t   run_disk_cln;
+        uint32_t   run_count;
+        int        i;
+
+        i = fat_file_extent_find(fat_fd, file_cln);
+        if (i >= 0)
         {
-            cur_cln = fat_fd->map.disk_cln;
-            count = file_cln - fat_fd->map.file_cln;
+            const fat_file_extent_t *ext = &fat_fd->map.extents[i];
+            uint32_t                 n = file_cln - ext->file_cln;
+
+            if (n < ext->count)
+            {
+                fat_fd->map.file_cln = file_cln;
+                fat_fd->map.disk_cln = ext->disk_cln + n;
+
+                *disk_cln = fat_fd->map.disk_cln;
+                return RC_OK;
+            }
+
+            cur_file_cln = ext->file_cln + ext->count - 1;
+            cur_cln = ext->disk_cln + ext->count - 1;
         }
-        else
+
+        if (file_cln > fat_fd->map.file_cln &&
+            fat_fd->map.file_cln > cur_file_cln)
         {
-            cur_cln = fat_fd->cln;
-            count = file_cln;
+            cur_file_cln = fat_fd->map.file_cln;
+            cur_cln = fat_fd->map.disk_cln;
         }
 
         /* skip over the clusters */
-        for (i = 0; i < count; i++)
+        run_file_cln = cur_file_cln;
+        run_disk_cln = cur_cln;
+        run_count = 1;
+        while (cur_file_cln < file_cln)
         {
-            rc = fat_get_fat_cluster(fs_info, cur_cln, &cur_cln);
+            uint32_t next_cln;
+
+            rc = fat_get_fat_cluster(fs_info, cur_cln, &next_cln);
             if ( rc != RC_OK )
                 return rc;
+
+            ++cur_file_cln;
+            if (next_cln == cur_cln + 1)
+            {
+                ++run_count;
+            }
+            else
+            {
+                fat_file_extent_add(fat_fd, run_file_cln, run_disk_cln,
+                                    run_count);
+                run_file_cln = cur_file_cln;
+                run_disk_cln = next_cln;
+                run_count = 1;
+            }
+
+            cur_cln = next_cln;
         }
 
+        fat_file_extent_add(fat_fd, run_file_cln, run_disk_cln, run_count);
+
         /* update cache */
         fat_fd->map.file_cln = file_cln;
         fat_fd->map.disk_cln = cur_cln;
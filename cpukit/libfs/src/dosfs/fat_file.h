@@ -58,13 +58,30 @@ typedef enum {
  * Such interface hides the architecture of fat-file and represents it like
  * linear file
  */
-typedef struct fat_file_map_s
+/*
+ * Run of clusters which are contiguous in the fat-file and on the volume
+ */
+typedef struct fat_file_extent_s
 {
     uint32_t   file_cln;
     uint32_t   disk_cln;
-    uint32_t   last_cln;
+    uint32_t   count;
+} fat_file_extent_t;
+
+typedef struct fat_file_map_s
+{
+    uint32_t           file_cln;
+    uint32_t           disk_cln;
+    uint32_t           last_cln;
+    fat_file_extent_t *extents;         /* known extents ordered by file_cln,
+                                           NULL if not yet allocated */
+    uint32_t           extent_count;
+    uint32_t           extent_capacity;
 } fat_file_map_t;
 
+/* default count of extents cached per fat-file */
+#define FAT_FILE_EXTENT_CACHE_DEFAULT_SIZE 32
+
 /**
  * @brief Descriptor of a fat-file.
  *
@@ -41,6 +41,45 @@ extern "C" {
 
 #define MSDOS_NAME_NOT_FOUND_ERR  0x7D01
 
+/*
+ * Default count of entries of the directory entry lookup cache, see also
+ * rtems_dosfs_name_cache_size.
+ */
+#define MSDOS_NAME_CACHE_DEFAULT_SIZE 128
+
+/*
+ * Maximum length of a name in the compare form which is kept in the directory
+ * entry lookup cache.  Longer names are not cached.
+ */
+#define MSDOS_NAME_CACHE_NAME_SIZE    48
+
+/*
+ * Result of a name lookup in a directory.  Entries which are in use are on a
+ * hash chain.  All entries are on the LRU chain, unused entries first.
+ */
+typedef struct msdos_name_cache_entry_s
+{
+    rtems_chain_node     hash_node;
+    rtems_chain_node     lru_node;
+    uint32_t             dir_cln;     /* first cluster of the directory */
+    uint32_t             hash;
+    uint8_t              name_type;
+    uint8_t              name_len;
+    bool                 found;       /* false for a negative entry */
+    fat_dir_pos_t        dir_pos;     /* valid only if found is true */
+    uint8_t              name[MSDOS_NAME_CACHE_NAME_SIZE];
+} msdos_name_cache_entry_t;
+
+typedef struct msdos_name_cache_s
+{
+    msdos_name_cache_entry_t *entries;
+    rtems_chain_control      *hash;
+    uint32_t                  hash_mask;
+    uint32_t                  count;
+    uint32_t                  negative_count;
+    rtems_chain_control       lru;
+} msdos_name_cache_t;
+
 /*
  * This structure identifies the instance of the filesystem on the MSDOS
  * level.
@@ -70,6 +109,11 @@ typedef struct msdos_fs_info_s
                                                             */
 
     rtems_dosfs_convert_control      *converter;
+
+    msdos_name_cache_t                name_cache;          /*
+                                                            * directory entry
+                                                            * lookup cache
+                                                            */
 } msdos_fs_info_t;
 
 RTEMS_INLINE_ROUTINE void msdos_fs_lock(msdos_fs_info_t *fs_info)
@@ -487,6 +531,45 @@ int msdos_sync(rtems_libio_t *iop);
 
 uint8_t msdos_lfn_checksum(const void *entry);
 
+int msdos_name_cache_init(msdos_fs_info_t *fs_info);
+
+void msdos_name_cache_destroy(msdos_fs_info_t *fs_info);
+
+bool msdos_name_cache_lookup(
+    msdos_fs_info_t   *fs_info,
+    uint32_t           dir_cln,
+    msdos_name_type_t  name_type,
+    const uint8_t     *name,
+    size_t             name_len,
+    bool              *found,
+    fat_dir_pos_t     *dir_pos
+);
+
+void msdos_name_cache_insert(
+    msdos_fs_info_t     *fs_info,
+    uint32_t             dir_cln,
+    msdos_name_type_t    name_type,
+    const uint8_t       *name,
+    size_t               name_len,
+    bool                 found,
+    const fat_dir_pos_t *dir_pos
+);
+
+void msdos_name_cache_remove(
+    msdos_fs_info_t     *fs_info,
+    const fat_dir_pos_t *dir_pos
+);
+
+void msdos_name_cache_remove_negative(
+    msdos_fs_info_t *fs_info,
+    uint32_t         dir_cln
+);
+
+void msdos_name_cache_remove_dir(
+    msdos_fs_info_t *fs_info,
+    uint32_t         dir_cln
+);
+
 #ifdef __cplusplus
 }
 #endif
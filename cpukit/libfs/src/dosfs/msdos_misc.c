@@ -892,6 +892,8 @@ msdos_set_first_char4file_name(
     if (dir_pos->lname.cln == FAT_FILE_SHORT_NAME)
       start = dir_pos->sname;
 
+    msdos_name_cache_remove(fs_info, dir_pos);
+
     /*
      * We handle the changes directly due the way the short file
      * name code was written rather than use the fat_file_write
@@ -1835,6 +1837,41 @@ msdos_add_file (
         rtems_set_errno_and_return_minus_one(EIO);
 }
 
+/* msdos_read_cached_dir_entry --
+ *     Read the short file name entry of a directory entry found in the
+ *     directory entry lookup cache.  The entry is read from the volume, so
+ *     that the size, first cluster and times are up to date.
+ *
+ * RETURNS:
+ *     RC_OK on success, MSDOS_NAME_NOT_FOUND_ERR if the entry is no longer in
+ *     use, or -1 if error occured (errno set apropriately)
+ */
+static int
+msdos_read_cached_dir_entry (
+    msdos_fs_info_t     *fs_info,
+    const fat_dir_pos_t *dir_pos,
+    char                *name_dir_entry)
+{
+    ssize_t  ret;
+    uint32_t sec = (fat_cluster_num_to_sector_num(&fs_info->fat,
+                                                  dir_pos->sname.cln) +
+                    (dir_pos->sname.ofs >> fs_info->fat.vol.sec_log2));
+    uint32_t byte = (dir_pos->sname.ofs & (fs_info->fat.vol.bps - 1));
+
+    ret = _fat_block_read(&fs_info->fat, sec, byte,
+                          MSDOS_DIRECTORY_ENTRY_STRUCT_SIZE, name_dir_entry);
+    if (ret < 0)
+        return -1;
+
+    if ((*MSDOS_DIR_ENTRY_TYPE(name_dir_entry) ==
+         MSDOS_THIS_DIR_ENTRY_EMPTY) ||
+        (*MSDOS_DIR_ENTRY_TYPE(name_dir_entry) ==
+         MSDOS_THIS_DIR_ENTRY_AND_REST_EMPTY))
+        return MSDOS_NAME_NOT_FOUND_ERR;
+
+    return RC_OK;
+}
+
 int
 msdos_find_name_in_fat_file (
     rtems_filesystem_mount_table_entry_t *mt_entry,
@@ -1912,6 +1949,33 @@ msdos_find_name_in_fat_file (
             retval = -1;
         break;
     }
+    if (retval == RC_OK && !create_node) {
+      bool found;
+
+      if (msdos_name_cache_lookup (
+          fs_info,
+          fat_fd->cln,
+          name_type,
+          buffer,
+          name_len_for_compare,
+          &found,
+          dir_pos)) {
+          if (!found)
+              return MSDOS_NAME_NOT_FOUND_ERR;
+
+          retval = msdos_read_cached_dir_entry (
+              fs_info,
+              dir_pos,
+              name_dir_entry);
+          if (retval != MSDOS_NAME_NOT_FOUND_ERR)
+              return retval;
+
+          /* Stale entry, search the directory */
+          msdos_name_cache_remove(fs_info, dir_pos);
+          fat_dir_pos_init(dir_pos);
+          retval = RC_OK;
+      }
+    }
     if (retval == RC_OK) {
       /* See if the file/directory does already exist */
       retval = msdos_find_file_in_directory (
@@ -1928,6 +1992,17 @@ msdos_find_name_in_fat_file (
           dir_pos,
           &empty_file_offset,
           &empty_entry_count);
+
+      if (!create_node &&
+          (retval == RC_OK || retval == MSDOS_NAME_NOT_FOUND_ERR))
+          msdos_name_cache_insert (
+              fs_info,
+              fat_fd->cln,
+              name_type,
+              buffer,
+              name_len_for_compare,
+              retval == RC_OK,
+              dir_pos);
     }
     /* Create a non-existing file/directory if requested */
     if (   retval == RC_OK
@@ -1966,7 +2041,8 @@ msdos_find_name_in_fat_file (
           break;
         }
 
-        if (retval == RC_OK)
+        if (retval == RC_OK) {
+            msdos_name_cache_remove_negative(fs_info, fat_fd->cln);
             retval = msdos_add_file (
                 buffer,
                 name_type,
@@ -1979,6 +2055,7 @@ msdos_find_name_in_fat_file (
                 empty_file_offset,
                 empty_entry_count
             );
+        }
     }
 
     return retval;
@@ -0,0 +1,405 @@
+/**
+ * @file
+ *
+ * @ingroup libfs_msdos
+ *
+ * @brief Directory Entry Lookup Cache
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <rtems/dosfs.h>
+
+#include "fat.h"
+#include "fat_file.h"
+
+#include "msdos.h"
+
+uint32_t rtems_dosfs_name_cache_size = MSDOS_NAME_CACHE_DEFAULT_SIZE;
+
+static uint32_t
+msdos_name_cache_hash(
+    uint32_t           dir_cln,
+    msdos_name_type_t  name_type,
+    const uint8_t     *name,
+    size_t             name_len
+)
+{
+    uint32_t hash = 2166136261U;
+    size_t   i;
+
+    hash = (hash ^ dir_cln) * 16777619U;
+    hash = (hash ^ (uint32_t) name_type) * 16777619U;
+
+    for (i = 0; i < name_len; ++i)
+        hash = (hash ^ name[i]) * 16777619U;
+
+    return hash;
+}
+
+static bool
+msdos_name_cache_is_used(const msdos_name_cache_entry_t *entry)
+{
+    return !rtems_chain_is_node_off_chain(&entry->hash_node);
+}
+
+static void
+msdos_name_cache_release(
+    msdos_name_cache_t       *cache,
+    msdos_name_cache_entry_t *entry
+)
+{
+    if (!entry->found)
+        --cache->negative_count;
+
+    rtems_chain_extract_unprotected(&entry->hash_node);
+    rtems_chain_set_off_chain(&entry->hash_node);
+
+    /* Reuse released entries first */
+    rtems_chain_extract_unprotected(&entry->lru_node);
+    rtems_chain_prepend_unprotected(&cache->lru, &entry->lru_node);
+}
+
+static msdos_name_cache_entry_t *
+msdos_name_cache_find(
+    msdos_name_cache_t *cache,
+    uint32_t            hash,
+    uint32_t            dir_cln,
+    msdos_name_type_t   name_type,
+    const uint8_t      *name,
+    size_t              name_len
+)
+{
+    rtems_chain_control *bucket = &cache->hash[hash & cache->hash_mask];
+    rtems_chain_node    *node = rtems_chain_first(bucket);
+
+    while (!rtems_chain_is_tail(bucket, node))
+    {
+        msdos_name_cache_entry_t *entry =
+            RTEMS_CONTAINER_OF(node, msdos_name_cache_entry_t, hash_node);
+
+        if (entry->hash == hash &&
+            entry->dir_cln == dir_cln &&
+            entry->name_type == name_type &&
+            entry->name_len == name_len &&
+            memcmp(entry->name, name, name_len) == 0)
+            return entry;
+
+        node = rtems_chain_next(node);
+    }
+
+    return NULL;
+}
+
+/* msdos_name_cache_init --
+ *     Allocate the directory entry lookup cache of the volume.  The count of
+ *     entries is given by rtems_dosfs_name_cache_size, a value of zero
+ *     disables the cache.
+ *
+ * PARAMETERS:
+ *     fs_info - MSDOS-specific mount table entry information
+ *
+ * RETURNS:
+ *     RC_OK on success, or -1 if error occured (errno set apropriately)
+ */
+int
+msdos_name_cache_init(msdos_fs_info_t *fs_info)
+{
+    msdos_name_cache_t *cache = &fs_info->name_cache;
+    uint32_t            count = rtems_dosfs_name_cache_size;
+    uint32_t            hash_size;
+    uint32_t            i;
+
+    memset(cache, 0, sizeof(*cache));
+    rtems_chain_initialize_empty(&cache->lru);
+
+    if (count == 0)
+        return RC_OK;
+
+    hash_size = 1;
+    while (hash_size < count)
+        hash_size <<= 1;
+
+    cache->entries = calloc(count, sizeof(*cache->entries));
+    cache->hash = calloc(hash_size, sizeof(*cache->hash));
+    if (cache->entries == NULL || cache->hash == NULL)
+    {
+        free(cache->entries);
+        free(cache->hash);
+        cache->entries = NULL;
+        cache->hash = NULL;
+        rtems_set_errno_and_return_minus_one(ENOMEM);
+    }
+
+    cache->count = count;
+    cache->hash_mask = hash_size - 1;
+
+    for (i = 0; i < hash_size; ++i)
+        rtems_chain_initialize_empty(&cache->hash[i]);
+
+    for (i = 0; i < count; ++i)
+    {
+        msdos_name_cache_entry_t *entry = &cache->entries[i];
+
+        rtems_chain_set_off_chain(&entry->hash_node);
+        rtems_chain_append_unprotected(&cache->lru, &entry->lru_node);
+    }
+
+    return RC_OK;
+}
+
+/* msdos_name_cache_destroy --
+ *     Free the directory entry lookup cache of the volume.
+ *
+ * PARAMETERS:
+ *     fs_info - MSDOS-specific mount table entry information
+ */
+void
+msdos_name_cache_destroy(msdos_fs_info_t *fs_info)
+{
+    msdos_name_cache_t *cache = &fs_info->name_cache;
+
+    free(cache->entries);
+    free(cache->hash);
+    cache->entries = NULL;
+    cache->hash = NULL;
+    cache->count = 0;
+}
+
+/* msdos_name_cache_lookup --
+ *     Look up the result of a previous search for a name in a directory.
+ *
+ * PARAMETERS:
+ *     fs_info   - MSDOS-specific mount table entry information
+ *     dir_cln   - first cluster of the directory
+ *     name_type - type of the name
+ *     name      - name in the compare form
+ *     name_len  - length of the name in the compare form
+ *     found     - placeholder for the search result, false for a name which
+ *                 does not exist in the directory
+ *     dir_pos   - placeholder for the position of the directory entry
+ *
+ * RETURNS:
+ *     true if the cache contains the name, otherwise false
+ */
+bool
+msdos_name_cache_lookup(
+    msdos_fs_info_t   *fs_info,
+    uint32_t           dir_cln,
+    msdos_name_type_t  name_type,
+    const uint8_t     *name,
+    size_t             name_len,
+    bool              *found,
+    fat_dir_pos_t     *dir_pos
+)
+{
+    msdos_name_cache_t       *cache = &fs_info->name_cache;
+    msdos_name_cache_entry_t *entry;
+    uint32_t                  hash;
+
+    if (cache->count == 0 || name_len > MSDOS_NAME_CACHE_NAME_SIZE)
+        return false;
+
+    hash = msdos_name_cache_hash(dir_cln, name_type, name, name_len);
+    entry = msdos_name_cache_find(cache, hash, dir_cln, name_type, name,
+                                  name_len);
+    if (entry == NULL)
+        return false;
+
+    rtems_chain_extract_unprotected(&entry->lru_node);
+    rtems_chain_append_unprotected(&cache->lru, &entry->lru_node);
+
+    *found = entry->found;
+    if (entry->found)
+        *dir_pos = entry->dir_pos;
+
+    return true;
+}
+
+/* msdos_name_cache_insert --
+ *     Record the result of a search for a name in a directory.  The least
+ *     recently used entry is replaced if the cache is full.
+ *
+ * PARAMETERS:
+ *     fs_info   - MSDOS-specific mount table entry information
+ *     dir_cln   - first cluster of the directory
+ *     name_type - type of the name
+ *     name      - name in the compare form
+ *     name_len  - length of the name in the compare form
+ *     found     - search result, false for a name which does not exist in
+ *                 the directory
+ *     dir_pos   - position of the directory entry, used only if found is
+ *                 true
+ */
+void
+msdos_name_cache_insert(
+    msdos_fs_info_t     *fs_info,
+    uint32_t             dir_cln,
+    msdos_name_type_t    name_type,
+    const uint8_t       *name,
+    size_t               name_len,
+    bool                 found,
+    const fat_dir_pos_t *dir_pos
+)
+{
+    msdos_name_cache_t       *cache = &fs_info->name_cache;
+    msdos_name_cache_entry_t *entry;
+    uint32_t                  hash;
+
+    if (cache->count == 0 || name_len > MSDOS_NAME_CACHE_NAME_SIZE)
+        return;
+
+    hash = msdos_name_cache_hash(dir_cln, name_type, name, name_len);
+    entry = msdos_name_cache_find(cache, hash, dir_cln, name_type, name,
+                                  name_len);
+    if (entry == NULL)
+    {
+        entry = RTEMS_CONTAINER_OF(rtems_chain_first(&cache->lru),
+                                   msdos_name_cache_entry_t, lru_node);
+        if (msdos_name_cache_is_used(entry))
+            msdos_name_cache_release(cache, entry);
+
+        entry->hash = hash;
+        entry->dir_cln = dir_cln;
+        entry->name_type = (uint8_t) name_type;
+        entry->name_len = (uint8_t) name_len;
+        memcpy(entry->name, name, name_len);
+
+        /* Counted as a positive entry until the result is set below */
+        entry->found = true;
+        rtems_chain_append_unprotected(&cache->hash[hash & cache->hash_mask],
+                                       &entry->hash_node);
+    }
+
+    if (entry->found != found)
+    {
+        if (found)
+            --cache->negative_count;
+        else
+            ++cache->negative_count;
+    }
+
+    entry->found = found;
+    if (found)
+        entry->dir_pos = *dir_pos;
+    else
+        fat_dir_pos_init(&entry->dir_pos);
+
+    rtems_chain_extract_unprotected(&entry->lru_node);
+    rtems_chain_append_unprotected(&cache->lru, &entry->lru_node);
+}
+
+/* msdos_name_cache_remove --
+ *     Remove all cached names which refer to a directory entry.  This must be
+ *     called if the directory entry is removed or renamed.
+ *
+ * PARAMETERS:
+ *     fs_info - MSDOS-specific mount table entry information
+ *     dir_pos - position of the directory entry
+ */
+void
+msdos_name_cache_remove(
+    msdos_fs_info_t     *fs_info,
+    const fat_dir_pos_t *dir_pos
+)
+{
+    msdos_name_cache_t *cache = &fs_info->name_cache;
+    uint32_t            i;
+
+    for (i = 0; i < cache->count; ++i)
+    {
+        msdos_name_cache_entry_t *entry = &cache->entries[i];
+
+        if (msdos_name_cache_is_used(entry) &&
+            entry->found &&
+            entry->dir_pos.sname.cln == dir_pos->sname.cln &&
+            entry->dir_pos.sname.ofs == dir_pos->sname.ofs)
+            msdos_name_cache_release(cache, entry);
+    }
+}
+
+/* msdos_name_cache_remove_negative --
+ *     Remove all cached names of a directory which do not exist.  This must
+ *     be called before an entry is added to the directory.  Adding an entry
+ *     with a long name adds also a generated short name.
+ *
+ * PARAMETERS:
+ *     fs_info - MSDOS-specific mount table entry information
+ *     dir_cln - first cluster of the directory
+ */
+void
+msdos_name_cache_remove_negative(
+    msdos_fs_info_t *fs_info,
+    uint32_t         dir_cln
+)
+{
+    msdos_name_cache_t *cache = &fs_info->name_cache;
+    uint32_t            i;
+
+    for (i = 0; i < cache->count && cache->negative_count > 0; ++i)
+    {
+        msdos_name_cache_entry_t *entry = &cache->entries[i];
+
+        if (msdos_name_cache_is_used(entry) &&
+            !entry->found &&
+            entry->dir_cln == dir_cln)
+            msdos_name_cache_release(cache, entry);
+    }
+}
+
+/* msdos_name_cache_remove_dir --
+ *     Remove all cached names of a directory.  This must be called if the
+ *     directory is removed, since its first cluster may be reused.
+ *
+ * PARAMETERS:
+ *     fs_info - MSDOS-specific mount table entry information
+ *     dir_cln - first cluster of the directory
+ */
+void
+msdos_name_cache_remove_dir(
+    msdos_fs_info_t *fs_info,
+    uint32_t         dir_cln
+)
+{
+    msdos_name_cache_t *cache = &fs_info->name_cache;
+    uint32_t            i;
+
+    for (i = 0; i < cache->count; ++i)
+    {
+        msdos_name_cache_entry_t *entry = &cache->entries[i];
+
+        if (msdos_name_cache_is_used(entry) && entry->dir_cln == dir_cln)
+            msdos_name_cache_release(cache, entry);
+    }
+}
@@ -69,6 +69,10 @@ msdos_rmnod(const rtems_filesystem_location_info_t *parent_pathloc,
         return rc;
     }
 
+    /* the clusters of a removed directory may be reused */
+    if (fat_fd->fat_file_type == FAT_DIRECTORY)
+        msdos_name_cache_remove_dir(fs_info, fat_fd->cln);
+
     fat_file_mark_removed(&fs_info->fat, fat_fd);
 
     return rc;
@@ -19,6 +19,82 @@
 
 #include <rtems/imfs.h>
 
+#include <string.h>
+
+typedef struct {
+  const char *name;
+  size_t      namelen;
+} IMFS_directory_key;
+
+#define IMFS_DIRECTORY_INDEX_NODE_TO_JNODE( node ) \
+  RTEMS_CONTAINER_OF( node, IMFS_jnode_t, Index_node )
+
+/*
+ *  The index order is by name length first and then by name.  This is cheaper
+ *  than a lexicographical order and the order is irrelevant for readdir().
+ */
+static int IMFS_directory_compare(
+  const IMFS_directory_key *key,
+  const IMFS_jnode_t       *entry
+)
+{
+  if ( key->namelen != entry->namelen ) {
+    return key->namelen < entry->namelen ? -1 : 1;
+  }
+
+  return memcmp( key->name, entry->name, key->namelen );
+}
+
+static bool IMFS_directory_index_equal(
+  const void        *key,
+  const RBTree_Node *node
+)
+{
+  return IMFS_directory_compare(
+    key,
+    IMFS_DIRECTORY_INDEX_NODE_TO_JNODE( node )
+  ) == 0;
+}
+
+static bool IMFS_directory_index_less(
+  const void        *key,
+  const RBTree_Node *node
+)
+{
+  return IMFS_directory_compare(
+    key,
+    IMFS_DIRECTORY_INDEX_NODE_TO_JNODE( node )
+  ) < 0;
+}
+
+static void *IMFS_directory_index_map( RBTree_Node *node )
+{
+  return IMFS_DIRECTORY_INDEX_NODE_TO_JNODE( node );
+}
+
+static void IMFS_directory_index_insert(
+  IMFS_directory_t *dir,
+  IMFS_jnode_t     *entry
+)
+{
+  IMFS_directory_key key;
+
+  key.name = entry->name;
+  key.namelen = entry->namelen;
+  _RBTree_Initialize_node( &entry->Index_node );
+  _RBTree_Insert_inline(
+    &dir->Index,
+    &entry->Index_node,
+    &key,
+    IMFS_directory_index_less
+  );
+}
+
+static bool IMFS_directory_is_indexed( const IMFS_directory_t *dir )
+{
+  return !_RBTree_Is_empty( &dir->Index );
+}
+
 IMFS_jnode_t *IMFS_node_initialize_directory(
   IMFS_jnode_t *node,
   void *arg
@@ -27,10 +103,90 @@ IMFS_jnode_t *IMFS_node_initialize_directory(
   IMFS_directory_t *dir = (IMFS_directory_t *) node;
 
   rtems_chain_initialize_empty( &dir->Entries );
+  _RBTree_Initialize_empty( &dir->Index );
+  dir->entry_count = 0;
 
   return node;
 }
 
+void IMFS_add_to_directory(
+  IMFS_jnode_t *dir_node,
+  IMFS_jnode_t *entry_node
+)
+{
+  IMFS_directory_t *dir = (IMFS_directory_t *) dir_node;
+
+  entry_node->Parent = dir_node;
+  rtems_chain_append_unprotected( &dir->Entries, &entry_node->Node );
+  ++dir->entry_count;
+
+  if ( IMFS_directory_is_indexed( dir ) ) {
+    IMFS_directory_index_insert( dir, entry_node );
+  } else if ( dir->entry_count > IMFS_DIRECTORY_INDEX_THRESHOLD ) {
+    rtems_chain_node *current = rtems_chain_first( &dir->Entries );
+    rtems_chain_node *tail = rtems_chain_tail( &dir->Entries );
+
+    while ( current != tail ) {
+      IMFS_directory_index_insert( dir, (IMFS_jnode_t *) current );
+      current = rtems_chain_next( current );
+    }
+  }
+}
+
+void IMFS_remove_from_directory( IMFS_jnode_t *node )
+{
+  IMFS_directory_t *dir;
+
+  IMFS_assert( node->Parent != NULL );
+  dir = (IMFS_directory_t *) node->Parent;
+  node->Parent = NULL;
+  rtems_chain_extract_unprotected( &node->Node );
+  --dir->entry_count;
+
+  if ( IMFS_directory_is_indexed( dir ) ) {
+    _RBTree_Extract( &dir->Index, &node->Index_node );
+  }
+}
+
+IMFS_jnode_t *IMFS_find_in_directory(
+  const IMFS_directory_t *dir,
+  const char             *name,
+  size_t                  namelen
+)
+{
+  IMFS_directory_key key;
+
+  key.name = name;
+  key.namelen = namelen;
+
+  if ( IMFS_directory_is_indexed( dir ) ) {
+    return _RBTree_Find_inline(
+      &dir->Index,
+      &key,
+      IMFS_directory_index_equal,
+      IMFS_directory_index_less,
+      IMFS_directory_index_map
+    );
+  } else {
+    const rtems_chain_node *current = rtems_chain_immutable_first(
+      &dir->Entries
+    );
+    const rtems_chain_node *tail = rtems_chain_immutable_tail( &dir->Entries );
+
+    while ( current != tail ) {
+      IMFS_jnode_t *entry = (IMFS_jnode_t *) current;
+
+      if ( IMFS_directory_compare( &key, entry ) == 0 ) {
+        return entry;
+      }
+
+      current = rtems_chain_immutable_next( current );
+    }
+
+    return NULL;
+  }
+}
+
 static bool IMFS_is_mount_point( const IMFS_directory_t *dir )
 {
   return dir->mt_fs != NULL;
@@ -0,0 +1,396 @@
+/**
+ * @file
+ *
+ * @ingroup IMFS
+ *
+ * @brief IMFS Extent File Handlers
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/imfs.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ *  Minimum size of an extent allocated by a write beyond the capacity of the
+ *  file.  The ftruncate() preallocation uses the exact size.
+ */
+#define IMFS_EXTFILE_MINIMUM_EXTENT_SIZE 512
+
+typedef struct IMFS_extent {
+  struct IMFS_extent *next;
+  off_t               offset;
+  size_t              size;
+  unsigned char       data[ RTEMS_ZERO_LENGTH_ARRAY ];
+} IMFS_extent;
+
+static IMFS_extent *IMFS_extfile_find(
+  const IMFS_extfile_t *file,
+  off_t                 offset
+)
+{
+  IMFS_extent *extent = file->extents;
+
+  while (
+    extent != NULL
+      && offset >= extent->offset + (off_t) extent->size
+  ) {
+    extent = extent->next;
+  }
+
+  return extent;
+}
+
+static IMFS_extent *IMFS_extfile_allocate_extent( size_t size )
+{
+  if ( size > SIZE_MAX - sizeof( IMFS_extent ) ) {
+    return NULL;
+  }
+
+  return calloc( 1, sizeof( IMFS_extent ) + size );
+}
+
+/*
+ *  Ensures that the capacity of the file is at least the new capacity.  The
+ *  memory of new extents is zero-filled.  In case the exact size is not
+ *  requested, then the capacity grows geometrically.
+ */
+static int IMFS_extfile_reserve(
+  IMFS_extfile_t *file,
+  off_t           new_capacity,
+  bool            exact
+)
+{
+  IMFS_extent *extent;
+  size_t       size;
+
+  if ( new_capacity <= file->capacity ) {
+    return 0;
+  }
+
+  if ( (uintmax_t) new_capacity > SIZE_MAX ) {
+    rtems_set_errno_and_return_minus_one( EFBIG );
+  }
+
+  size = (size_t) ( new_capacity - file->capacity );
+  extent = NULL;
+
+  if ( !exact ) {
+    size_t grow_size = (size_t) file->capacity;
+
+    if ( grow_size < IMFS_EXTFILE_MINIMUM_EXTENT_SIZE ) {
+      grow_size = IMFS_EXTFILE_MINIMUM_EXTENT_SIZE;
+    }
+
+    if ( grow_size > size ) {
+      extent = IMFS_extfile_allocate_extent( grow_size );
+
+      if ( extent != NULL ) {
+        size = grow_size;
+      }
+    }
+  }
+
+  if ( extent == NULL ) {
+    extent = IMFS_extfile_allocate_extent( size );
+
+    if ( extent == NULL ) {
+      rtems_set_errno_and_return_minus_one( ENOSPC );
+    }
+  }
+
+  extent->offset = file->capacity;
+  extent->size = size;
+
+  if ( file->last != NULL ) {
+    file->last->next = extent;
+  } else {
+    file->extents = extent;
+  }
+
+  file->last = extent;
+  file->capacity += (off_t) size;
+
+  return 0;
+}
+
+/*
+ *  Copies the source data to the file area starting at the specified offset.
+ *  In case the source is NULL, then the area is zero-filled.  The area must be
+ *  within the capacity of the file.
+ */
+static void IMFS_extfile_copy_in(
+  IMFS_extfile_t      *file,
+  off_t                start,
+  const unsigned char *source,
+  size_t               count
+)
+{
+  IMFS_extent *extent = IMFS_extfile_find( file, start );
+
+  while ( count > 0 ) {
+    size_t skip = (size_t) ( start - extent->offset );
+    size_t n = extent->size - skip;
+
+    if ( n > count ) {
+      n = count;
+    }
+
+    if ( source != NULL ) {
+      memcpy( &extent->data[ skip ], source, n );
+      source += n;
+    } else {
+      memset( &extent->data[ skip ], 0, n );
+    }
+
+    start += (off_t) n;
+    count -= n;
+    extent = extent->next;
+  }
+}
+
+static void IMFS_extfile_copy_out(
+  const IMFS_extfile_t *file,
+  off_t                 start,
+  unsigned char        *destination,
+  size_t                count
+)
+{
+  const IMFS_extent *extent = IMFS_extfile_find( file, start );
+
+  while ( count > 0 ) {
+    size_t skip = (size_t) ( start - extent->offset );
+    size_t n = extent->size - skip;
+
+    if ( n > count ) {
+      n = count;
+    }
+
+    memcpy( destination, &extent->data[ skip ], n );
+    destination += n;
+    start += (off_t) n;
+    count -= n;
+    extent = extent->next;
+  }
+}
+
+/*
+ *  Zero-fills the file area from the current file size up to the end.  Only
+ *  memory below the old capacity may contain stale data from a previous
+ *  truncation, new extents are already zero-filled.
+ */
+static void IMFS_extfile_zero_fill(
+  IMFS_extfile_t *file,
+  off_t           end,
+  off_t           old_capacity
+)
+{
+  off_t start = (off_t) file->File.size;
+
+  if ( end > old_capacity ) {
+    end = old_capacity;
+  }
+
+  if ( start < end ) {
+    IMFS_extfile_copy_in( file, start, NULL, (size_t) ( end - start ) );
+  }
+}
+
+static ssize_t IMFS_extfile_read(
+  rtems_libio_t *iop,
+  void          *buffer,
+  size_t         count
+)
+{
+  IMFS_extfile_t *file = IMFS_iop_to_extfile( iop );
+  off_t           start = iop->offset;
+  off_t           size = (off_t) file->File.size;
+
+  if ( start >= size ) {
+    count = 0;
+  } else if ( (off_t) count > size - start ) {
+    count = (size_t) ( size - start );
+  }
+
+  IMFS_extfile_copy_out( file, start, buffer, count );
+  iop->offset = start + (off_t) count;
+  IMFS_update_atime( &file->File.Node );
+
+  return (ssize_t) count;
+}
+
+static ssize_t IMFS_extfile_write(
+  rtems_libio_t *iop,
+  const void    *buffer,
+  size_t         count
+)
+{
+  IMFS_extfile_t *file = IMFS_iop_to_extfile( iop );
+  off_t           old_capacity = file->capacity;
+  off_t           start;
+  off_t           end;
+  int             rv;
+
+  if ( count == 0 ) {
+    return 0;
+  }
+
+  if ( rtems_libio_iop_is_append( iop ) ) {
+    iop->offset = (off_t) file->File.size;
+  }
+
+  start = iop->offset;
+  end = start + (off_t) count;
+
+  rv = IMFS_extfile_reserve( file, end, false );
+  if ( rv != 0 ) {
+    return rv;
+  }
+
+  IMFS_extfile_zero_fill( file, start, old_capacity );
+  IMFS_extfile_copy_in( file, start, buffer, count );
+
+  if ( end > (off_t) file->File.size ) {
+    file->File.size = (size_t) end;
+  }
+
+  iop->offset = end;
+  IMFS_mtime_ctime_update( &file->File.Node );
+
+  return (ssize_t) count;
+}
+
+static int IMFS_extfile_ftruncate(
+  rtems_libio_t *iop,
+  off_t          length
+)
+{
+  IMFS_extfile_t *file = IMFS_iop_to_extfile( iop );
+
+  /*
+   *  An extend operation preallocates exactly the missing capacity, so that a
+   *  file prepared by ftruncate() can be mapped as a whole.  The capacity is
+   *  never reduced, see also memfile_ftruncate().
+   */
+  if ( length > (off_t) file->File.size ) {
+    off_t old_capacity = file->capacity;
+    int   rv;
+
+    rv = IMFS_extfile_reserve( file, length, true );
+    if ( rv != 0 ) {
+      return rv;
+    }
+
+    IMFS_extfile_zero_fill( file, length, old_capacity );
+  }
+
+  file->File.size = (size_t) length;
+  IMFS_mtime_ctime_update( &file->File.Node );
+
+  return 0;
+}
+
+/*
+ *  Shared mappings are served directly from the extent memory.  This requires
+ *  that the mapped area is contained in one extent.  The mmap() support takes
+ *  a node reference for each shared mapping and releases it in munmap(), so
+ *  the extents stay valid after the file is closed or unlinked.
+ */
+static int IMFS_extfile_mmap(
+  rtems_libio_t *iop,
+  void         **addr,
+  size_t         len,
+  int            prot,
+  off_t          off
+)
+{
+  IMFS_extfile_t *file = IMFS_iop_to_extfile( iop );
+  IMFS_extent    *extent = IMFS_extfile_find( file, off );
+
+  if (
+    extent == NULL
+      || off + (off_t) len > extent->offset + (off_t) extent->size
+  ) {
+    rtems_set_errno_and_return_minus_one( ENOTSUP );
+  }
+
+  *addr = &extent->data[ off - extent->offset ];
+  IMFS_update_atime( &file->File.Node );
+
+  return 0;
+}
+
+static void IMFS_extfile_destroy( IMFS_jnode_t *node )
+{
+  IMFS_extfile_t *file = (IMFS_extfile_t *) node;
+  IMFS_extent    *extent = file->extents;
+
+  while ( extent != NULL ) {
+    IMFS_extent *next = extent->next;
+
+    free( extent );
+    extent = next;
+  }
+
+  IMFS_node_destroy_default( node );
+}
+
+static const rtems_filesystem_file_handlers_r IMFS_extfile_handlers = {
+  .open_h = rtems_filesystem_default_open,
+  .close_h = rtems_filesystem_default_close,
+  .read_h = IMFS_extfile_read,
+  .write_h = IMFS_extfile_write,
+  .ioctl_h = rtems_filesystem_default_ioctl,
+  .lseek_h = rtems_filesystem_default_lseek_file,
+  .fstat_h = IMFS_stat_file,
+  .ftruncate_h = IMFS_extfile_ftruncate,
+  .fsync_h = rtems_filesystem_default_fsync_or_fdatasync_success,
+  .fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync_success,
+  .fcntl_h = rtems_filesystem_default_fcntl,
+  .kqfilter_h = rtems_filesystem_default_kqfilter,
+  .mmap_h = IMFS_extfile_mmap,
+  .poll_h = rtems_filesystem_default_poll,
+  .readv_h = rtems_filesystem_default_readv,
+  .writev_h = rtems_filesystem_default_writev
+};
+
+const IMFS_mknod_control IMFS_mknod_control_extfile = {
+  {
+    .handlers = &IMFS_extfile_handlers,
+    .node_initialize = IMFS_node_initialize_default,
+    .node_remove = IMFS_node_remove_default,
+    .node_destroy = IMFS_extfile_destroy
+  },
+  .node_size = sizeof( IMFS_extfile_t )
+};
@@ -0,0 +1,165 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/capture.h>
+
+static uint8_t*
+rtems_capture_compact_put (uint8_t* buf, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    *buf = (uint8_t) (value | 0x80);
+    ++buf;
+    value >>= 7;
+  }
+
+  *buf = (uint8_t) value;
+  return buf + 1;
+}
+
+static const uint8_t*
+rtems_capture_compact_get (const uint8_t* buf,
+                           const uint8_t* end,
+                           uint64_t*      value)
+{
+  uint64_t v = 0;
+  uint32_t shift = 0;
+
+  while (buf < end && shift < 64)
+  {
+    uint8_t byte = *buf;
+
+    ++buf;
+    v |= (uint64_t) (byte & 0x7f) << shift;
+    shift += 7;
+
+    if ((byte & 0x80) == 0)
+    {
+      *value = v;
+      return buf;
+    }
+  }
+
+  return NULL;
+}
+
+static uint64_t
+rtems_capture_compact_zigzag (int64_t value)
+{
+  return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+}
+
+static int64_t
+rtems_capture_compact_unzigzag (uint64_t value)
+{
+  return (int64_t) ((value >> 1) ^ (~(value & 1) + 1));
+}
+
+void
+rtems_capture_compact_initialize (rtems_capture_compact_state* state)
+{
+  memset (state, 0, sizeof (*state));
+}
+
+size_t
+rtems_capture_compact_encode (rtems_capture_compact_state* state,
+                              const void*                  rec,
+                              void*                        buf)
+{
+  rtems_capture_record in;
+  const void*          data;
+  size_t               data_size;
+  uint8_t*             out;
+
+  data = rtems_capture_record_extract (rec, &in, sizeof (in));
+  data_size = in.size - sizeof (in);
+
+  out = rtems_capture_compact_put (buf, in.events);
+  out = rtems_capture_compact_put (
+    out, rtems_capture_compact_zigzag ((int64_t) (in.time - state->time)));
+  out = rtems_capture_compact_put (
+    out, rtems_capture_compact_zigzag ((int32_t) (in.task_id - state->task_id)));
+  out = rtems_capture_compact_put (out, data_size);
+  out = rtems_capture_record_append (out, data, data_size);
+
+  state->time = in.time;
+  state->task_id = in.task_id;
+
+  return (size_t) (out - (uint8_t*) buf);
+}
+
+size_t
+rtems_capture_compact_decode (rtems_capture_compact_state* state,
+                              const void*                  buf,
+                              size_t                       size,
+                              void*                        rec,
+                              size_t                       rec_size)
+{
+  const uint8_t*       in = buf;
+  const uint8_t*       end = in + size;
+  rtems_capture_record out;
+  uint64_t             events;
+  uint64_t             time;
+  uint64_t             task_id;
+  uint64_t             data_size;
+
+  in = rtems_capture_compact_get (in, end, &events);
+  if (in == NULL)
+    return 0;
+
+  in = rtems_capture_compact_get (in, end, &time);
+  if (in == NULL)
+    return 0;
+
+  in = rtems_capture_compact_get (in, end, &task_id);
+  if (in == NULL)
+    return 0;
+
+  in = rtems_capture_compact_get (in, end, &data_size);
+  if (in == NULL
+      || rec_size < sizeof (out)
+      || data_size > (uint64_t) (end - in)
+      || data_size > rec_size - sizeof (out))
+    return 0;
+
+  out.size = sizeof (out) + (size_t) data_size;
+  out.events = (uint32_t) events;
+  out.task_id = state->task_id
+    + (rtems_id) rtems_capture_compact_unzigzag (task_id);
+  out.time = state->time
+    + (rtems_capture_time) rtems_capture_compact_unzigzag (time);
+
+  rec = rtems_capture_record_append (rec, &out, sizeof (out));
+  rtems_capture_record_append (rec, in, (size_t) data_size);
+
+  state->time = out.time;
+  state->task_id = out.task_id;
+
+  return (size_t) (in - (const uint8_t*) buf) + (size_t) data_size;
+}
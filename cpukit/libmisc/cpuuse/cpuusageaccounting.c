@@ -0,0 +1,192 @@
+/**
+ * @file
+ *
+ * @ingroup libmisc_cpuuse
+ *
+ * @brief Thread Accounting Iteration
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/cpuuse.h>
+
+#if defined(RTEMS_THREAD_ACCOUNTING)
+#include <rtems/counter.h>
+#include <rtems/score/threadimpl.h>
+
+#include <string.h>
+
+RTEMS_STATIC_ASSERT(
+  RTEMS_THREAD_ACCOUNTING_WAIT_QUEUES == THREAD_ACCOUNTING_WAIT_QUEUES,
+  thread_accounting_wait_queues
+);
+
+RTEMS_STATIC_ASSERT(
+  sizeof( ( (rtems_thread_accounting_wait *) 0 )->name )
+    == THREAD_ACCOUNTING_NAME_SIZE,
+  thread_accounting_name_size
+);
+
+typedef struct {
+  rtems_thread_accounting_visitor  visitor;
+  void                            *arg;
+} Thread_accounting_iteration;
+
+static uint64_t Thread_accounting_ticks_to_nanoseconds( uint64_t ticks )
+{
+  uint64_t frequency;
+
+  frequency = rtems_counter_frequency();
+
+  if ( frequency == 0 ) {
+    return 0;
+  }
+
+  /* Avoid an overflow for large tick values */
+  return ( ticks / frequency ) * 1000000000
+    + ( ( ticks % frequency ) * 1000000000 ) / frequency;
+}
+
+static void Thread_accounting_get_wait(
+  rtems_thread_accounting_wait *wait,
+  const Thread_Accounting_wait *account
+)
+{
+  wait->id = account->id;
+  memcpy( wait->name, account->name, sizeof( wait->name ) );
+  wait->count = account->count;
+  wait->wait_time = _Timestamp_Get_as_nanoseconds( &account->time );
+}
+
+static void Thread_accounting_sort_waits( rtems_thread_accounting *accounting )
+{
+  size_t i;
+
+  for ( i = 1; i < accounting->wait_queue_count; ++i ) {
+    rtems_thread_accounting_wait wait;
+    size_t                       j;
+
+    wait = accounting->wait_queues[ i ];
+    j = i;
+
+    while (
+      j > 0 && accounting->wait_queues[ j - 1 ].wait_time < wait.wait_time
+    ) {
+      accounting->wait_queues[ j ] = accounting->wait_queues[ j - 1 ];
+      --j;
+    }
+
+    accounting->wait_queues[ j ] = wait;
+  }
+}
+
+static bool Thread_accounting_visitor( Thread_Control *the_thread, void *arg )
+{
+  Thread_accounting_iteration *iteration;
+  rtems_thread_accounting      accounting;
+  Thread_Accounting_control    account;
+  Timestamp_Control            cpu_time;
+  ISR_lock_Context             lock_context;
+  size_t                       i;
+
+  iteration = arg;
+
+  _Thread_Get_CPU_time_used( the_thread, &cpu_time );
+
+  _Thread_State_acquire( the_thread, &lock_context );
+  account = the_thread->Accounting;
+  _Thread_State_release( the_thread, &lock_context );
+
+  /* The wait time accounts are protected by the default thread wait lock */
+  _Thread_Wait_acquire_default( the_thread, &lock_context );
+  memcpy(
+    account.Waits,
+    the_thread->Accounting.Waits,
+    sizeof( account.Waits )
+  );
+  account.Other_waits = the_thread->Accounting.Other_waits;
+  account.wait_time = the_thread->Accounting.wait_time;
+  _Thread_Wait_release_default( the_thread, &lock_context );
+
+  memset( &accounting, 0, sizeof( accounting ) );
+  accounting.id = the_thread->Object.id;
+  accounting.cpu_time = _Timestamp_Get_as_nanoseconds( &cpu_time );
+  accounting.ready_time =
+    _Timestamp_Get_as_nanoseconds( &account.ready_time );
+  accounting.wait_time = _Timestamp_Get_as_nanoseconds( &account.wait_time );
+  accounting.isr_time =
+    Thread_accounting_ticks_to_nanoseconds( account.isr_ticks );
+
+  for ( i = 0; i < THREAD_ACCOUNTING_WAIT_QUEUES; ++i ) {
+    if ( account.Waits[ i ].count == 0 ) {
+      break;
+    }
+
+    Thread_accounting_get_wait(
+      &accounting.wait_queues[ i ],
+      &account.Waits[ i ]
+    );
+  }
+
+  accounting.wait_queue_count = i;
+  Thread_accounting_sort_waits( &accounting );
+  Thread_accounting_get_wait(
+    &accounting.other_wait_queues,
+    &account.Other_waits
+  );
+
+  return ( *iteration->visitor )( &accounting, iteration->arg );
+}
+
+rtems_status_code rtems_thread_accounting_iterate(
+  rtems_thread_accounting_visitor  visitor,
+  void                            *arg
+)
+{
+  Thread_accounting_iteration iteration;
+
+  iteration.visitor = visitor;
+  iteration.arg = arg;
+  rtems_task_iterate( Thread_accounting_visitor, &iteration );
+
+  return RTEMS_SUCCESSFUL;
+}
+#else
+rtems_status_code rtems_thread_accounting_iterate(
+  rtems_thread_accounting_visitor  visitor,
+  void                            *arg
+)
+{
+  (void) visitor;
+  (void) arg;
+
+  return RTEMS_NOT_IMPLEMENTED;
+}
+#endif
@@ -24,6 +24,8 @@
 #include <rtems/score/schedulerimpl.h>
 #include <rtems/score/watchdogimpl.h>
 
+#include <string.h>
+
 #include "cpuuseimpl.h"
 
 static bool CPU_usage_Per_thread_handler(
@@ -34,6 +36,9 @@ static bool CPU_usage_Per_thread_handler(
   const Scheduler_Control *scheduler;
   ISR_lock_Context         state_lock_context;
   ISR_lock_Context         scheduler_lock_context;
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  ISR_lock_Context         wait_lock_context;
+#endif
 
   _Thread_State_acquire( the_thread, &state_lock_context );
   scheduler = _Thread_Scheduler_get_home( the_thread );
@@ -41,8 +46,30 @@ static bool CPU_usage_Per_thread_handler(
 
   _Timestamp_Set_to_zero( &the_thread->cpu_time_used );
 
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  _Timestamp_Set_to_zero( &the_thread->Accounting.ready_time );
+  the_thread->Accounting.isr_ticks = 0;
+#endif
+
   _Scheduler_Release_critical( scheduler, &scheduler_lock_context );
   _Thread_State_release( the_thread, &state_lock_context );
+
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  _Thread_Wait_acquire_default( the_thread, &wait_lock_context );
+  _Timestamp_Set_to_zero( &the_thread->Accounting.wait_time );
+  memset(
+    &the_thread->Accounting.Waits,
+    0,
+    sizeof( the_thread->Accounting.Waits )
+  );
+  memset(
+    &the_thread->Accounting.Other_waits,
+    0,
+    sizeof( the_thread->Accounting.Other_waits )
+  );
+  _Thread_Wait_release_default( the_thread, &wait_lock_context );
+#endif
+
   return false;
 }
 
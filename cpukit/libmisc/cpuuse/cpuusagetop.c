@@ -55,6 +55,7 @@ typedef struct
   volatile uint32_t      sort_order;
   volatile uint32_t      poll_rate_usecs;
   volatile uint32_t      show;
+  volatile bool          show_waits;
   const rtems_printer*   printer;
   Timestamp_Control      zero;
   Timestamp_Control      uptime;
@@ -68,6 +69,8 @@ typedef struct
   Timestamp_Control*     usage;             /* Usage of task's in this sample. */
   Timestamp_Control*     last_usage;        /* Usage of task's in the last sample. */
   Timestamp_Control*     current_usage;     /* Current usage for this sample. */
+  rtems_thread_accounting* accounting;      /* Time accounts in this sample. */
+  int                    accounting_count;  /* Number of time accounts. */
   Timestamp_Control      total;             /* Total run run, should equal the uptime. */
   Timestamp_Control      idle;              /* Time spent in idle. */
   Timestamp_Control      current;           /* Current time run in this period. */
@@ -162,6 +165,83 @@ task_counter(Thread_Control *thrad, void* arg)
   return false;
 }
 
+/*
+ * Collect the time accounts of the tasks.
+ */
+static bool
+task_accounting(const rtems_thread_accounting* accounting, void* arg)
+{
+  rtems_cpu_usage_data* data = (rtems_cpu_usage_data*) arg;
+
+  if (data->accounting_count < data->task_count)
+  {
+    data->accounting[data->accounting_count] = *accounting;
+    ++data->accounting_count;
+  }
+
+  return false;
+}
+
+static const rtems_thread_accounting*
+find_accounting(rtems_cpu_usage_data* data, rtems_id id)
+{
+  int i;
+
+  for (i = 0; i < data->accounting_count; i++)
+  {
+    if (data->accounting[i].id == id)
+      return &data->accounting[i];
+  }
+
+  return NULL;
+}
+
+static void
+print_nanoseconds(rtems_cpu_usage_data* data,
+                  uint64_t              nanoseconds,
+                  const int             length)
+{
+  Timestamp_Control time;
+
+  _Timestamp_Set(&time,
+                 nanoseconds / TOD_NANOSECONDS_PER_SECOND,
+                 nanoseconds % TOD_NANOSECONDS_PER_SECOND);
+  print_time(data, &time, length);
+}
+
+/*
+ * Print the ready, wait and interrupt times and the thread queue with the
+ * most wait time of a task.
+ */
+static void
+print_accounting(rtems_cpu_usage_data*          data,
+                 const rtems_thread_accounting* accounting)
+{
+  if (accounting == NULL)
+  {
+    rtems_printf(data->printer, "\n");
+    return;
+  }
+
+  print_nanoseconds(data, accounting->ready_time, 19);
+  rtems_printf(data->printer, " | ");
+  print_nanoseconds(data, accounting->wait_time, 19);
+  rtems_printf(data->printer, " | ");
+  print_nanoseconds(data, accounting->isr_time, 19);
+  rtems_printf(data->printer, " | ");
+
+  if (accounting->wait_queue_count > 0)
+  {
+    const rtems_thread_accounting_wait* wait = &accounting->wait_queues[0];
+
+    rtems_printf(data->printer, "%-15s 0x%08" PRIx32 " %" PRIu32 "x ",
+                 wait->name, wait->id, wait->count);
+    print_nanoseconds(data, wait->wait_time, 0);
+  }
+
+  rtems_printf(data->printer, "\n");
+}
+
 /*
  * Create the sorted table with the current and total usage.
  */
@@ -286,6 +366,7 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
     Timestamp_Control uptime_at_last_reset = CPU_usage_Uptime_at_last_reset;
     size_t            tasks_size;
     size_t            usage_size;
+    size_t            accounting_size;
     Timestamp_Control load;
 
     data->task_count = 0;
@@ -293,13 +374,16 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
 
     tasks_size = sizeof(Thread_Control*) * (data->task_count + 1);
     usage_size = sizeof(Timestamp_Control) * (data->task_count + 1);
+    accounting_size = sizeof(rtems_thread_accounting) * (data->task_count + 1);
 
     if (data->task_count > data->task_size)
     {
       data->tasks = realloc(data->tasks, tasks_size);
       data->usage = realloc(data->usage, usage_size);
       data->current_usage = realloc(data->current_usage, usage_size);
-      if ((data->tasks == NULL) || (data->usage == NULL) || (data->current_usage == NULL))
+      data->accounting = realloc(data->accounting, accounting_size);
+      if ((data->tasks == NULL) || (data->usage == NULL) ||
+          (data->current_usage == NULL) || (data->accounting == NULL))
       {
         rtems_printf(data->printer, "top worker: error: no memory\n");
         data->thread_run = false;
@@ -322,6 +406,14 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
 
     _Thread_Iterate(task_usage, data);
 
+    data->accounting_count = 0;
+    if (data->show_waits &&
+        rtems_thread_accounting_iterate(task_accounting, data) != RTEMS_SUCCESSFUL)
+    {
+      rtems_printf(data->printer, "top worker: thread accounting not enabled\n");
+      data->show_waits = false;
+    }
+
     if (data->task_count > data->task_size)
     {
       data->last_tasks = realloc(data->last_tasks, tasks_size);
@@ -356,7 +448,7 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
       rtems_printf(data->printer,
                    "\x1b[H\x1b[J"
                    " ENTER:Exit  SPACE:Refresh"
-                   "  S:Scroll  A:All  <>:Order  +/-:Lines\n");
+                   "  S:Scroll  A:All  <>:Order  +/-:Lines  W:Waits\n");
     rtems_printf(data->printer, "\n");
 
     /*
@@ -406,16 +498,30 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
 
     print_memsize(data, data->stack_size, "stack\n");
 
-    rtems_printf(data->printer,
-       "\n"
-        " ID         | NAME                | RPRI | CPRI   | TIME                | TOTAL   | CURRENT\n"
-        "-%s---------+---------------------+-%s-----%s-----+---------------------+-%s------+--%s----\n",
-       data->sort_order == RTEMS_TOP_SORT_ID ? "^^" : "--",
-       data->sort_order == RTEMS_TOP_SORT_REAL_PRI ? "^^" : "--",
-       data->sort_order == RTEMS_TOP_SORT_CURRENT_PRI ? "^^" : "--",
-                          data->sort_order == RTEMS_TOP_SORT_TOTAL ? "^^" : "--",
-       data->sort_order == RTEMS_TOP_SORT_CURRENT ? "^^" : "--"
-    );
+    if (data->show_waits)
+    {
+      rtems_printf(data->printer,
+         "\n"
+          " ID         | NAME                | RPRI | CPRI   | READY               | WAIT                | ISR                 | MOST WAITED FOR\n"
+          "-%s---------+---------------------+-%s-----%s-----+---------------------+---------------------+---------------------+----------------\n",
+         data->sort_order == RTEMS_TOP_SORT_ID ? "^^" : "--",
+         data->sort_order == RTEMS_TOP_SORT_REAL_PRI ? "^^" : "--",
+         data->sort_order == RTEMS_TOP_SORT_CURRENT_PRI ? "^^" : "--"
+      );
+    }
+    else
+    {
+      rtems_printf(data->printer,
+         "\n"
+          " ID         | NAME                | RPRI | CPRI   | TIME                | TOTAL   | CURRENT\n"
+          "-%s---------+---------------------+-%s-----%s-----+---------------------+-%s------+--%s----\n",
+         data->sort_order == RTEMS_TOP_SORT_ID ? "^^" : "--",
+         data->sort_order == RTEMS_TOP_SORT_REAL_PRI ? "^^" : "--",
+         data->sort_order == RTEMS_TOP_SORT_CURRENT_PRI ? "^^" : "--",
+                            data->sort_order == RTEMS_TOP_SORT_TOTAL ? "^^" : "--",
+         data->sort_order == RTEMS_TOP_SORT_CURRENT ? "^^" : "--"
+      );
+    }
 
     task_count = 0;
 
@@ -451,6 +557,12 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
                    _Thread_Get_unmapped_real_priority(thread),
                    _Thread_Get_unmapped_priority(thread));
 
+      if (data->show_waits)
+      {
+        print_accounting(data, find_accounting(data, thread->Object.id));
+        continue;
+      }
+
       usage = data->usage[i];
       current_usage = data->current_usage[i];
 
@@ -492,6 +604,7 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
   free(data->last_tasks);
   free(data->last_usage);
   free(data->current_usage);
+  free(data->accounting);
 
   data->thread_active = false;
 
@@ -610,6 +723,11 @@ void rtems_cpu_usage_top_with_plugin(
       if (data.show != 0)
         data.show = show_lines;
     }
+    else if ((c == 'w') || (c == 'W'))
+    {
+      data.show_waits = !data.show_waits;
+      rtems_event_send(id, RTEMS_EVENT_1);
+    }
     else if (c == ' ')
     {
       rtems_event_send(id, RTEMS_EVENT_1);
@@ -23,6 +23,42 @@
 
 #include "internal.h"
 
+static void rtems_shell_print_malloc_cache_info( void )
+{
+  rtems_malloc_cache_info info;
+  size_t                  i;
+
+  if ( malloc_cache_info( &info ) != 0 ) {
+    return;
+  }
+
+  printf(
+    "Per-processor cache:\n"
+    "   SIZE CACHED       HITS     MISSES      FREES  REFILLS  FLUSHES HIT%%\n"
+  );
+
+  for ( i = 0; i < RTEMS_MALLOC_CACHE_CLASS_COUNT; ++i ) {
+    const rtems_malloc_cache_class_info *c;
+    uint64_t                             total;
+
+    c = &info.classes[ i ];
+    total = (uint64_t) c->hits + c->misses;
+
+    printf(
+      "%7zu %6" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32
+        " %8" PRIu32 " %8" PRIu32 " %3" PRIu64 "\n",
+      c->size,
+      c->cached,
+      c->hits,
+      c->misses,
+      c->frees,
+      c->refills,
+      c->flushes,
+      total != 0 ? ( 100 * (uint64_t) c->hits ) / total : 0
+    );
+  }
+}
+
 static int rtems_shell_main_malloc_info(
   int   argc,
   char *argv[]
@@ -38,6 +74,7 @@ static int rtems_shell_main_malloc_info(
     rtems_shell_print_heap_info( "free", &info.Free );
     rtems_shell_print_heap_info( "used", &info.Used );
     rtems_shell_print_heap_stats( &info.Stats );
+    rtems_shell_print_malloc_cache_info();
   }
 
   return 0;
@@ -0,0 +1,530 @@
+/**
+ * @file
+ *
+ * @ingroup libmisc_stackpool
+ *
+ * @brief Task Stack Pool Implementation
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/stackpool.h>
+#include <rtems/score/assert.h>
+#include <rtems/score/chainimpl.h>
+#include <rtems/score/interr.h>
+#include <rtems/score/objectimpl.h>
+#include <rtems/score/threadimpl.h>
+#include <rtems/score/wkspace.h>
+
+#include <string.h>
+
+/*
+ * The sanity pattern and the paint pattern are the ones of the stack checker,
+ * so that both may be used at the same time.
+ */
+#if !defined(CPU_STACK_CHECK_PATTERN_INITIALIZER)
+#define CPU_STACK_CHECK_PATTERN_INITIALIZER \
+  { \
+    0xFEEDF00D, 0x0BAD0D06, /* FEED FOOD to  BAD DOG */ \
+    0xDEADF00D, 0x600D0D06  /* DEAD FOOD but GOOD DOG */ \
+  }
+#endif
+
+#define STACK_POOL_PAINT_PATTERN 0xA5A5A5A5
+
+typedef struct {
+  Chain_Node Node;
+
+  /*
+   * The size of the stack in use or zero if the slot is free.
+   */
+  size_t size;
+
+  /*
+   * The count of bytes starting at the stack begin which may differ from the
+   * paint pattern.
+   */
+  size_t high_water;
+} Stack_pool_Slot;
+
+typedef struct {
+  char            *begin;
+  char            *end;
+  size_t           stride;
+  Stack_pool_Slot *slots;
+  Chain_Control    Free;
+  rtems_stack_pool_class_information info;
+} Stack_pool_Class;
+
+RTEMS_STATIC_ASSERT(
+  sizeof( Stack_pool_Slot ) <= RTEMS_STACK_POOL_SLOT_SIZE,
+  Stack_pool_Slot
+);
+
+RTEMS_STATIC_ASSERT(
+  sizeof( Stack_pool_Class ) <= RTEMS_STACK_POOL_CLASS_CONTROL_SIZE,
+  Stack_pool_Class
+);
+
+static const uint32_t Stack_pool_Sanity_pattern[] =
+  CPU_STACK_CHECK_PATTERN_INITIALIZER;
+
+#define STACK_POOL_SANITY_PATTERN_SIZE sizeof( Stack_pool_Sanity_pattern )
+
+static Stack_pool_Class *Stack_pool_Classes;
+
+static uint32_t Stack_pool_Workspace_allocations;
+
+static void *Stack_pool_Get_sanity_pattern( char *area, size_t size )
+{
+#if CPU_STACK_GROWS_UP == TRUE
+  return area + size - STACK_POOL_SANITY_PATTERN_SIZE;
+#else
+  (void) size;
+  return area;
+#endif
+}
+
+static size_t Stack_pool_Usable_size( size_t size )
+{
+  return RTEMS_ALIGN_DOWN(
+    size - STACK_POOL_SANITY_PATTERN_SIZE,
+    sizeof( uint32_t )
+  );
+}
+
+/*
+ * Returns the word at the offset relative to the stack begin.  The stack
+ * begin is the end of the stack area opposite to the sanity pattern.
+ */
+static uint32_t *Stack_pool_Get_word( char *area, size_t size, size_t offset )
+{
+#if CPU_STACK_GROWS_UP == TRUE
+  (void) size;
+  return (uint32_t *) ( area + offset );
+#else
+  return (uint32_t *) ( area + RTEMS_ALIGN_DOWN( size, sizeof( uint32_t ) )
+    - offset - sizeof( uint32_t ) );
+#endif
+}
+
+static Stack_pool_Class *Stack_pool_Find(
+  const void       *addr,
+  Stack_pool_Slot **slot
+)
+{
+  const char *p;
+  size_t      i;
+
+  p = addr;
+
+  for ( i = 0; i < rtems_stack_pool_class_count; ++i ) {
+    Stack_pool_Class *cls;
+
+    cls = &Stack_pool_Classes[ i ];
+
+    if ( cls->begin <= p && p < cls->end ) {
+      *slot = &cls->slots[ (size_t) ( p - cls->begin ) / cls->stride ];
+      return cls;
+    }
+  }
+
+  return NULL;
+}
+
+static char *Stack_pool_Get_area(
+  const Stack_pool_Class *cls,
+  const Stack_pool_Slot  *slot
+)
+{
+  return cls->begin + (size_t) ( slot - cls->slots ) * cls->stride;
+}
+
+static bool Stack_pool_Is_sanity_pattern_valid(
+  char   *area,
+  size_t  size
+)
+{
+  return memcmp(
+    Stack_pool_Get_sanity_pattern( area, size ),
+    Stack_pool_Sanity_pattern,
+    STACK_POOL_SANITY_PATTERN_SIZE
+  ) == 0;
+}
+
+static size_t Stack_pool_Update_high_water(
+  Stack_pool_Class *cls,
+  Stack_pool_Slot  *slot,
+  char             *area
+)
+{
+  size_t offset;
+  size_t high_water;
+
+  /*
+   * Search from the stack limit toward the last known high water mark.  A
+   * search in the other direction could stop in an untouched part of a large
+   * stack frame and miss the words used beyond it.
+   */
+  offset = Stack_pool_Usable_size( slot->size );
+  high_water = slot->high_water;
+
+  while ( offset > high_water ) {
+    offset -= sizeof( uint32_t );
+
+    if (
+      *Stack_pool_Get_word( area, slot->size, offset )
+        != STACK_POOL_PAINT_PATTERN
+    ) {
+      high_water = offset + sizeof( uint32_t );
+      break;
+    }
+  }
+
+  slot->high_water = high_water;
+
+  if ( high_water > cls->info.max_high_water ) {
+    cls->info.max_high_water = high_water;
+  }
+
+  return high_water;
+}
+
+static void Stack_pool_Repaint(
+  Stack_pool_Class *cls,
+  Stack_pool_Slot  *slot,
+  char             *area
+)
+{
+  size_t high_water;
+  size_t offset;
+
+  high_water = Stack_pool_Update_high_water( cls, slot, area );
+
+  for ( offset = 0; offset < high_water; offset += sizeof( uint32_t ) ) {
+    *Stack_pool_Get_word( area, slot->size, offset ) =
+      STACK_POOL_PAINT_PATTERN;
+  }
+
+  slot->high_water = 0;
+}
+
+void rtems_stack_pool_initialize( size_t stack_space_size )
+{
+  size_t i;
+
+  (void) stack_space_size;
+
+  Stack_pool_Classes = _Workspace_Allocate_or_fatal_error(
+    rtems_stack_pool_class_count * sizeof( *Stack_pool_Classes )
+  );
+
+  for ( i = 0; i < rtems_stack_pool_class_count; ++i ) {
+    const rtems_stack_pool_class *config;
+    Stack_pool_Class             *cls;
+    size_t                        area_size;
+
+    config = &rtems_stack_pool_classes[ i ];
+    cls = &Stack_pool_Classes[ i ];
+    memset( cls, 0, sizeof( *cls ) );
+
+    cls->stride = RTEMS_ALIGN_UP( config->stack_size, CPU_STACK_ALIGNMENT );
+    area_size = cls->stride * config->stack_count;
+    cls->begin = _Workspace_Allocate_aligned( area_size, CPU_STACK_ALIGNMENT );
+
+    if ( cls->begin == NULL ) {
+      _Internal_error( INTERNAL_ERROR_WORKSPACE_ALLOCATION );
+    }
+
+    cls->end = cls->begin + area_size;
+    cls->slots = _Workspace_Allocate_or_fatal_error(
+      config->stack_count * sizeof( *cls->slots )
+    );
+    memset( cls->slots, 0, config->stack_count * sizeof( *cls->slots ) );
+    _Chain_Initialize(
+      &cls->Free,
+      cls->slots,
+      config->stack_count,
+      sizeof( *cls->slots )
+    );
+
+    cls->info.stack_size = config->stack_size;
+    cls->info.stack_count = config->stack_count;
+
+    if ( rtems_stack_pool_painting ) {
+      memset(
+        cls->begin,
+        (int) ( STACK_POOL_PAINT_PATTERN & 0xff ),
+        area_size
+      );
+    }
+  }
+}
+
+void *rtems_stack_pool_allocate( size_t stack_size )
+{
+  Stack_pool_Class *best;
+  Stack_pool_Slot  *slot;
+  char             *area;
+  size_t            i;
+
+  best = NULL;
+
+  for ( i = 0; i < rtems_stack_pool_class_count; ++i ) {
+    Stack_pool_Class *cls;
+
+    cls = &Stack_pool_Classes[ i ];
+
+    if (
+      cls->info.stack_size >= stack_size
+        && !_Chain_Is_empty( &cls->Free )
+        && ( best == NULL || cls->info.stack_size < best->info.stack_size )
+    ) {
+      best = cls;
+    }
+  }
+
+  if ( best == NULL ) {
+    ++Stack_pool_Workspace_allocations;
+    return _Workspace_Allocate( stack_size );
+  }
+
+  slot = (Stack_pool_Slot *) _Chain_Get_first_unprotected( &best->Free );
+  slot->size = stack_size;
+  _Assert( slot->high_water == 0 );
+
+  ++best->info.allocations;
+  ++best->info.used;
+
+  if ( best->info.used > best->info.max_used ) {
+    best->info.max_used = best->info.used;
+  }
+
+  area = Stack_pool_Get_area( best, slot );
+  memcpy(
+    Stack_pool_Get_sanity_pattern( area, stack_size ),
+    Stack_pool_Sanity_pattern,
+    STACK_POOL_SANITY_PATTERN_SIZE
+  );
+
+  return area;
+}
+
+void rtems_stack_pool_free( void *addr )
+{
+  Stack_pool_Class *cls;
+  Stack_pool_Slot  *slot;
+
+  cls = Stack_pool_Find( addr, &slot );
+
+  if ( cls == NULL ) {
+    _Workspace_Free( addr );
+    return;
+  }
+
+  _Assert( slot->size != 0 );
+
+  if ( !Stack_pool_Is_sanity_pattern_valid( addr, slot->size ) ) {
+    rtems_fatal(
+      RTEMS_FATAL_SOURCE_STACK_CHECKER,
+      rtems_build_name( 'P', 'O', 'O', 'L' )
+    );
+  }
+
+  if ( rtems_stack_pool_painting ) {
+    Stack_pool_Repaint( cls, slot, addr );
+  }
+
+  slot->size = 0;
+  --cls->info.used;
+  _Chain_Prepend_unprotected( &cls->Free, &slot->Node );
+}
+
+static bool Stack_pool_Sample_thread(
+  Thread_Control *the_thread,
+  void           *arg
+)
+{
+  Stack_pool_Class *cls;
+  Stack_pool_Slot  *slot;
+  char             *area;
+
+  (void) arg;
+
+  area = the_thread->Start.Initial_stack.area;
+  cls = Stack_pool_Find( area, &slot );
+
+  if ( cls == NULL ) {
+    return false;
+  }
+
+  if ( !Stack_pool_Is_sanity_pattern_valid( area, slot->size ) ) {
+    rtems_fatal(
+      RTEMS_FATAL_SOURCE_STACK_CHECKER,
+      the_thread->Object.name.name_u32
+    );
+  }
+
+  if ( rtems_stack_pool_painting ) {
+    Stack_pool_Update_high_water( cls, slot, area );
+  }
+
+  return false;
+}
+
+void rtems_stack_pool_sample( void )
+{
+  rtems_task_iterate( Stack_pool_Sample_thread, NULL );
+}
+
+rtems_status_code rtems_stack_pool_get_high_water(
+  rtems_id  id,
+  size_t   *high_water
+)
+{
+  Thread_Control   *the_thread;
+  ISR_lock_Context  lock_context;
+  Stack_pool_Class *cls;
+  Stack_pool_Slot  *slot;
+  char             *area;
+
+  if ( high_water == NULL ) {
+    return RTEMS_INVALID_ADDRESS;
+  }
+
+  if ( !rtems_stack_pool_painting ) {
+    return RTEMS_NOT_CONFIGURED;
+  }
+
+  /*
+   * The object allocator lock prevents that the thread and its stack are
+   * freed.
+   */
+  _Objects_Allocator_lock();
+  the_thread = _Thread_Get( id, &lock_context );
+
+  if ( the_thread == NULL ) {
+    _Objects_Allocator_unlock();
+    return RTEMS_INVALID_ID;
+  }
+
+  _ISR_lock_ISR_enable( &lock_context );
+
+  area = the_thread->Start.Initial_stack.area;
+  cls = Stack_pool_Find( area, &slot );
+
+  if ( cls == NULL ) {
+    _Objects_Allocator_unlock();
+    return RTEMS_NOT_DEFINED;
+  }
+
+  *high_water = Stack_pool_Update_high_water( cls, slot, area );
+  _Objects_Allocator_unlock();
+  return RTEMS_SUCCESSFUL;
+}
+
+rtems_status_code rtems_stack_pool_get_class_information(
+  size_t                              class_index,
+  rtems_stack_pool_class_information *info
+)
+{
+  if ( info == NULL ) {
+    return RTEMS_INVALID_ADDRESS;
+  }
+
+  if ( class_index >= rtems_stack_pool_class_count ) {
+    return RTEMS_INVALID_NUMBER;
+  }
+
+  _Objects_Allocator_lock();
+  *info = Stack_pool_Classes[ class_index ].info;
+  _Objects_Allocator_unlock();
+  return RTEMS_SUCCESSFUL;
+}
+
+uint32_t rtems_stack_pool_get_workspace_allocations( void )
+{
+  return Stack_pool_Workspace_allocations;
+}
+
+static void Stack_pool_Sampler( rtems_task_argument arg )
+{
+  rtems_interval interval;
+
+  interval = (rtems_interval) arg;
+
+  while ( true ) {
+    rtems_stack_pool_sample();
+    (void) rtems_task_wake_after( interval );
+  }
+}
+
+rtems_status_code rtems_stack_pool_start_sampler(
+  rtems_task_priority  priority,
+  rtems_interval       interval,
+  rtems_id            *id
+)
+{
+  rtems_status_code sc;
+
+  if ( id == NULL ) {
+    return RTEMS_INVALID_ADDRESS;
+  }
+
+  if ( interval == 0 ) {
+    return RTEMS_INVALID_NUMBER;
+  }
+
+  sc = rtems_task_create(
+    rtems_build_name( 'S', 'P', 'H', 'W' ),
+    priority,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    id
+  );
+
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    return sc;
+  }
+
+  sc = rtems_task_start(
+    *id,
+    Stack_pool_Sampler,
+    (rtems_task_argument) interval
+  );
+
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    (void) rtems_task_delete( *id );
+  }
+
+  return sc;
+}
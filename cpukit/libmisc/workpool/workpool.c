@@ -0,0 +1,850 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/workpool.h>
+#include <rtems/malloc.h>
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEQUE_MASK ( RTEMS_WORK_POOL_DEQUE_SIZE - 1 )
+
+#define GROUP_WAITING ( ~( ULONG_MAX >> 1 ) )
+
+RTEMS_STATIC_ASSERT(
+  ( RTEMS_WORK_POOL_DEQUE_SIZE & DEQUE_MASK ) == 0,
+  RTEMS_WORK_POOL_DEQUE_SIZE
+);
+
+typedef struct {
+  /*
+   * The top index is modified by thieves, the bottom index only by the owner,
+   * so place them in distinct cache lines.
+   */
+  Atomic_Ulong top;
+  Atomic_Ulong bottom RTEMS_ALIGNED( CPU_CACHE_LINE_BYTES );
+  Atomic_Uintptr items[ RTEMS_WORK_POOL_DEQUE_SIZE ];
+  Atomic_Uint sleeping;
+  rtems_id id;
+  uint32_t index;
+  uint32_t victim;
+  rtems_work_pool *pool;
+} RTEMS_ALIGNED( CPU_CACHE_LINE_BYTES ) work_pool_worker;
+
+struct rtems_work_pool {
+  Atomic_Ulong stop;
+  Atomic_Uint sleeping_count;
+  Atomic_Uint live_count;
+  RTEMS_INTERRUPT_LOCK_MEMBER( lock )
+  rtems_chain_control injection;
+  rtems_id deleter;
+  uint32_t worker_count;
+  uint32_t processor_maximum;
+  work_pool_worker **worker_by_processor;
+  work_pool_worker *workers;
+};
+
+static bool deque_push( work_pool_worker *worker, rtems_work_item *item )
+{
+  unsigned long bottom;
+  unsigned long top;
+
+  bottom = _Atomic_Load_ulong( &worker->bottom, ATOMIC_ORDER_RELAXED );
+  top = _Atomic_Load_ulong( &worker->top, ATOMIC_ORDER_ACQUIRE );
+
+  if ( bottom - top >= RTEMS_WORK_POOL_DEQUE_SIZE ) {
+    return false;
+  }
+
+  _Atomic_Store_uintptr(
+    &worker->items[ bottom & DEQUE_MASK ],
+    (uintptr_t) item,
+    ATOMIC_ORDER_RELAXED
+  );
+  _Atomic_Store_ulong( &worker->bottom, bottom + 1, ATOMIC_ORDER_RELEASE );
+  return true;
+}
+
+static rtems_work_item *deque_take( work_pool_worker *worker )
+{
+  unsigned long    bottom;
+  unsigned long    top;
+  rtems_work_item *item;
+
+  bottom = _Atomic_Load_ulong( &worker->bottom, ATOMIC_ORDER_RELAXED ) - 1;
+  _Atomic_Store_ulong( &worker->bottom, bottom, ATOMIC_ORDER_RELAXED );
+  _Atomic_Fence( ATOMIC_ORDER_SEQ_CST );
+  top = _Atomic_Load_ulong( &worker->top, ATOMIC_ORDER_RELAXED );
+
+  if ( (long) ( bottom - top ) < 0 ) {
+    _Atomic_Store_ulong( &worker->bottom, bottom + 1, ATOMIC_ORDER_RELAXED );
+    return NULL;
+  }
+
+  item = (rtems_work_item *) _Atomic_Load_uintptr(
+    &worker->items[ bottom & DEQUE_MASK ],
+    ATOMIC_ORDER_RELAXED
+  );
+
+  if ( bottom == top ) {
+    /* This is the last item, so race with the thieves */
+    if (
+      !_Atomic_Compare_exchange_ulong(
+        &worker->top,
+        &top,
+        top + 1,
+        ATOMIC_ORDER_SEQ_CST,
+        ATOMIC_ORDER_RELAXED
+      )
+    ) {
+      item = NULL;
+    }
+
+    _Atomic_Store_ulong( &worker->bottom, bottom + 1, ATOMIC_ORDER_RELAXED );
+  }
+
+  return item;
+}
+
+static rtems_work_item *deque_steal( work_pool_worker *worker )
+{
+  unsigned long    top;
+  unsigned long    bottom;
+  rtems_work_item *item;
+
+  top = _Atomic_Load_ulong( &worker->top, ATOMIC_ORDER_ACQUIRE );
+  _Atomic_Fence( ATOMIC_ORDER_SEQ_CST );
+  bottom = _Atomic_Load_ulong( &worker->bottom, ATOMIC_ORDER_ACQUIRE );
+
+  if ( (long) ( bottom - top ) <= 0 ) {
+    return NULL;
+  }
+
+  item = (rtems_work_item *) _Atomic_Load_uintptr(
+    &worker->items[ top & DEQUE_MASK ],
+    ATOMIC_ORDER_RELAXED
+  );
+
+  if (
+    !_Atomic_Compare_exchange_ulong(
+      &worker->top,
+      &top,
+      top + 1,
+      ATOMIC_ORDER_SEQ_CST,
+      ATOMIC_ORDER_RELAXED
+    )
+  ) {
+    return NULL;
+  }
+
+  return item;
+}
+
+static work_pool_worker *get_current_worker( const rtems_work_pool *pool )
+{
+  uint32_t          cpu_index;
+  work_pool_worker *worker;
+
+  /*
+   * The workers are pinned to their processor.  For other tasks the
+   * identifier check fails regardless of a migration.
+   */
+  cpu_index = rtems_scheduler_get_processor();
+
+  if ( cpu_index >= pool->processor_maximum ) {
+    return NULL;
+  }
+
+  worker = pool->worker_by_processor[ cpu_index ];
+
+  if ( worker == NULL || worker->id != rtems_task_self() ) {
+    return NULL;
+  }
+
+  return worker;
+}
+
+static rtems_work_item *injection_get( rtems_work_pool *pool )
+{
+  rtems_interrupt_lock_context lock_context;
+  rtems_chain_node            *node;
+
+  if ( rtems_chain_is_empty( &pool->injection ) ) {
+    return NULL;
+  }
+
+  rtems_interrupt_lock_acquire( &pool->lock, &lock_context );
+  node = rtems_chain_get_unprotected( &pool->injection );
+  rtems_interrupt_lock_release( &pool->lock, &lock_context );
+
+  return (rtems_work_item *) node;
+}
+
+static rtems_work_item *find_work(
+  rtems_work_pool  *pool,
+  work_pool_worker *self
+)
+{
+  rtems_work_item *item;
+  uint32_t         n;
+  uint32_t         victim;
+  uint32_t         i;
+
+  if ( self != NULL ) {
+    item = deque_take( self );
+
+    if ( item != NULL ) {
+      return item;
+    }
+
+    victim = self->victim;
+  } else {
+    victim = 0;
+  }
+
+  item = injection_get( pool );
+
+  if ( item != NULL ) {
+    return item;
+  }
+
+  n = pool->worker_count;
+
+  for ( i = 0; i < n; ++i ) {
+    work_pool_worker *other;
+
+    if ( victim >= n ) {
+      victim = 0;
+    }
+
+    other = &pool->workers[ victim ];
+    ++victim;
+
+    if ( other != self ) {
+      item = deque_steal( other );
+
+      if ( item != NULL ) {
+        break;
+      }
+    }
+  }
+
+  if ( self != NULL ) {
+    self->victim = victim;
+  }
+
+  return item;
+}
+
+static void complete( rtems_work_group *group )
+{
+  unsigned long previous;
+
+  previous = _Atomic_Fetch_sub_ulong(
+    &group->pending,
+    1,
+    ATOMIC_ORDER_ACQ_REL
+  );
+
+  /*
+   * Only a blocked joiner keeps the group alive after the last decrement, so
+   * do not touch the group in the other cases.
+   */
+  if ( previous == ( GROUP_WAITING | 1 ) ) {
+    (void) rtems_event_transient_send( group->waiter );
+  }
+}
+
+static void execute( rtems_work_pool *pool, rtems_work_item *item )
+{
+  rtems_work_group *group;
+
+  group = item->group;
+  ( *item->handler )( pool, item );
+  complete( group );
+}
+
+static void wake_up_one( rtems_work_pool *pool, const work_pool_worker *self )
+{
+  uint32_t n;
+  uint32_t index;
+  uint32_t i;
+
+  _Atomic_Fence( ATOMIC_ORDER_SEQ_CST );
+
+  if (
+    _Atomic_Load_uint( &pool->sleeping_count, ATOMIC_ORDER_RELAXED ) == 0
+  ) {
+    return;
+  }
+
+  n = pool->worker_count;
+  index = self != NULL ? self->index + 1 : 0;
+
+  for ( i = 0; i < n; ++i ) {
+    work_pool_worker *worker;
+    unsigned int      sleeping;
+
+    if ( index >= n ) {
+      index = 0;
+    }
+
+    worker = &pool->workers[ index ];
+    ++index;
+    sleeping = 1;
+
+    if (
+      _Atomic_Compare_exchange_uint(
+        &worker->sleeping,
+        &sleeping,
+        0,
+        ATOMIC_ORDER_RELAXED,
+        ATOMIC_ORDER_RELAXED
+      )
+    ) {
+      (void) rtems_event_system_send( worker->id, RTEMS_EVENT_SYSTEM_SERVER );
+      return;
+    }
+  }
+}
+
+static void wait_for_work( rtems_work_pool *pool, work_pool_worker *self )
+{
+  rtems_work_item *item;
+
+  _Atomic_Store_uint( &self->sleeping, 1, ATOMIC_ORDER_RELAXED );
+  _Atomic_Fetch_add_uint( &pool->sleeping_count, 1, ATOMIC_ORDER_SEQ_CST );
+  _Atomic_Fence( ATOMIC_ORDER_SEQ_CST );
+
+  /*
+   * Check again after the announcement to not miss work forked in the
+   * meantime, see wake_up_one().  A wake up after this check leaves a pending
+   * event which makes the next wait return immediately.
+   */
+  item = find_work( pool, self );
+
+  if (
+    item == NULL
+      && _Atomic_Load_ulong( &pool->stop, ATOMIC_ORDER_RELAXED ) == 0
+  ) {
+    rtems_event_set events;
+
+    (void) rtems_event_system_receive(
+      RTEMS_EVENT_SYSTEM_SERVER,
+      RTEMS_EVENT_ALL | RTEMS_WAIT,
+      RTEMS_NO_TIMEOUT,
+      &events
+    );
+  }
+
+  _Atomic_Store_uint( &self->sleeping, 0, ATOMIC_ORDER_RELAXED );
+  _Atomic_Fetch_sub_uint( &pool->sleeping_count, 1, ATOMIC_ORDER_RELAXED );
+
+  if ( item != NULL ) {
+    execute( pool, item );
+  }
+}
+
+static void worker_task( rtems_task_argument arg )
+{
+  work_pool_worker *self;
+  rtems_work_pool  *pool;
+
+  self = (work_pool_worker *) arg;
+  pool = self->pool;
+
+  while ( _Atomic_Load_ulong( &pool->stop, ATOMIC_ORDER_ACQUIRE ) == 0 ) {
+    rtems_work_item *item;
+
+    item = find_work( pool, self );
+
+    if ( item != NULL ) {
+      execute( pool, item );
+    } else {
+      wait_for_work( pool, self );
+    }
+  }
+
+  /*
+   * Transient events do not count, so only the last exiting worker sends one.
+   * The pool may be freed afterwards.
+   */
+  if (
+    _Atomic_Fetch_sub_uint( &pool->live_count, 1, ATOMIC_ORDER_ACQ_REL ) == 1
+  ) {
+    (void) rtems_event_transient_send( pool->deleter );
+  }
+
+  rtems_task_exit();
+}
+
+static void stop_workers( rtems_work_pool *pool, uint32_t started )
+{
+  uint32_t i;
+
+  if ( started == 0 ) {
+    return;
+  }
+
+  /* The workers do not exit before the stop request */
+  _Atomic_Store_uint( &pool->live_count, started, ATOMIC_ORDER_RELAXED );
+  pool->deleter = rtems_task_self();
+  _Atomic_Store_ulong( &pool->stop, 1, ATOMIC_ORDER_RELEASE );
+
+  for ( i = 0; i < started; ++i ) {
+    (void) rtems_event_system_send(
+      pool->workers[ i ].id,
+      RTEMS_EVENT_SYSTEM_SERVER
+    );
+  }
+
+  (void) rtems_event_transient_receive( RTEMS_WAIT, RTEMS_NO_TIMEOUT );
+}
+
+static void free_pool( rtems_work_pool *pool )
+{
+  free( pool->worker_by_processor );
+  free( pool->workers );
+  free( pool );
+}
+
+static bool get_scheduler(
+  const cpu_set_t *cpuset,
+  uint32_t         cpu_index,
+  cpu_set_t       *one,
+  rtems_id        *scheduler_id
+)
+{
+  rtems_status_code sc;
+
+  if ( !CPU_ISSET( (int) cpu_index, cpuset ) ) {
+    return false;
+  }
+
+  CPU_ZERO( one );
+  CPU_SET( (int) cpu_index, one );
+
+  sc = rtems_scheduler_ident_by_processor_set(
+    sizeof( *one ),
+    one,
+    scheduler_id
+  );
+  return sc == RTEMS_SUCCESSFUL;
+}
+
+static rtems_status_code start_worker(
+  rtems_work_pool              *pool,
+  const rtems_work_pool_config *config,
+  work_pool_worker             *worker,
+  uint32_t                      cpu_index,
+  const cpu_set_t              *cpuset,
+  rtems_id                      scheduler_id,
+  rtems_task_priority           priority
+)
+{
+  rtems_status_code sc;
+  rtems_id          id;
+
+  sc = rtems_task_create(
+    config->name,
+    priority,
+    config->stack_size != 0 ? config->stack_size : RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    config->attributes,
+    &id
+  );
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    return sc;
+  }
+
+  sc = rtems_task_set_scheduler( id, scheduler_id, priority );
+  if ( sc == RTEMS_SUCCESSFUL ) {
+    sc = rtems_task_set_affinity( id, sizeof( *cpuset ), cpuset );
+  }
+
+  if ( sc == RTEMS_SUCCESSFUL ) {
+    worker->id = id;
+    pool->worker_by_processor[ cpu_index ] = worker;
+    sc = rtems_task_start( id, worker_task, (rtems_task_argument) worker );
+  }
+
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    pool->worker_by_processor[ cpu_index ] = NULL;
+    (void) rtems_task_delete( id );
+  }
+
+  return sc;
+}
+
+static rtems_status_code get_processor_set(
+  const rtems_work_pool_config *config,
+  cpu_set_t                    *cpuset
+)
+{
+  rtems_status_code sc;
+  rtems_id          scheduler_id;
+
+  if ( config->cpuset != NULL ) {
+    if ( config->cpusetsize == 0 ) {
+      return RTEMS_INVALID_SIZE;
+    }
+
+    CPU_ZERO( cpuset );
+    memcpy(
+      cpuset,
+      config->cpuset,
+      config->cpusetsize < sizeof( *cpuset ) ?
+        config->cpusetsize : sizeof( *cpuset )
+    );
+    return RTEMS_SUCCESSFUL;
+  }
+
+  sc = rtems_task_get_scheduler( RTEMS_SELF, &scheduler_id );
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    return sc;
+  }
+
+  return rtems_scheduler_get_processor_set(
+    scheduler_id,
+    sizeof( *cpuset ),
+    cpuset
+  );
+}
+
+static uint32_t count_workers( const cpu_set_t *cpuset, uint32_t n )
+{
+  uint32_t count;
+  uint32_t cpu_index;
+
+  count = 0;
+
+  for ( cpu_index = 0; cpu_index < n; ++cpu_index ) {
+    cpu_set_t one;
+    rtems_id  scheduler_id;
+
+    if ( get_scheduler( cpuset, cpu_index, &one, &scheduler_id ) ) {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+rtems_status_code rtems_work_pool_create(
+  const rtems_work_pool_config *config,
+  rtems_work_pool             **pool_ptr
+)
+{
+  rtems_status_code   sc;
+  rtems_work_pool    *pool;
+  rtems_task_priority priority;
+  cpu_set_t           cpuset;
+  uint32_t            n;
+  uint32_t            worker_count;
+  uint32_t            cpu_index;
+  uint32_t            started;
+
+  if ( config == NULL || pool_ptr == NULL ) {
+    return RTEMS_INVALID_ADDRESS;
+  }
+
+  sc = get_processor_set( config, &cpuset );
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    return sc;
+  }
+
+  n = rtems_scheduler_get_processor_maximum();
+  worker_count = count_workers( &cpuset, n );
+
+  if ( worker_count == 0 ) {
+    return RTEMS_INVALID_NAME;
+  }
+
+  priority = config->priority;
+
+  if ( priority == 0 ) {
+    sc = rtems_task_set_priority(
+      RTEMS_SELF,
+      RTEMS_CURRENT_PRIORITY,
+      &priority
+    );
+    if ( sc != RTEMS_SUCCESSFUL ) {
+      return sc;
+    }
+  }
+
+  pool = calloc( 1, sizeof( *pool ) );
+  if ( pool == NULL ) {
+    return RTEMS_NO_MEMORY;
+  }
+
+  pool->worker_by_processor = calloc( n, sizeof( *pool->worker_by_processor ) );
+  pool->workers = rtems_heap_allocate_aligned_with_boundary(
+    worker_count * sizeof( *pool->workers ),
+    CPU_CACHE_LINE_BYTES,
+    0
+  );
+
+  if ( pool->worker_by_processor == NULL || pool->workers == NULL ) {
+    free_pool( pool );
+    return RTEMS_NO_MEMORY;
+  }
+
+  memset( pool->workers, 0, worker_count * sizeof( *pool->workers ) );
+  rtems_interrupt_lock_initialize( &pool->lock, "Work Pool" );
+  rtems_chain_initialize_empty( &pool->injection );
+  pool->processor_maximum = n;
+  pool->worker_count = worker_count;
+
+  started = 0;
+
+  for ( cpu_index = 0; cpu_index < n && started < worker_count; ++cpu_index ) {
+    work_pool_worker *worker;
+    cpu_set_t         one;
+    rtems_id          scheduler_id;
+
+    if ( !get_scheduler( &cpuset, cpu_index, &one, &scheduler_id ) ) {
+      continue;
+    }
+
+    worker = &pool->workers[ started ];
+    worker->index = started;
+    worker->victim = started + 1;
+    worker->pool = pool;
+
+    sc = start_worker(
+      pool,
+      config,
+      worker,
+      cpu_index,
+      &one,
+      scheduler_id,
+      priority
+    );
+    if ( sc != RTEMS_SUCCESSFUL ) {
+      break;
+    }
+
+    ++started;
+  }
+
+  if ( started < worker_count && sc == RTEMS_SUCCESSFUL ) {
+    /* A processor was removed from its scheduler instance in the meantime */
+    sc = RTEMS_INCORRECT_STATE;
+  }
+
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    stop_workers( pool, started );
+    rtems_interrupt_lock_destroy( &pool->lock );
+    free_pool( pool );
+    return sc;
+  }
+
+  *pool_ptr = pool;
+  return RTEMS_SUCCESSFUL;
+}
+
+void rtems_work_pool_delete( rtems_work_pool *pool )
+{
+  stop_workers( pool, pool->worker_count );
+  rtems_interrupt_lock_destroy( &pool->lock );
+  free_pool( pool );
+}
+
+uint32_t rtems_work_pool_get_worker_count( const rtems_work_pool *pool )
+{
+  return pool->worker_count;
+}
+
+void rtems_work_group_initialize( rtems_work_group *group )
+{
+  /* The owner holds one reference until the join */
+  _Atomic_Init_ulong( &group->pending, 1 );
+  group->waiter = 0;
+}
+
+void rtems_work_pool_fork(
+  rtems_work_pool  *pool,
+  rtems_work_group *group,
+  rtems_work_item  *item,
+  rtems_work_handler handler
+)
+{
+  work_pool_worker *self;
+
+  item->handler = handler;
+  item->group = group;
+  _Atomic_Fetch_add_ulong( &group->pending, 1, ATOMIC_ORDER_RELAXED );
+
+  self = get_current_worker( pool );
+
+  if ( self != NULL ) {
+    if ( !deque_push( self, item ) ) {
+      execute( pool, item );
+      return;
+    }
+  } else {
+    rtems_interrupt_lock_context lock_context;
+
+    rtems_interrupt_lock_acquire( &pool->lock, &lock_context );
+    rtems_chain_append_unprotected( &pool->injection, &item->node );
+    rtems_interrupt_lock_release( &pool->lock, &lock_context );
+  }
+
+  wake_up_one( pool, self );
+}
+
+void rtems_work_pool_join( rtems_work_pool *pool, rtems_work_group *group )
+{
+  work_pool_worker *self;
+  unsigned long     previous;
+
+  self = get_current_worker( pool );
+
+  if ( self != NULL ) {
+    previous = _Atomic_Fetch_sub_ulong(
+      &group->pending,
+      1,
+      ATOMIC_ORDER_ACQ_REL
+    );
+
+    if ( previous == 1 ) {
+      return;
+    }
+
+    while (
+      _Atomic_Load_ulong( &group->pending, ATOMIC_ORDER_ACQUIRE ) != 0
+    ) {
+      rtems_work_item *item;
+
+      item = find_work( pool, self );
+
+      if ( item != NULL ) {
+        execute( pool, item );
+      }
+    }
+  } else {
+    /*
+     * Drop the owner reference and set the waiting flag in one atomic
+     * operation.  The completion which makes the count zero sends exactly one
+     * transient event.  Other tasks do not execute work items here, since a
+     * nested join would consume the transient event of this join.
+     */
+    group->waiter = rtems_task_self();
+    previous = _Atomic_Fetch_add_ulong(
+      &group->pending,
+      GROUP_WAITING - 1,
+      ATOMIC_ORDER_ACQ_REL
+    );
+
+    if ( previous != 1 ) {
+      (void) rtems_event_transient_receive( RTEMS_WAIT, RTEMS_NO_TIMEOUT );
+    }
+  }
+}
+
+typedef struct {
+  rtems_work_range_handler handler;
+  void                    *arg;
+  size_t                   grain;
+} parallel_for_context;
+
+typedef struct {
+  rtems_work_item             item;
+  const parallel_for_context *ctx;
+  size_t                      begin;
+  size_t                      end;
+} parallel_for_item;
+
+static void parallel_for_range(
+  rtems_work_pool            *pool,
+  const parallel_for_context *ctx,
+  size_t                      begin,
+  size_t                      end
+);
+
+static void parallel_for_handler(
+  rtems_work_pool *pool,
+  rtems_work_item *base
+)
+{
+  parallel_for_item *item;
+
+  item = RTEMS_CONTAINER_OF( base, parallel_for_item, item );
+  parallel_for_range( pool, item->ctx, item->begin, item->end );
+}
+
+static void parallel_for_range(
+  rtems_work_pool            *pool,
+  const parallel_for_context *ctx,
+  size_t                      begin,
+  size_t                      end
+)
+{
+  rtems_work_group  group;
+  parallel_for_item right;
+  size_t            middle;
+
+  if ( end - begin <= ctx->grain ) {
+    ( *ctx->handler )( ctx->arg, begin, end );
+    return;
+  }
+
+  middle = begin + ( end - begin ) / 2;
+  right.ctx = ctx;
+  right.begin = middle;
+  right.end = end;
+
+  rtems_work_group_initialize( &group );
+  rtems_work_pool_fork( pool, &group, &right.item, parallel_for_handler );
+  parallel_for_range( pool, ctx, begin, middle );
+  rtems_work_pool_join( pool, &group );
+}
+
+void rtems_work_pool_parallel_for(
+  rtems_work_pool         *pool,
+  size_t                   begin,
+  size_t                   end,
+  size_t                   grain,
+  rtems_work_range_handler handler,
+  void                    *arg
+)
+{
+  parallel_for_context ctx;
+
+  if ( begin >= end ) {
+    return;
+  }
+
+  ctx.handler = handler;
+  ctx.arg = arg;
+  ctx.grain = grain != 0 ? grain : 1;
+  parallel_for_range( pool, &ctx, begin, end );
+}
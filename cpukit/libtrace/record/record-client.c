@@ -588,6 +588,105 @@ static rtems_record_client_status consume_swap_64(
   return RTEMS_RECORD_CLIENT_SUCCESS;
 }
 
+static rtems_record_client_status visit_compact(
+  rtems_record_client_context *ctx,
+  uint64_t                     first,
+  uint64_t                     value
+)
+{
+  uint32_t           cpu;
+  uint32_t           time;
+  rtems_record_event event;
+  uint64_t           data;
+
+  cpu = ctx->compact.cpu;
+  event = (rtems_record_event) ( ( first >> RTEMS_RECORD_COMPACT_FLAG_BITS )
+    & ( ( UINT32_C( 1 ) << RTEMS_RECORD_EVENT_BITS ) - 1 ) );
+
+  if ( ( first & RTEMS_RECORD_COMPACT_TIME_ZERO ) != 0 ) {
+    time = 0;
+  } else {
+    time = (uint32_t) ( first
+      >> ( RTEMS_RECORD_COMPACT_FLAG_BITS + RTEMS_RECORD_EVENT_BITS ) );
+    time = ( ctx->compact.time[ cpu ] + time ) & TIME_MASK;
+    ctx->compact.time[ cpu ] = time;
+  }
+
+  if ( ( first & RTEMS_RECORD_COMPACT_DATA_DELTA ) != 0 ) {
+    int64_t delta;
+
+    delta = (int64_t) ( ( value >> 1 ) ^ ( ~( value & 1 ) + 1 ) );
+    data = ctx->compact.data[ cpu ] + (uint64_t) delta;
+  } else {
+    data = value;
+  }
+
+  if ( ctx->data_size == 4 ) {
+    data = (uint32_t) data;
+  }
+
+  ctx->compact.data[ cpu ] = data;
+
+  if (
+    event == RTEMS_RECORD_PROCESSOR
+      && data < RTEMS_RECORD_COMPACT_CPU_COUNT
+  ) {
+    ctx->compact.cpu = (uint32_t) data;
+  }
+
+  return visit( ctx, RTEMS_RECORD_TIME_EVENT( time, event ), data );
+}
+
+static rtems_record_client_status consume_compact(
+  rtems_record_client_context *ctx,
+  const void                  *buf,
+  size_t                       n
+)
+{
+  const uint8_t *pos;
+
+  pos = buf;
+
+  while ( n > 0 ) {
+    uint8_t byte;
+
+    byte = *pos;
+    ++pos;
+    --n;
+
+    if ( ctx->compact.shift >= 64 ) {
+      return error( ctx, RTEMS_RECORD_CLIENT_ERROR_INVALID_COMPACT_ITEM );
+    }
+
+    ctx->compact.value |= (uint64_t) ( byte & 0x7f ) << ctx->compact.shift;
+    ctx->compact.shift += 7;
+
+    if ( ( byte & 0x80 ) == 0 ) {
+      uint64_t value;
+
+      value = ctx->compact.value;
+      ctx->compact.value = 0;
+      ctx->compact.shift = 0;
+
+      if ( ctx->compact.has_first ) {
+        rtems_record_client_status status;
+
+        ctx->compact.has_first = false;
+        status = visit_compact( ctx, ctx->compact.first, value );
+
+        if ( status != RTEMS_RECORD_CLIENT_SUCCESS ) {
+          return status;
+        }
+      } else {
+        ctx->compact.first = value;
+        ctx->compact.has_first = true;
+      }
+    }
+  }
+
+  return RTEMS_RECORD_CLIENT_SUCCESS;
+}
+
 static rtems_record_client_status consume_init(
   rtems_record_client_context *ctx,
   const void                  *buf,
@@ -610,6 +709,24 @@ static rtems_record_client_status consume_init(
       magic = ctx->header[ 1 ];
 
       switch ( ctx->header[ 0 ] ) {
+        case RTEMS_RECORD_FORMAT_COMPACT_32:
+          ctx->consume = consume_compact;
+          ctx->data_size = 4;
+
+          if ( magic != RTEMS_RECORD_MAGIC ) {
+            magic = __builtin_bswap32( magic );
+          }
+
+          break;
+        case RTEMS_RECORD_FORMAT_COMPACT_64:
+          ctx->consume = consume_compact;
+          ctx->data_size = 8;
+
+          if ( magic != RTEMS_RECORD_MAGIC ) {
+            magic = __builtin_bswap32( magic );
+          }
+
+          break;
 #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
         case RTEMS_RECORD_FORMAT_LE_32:
           ctx->todo = sizeof( ctx->item.format_32 );
@@ -0,0 +1,121 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/record.h>
+
+#include <string.h>
+
+#define TIME_MASK ( ( UINT32_C( 1 ) << RTEMS_RECORD_TIME_BITS ) - 1 )
+
+void rtems_record_compact_encoder_initialize(
+  rtems_record_compact_encoder *encoder
+)
+{
+  memset( encoder, 0, sizeof( *encoder ) );
+}
+
+uint32_t rtems_record_compact_format( void )
+{
+#if __INTPTR_WIDTH__ == 32
+  return RTEMS_RECORD_FORMAT_COMPACT_32;
+#elif __INTPTR_WIDTH__ == 64
+  return RTEMS_RECORD_FORMAT_COMPACT_64;
+#else
+#error "unexpected __INTPTR_WIDTH__"
+#endif
+}
+
+static uint8_t *encode_varint( uint8_t *buf, uint64_t value )
+{
+  while ( value >= 0x80 ) {
+    *buf = (uint8_t) ( value | 0x80 );
+    ++buf;
+    value >>= 7;
+  }
+
+  *buf = (uint8_t) value;
+  return buf + 1;
+}
+
+size_t rtems_record_compact_encode(
+  rtems_record_compact_encoder *encoder,
+  const rtems_record_item      *item,
+  void                         *buf
+)
+{
+  uint32_t           time;
+  rtems_record_event event;
+  rtems_record_data  data;
+  uint64_t           first;
+  int64_t            delta;
+  uint64_t           zigzag;
+  uint8_t           *end;
+
+  time = RTEMS_RECORD_GET_TIME( item->event );
+  event = RTEMS_RECORD_GET_EVENT( item->event );
+  data = item->data;
+  first = (uint64_t) event << RTEMS_RECORD_COMPACT_FLAG_BITS;
+
+  if ( time != 0 ) {
+    uint32_t time_delta;
+
+    time_delta = ( time - encoder->Per_CPU[ encoder->cpu ].time ) & TIME_MASK;
+    encoder->Per_CPU[ encoder->cpu ].time = time;
+    first |= (uint64_t) time_delta
+      << ( RTEMS_RECORD_COMPACT_FLAG_BITS + RTEMS_RECORD_EVENT_BITS );
+  } else {
+    first |= RTEMS_RECORD_COMPACT_TIME_ZERO;
+  }
+
+  /*
+   * The difference is sign extended from the data width to get short
+   * encodings for small negative differences also on 32-bit targets.
+   */
+  delta = (long) ( data - encoder->Per_CPU[ encoder->cpu ].data );
+  zigzag = ( (uint64_t) delta << 1 ) ^ (uint64_t) ( delta >> 63 );
+  encoder->Per_CPU[ encoder->cpu ].data = data;
+
+  if ( zigzag < data ) {
+    first |= RTEMS_RECORD_COMPACT_DATA_DELTA;
+  } else {
+    zigzag = data;
+  }
+
+  end = encode_varint( buf, first );
+  end = encode_varint( end, zigzag );
+
+  if (
+    event == RTEMS_RECORD_PROCESSOR
+      && data < RTEMS_RECORD_COMPACT_CPU_COUNT
+  ) {
+    encoder->cpu = (uint32_t) data;
+  }
+
+  return (size_t) ( end - (uint8_t *) buf );
+}
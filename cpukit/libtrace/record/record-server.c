@@ -93,6 +93,98 @@ ssize_t rtems_record_writev( int fd, bool *written )
   }
 }
 
+static ssize_t write_items(
+  int                           fd,
+  rtems_record_compact_encoder *encoder,
+  const rtems_record_item      *items,
+  size_t                        count
+)
+{
+  uint8_t buf[ 16 * RTEMS_RECORD_COMPACT_ITEM_SIZE_MAX ];
+  ssize_t total;
+
+  if ( encoder == NULL ) {
+    return write( fd, items, count * sizeof( *items ) );
+  }
+
+  total = 0;
+
+  while ( count > 0 ) {
+    size_t  size;
+    ssize_t n;
+
+    size = 0;
+
+    while (
+      count > 0
+        && size <= sizeof( buf ) - RTEMS_RECORD_COMPACT_ITEM_SIZE_MAX
+    ) {
+      size += rtems_record_compact_encode( encoder, items, &buf[ size ] );
+      ++items;
+      --count;
+    }
+
+    n = write( fd, buf, size );
+
+    if ( n <= 0 ) {
+      return n;
+    }
+
+    total += n;
+  }
+
+  return total;
+}
+
+typedef struct {
+  int                           fd;
+  rtems_record_compact_encoder *encoder;
+  ssize_t                       n;
+  bool                          written;
+} compact_visitor_context;
+
+static void compact_visitor(
+  const rtems_record_item *items,
+  size_t                   count,
+  void                    *arg
+)
+{
+  compact_visitor_context *ctx;
+
+  ctx = arg;
+  ctx->written = true;
+
+  if ( ctx->n >= 0 ) {
+    ssize_t n;
+
+    n = write_items( ctx->fd, ctx->encoder, items, count );
+
+    if ( n > 0 ) {
+      ctx->n += n;
+    } else {
+      ctx->n = -1;
+    }
+  }
+}
+
+ssize_t rtems_record_write_compact(
+  int                           fd,
+  rtems_record_compact_encoder *encoder,
+  bool                         *written
+)
+{
+  compact_visitor_context ctx;
+
+  ctx.fd = fd;
+  ctx.encoder = encoder;
+  ctx.n = 0;
+  ctx.written = false;
+  rtems_record_drain( compact_visitor, &ctx );
+  *written = ctx.written;
+
+  return ctx.n;
+}
+
 #define WAKEUP_EVENT RTEMS_EVENT_0
 
 static void wakeup( rtems_id task )
@@ -121,6 +213,14 @@ static void wakeup_timer( rtems_id timer, void *arg )
   (void) rtems_timer_reset( timer );
 }
 
+static void wakeup_watermark( void *arg )
+{
+  rtems_id *server;
+
+  server = arg;
+  wakeup( *server );
+}
+
 size_t _Record_Stream_header_initialize( Record_Stream_header *header )
 {
   rtems_record_item *items;
@@ -224,17 +324,33 @@ size_t _Record_Stream_header_initialize( Record_Stream_header *header )
   return (size_t) ( (char *) items - (char *) header );
 }
 
-static void send_header( int fd )
+static void send_header( int fd, rtems_record_compact_encoder *encoder )
 {
   Record_Stream_header header;
   size_t               size;
 
   size = _Record_Stream_header_initialize( &header );
-  (void) write( fd, &header, size );
+
+  if ( encoder != NULL ) {
+    size_t prefix;
+
+    prefix = sizeof( header.format ) + sizeof( header.magic );
+    header.format = rtems_record_compact_format();
+    (void) write( fd, &header, prefix );
+    (void) write_items(
+      fd,
+      encoder,
+      &header.Version,
+      ( size - prefix ) / sizeof( header.Version )
+    );
+  } else {
+    (void) write( fd, &header, size );
+  }
 }
 
 typedef struct {
   int fd;
+  rtems_record_compact_encoder *encoder;
   size_t index;
   rtems_record_item items[ 128 ];
 } thread_names_context;
@@ -253,7 +369,12 @@ static void thread_names_produce(
 
   if (i == RTEMS_ARRAY_SIZE(ctx->items) - 1) {
     ctx->index = 0;
-    (void) write( ctx->fd, ctx->items, sizeof( ctx->items ) );
+    (void) write_items(
+      ctx->fd,
+      ctx->encoder,
+      ctx->items,
+      RTEMS_ARRAY_SIZE( ctx->items )
+    );
   } else {
     ctx->index = i + 1;
   }
@@ -291,30 +412,42 @@ static bool thread_names_visitor( rtems_tcb *tcb, void *arg )
   return false;
 }
 
-static void send_thread_names( int fd )
+static void send_thread_names(
+  int                           fd,
+  rtems_record_compact_encoder *encoder
+)
 {
   thread_names_context ctx;
 
   ctx.fd = fd;
+  ctx.encoder = encoder;
   ctx.index = 0;
   rtems_task_iterate( thread_names_visitor, &ctx );
 
   if ( ctx.index > 0 ) {
-    (void) write( ctx.fd, ctx.items, ctx.index * sizeof( ctx.items[ 0 ] ) );
+    (void) write_items( ctx.fd, ctx.encoder, ctx.items, ctx.index );
   }
 }
 
-void rtems_record_server( uint16_t port, rtems_interval period )
+static void record_server(
+  uint16_t       port,
+  rtems_interval period,
+  unsigned int   watermark,
+  bool           compact
+)
 {
   rtems_status_code sc;
   rtems_id self;
   rtems_id timer;
+  rtems_record_compact_encoder compact_encoder;
+  rtems_record_compact_encoder *encoder;
   struct sockaddr_in addr;
   int sd;
   int rv;
 
   sd = -1;
   self = rtems_task_self();
+  encoder = compact ? &compact_encoder : NULL;
 
   sc = rtems_timer_create( rtems_build_name( 'R', 'C', 'R', 'D' ), &timer );
   if ( sc != RTEMS_SUCCESSFUL ) {
@@ -353,20 +486,49 @@ void rtems_record_server( uint16_t port, rtems_interval period )
     }
 
     wait( RTEMS_NO_WAIT );
+
     (void) rtems_timer_fire_after( timer, period, wakeup_timer, &self );
-    send_header( cd );
-    send_thread_names( cd );
 
-    while ( true ) {
-      n = rtems_record_writev( cd, &written );
+    if ( encoder != NULL ) {
+      rtems_record_compact_encoder_initialize( encoder );
+    }
 
-      if ( written && n <= 0 ) {
-        break;
+    send_header( cd, encoder );
+    send_thread_names( cd, encoder );
+
+    while ( true ) {
+      /*
+       * In streaming mode, keep on sending as long as the producers are ahead
+       * of us.  Items overwritten during a zero-copy transfer are accounted
+       * per processor by the client through the PER_CPU_HEAD item of the next
+       * drain.  Under load, this drain follows immediately.
+       */
+      do {
+        if ( encoder != NULL ) {
+          n = rtems_record_write_compact( cd, encoder, &written );
+        } else {
+          n = rtems_record_writev( cd, &written );
+        }
+
+        if ( written && n <= 0 ) {
+          goto done;
+        }
+      } while (
+        written
+          && watermark > 0
+          && rtems_record_get_maximum_content() >= watermark
+      );
+
+      if ( watermark > 0 ) {
+        _Record_Arm_watermark( watermark, wakeup_watermark, &self );
       }
 
       wait( RTEMS_WAIT );
     }
 
+done:
+
+    _Record_Disarm_watermark();
     (void) rtems_timer_cancel( timer );
     (void) close( cd );
   }
@@ -377,10 +539,52 @@ error:
   (void) rtems_timer_delete( timer );
 }
 
+static unsigned int clamp_watermark( unsigned int watermark )
+{
+  if ( watermark > _Record_Configuration.item_count / 2 ) {
+    watermark = _Record_Configuration.item_count / 2;
+  }
+
+  if ( watermark == 0 ) {
+    watermark = 1;
+  }
+
+  return watermark;
+}
+
+void rtems_record_server( uint16_t port, rtems_interval period )
+{
+  record_server( port, period, 0, false );
+}
+
+void rtems_record_stream_server(
+  uint16_t       port,
+  rtems_interval period,
+  unsigned int   watermark
+)
+{
+  record_server( port, period, clamp_watermark( watermark ), false );
+}
+
+void rtems_record_compact_server(
+  uint16_t       port,
+  rtems_interval period,
+  unsigned int   watermark
+)
+{
+  if ( watermark > 0 ) {
+    watermark = clamp_watermark( watermark );
+  }
+
+  record_server( port, period, watermark, true );
+}
+
 typedef struct {
   rtems_id       task;
   uint16_t       port;
   rtems_interval period;
+  unsigned int   watermark;
+  bool           compact;
 } server_arg;
 
 static void server( rtems_task_argument arg )
@@ -388,19 +592,25 @@ static void server( rtems_task_argument arg )
   server_arg     *sarg;
   uint16_t        port;
   rtems_interval  period;
+  unsigned int    watermark;
+  bool            compact;
 
   sarg = (server_arg *) arg;
   port = sarg->port;
   period = sarg->period;
+  watermark = sarg->watermark;
+  compact = sarg->compact;
   wakeup(sarg->task);
-  rtems_record_server( port, period );
+  record_server( port, period, watermark, compact );
   rtems_task_exit();
 }
 
-rtems_status_code rtems_record_start_server(
+static rtems_status_code start_server(
   rtems_task_priority priority,
   uint16_t            port,
-  rtems_interval      period
+  rtems_interval      period,
+  unsigned int        watermark,
+  bool                compact
 )
 {
   rtems_status_code sc;
@@ -409,6 +619,8 @@ rtems_status_code rtems_record_start_server(
 
   sarg.port = port;
   sarg.period = period;
+  sarg.watermark = watermark;
+  sarg.compact = compact;
   sarg.task = rtems_task_self();
 
   sc = rtems_task_create(
@@ -428,3 +640,42 @@ rtems_status_code rtems_record_start_server(
 
   return RTEMS_SUCCESSFUL;
 }
+
+rtems_status_code rtems_record_start_server(
+  rtems_task_priority priority,
+  uint16_t            port,
+  rtems_interval      period
+)
+{
+  return start_server( priority, port, period, 0, false );
+}
+
+rtems_status_code rtems_record_start_stream_server(
+  rtems_task_priority priority,
+  uint16_t            port,
+  rtems_interval      period,
+  unsigned int        watermark
+)
+{
+  return start_server(
+    priority,
+    port,
+    period,
+    clamp_watermark( watermark ),
+    false
+  );
+}
+
+rtems_status_code rtems_record_start_compact_server(
+  rtems_task_priority priority,
+  uint16_t            port,
+  rtems_interval      period,
+  unsigned int        watermark
+)
+{
+  if ( watermark > 0 ) {
+    watermark = clamp_watermark( watermark );
+  }
+
+  return start_server( priority, port, period, watermark, true );
+}
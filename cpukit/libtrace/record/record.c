@@ -44,6 +44,53 @@ RTEMS_STATIC_ASSERT(
   RTEMS_RECORD_EVENT_BITS
 );
 
+Atomic_Uint _Record_Watermark = ATOMIC_INITIALIZER_UINT( 0 );
+
+static void ( *_Record_Watermark_handler )( void * );
+
+static void *_Record_Watermark_arg;
+
+void _Record_Watermark_reached( void )
+{
+  unsigned int watermark;
+
+  watermark = _Atomic_Exchange_uint(
+    &_Record_Watermark,
+    0,
+    ATOMIC_ORDER_ACQUIRE
+  );
+
+  if ( watermark != 0 ) {
+    ( *_Record_Watermark_handler )( _Record_Watermark_arg );
+  }
+}
+
+void _Record_Arm_watermark(
+  unsigned int   watermark,
+  void        ( *handler )( void * ),
+  void          *arg
+)
+{
+  _Assert( watermark > 0 );
+
+  _Record_Watermark_handler = handler;
+  _Record_Watermark_arg = arg;
+  _Atomic_Store_uint( &_Record_Watermark, watermark, ATOMIC_ORDER_RELEASE );
+
+  /*
+   * The producers did not check the watermark while it was disarmed, so check
+   * the content produced in the meantime.
+   */
+  if ( rtems_record_get_maximum_content() >= watermark ) {
+    _Record_Watermark_reached();
+  }
+}
+
+void _Record_Disarm_watermark( void )
+{
+  _Atomic_Store_uint( &_Record_Watermark, 0, ATOMIC_ORDER_RELAXED );
+}
+
 void rtems_record_produce( rtems_record_event event, rtems_record_data data )
 {
   rtems_record_context context;
@@ -183,3 +230,27 @@ void rtems_record_drain( rtems_record_drain_visitor visitor, void *arg )
     _Record_Drain( cpu->record, cpu_index, visitor, arg );
   }
 }
+
+unsigned int rtems_record_get_maximum_content( void )
+{
+  uint32_t     cpu_max;
+  uint32_t     cpu_index;
+  unsigned int maximum;
+
+  cpu_max = rtems_configuration_get_maximum_processors();
+  maximum = 0;
+
+  for ( cpu_index = 0; cpu_index < cpu_max; ++cpu_index ) {
+    const Record_Control *control;
+    unsigned int          content;
+
+    control = _Per_CPU_Get_by_index( cpu_index )->record;
+    content = _Record_Head( control ) - _Record_Tail( control );
+
+    if ( content > maximum ) {
+      maximum = content;
+    }
+  }
+
+  return maximum;
+}
@@ -159,9 +159,7 @@ void *mmap(
 
     /* Check to see if the mapping is valid for a regular file. */
     if ( S_ISREG( sb.st_mode )
-    /* FIXME: Should this be using strict inequality (>) comparisons? It would
-     * be valid to map a region exactly equal to the st_size, e.g. see below. */
-         && (( off >= sb.st_size ) || (( off + len ) >= sb.st_size ))) {
+         && (( off >= sb.st_size ) || (( off + len ) > sb.st_size ))) {
       errno = EOVERFLOW;
       return MAP_FAILED;
     }
@@ -292,6 +290,16 @@ void *mmap(
       free( mapping );
       return MAP_FAILED;
     }
+
+    if ( !is_shared_shm ) {
+      /*
+       * The mapping uses the file memory directly, so keep a node reference
+       * until munmap().
+       */
+      rtems_filesystem_instance_lock( &iop->pathinfo );
+      rtems_filesystem_location_clone( &mapping->location, &iop->pathinfo );
+      rtems_filesystem_instance_unlock( &iop->pathinfo );
+    }
   }
 
   rtems_chain_append_unprotected( &mmap_mappings, &mapping->node );
@@ -22,6 +22,7 @@
 int munmap(void *addr, size_t len)
 {
   mmap_mapping     *mapping;
+  mmap_mapping     *removed;
   rtems_chain_node *node;
 
   /*
@@ -43,6 +44,8 @@ int munmap(void *addr, size_t len)
     return -1;
   }
 
+  removed = NULL;
+
   mmap_mappings_lock_obtain();
 
   node = rtems_chain_first (&mmap_mappings);
@@ -67,12 +70,22 @@ int munmap(void *addr, size_t len)
           free( mapping->addr );
         }
       }
-      free( mapping );
+      removed = mapping;
       break;
     }
     node = rtems_chain_next( node );
   }
 
   mmap_mappings_lock_release( );
+
+  if ( removed != NULL ) {
+    /* Drop the node reference of a shared file mapping, see mmap() */
+    if ( removed->location.mt_entry != NULL ) {
+      rtems_filesystem_location_free( &removed->location );
+    }
+
+    free( removed );
+  }
+
   return 0;
 }
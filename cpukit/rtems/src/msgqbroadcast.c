@@ -50,6 +50,11 @@ rtems_status_code rtems_message_queue_broadcast(
 #endif
   }
 
+  if ( _Message_queue_Is_by_reference( the_message_queue ) ) {
+    _ISR_lock_ISR_enable( &queue_context.Lock_context.Lock_context );
+    return RTEMS_NOT_DEFINED;
+  }
+
   _Thread_queue_Context_set_MP_callout(
     &queue_context,
     _Message_queue_Core_message_queue_mp_support
@@ -0,0 +1,145 @@
+/**
+ * @file
+ *
+ * @ingroup ClassicMessageQueue
+ *
+ * @brief rtems_message_queue_broadcast_reference()
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/rtems/messageimpl.h>
+#include <rtems/rtems/statusimpl.h>
+
+rtems_status_code rtems_message_queue_broadcast_reference(
+  rtems_id  id,
+  void     *buffer,
+  size_t    size,
+  uint32_t *count
+)
+{
+  Message_queue_Control       *the_message_queue;
+  Thread_queue_Context         queue_context;
+  Message_queue_Reference      reference;
+  Message_queue_Buffer_header *header;
+  Status_Control               status;
+
+  if ( buffer == NULL ) {
+    return RTEMS_INVALID_ADDRESS;
+  }
+
+  if ( count == NULL ) {
+    return RTEMS_INVALID_ADDRESS;
+  }
+
+  the_message_queue = _Message_queue_Get( id, &queue_context );
+
+  if ( the_message_queue == NULL ) {
+#if defined(RTEMS_MULTIPROCESSING)
+    if ( _Message_queue_MP_Is_remote( id ) ) {
+      return RTEMS_ILLEGAL_ON_REMOTE_OBJECT;
+    }
+#endif
+
+    return RTEMS_INVALID_ID;
+  }
+
+  if ( !_Message_queue_Is_by_reference( the_message_queue ) ) {
+    _ISR_lock_ISR_enable( &queue_context.Lock_context.Lock_context );
+    return RTEMS_NOT_DEFINED;
+  }
+
+  header = _Message_queue_Get_buffer_header( the_message_queue, buffer );
+
+  if ( header != NULL ) {
+    if ( size > the_message_queue->Buffer_pool.buffer_size ) {
+      _ISR_lock_ISR_enable( &queue_context.Lock_context.Lock_context );
+      return RTEMS_INVALID_SIZE;
+    }
+
+    /*
+     *  The receivers may return the buffer before the broadcast finished.
+     *  Turn the reference of the sender into a hold reference until the count
+     *  of receivers is known.
+     */
+    _CORE_message_queue_Acquire_critical(
+      &the_message_queue->message_queue,
+      &queue_context
+    );
+    header->reference_count += MESSAGE_QUEUE_BUFFER_BROADCAST_HOLD - 1;
+    _CORE_message_queue_Release(
+      &the_message_queue->message_queue,
+      &queue_context
+    );
+    _ISR_lock_ISR_disable( &queue_context.Lock_context.Lock_context );
+  }
+
+  reference.buffer = buffer;
+  reference.size = size;
+
+  _Thread_queue_Context_set_MP_callout(
+    &queue_context,
+    _Message_queue_Core_message_queue_mp_support
+  );
+  status = _CORE_message_queue_Broadcast(
+    &the_message_queue->message_queue,
+    &reference,
+    sizeof( reference ),
+    count,
+    &queue_context
+  );
+
+  if ( header != NULL ) {
+    /*
+     *  Each receiver owns one reference.  Without receivers the buffer returns
+     *  to the pool.
+     */
+    _CORE_message_queue_Acquire(
+      &the_message_queue->message_queue,
+      &queue_context
+    );
+
+    if ( status == STATUS_SUCCESSFUL ) {
+      header->reference_count += *count;
+    }
+
+    _Message_queue_Release_buffer(
+      the_message_queue,
+      header,
+      MESSAGE_QUEUE_BUFFER_BROADCAST_HOLD
+    );
+    _CORE_message_queue_Release(
+      &the_message_queue->message_queue,
+      &queue_context
+    );
+  }
+
+  return _Status_Get( status );
+}
@@ -31,6 +31,58 @@
 #include <rtems/score/wkspace.h>
 #include <rtems/sysinit.h>
 
+static bool _Message_queue_Initialize_buffer_pool(
+  Message_queue_Control *the_message_queue,
+  uint32_t               count,
+  size_t                 buffer_size
+)
+{
+  Message_queue_Buffer_pool *pool;
+  size_t                     stride;
+  size_t                     area_size;
+  char                      *area;
+
+  pool = &the_message_queue->Buffer_pool;
+  _Chain_Initialize_empty( &pool->Free );
+  pool->begin = NULL;
+  pool->end = NULL;
+  pool->stride = 0;
+  pool->buffer_size = buffer_size;
+
+  if ( buffer_size == 0 ) {
+    return true;
+  }
+
+  stride = MESSAGE_QUEUE_BUFFER_HEADER_SIZE + buffer_size
+    + CPU_HEAP_ALIGNMENT - 1;
+  if ( stride < buffer_size ) {
+    return false;
+  }
+
+  stride &= ~( (size_t) CPU_HEAP_ALIGNMENT - 1 );
+
+  area_size = (size_t) count * stride;
+  if ( area_size / stride != count ) {
+    return false;
+  }
+
+  area = _Workspace_Allocate( area_size );
+  if ( area == NULL ) {
+    return false;
+  }
+
+  pool->begin = area;
+  pool->end = area + area_size;
+  pool->stride = stride;
+  _Chain_Initialize(
+    &pool->Free,
+    area,
+    count,
+    stride
+  );
+  return true;
+}
+
 rtems_status_code rtems_message_queue_create(
   rtems_name       name,
   uint32_t         count,
@@ -41,6 +93,8 @@ rtems_status_code rtems_message_queue_create(
 {
   Message_queue_Control          *the_message_queue;
   CORE_message_queue_Disciplines  discipline;
+  bool                            by_reference;
+  size_t                          core_message_size;
 #if defined(RTEMS_MULTIPROCESSING)
   bool                            is_global;
 #endif
@@ -60,10 +114,18 @@ rtems_status_code rtems_message_queue_create(
   if ( count == 0 )
       return RTEMS_INVALID_NUMBER;
 
-  if ( max_message_size == 0 )
+  by_reference = _Attributes_Is_message_by_reference( attribute_set );
+
+  if ( max_message_size == 0 && !by_reference )
       return RTEMS_INVALID_SIZE;
 
 #if defined(RTEMS_MULTIPROCESSING)
+  /*
+   * Message buffers passed by reference cannot cross node boundaries.
+   */
+  if ( is_global && by_reference )
+    return RTEMS_NOT_DEFINED;
+
 #if 1
   /*
    * I am not 100% sure this should be an error.
@@ -105,12 +167,36 @@ rtems_status_code rtems_message_queue_create(
   else
     discipline = CORE_MESSAGE_QUEUE_DISCIPLINES_FIFO;
 
+  /*
+   *  A message queue which passes messages by reference uses the maximum
+   *  message size for its buffer pool.  The SuperCore Message Queue copies
+   *  only the reference.
+   */
+  if ( by_reference ) {
+    core_message_size = sizeof( Message_queue_Reference );
+  } else {
+    core_message_size = max_message_size;
+    max_message_size = 0;
+  }
+
+  if ( ! _Message_queue_Initialize_buffer_pool(
+           the_message_queue,
+           count,
+           max_message_size
+         ) ) {
+    _Message_queue_Free( the_message_queue );
+    _Objects_Allocator_unlock();
+    return RTEMS_UNSATISFIED;
+  }
+
   if ( ! _CORE_message_queue_Initialize(
            &the_message_queue->message_queue,
            discipline,
            count,
-           max_message_size
+           core_message_size
          ) ) {
+    _Workspace_Free( the_message_queue->Buffer_pool.begin );
+
 #if defined(RTEMS_MULTIPROCESSING)
     if ( is_global )
         _Objects_MP_Close(
@@ -20,6 +20,7 @@
 
 #include <rtems/rtems/messageimpl.h>
 #include <rtems/rtems/attrimpl.h>
+#include <rtems/score/wkspace.h>
 
 rtems_status_code rtems_message_queue_delete(
   rtems_id id
@@ -75,6 +76,7 @@ rtems_status_code rtems_message_queue_delete(
   }
 #endif
 
+  _Workspace_Free( the_message_queue->Buffer_pool.begin );
   _Message_queue_Free( the_message_queue );
   _Objects_Allocator_unlock();
   return RTEMS_SUCCESSFUL;
@@ -20,6 +20,47 @@
 
 #include <rtems/rtems/messageimpl.h>
 
+/*
+ *  The pending messages own their buffers.  Return the pool buffers while
+ *  the messages are flushed one by one.
+ */
+static uint32_t _Message_queue_Flush_references(
+  Message_queue_Control *the_message_queue,
+  Thread_queue_Context  *queue_context
+)
+{
+  CORE_message_queue_Control        *core;
+  CORE_message_queue_Buffer_control *the_message;
+  uint32_t                           count;
+
+  core = &the_message_queue->message_queue;
+  count = 0;
+
+  _CORE_message_queue_Acquire_critical( core, queue_context );
+
+  while ( ( the_message = _CORE_message_queue_Get_pending_message( core ) ) ) {
+    const Message_queue_Reference *reference;
+    Message_queue_Buffer_header   *header;
+
+    reference = (const Message_queue_Reference *) the_message->Contents.buffer;
+    header = _Message_queue_Get_buffer_header(
+      the_message_queue,
+      reference->buffer
+    );
+
+    if ( header != NULL ) {
+      _Message_queue_Release_buffer( the_message_queue, header, 1 );
+    }
+
+    --core->number_of_pending_messages;
+    _CORE_message_queue_Free_message_buffer( core, the_message );
+    ++count;
+  }
+
+  _CORE_message_queue_Release( core, queue_context );
+  return count;
+}
+
 rtems_status_code rtems_message_queue_flush(
   rtems_id  id,
   uint32_t *count
@@ -42,9 +83,17 @@ rtems_status_code rtems_message_queue_flush(
 #endif
   }
 
-  *count = _CORE_message_queue_Flush(
-    &the_message_queue->message_queue,
-    &queue_context
-  );
+  if ( _Message_queue_Is_by_reference( the_message_queue ) ) {
+    *count = _Message_queue_Flush_references(
+      the_message_queue,
+      &queue_context
+    );
+  } else {
+    *count = _CORE_message_queue_Flush(
+      &the_message_queue->message_queue,
+      &queue_context
+    );
+  }
+
   return RTEMS_SUCCESSFUL;
 }
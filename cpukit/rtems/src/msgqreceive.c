@@ -59,6 +59,11 @@ rtems_status_code rtems_message_queue_receive(
 #endif
   }
 
+  if ( _Message_queue_Is_by_reference( the_message_queue ) ) {
+    _ISR_lock_ISR_enable( &queue_context.Lock_context.Lock_context );
+    return RTEMS_NOT_DEFINED;
+  }
+
   _CORE_message_queue_Acquire_critical(
     &the_message_queue->message_queue,
     &queue_context
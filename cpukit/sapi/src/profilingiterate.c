@@ -19,11 +19,64 @@
 #include <rtems/profiling.h>
 #include <rtems/counter.h>
 #include <rtems/score/percpu.h>
+#include <rtems/score/schedulerimpl.h>
 #include <rtems/score/smplock.h>
 #include <rtems.h>
 
 #include <string.h>
 
+#ifdef RTEMS_PROFILING
+RTEMS_STATIC_ASSERT(
+  RTEMS_PROFILING_OPERATION_COUNT == PER_CPU_OPERATION_COUNT,
+  profiling_operation_count
+);
+
+RTEMS_STATIC_ASSERT(
+  RTEMS_PROFILING_HISTOGRAM_BINS == PER_CPU_OPERATION_HISTOGRAM_BINS,
+  profiling_histogram_bins
+);
+
+static void operation_stats_add(
+  Per_CPU_Operation_stats *sum,
+  const Per_CPU_Operation_stats *stats
+)
+{
+  size_t i;
+
+  sum->count += stats->count;
+  sum->total_time += stats->total_time;
+
+  if (sum->max_time < stats->max_time) {
+    sum->max_time = stats->max_time;
+  }
+
+  for (i = 0; i < PER_CPU_OPERATION_HISTOGRAM_BINS; ++i) {
+    sum->histogram[i] += stats->histogram[i];
+  }
+}
+
+static void operation_stats_convert(
+  rtems_profiling_operation_stats *operations,
+  const Per_CPU_Operation_stats *stats
+)
+{
+  size_t i;
+
+  for (i = 0; i < PER_CPU_OPERATION_COUNT; ++i) {
+    operations[i].max_time =
+      rtems_counter_ticks_to_nanoseconds(stats[i].max_time);
+    operations[i].count = stats[i].count;
+    operations[i].total_time =
+      rtems_counter_ticks_to_nanoseconds(stats[i].total_time);
+    memcpy(
+      &operations[i].histogram[0],
+      &stats[i].histogram[0],
+      sizeof(operations[i].histogram)
+    );
+  }
+}
+#endif
+
 static void per_cpu_stats_iterate(
   rtems_profiling_visitor visitor,
   void *visitor_arg,
@@ -69,6 +122,11 @@ static void per_cpu_stats_iterate(
         stats->total_interrupt_time
       );
 
+    operation_stats_convert(
+      &per_cpu_data->operations[0],
+      &stats->Operations[0]
+    );
+
     (*visitor)(visitor_arg, data);
   }
 #else
@@ -84,6 +142,12 @@ RTEMS_STATIC_ASSERT(
     == SMP_LOCK_STATS_CONTENTION_COUNTS,
   smp_lock_contention_counts
 );
+
+RTEMS_STATIC_ASSERT(
+  RTEMS_PROFILING_SMP_LOCK_ACQUIRE_TIME_BINS
+    == SMP_LOCK_STATS_ACQUIRE_TIME_BINS,
+  smp_lock_acquire_time_bins
+);
 #endif
 
 static void smp_lock_stats_iterate(
@@ -128,6 +192,14 @@ static void smp_lock_stats_iterate(
       sizeof(smp_lock_data->contention_counts)
     );
 
+    memcpy(
+      &smp_lock_data->acquire_time_histogram[0],
+      &snapshot.acquire_time_histogram[0],
+      sizeof(smp_lock_data->acquire_time_histogram)
+    );
+
+    smp_lock_data->other_cluster_count = snapshot.other_cluster_count;
+
     (*visitor)(visitor_arg, data);
   }
   _SMP_lock_Stats_iteration_stop(&iteration_context);
@@ -138,6 +210,78 @@ static void smp_lock_stats_iterate(
 #endif
 }
 
+static void scheduler_stats_iterate(
+  rtems_profiling_visitor visitor,
+  void *visitor_arg,
+  rtems_profiling_data *data
+)
+{
+#ifdef RTEMS_PROFILING
+  uint32_t cpu_max = rtems_scheduler_get_processor_maximum();
+  uint32_t scheduler_index;
+
+  for (
+    scheduler_index = 0;
+    scheduler_index < _Scheduler_Count;
+    ++scheduler_index
+  ) {
+    const Scheduler_Control *scheduler = &_Scheduler_Table[scheduler_index];
+    rtems_profiling_scheduler *scheduler_data = &data->scheduler;
+    Per_CPU_Operation_stats operations[PER_CPU_OPERATION_COUNT];
+    CPU_Counter_ticks max_thread_dispatch_disabled_time = 0;
+    uint64_t total_thread_dispatch_disabled_time = 0;
+    uint32_t cpu_index;
+    size_t i;
+
+    memset(data, 0, sizeof(*data));
+    memset(operations, 0, sizeof(operations));
+    data->header.type = RTEMS_PROFILING_SCHEDULER;
+    scheduler_data->name = scheduler->name;
+    scheduler_data->scheduler_index = scheduler_index;
+
+    for (cpu_index = 0; cpu_index < cpu_max; ++cpu_index) {
+      const Per_CPU_Control *per_cpu = _Per_CPU_Get_by_index(cpu_index);
+      const Per_CPU_Stats *stats = &per_cpu->Stats;
+
+      if (_Scheduler_Get_by_CPU(per_cpu) != scheduler) {
+        continue;
+      }
+
+      ++scheduler_data->processor_count;
+
+      if (
+        max_thread_dispatch_disabled_time
+          < stats->max_thread_dispatch_disabled_time
+      ) {
+        max_thread_dispatch_disabled_time =
+          stats->max_thread_dispatch_disabled_time;
+      }
+
+      scheduler_data->thread_dispatch_disabled_count +=
+        stats->thread_dispatch_disabled_count;
+      total_thread_dispatch_disabled_time +=
+        stats->total_thread_dispatch_disabled_time;
+
+      for (i = 0; i < PER_CPU_OPERATION_COUNT; ++i) {
+        operation_stats_add(&operations[i], &stats->Operations[i]);
+      }
+    }
+
+    scheduler_data->max_thread_dispatch_disabled_time =
+      rtems_counter_ticks_to_nanoseconds(max_thread_dispatch_disabled_time);
+    scheduler_data->total_thread_dispatch_disabled_time =
+      rtems_counter_ticks_to_nanoseconds(total_thread_dispatch_disabled_time);
+    operation_stats_convert(&scheduler_data->operations[0], &operations[0]);
+
+    (*visitor)(visitor_arg, data);
+  }
+#else
+  (void) visitor;
+  (void) visitor_arg;
+  (void) data;
+#endif
+}
+
 void rtems_profiling_iterate(
   rtems_profiling_visitor visitor,
   void *visitor_arg
@@ -146,5 +290,6 @@ void rtems_profiling_iterate(
   rtems_profiling_data data;
 
   per_cpu_stats_iterate(visitor, visitor_arg, &data);
+  scheduler_stats_iterate(visitor, visitor_arg, &data);
   smp_lock_stats_iterate(visitor, visitor_arg, &data);
 }
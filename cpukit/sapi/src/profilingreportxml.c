@@ -20,6 +20,9 @@
 
 #ifdef RTEMS_PROFILING
 
+#include <rtems/counter.h>
+#include <rtems.h>
+
 #include <inttypes.h>
 
 typedef struct {
@@ -53,6 +56,98 @@ static uint64_t arithmetic_mean(uint64_t total, uint64_t count)
   return count != 0 ? total / count : 0;
 }
 
+static const char * const operation_names[RTEMS_PROFILING_OPERATION_COUNT] = {
+  [RTEMS_PROFILING_OPERATION_SCHEDULER_BLOCK] = "SchedulerBlock",
+  [RTEMS_PROFILING_OPERATION_SCHEDULER_UNBLOCK] = "SchedulerUnblock",
+  [RTEMS_PROFILING_OPERATION_SCHEDULER_UPDATE_PRIORITY] =
+    "SchedulerUpdatePriority",
+  [RTEMS_PROFILING_OPERATION_THREAD_DISPATCH] = "ThreadDispatch"
+};
+
+static void report_operations(
+  context *ctx,
+  const rtems_profiling_operation_stats *operations
+)
+{
+  int rv;
+  uint32_t i;
+  uint32_t j;
+
+  for (i = 0; i < RTEMS_PROFILING_OPERATION_COUNT; ++i) {
+    const rtems_profiling_operation_stats *operation = &operations[i];
+
+    indent(ctx, 2);
+    rv = rtems_printf(
+      ctx->printer,
+      "<Operation name=\"%s\">\n",
+      operation_names[i]
+    );
+    update_retval(ctx, rv);
+
+    indent(ctx, 3);
+    rv = rtems_printf(
+      ctx->printer,
+      "<MaxTime unit=\"ns\">%" PRIu32 "</MaxTime>\n",
+      operation->max_time
+    );
+    update_retval(ctx, rv);
+
+    indent(ctx, 3);
+    rv = rtems_printf(
+      ctx->printer,
+      "<MeanTime unit=\"ns\">%" PRIu64 "</MeanTime>\n",
+      arithmetic_mean(operation->total_time, operation->count)
+    );
+    update_retval(ctx, rv);
+
+    indent(ctx, 3);
+    rv = rtems_printf(
+      ctx->printer,
+      "<TotalTime unit=\"ns\">%" PRIu64 "</TotalTime>\n",
+      operation->total_time
+    );
+    update_retval(ctx, rv);
+
+    indent(ctx, 3);
+    rv = rtems_printf(
+      ctx->printer,
+      "<Count>%" PRIu64 "</Count>\n",
+      operation->count
+    );
+    update_retval(ctx, rv);
+
+    for (j = 0; j < RTEMS_PROFILING_HISTOGRAM_BINS; ++j) {
+      uint32_t lower_bound;
+
+      if (operation->histogram[j] == 0) {
+        continue;
+      }
+
+      if (j > 0) {
+        lower_bound = rtems_counter_ticks_to_nanoseconds(
+          (rtems_counter_ticks) 1 << j
+        );
+      } else {
+        lower_bound = 0;
+      }
+
+      indent(ctx, 3);
+      rv = rtems_printf(
+        ctx->printer,
+        "<HistogramBin lowerBound=\"%" PRIu32 "\" unit=\"ns\">%" PRIu64
+          "</HistogramBin>\n",
+        lower_bound,
+        operation->histogram[j]
+      );
+      update_retval(ctx, rv);
+    }
+
+    indent(ctx, 2);
+    rv = rtems_printf(ctx->printer, "</Operation>\n");
+    update_retval(ctx, rv);
+  }
+}
+
 static void report_per_cpu(context *ctx, const rtems_profiling_per_cpu *per_cpu)
 {
   int rv;
@@ -148,6 +243,8 @@ static void report_per_cpu(context *ctx, const rtems_profiling_per_cpu *per_cpu)
   );
   update_retval(ctx, rv);
 
+  report_operations(ctx, &per_cpu->operations[0]);
+
   indent(ctx, 1);
   rv = rtems_printf(
     ctx->printer,
@@ -245,6 +342,40 @@ static void report_smp_lock(context *ctx, const rtems_profiling_smp_lock *smp_lo
     update_retval(ctx, rv);
   }
 
+  for (i = 0; i < RTEMS_PROFILING_SMP_LOCK_ACQUIRE_TIME_BINS; ++i) {
+    uint32_t lower_bound;
+
+    if (smp_lock->acquire_time_histogram[i] == 0) {
+      continue;
+    }
+
+    if (i > 0) {
+      lower_bound = rtems_counter_ticks_to_nanoseconds(
+        (rtems_counter_ticks) 1 << i
+      );
+    } else {
+      lower_bound = 0;
+    }
+
+    indent(ctx, 2);
+    rv = rtems_printf(
+      ctx->printer,
+      "<AcquireTimeHistogramBin lowerBound=\"%" PRIu32 "\" unit=\"ns\">%"
+        PRIu64 "</AcquireTimeHistogramBin>\n",
+      lower_bound,
+      smp_lock->acquire_time_histogram[i]
+    );
+    update_retval(ctx, rv);
+  }
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<OtherClusterCount>%" PRIu64 "</OtherClusterCount>\n",
+    smp_lock->other_cluster_count
+  );
+  update_retval(ctx, rv);
+
   indent(ctx, 1);
   rv = rtems_printf(
     ctx->printer,
@@ -253,6 +384,82 @@ static void report_smp_lock(context *ctx, const rtems_profiling_smp_lock *smp_lo
   update_retval(ctx, rv);
 }
 
+static void report_scheduler(
+  context *ctx,
+  const rtems_profiling_scheduler *scheduler
+)
+{
+  int rv;
+  char name[5];
+
+  rtems_name_to_characters(
+    scheduler->name,
+    &name[0],
+    &name[1],
+    &name[2],
+    &name[3]
+  );
+  name[4] = '\0';
+
+  indent(ctx, 1);
+  rv = rtems_printf(
+    ctx->printer,
+    "<SchedulerProfilingReport name=\"%s\" schedulerIndex=\"%" PRIu32
+      "\" processorCount=\"%" PRIu32 "\">\n",
+    name,
+    scheduler->scheduler_index,
+    scheduler->processor_count
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<MaxThreadDispatchDisabledTime unit=\"ns\">%" PRIu32
+      "</MaxThreadDispatchDisabledTime>\n",
+    scheduler->max_thread_dispatch_disabled_time
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<MeanThreadDispatchDisabledTime unit=\"ns\">%" PRIu64
+      "</MeanThreadDispatchDisabledTime>\n",
+    arithmetic_mean(
+      scheduler->total_thread_dispatch_disabled_time,
+      scheduler->thread_dispatch_disabled_count
+    )
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<TotalThreadDispatchDisabledTime unit=\"ns\">%" PRIu64
+      "</TotalThreadDispatchDisabledTime>\n",
+    scheduler->total_thread_dispatch_disabled_time
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<ThreadDispatchDisabledCount>%" PRIu64 "</ThreadDispatchDisabledCount>\n",
+    scheduler->thread_dispatch_disabled_count
+  );
+  update_retval(ctx, rv);
+
+  report_operations(ctx, &scheduler->operations[0]);
+
+  indent(ctx, 1);
+  rv = rtems_printf(
+    ctx->printer,
+    "</SchedulerProfilingReport>\n"
+  );
+  update_retval(ctx, rv);
+}
+
 static void report(void *arg, const rtems_profiling_data *data)
 {
   context *ctx = arg;
@@ -264,6 +471,9 @@ static void report(void *arg, const rtems_profiling_data *data)
     case RTEMS_PROFILING_SMP_LOCK:
       report_smp_lock(ctx, &data->smp_lock);
       break;
+    case RTEMS_PROFILING_SCHEDULER:
+      report_scheduler(ctx, &data->scheduler);
+      break;
   }
 }
 
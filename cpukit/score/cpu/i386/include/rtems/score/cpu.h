@@ -91,6 +91,14 @@ extern "C" {
 #define CPU_IDLE_TASK_IS_FP              FALSE
 #if defined(RTEMS_SMP)
   #define CPU_USE_DEFERRED_FP_SWITCH     FALSE
+#elif defined(RTEMS_LAZY_FP_SWITCH) && ( I386_HAS_FPU == 1 )
+  /*
+   *  The TS flag of CR0 disables the FPU for threads which do not own it.
+   *  The device not available exception loads the floating point context,
+   *  see _CPU_Context_Set_fp_enabled() and rtems_exception_prologue_7.
+   */
+  #define CPU_USE_DEFERRED_FP_SWITCH     FALSE
+  #define CPU_USE_LAZY_FP_SWITCH         TRUE
 #else
   #define CPU_USE_DEFERRED_FP_SWITCH     TRUE
 #endif
@@ -625,6 +633,35 @@ void _CPU_Context_restore_fp(
 );
 #endif
 
+#if CPU_USE_LAZY_FP_SWITCH == TRUE
+/*
+ *  _CPU_Context_Set_fp_enabled
+ *
+ *  This routine clears or sets the TS flag (CR0_FLOATING_INSTR_EXCEPTION) of
+ *  CR0 for the heir thread.  With the TS flag set, the first floating point
+ *  instruction raises the device not available exception.  The TS flag is
+ *  changed only if necessary, since a write to CR0 serializes the processor.
+ */
+static inline void _CPU_Context_Set_fp_enabled(
+  Context_Control *context,
+  bool             enabled
+)
+{
+  unsigned int cr0;
+
+  (void) context;
+  cr0 = i386_get_cr0();
+
+  if ( enabled ) {
+    if ( ( cr0 & CR0_FLOATING_INSTR_EXCEPTION ) != 0 ) {
+      __asm__ volatile ( "clts" );
+    }
+  } else if ( ( cr0 & CR0_FLOATING_INSTR_EXCEPTION ) == 0 ) {
+    i386_set_cr0( cr0 | CR0_FLOATING_INSTR_EXCEPTION );
+  }
+}
+#endif
+
 #ifdef __SSE__
 #define _CPU_Context_Initialization_at_thread_begin() \
   do {                                                \
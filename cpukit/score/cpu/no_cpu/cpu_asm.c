@@ -79,6 +79,24 @@ void _CPU_Context_restore_fp(
 {
 }
 
+/*
+ *  _CPU_Context_Set_fp_enabled
+ *
+ *  This routine enables or disables the floating point unit for the context
+ *  of the heir thread.  It is only used by the lazy FP switch.
+ *
+ *  NO_CPU Specific Information:
+ *
+ *  XXX document implementation including references if appropriate
+ */
+
+void _CPU_Context_Set_fp_enabled(
+  Context_Control *context,
+  bool             enabled
+)
+{
+}
+
 /*  _CPU_Context_switch
  *
  *  This routine performs a normal non-FP context switch.
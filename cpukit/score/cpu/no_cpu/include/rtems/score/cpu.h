@@ -185,6 +185,33 @@ extern "C" {
  */
 #define CPU_USE_DEFERRED_FP_SWITCH       TRUE
 
+/**
+ * Should the floating point context be switched lazily?
+ *
+ * If TRUE, then the floating point unit is disabled for a thread which does
+ * not own the floating point registers of the processor.  The first floating
+ * point instruction of such a thread raises an exception.  The exception
+ * handler must enable the floating point unit for the interrupted context and
+ * call _Thread_Lazy_fp_switch() with interrupts disabled.  This saves the
+ * floating point context of the previous owner and restores the context of
+ * the executing thread.  Threads which do not use the floating point unit
+ * during their time slice pay no floating point context switch costs.  On
+ * SMP configurations, the floating point context of the owner is saved when
+ * it is switched out, so that it can continue on another processor.  The
+ * registers must stay valid after this save operation.
+ *
+ * If TRUE, then the port must provide _CPU_Context_Set_fp_enabled() and
+ * CPU_USE_DEFERRED_FP_SWITCH must be FALSE.
+ *
+ * If FALSE or undefined, then the floating point context is switched as
+ * specified by CPU_USE_DEFERRED_FP_SWITCH.
+ *
+ * Port Specific Information:
+ *
+ * XXX document implementation including references if appropriate
+ */
+#define CPU_USE_LAZY_FP_SWITCH           FALSE
+
 /**
  * @brief Enables a robust thread dispatch if set to TRUE.
  *
@@ -1119,6 +1146,24 @@ void _CPU_Context_restore_fp(
   Context_Control_fp **fp_context_ptr
 );
 
+/**
+ * @addtogroup RTEMSScoreCPUExampleContext
+ *
+ * This routine enables or disables the floating point unit for a context.  It
+ * is only necessary if CPU_USE_LAZY_FP_SWITCH is TRUE.
+ *
+ * @param[in] context is the context of the heir thread.
+ * @param[in] enabled indicates if the floating point unit is enabled.
+ *
+ * Port Specific Information:
+ *
+ * XXX document implementation including references if appropriate
+ */
+void _CPU_Context_Set_fp_enabled(
+  Context_Control *context,
+  bool             enabled
+);
+
 /**
  * @brief The set of registers that specifies the complete processor state.
  *
@@ -185,6 +185,103 @@ static uintptr_t _Heap_Check_block(
   return 0;
 }
 
+static uintptr_t _Heap_Search_free_list(
+  Heap_Control *heap,
+  Heap_Block **block_ptr,
+  const Heap_Block *stop,
+  uintptr_t alloc_size,
+  uintptr_t alignment,
+  uintptr_t boundary,
+  uint32_t *search_count
+)
+{
+  uintptr_t const block_size_floor = alloc_size + HEAP_BLOCK_HEADER_SIZE
+    - HEAP_ALLOC_BONUS;
+  Heap_Block *block = *block_ptr;
+  uintptr_t alloc_begin = 0;
+
+  while ( block != stop ) {
+    _HAssert( _Heap_Is_prev_used( block ) );
+
+    _Heap_Protection_block_check( heap, block );
+
+    /*
+     * The HEAP_PREV_BLOCK_USED flag is always set in the block size_and_flag
+     * field.  Thus the value is about one unit larger than the real block
+     * size.  The greater than operator takes this into account.
+     */
+    if ( block->size_and_flag > block_size_floor ) {
+      if ( alignment == 0 ) {
+        alloc_begin = _Heap_Alloc_area_of_block( block );
+      } else {
+        alloc_begin = _Heap_Check_block(
+          heap,
+          block,
+          alloc_size,
+          alignment,
+          boundary
+        );
+      }
+    }
+
+    /* Statistics */
+    ++*search_count;
+
+    if ( alloc_begin != 0 ) {
+      break;
+    }
+
+    block = block->next;
+  }
+
+  *block_ptr = block;
+
+  return alloc_begin;
+}
+
+/*
+ * Returns the first free block of the size class which contains the block
+ * size or of the next non-empty size class.  In case the block size is rounded
+ * up to the next size class, then each block of the returned size class is
+ * large enough for the allocation.
+ */
+static Heap_Block *_Heap_Segregated_fit_first(
+  Heap_Control *heap,
+  uintptr_t block_size,
+  bool round_up
+)
+{
+  Heap_Block *block;
+  unsigned int fl;
+  unsigned int sl;
+
+  if ( block_size < heap->min_block_size ) {
+    block_size = heap->min_block_size;
+  }
+
+  if ( round_up ) {
+    uintptr_t const rounded_block_size = block_size + ( (uintptr_t) 1
+      << ( _Heap_Segregated_fit_msb( block_size )
+        - HEAP_SEGREGATED_FIT_SECOND_LEVEL_BITS ) ) - 1;
+
+    if ( rounded_block_size < block_size ) {
+      /* Integer overflow occured */
+      return _Heap_Free_list_tail( heap );
+    }
+
+    block_size = rounded_block_size;
+  }
+
+  _Heap_Segregated_fit_map( block_size, &fl, &sl );
+  block = _Heap_Segregated_fit_find( heap->segregated_fit, fl, sl );
+
+  if ( block == NULL ) {
+    block = _Heap_Free_list_tail( heap );
+  }
+
+  return block;
+}
+
 void *_Heap_Allocate_aligned_with_boundary(
   Heap_Control *heap,
   uintptr_t alloc_size,
@@ -219,39 +316,50 @@ void *_Heap_Allocate_aligned_with_boundary(
   do {
     Heap_Block *const free_list_tail = _Heap_Free_list_tail( heap );
 
-    block = _Heap_Free_list_first( heap );
-    while ( block != free_list_tail ) {
-      _HAssert( _Heap_Is_prev_used( block ) );
-
-      _Heap_Protection_block_check( heap, block );
+    if ( heap->segregated_fit == NULL ) {
+      block = _Heap_Free_list_first( heap );
+      alloc_begin = _Heap_Search_free_list(
+        heap,
+        &block,
+        free_list_tail,
+        alloc_size,
+        alignment,
+        boundary,
+        &search_count
+      );
+    } else {
+      Heap_Block *const good_fit =
+        _Heap_Segregated_fit_first( heap, block_size_floor, true );
 
       /*
-       * The HEAP_PREV_BLOCK_USED flag is always set in the block size_and_flag
-       * field.  Thus the value is about one unit larger than the real block
-       * size.  The greater than operator takes this into account.
+       * Without an alignment or boundary constraint, the first block of the
+       * good fit size class satisfies the allocation request.  The free list
+       * is sorted by size class, so only the blocks of the size class which
+       * contains the requested size need a second look in case this fails.
        */
-      if ( block->size_and_flag > block_size_floor ) {
-        if ( alignment == 0 ) {
-          alloc_begin = _Heap_Alloc_area_of_block( block );
-        } else {
-          alloc_begin = _Heap_Check_block(
-            heap,
-            block,
-            alloc_size,
-            alignment,
-            boundary
-          );
-        }
-      }
-
-      /* Statistics */
-      ++search_count;
-
-      if ( alloc_begin != 0 ) {
-        break;
+      block = good_fit;
+      alloc_begin = _Heap_Search_free_list(
+        heap,
+        &block,
+        free_list_tail,
+        alloc_size,
+        alignment,
+        boundary,
+        &search_count
+      );
+
+      if ( alloc_begin == 0 ) {
+        block = _Heap_Segregated_fit_first( heap, block_size_floor, false );
+        alloc_begin = _Heap_Search_free_list(
+          heap,
+          &block,
+          good_fit,
+          alloc_size,
+          alignment,
+          boundary,
+          &search_count
+        );
       }
-
-      block = block->next;
     }
 
     search_again = _Heap_Protection_free_delayed_blocks( heap, alloc_begin );
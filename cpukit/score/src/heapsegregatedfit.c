@@ -0,0 +1,81 @@
+/**
+ * @file
+ *
+ * @ingroup RTEMSScoreHeap
+ *
+ * @brief _Heap_Initialize_segregated_fit() implementation.
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/score/heapimpl.h>
+
+#include <string.h>
+
+uintptr_t _Heap_Initialize_segregated_fit(
+  Heap_Control *heap,
+  void *heap_area_begin_ptr,
+  uintptr_t heap_area_size,
+  uintptr_t page_size
+)
+{
+  uintptr_t const heap_area_begin = (uintptr_t) heap_area_begin_ptr;
+  uintptr_t const index_begin = _Heap_Align_up( heap_area_begin, CPU_ALIGNMENT );
+  uintptr_t const index_end = index_begin + sizeof( Heap_Segregated_fit );
+  uintptr_t const overhead = index_end - heap_area_begin;
+  Heap_Segregated_fit *const index = (Heap_Segregated_fit *) index_begin;
+  Heap_Block *first_block;
+  uintptr_t first_block_size;
+
+  if ( index_end < heap_area_begin || heap_area_size <= overhead ) {
+    /* Invalid area or area too small */
+    return 0;
+  }
+
+  first_block_size = _Heap_Initialize(
+    heap,
+    (void *) index_end,
+    heap_area_size - overhead,
+    page_size
+  );
+
+  if ( first_block_size == 0 ) {
+    return 0;
+  }
+
+  memset( index, 0, sizeof( *index ) );
+  heap->segregated_fit = index;
+
+  first_block = heap->first_block;
+  _Heap_Free_list_remove( first_block );
+  _Heap_Segregated_fit_insert( heap, first_block, first_block_size );
+
+  return first_block_size;
+}
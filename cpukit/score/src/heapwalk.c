@@ -119,6 +119,113 @@ static bool _Heap_Walk_check_free_list(
   return true;
 }
 
+static bool _Heap_Walk_check_segregated_fit(
+  int source,
+  Heap_Walk_printer printer,
+  Heap_Control *heap
+)
+{
+  const Heap_Segregated_fit *const index = heap->segregated_fit;
+  const Heap_Block *const free_list_tail = _Heap_Free_list_tail( heap );
+  const Heap_Block *free_block = _Heap_Free_list_first( heap );
+  unsigned int prev_fl = 0;
+  unsigned int prev_sl = 0;
+  unsigned int fl;
+  unsigned int sl;
+  unsigned int class_count = 0;
+  unsigned int expected_class_count = 0;
+
+  while ( free_block != free_list_tail ) {
+    _Heap_Segregated_fit_map( _Heap_Block_size( free_block ), &fl, &sl );
+
+    if ( fl < prev_fl || ( fl == prev_fl && sl < prev_sl ) ) {
+      (*printer)(
+        source,
+        true,
+        "free block 0x%08x: size class not sorted\n",
+        free_block
+      );
+
+      return false;
+    }
+
+    if ( class_count == 0 || fl != prev_fl || sl != prev_sl ) {
+      if (
+        index->first[ fl ][ sl ] != free_block
+          || ( index->first_level_map & ( (uintptr_t) 1 << fl ) ) == 0
+          || ( index->second_level_map[ fl ] & ( (uint32_t) 1 << sl ) ) == 0
+      ) {
+        (*printer)(
+          source,
+          true,
+          "free block 0x%08x: not first block of size class %u/%u\n",
+          free_block,
+          fl,
+          sl
+        );
+
+        return false;
+      }
+
+      ++class_count;
+    }
+
+    prev_fl = fl;
+    prev_sl = sl;
+    free_block = free_block->next;
+  }
+
+  for ( fl = 0; fl < HEAP_SEGREGATED_FIT_FIRST_LEVEL_COUNT; ++fl ) {
+    bool const fl_set =
+      ( index->first_level_map & ( (uintptr_t) 1 << fl ) ) != 0;
+
+    if ( fl_set != ( index->second_level_map[ fl ] != 0 ) ) {
+      (*printer)(
+        source,
+        true,
+        "segregated fit index: invalid first level map for %u\n",
+        fl
+      );
+
+      return false;
+    }
+
+    for ( sl = 0; sl < HEAP_SEGREGATED_FIT_SECOND_LEVEL_COUNT; ++sl ) {
+      bool const sl_set =
+        ( index->second_level_map[ fl ] & ( (uint32_t) 1 << sl ) ) != 0;
+
+      if ( sl_set != ( index->first[ fl ][ sl ] != NULL ) ) {
+        (*printer)(
+          source,
+          true,
+          "segregated fit index: invalid second level map for %u/%u\n",
+          fl,
+          sl
+        );
+
+        return false;
+      }
+
+      if ( sl_set ) {
+        ++expected_class_count;
+      }
+    }
+  }
+
+  if ( class_count != expected_class_count ) {
+    (*printer)(
+      source,
+      true,
+      "segregated fit index: unexpected size class count %u\n",
+      expected_class_count
+    );
+
+    return false;
+  }
+
+  return true;
+}
+
 static bool _Heap_Walk_is_in_free_list(
   Heap_Control *heap,
   Heap_Block *block
@@ -236,7 +343,15 @@ static bool _Heap_Walk_check_control(
     return false;
   }
 
-  return _Heap_Walk_check_free_list( source, printer, heap );
+  if ( !_Heap_Walk_check_free_list( source, printer, heap ) ) {
+    return false;
+  }
+
+  if ( heap->segregated_fit != NULL ) {
+    return _Heap_Walk_check_segregated_fit( source, printer, heap );
+  }
+
+  return true;
 }
 
 static bool _Heap_Walk_check_free_block(
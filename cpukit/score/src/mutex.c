@@ -19,6 +19,8 @@
 #include <sys/lock.h>
 #include <errno.h>
 
+#include <rtems/thread.h>
+
 #include <rtems/score/assert.h>
 #include <rtems/score/muteximpl.h>
 #include <rtems/score/threadimpl.h>
@@ -55,6 +57,23 @@ RTEMS_STATIC_ASSERT(
   MUTEX_RECURSIVE_CONTROL_SIZE
 );
 
+RTEMS_STATIC_ASSERT(
+  offsetof( Mutex_fast_Control, Mutex )
+    == offsetof( struct _Mutex_fast_Control, _Mutex ),
+  MUTEX_FAST_CONTROL_MUTEX
+);
+
+RTEMS_STATIC_ASSERT(
+  offsetof( Mutex_fast_Control, owner )
+    == offsetof( struct _Mutex_fast_Control, _owner ),
+  MUTEX_FAST_CONTROL_OWNER
+);
+
+RTEMS_STATIC_ASSERT(
+  sizeof( Mutex_fast_Control ) == sizeof( struct _Mutex_fast_Control ),
+  MUTEX_FAST_CONTROL_SIZE
+);
+
 static Mutex_Control *_Mutex_Get( struct _Mutex_Control *_mutex )
 {
   return (Mutex_Control *) _mutex;
@@ -380,3 +399,204 @@ void _Mutex_recursive_Release( struct _Mutex_recursive_Control *_mutex )
     _Mutex_Queue_release( &mutex->Mutex, level, &queue_context );
   }
 }
+
+static Mutex_fast_Control *_Mutex_fast_Get(
+  struct _Mutex_fast_Control *_mutex
+)
+{
+  return (Mutex_fast_Control *) _mutex;
+}
+
+static bool _Mutex_fast_Try_acquire_owner_word(
+  Mutex_fast_Control *mutex,
+  Thread_Control     *executing
+)
+{
+  uintptr_t owner_word;
+
+  owner_word = 0;
+  return _Atomic_Compare_exchange_uintptr(
+    &mutex->owner,
+    &owner_word,
+    (uintptr_t) executing,
+    ATOMIC_ORDER_ACQUIRE,
+    ATOMIC_ORDER_RELAXED
+  );
+}
+
+static void _Mutex_fast_Acquire_contended( Mutex_fast_Control *mutex )
+{
+  Thread_queue_Context  queue_context;
+  ISR_Level             level;
+  Thread_Control       *executing;
+  Thread_Control       *owner;
+  uintptr_t             owner_word;
+
+  _Thread_queue_Context_initialize( &queue_context );
+  _Thread_queue_Context_ISR_disable( &queue_context, level );
+  executing = _Mutex_Queue_acquire_critical( &mutex->Mutex, &queue_context );
+
+  owner_word = _Atomic_Load_uintptr( &mutex->owner, ATOMIC_ORDER_RELAXED );
+
+  while ( true ) {
+    if ( owner_word == 0 ) {
+      if (
+        _Atomic_Compare_exchange_uintptr(
+          &mutex->owner,
+          &owner_word,
+          (uintptr_t) executing,
+          ATOMIC_ORDER_ACQUIRE,
+          ATOMIC_ORDER_RELAXED
+        )
+      ) {
+        _Thread_Resource_count_increment( executing );
+        _Mutex_Queue_release( &mutex->Mutex, level, &queue_context );
+        return;
+      }
+    } else if (
+      ( owner_word & MUTEX_FAST_WAITERS ) != 0
+        || _Atomic_Compare_exchange_uintptr(
+          &mutex->owner,
+          &owner_word,
+          owner_word | MUTEX_FAST_WAITERS,
+          ATOMIC_ORDER_RELAXED,
+          ATOMIC_ORDER_RELAXED
+        )
+    ) {
+      break;
+    }
+  }
+
+  /*
+   * The owner can no longer release the mutex without the thread queue lock,
+   * so the thread queue owner is valid for the priority inheritance.
+   */
+  owner = (Thread_Control *) ( owner_word & ~MUTEX_FAST_WAITERS );
+  _Assert(
+    ( owner_word & MUTEX_FAST_WAITERS ) == 0
+      || mutex->Mutex.Queue.Queue.owner == owner
+  );
+  mutex->Mutex.Queue.Queue.owner = owner;
+
+  _Thread_queue_Context_set_enqueue_do_nothing_extra( &queue_context );
+  _Mutex_Acquire_slow(
+    &mutex->Mutex,
+    owner,
+    executing,
+    level,
+    &queue_context
+  );
+}
+
+void _Mutex_fast_Acquire( struct _Mutex_fast_Control *_mutex )
+{
+  Mutex_fast_Control *mutex;
+  Thread_Control     *executing;
+
+  mutex = _Mutex_fast_Get( _mutex );
+  executing = _Thread_Get_executing();
+
+  if (
+    RTEMS_PREDICT_TRUE(
+      _Mutex_fast_Try_acquire_owner_word( mutex, executing )
+    )
+  ) {
+    _Thread_Resource_count_increment( executing );
+    return;
+  }
+
+  _Mutex_fast_Acquire_contended( mutex );
+}
+
+int _Mutex_fast_Try_acquire( struct _Mutex_fast_Control *_mutex )
+{
+  Mutex_fast_Control *mutex;
+  Thread_Control     *executing;
+
+  mutex = _Mutex_fast_Get( _mutex );
+  executing = _Thread_Get_executing();
+
+  if ( _Mutex_fast_Try_acquire_owner_word( mutex, executing ) ) {
+    _Thread_Resource_count_increment( executing );
+    return 0;
+  }
+
+  return EBUSY;
+}
+
+static void _Mutex_fast_Release_contended( Mutex_fast_Control *mutex )
+{
+  Thread_queue_Context  queue_context;
+  ISR_Level             level;
+  Thread_Control       *executing;
+  Thread_queue_Heads   *heads;
+
+  _Thread_queue_Context_initialize( &queue_context );
+  _Thread_queue_Context_ISR_disable( &queue_context, level );
+  executing = _Mutex_Queue_acquire_critical( &mutex->Mutex, &queue_context );
+
+  _Assert(
+    _Atomic_Load_uintptr( &mutex->owner, ATOMIC_ORDER_RELAXED )
+      == ( (uintptr_t) executing | MUTEX_FAST_WAITERS )
+  );
+  _Assert( mutex->Mutex.Queue.Queue.owner == executing );
+
+  heads = mutex->Mutex.Queue.Queue.heads;
+  _Thread_Resource_count_decrement( executing );
+
+  if ( heads == NULL ) {
+    mutex->Mutex.Queue.Queue.owner = NULL;
+    _Atomic_Store_uintptr( &mutex->owner, 0, ATOMIC_ORDER_RELEASE );
+    _Mutex_Queue_release( &mutex->Mutex, level, &queue_context );
+  } else {
+    Thread_Control *new_owner;
+
+    /*
+     * Hand over the mutex to the first waiting thread.  The new owner keeps
+     * the flag, since more threads may wait for the mutex.
+     */
+    new_owner = ( *MUTEX_TQ_OPERATIONS->first )( heads );
+    _Atomic_Store_uintptr(
+      &mutex->owner,
+      (uintptr_t) new_owner | MUTEX_FAST_WAITERS,
+      ATOMIC_ORDER_RELEASE
+    );
+    _Thread_queue_Context_set_ISR_level( &queue_context, level );
+    _Thread_queue_Surrender(
+      &mutex->Mutex.Queue.Queue,
+      heads,
+      executing,
+      &queue_context,
+      MUTEX_TQ_OPERATIONS
+    );
+  }
+}
+
+void _Mutex_fast_Release( struct _Mutex_fast_Control *_mutex )
+{
+  Mutex_fast_Control *mutex;
+  Thread_Control     *executing;
+  uintptr_t           owner_word;
+
+  mutex = _Mutex_fast_Get( _mutex );
+  executing = _Thread_Get_executing();
+  owner_word = (uintptr_t) executing;
+
+  if (
+    RTEMS_PREDICT_TRUE(
+      _Atomic_Compare_exchange_uintptr(
+        &mutex->owner,
+        &owner_word,
+        0,
+        ATOMIC_ORDER_RELEASE,
+        ATOMIC_ORDER_RELAXED
+      )
+    )
+  ) {
+    _Thread_Resource_count_decrement( executing );
+    return;
+  }
+
+  _Assert( owner_word == ( (uintptr_t) executing | MUTEX_FAST_WAITERS ) );
+  _Mutex_fast_Release_contended( mutex );
+}
@@ -226,6 +226,15 @@ void _Objects_Extend_information(
 
     _Workspace_Free( old_tables );
 
+    /*
+     *  The name index is sized according to the maximum index.  If there is
+     *  not enough memory to grow it, then the name lookups use the local
+     *  table.
+     */
+    if ( information->name_index != NULL ) {
+      (void) _Objects_Name_index_create( information );
+    }
+
     block_count++;
   }
 
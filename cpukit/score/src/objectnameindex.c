@@ -0,0 +1,319 @@
+/**
+ * @file
+ *
+ * @ingroup RTEMSScoreObject
+ *
+ * @brief Object Name Index
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/score/objectimpl.h>
+#include <rtems/score/address.h>
+#include <rtems/score/assert.h>
+#include <rtems/score/wkspace.h>
+
+#include <string.h>
+
+static uint32_t _Objects_Name_index_hash_u32( uint32_t name )
+{
+  /* Finalization step of MurmurHash3, the names are often similar */
+  name ^= name >> 16;
+  name *= 0x85ebca6bU;
+  name ^= name >> 13;
+  name *= 0xc2b2ae35U;
+  name ^= name >> 16;
+
+  return name;
+}
+
+static uint32_t _Objects_Name_index_hash_string(
+  const char *name,
+  size_t      max_name_length
+)
+{
+  uint32_t hash;
+  size_t   i;
+
+  /* FNV-1a, see strncmp() in _Objects_Name_index_find_string() */
+  hash = 2166136261U;
+
+  for ( i = 0; i < max_name_length && name[ i ] != '\0'; ++i ) {
+    hash ^= (unsigned char) name[ i ];
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+static bool _Objects_Name_index_hash_object(
+  const Objects_Information *information,
+  const Objects_Control     *the_object,
+  uint32_t                  *hash
+)
+{
+  if ( _Objects_Has_string_name( information ) ) {
+    if ( the_object->name.name_p == NULL ) {
+      return false;
+    }
+
+    *hash = _Objects_Name_index_hash_string(
+      the_object->name.name_p,
+      information->name_length
+    );
+  } else {
+    if ( the_object->name.name_u32 == 0 ) {
+      return false;
+    }
+
+    *hash = _Objects_Name_index_hash_u32( the_object->name.name_u32 );
+  }
+
+  return true;
+}
+
+static Objects_Maximum _Objects_Name_index_local_index(
+  const Objects_Control *the_object
+)
+{
+  return (Objects_Maximum)
+    ( _Objects_Get_index( the_object->id ) - OBJECTS_INDEX_MINIMUM );
+}
+
+void _Objects_Name_index_insert(
+  const Objects_Information *information,
+  const Objects_Control     *the_object
+)
+{
+  Objects_Name_index *index;
+  Objects_Maximum    *head;
+  Objects_Maximum     local_index;
+  uint32_t            hash;
+
+  index = information->name_index;
+  _Assert( index != NULL );
+
+  if ( !_Objects_Name_index_hash_object( information, the_object, &hash ) ) {
+    return;
+  }
+
+  local_index = _Objects_Name_index_local_index( the_object );
+  head = &index->buckets[ hash & index->bucket_mask ];
+  index->next[ local_index ] = *head;
+  *head = (Objects_Maximum) ( local_index + 1 );
+}
+
+void _Objects_Name_index_remove(
+  const Objects_Information *information,
+  const Objects_Control     *the_object
+)
+{
+  Objects_Name_index *index;
+  Objects_Maximum    *link;
+  Objects_Maximum     local_index;
+  uint32_t            hash;
+
+  index = information->name_index;
+  _Assert( index != NULL );
+
+  if ( !_Objects_Name_index_hash_object( information, the_object, &hash ) ) {
+    return;
+  }
+
+  local_index = _Objects_Name_index_local_index( the_object );
+  link = &index->buckets[ hash & index->bucket_mask ];
+
+  while ( *link != 0 ) {
+    Objects_Maximum current;
+
+    current = (Objects_Maximum) ( *link - 1 );
+
+    if ( current == local_index ) {
+      *link = index->next[ local_index ];
+      return;
+    }
+
+    link = &index->next[ current ];
+  }
+}
+
+Objects_Control *_Objects_Name_index_find_u32(
+  const Objects_Information *information,
+  uint32_t                   name
+)
+{
+  const Objects_Name_index *index;
+  Objects_Control          *found;
+  Objects_Maximum           link;
+  uint32_t                  hash;
+
+  index = information->name_index;
+  _Assert( index != NULL );
+  _Assert( !_Objects_Has_string_name( information ) );
+
+  found = NULL;
+  hash = _Objects_Name_index_hash_u32( name );
+  link = index->buckets[ hash & index->bucket_mask ];
+
+  while ( link != 0 ) {
+    Objects_Control *the_object;
+
+    the_object = information->local_table[ link - 1 ];
+    _Assert( the_object != NULL );
+
+    /* Use the lowest index in case of duplicate names like the table search */
+    if (
+      the_object->name.name_u32 == name
+        && ( found == NULL || the_object->id < found->id )
+    ) {
+      found = the_object;
+    }
+
+    link = index->next[ link - 1 ];
+  }
+
+  return found;
+}
+
+Objects_Control *_Objects_Name_index_find_string(
+  const Objects_Information *information,
+  const char                *name
+)
+{
+  const Objects_Name_index *index;
+  Objects_Control          *found;
+  Objects_Maximum           link;
+  size_t                    max_name_length;
+  uint32_t                  hash;
+
+  index = information->name_index;
+  _Assert( index != NULL );
+  _Assert( _Objects_Has_string_name( information ) );
+
+  found = NULL;
+  max_name_length = information->name_length;
+  hash = _Objects_Name_index_hash_string( name, max_name_length );
+  link = index->buckets[ hash & index->bucket_mask ];
+
+  while ( link != 0 ) {
+    Objects_Control *the_object;
+
+    the_object = information->local_table[ link - 1 ];
+    _Assert( the_object != NULL );
+    _Assert( the_object->name.name_p != NULL );
+
+    if (
+      strncmp( name, the_object->name.name_p, max_name_length ) == 0
+        && ( found == NULL || the_object->id < found->id )
+    ) {
+      found = the_object;
+    }
+
+    link = index->next[ link - 1 ];
+  }
+
+  return found;
+}
+
+bool _Objects_Name_index_create( Objects_Information *information )
+{
+  Objects_Name_index *index;
+  Objects_Maximum     maximum;
+  Objects_Maximum     local_index;
+  uint32_t            bucket_count;
+  size_t              buckets_size;
+  size_t              next_size;
+
+  _Workspace_Free( information->name_index );
+  information->name_index = NULL;
+
+  maximum = _Objects_Get_maximum_index( information );
+  bucket_count = 1;
+
+  while ( bucket_count < maximum ) {
+    bucket_count <<= 1;
+  }
+
+  buckets_size = bucket_count * sizeof( *index->buckets );
+  next_size = maximum * sizeof( *index->next );
+  index = _Workspace_Allocate( sizeof( *index ) + buckets_size + next_size );
+  if ( index == NULL ) {
+    return false;
+  }
+
+  index->bucket_mask = bucket_count - 1;
+  index->buckets = _Addresses_Add_offset( index, sizeof( *index ) );
+  index->next = _Addresses_Add_offset( index->buckets, buckets_size );
+  memset( index->buckets, 0, buckets_size );
+
+  information->name_index = index;
+
+  for ( local_index = 0; local_index < maximum; ++local_index ) {
+    Objects_Control *the_object;
+
+    the_object = information->local_table[ local_index ];
+
+    if ( the_object != NULL ) {
+      _Objects_Name_index_insert( information, the_object );
+    }
+  }
+
+  return true;
+}
+
+void _Objects_Name_index_initialize( void )
+{
+  uint32_t api;
+
+  for ( api = OBJECTS_INTERNAL_API; api <= OBJECTS_APIS_LAST; ++api ) {
+    unsigned int maximum_class;
+    unsigned int the_class;
+
+    maximum_class = _Objects_API_maximum_class( api );
+
+    /*
+     * The thread classes use the class number one.  They have no name index,
+     * since an exiting thread closes its object without the object allocator
+     * mutex, see _Thread_Life_action_handler().
+     */
+    for ( the_class = 2; the_class <= maximum_class; ++the_class ) {
+      Objects_Information *information;
+
+      information = _Objects_Get_information( api, (uint16_t) the_class );
+
+      if (
+        information != NULL
+          && _Objects_Get_maximum_index( information ) > 0
+      ) {
+        (void) _Objects_Name_index_create( information );
+      }
+    }
+  }
+}
@@ -28,6 +28,11 @@ void _Objects_Namespace_remove_u32(
 )
 {
   _Assert( !_Objects_Has_string_name( information ) );
+
+  if ( information->name_index != NULL ) {
+    _Objects_Name_index_remove( information, the_object );
+  }
+
   the_object->name.name_u32 = 0;
 }
 
@@ -39,6 +44,11 @@ void _Objects_Namespace_remove_string(
   char *name;
 
   _Assert( _Objects_Has_string_name( information ) );
+
+  if ( information->name_index != NULL ) {
+    _Objects_Name_index_remove( information, the_object );
+  }
+
   name = RTEMS_DECONST( char *, the_object->name.name_p );
   the_object->name.name_p = NULL;
   _Workspace_Free( name );
@@ -53,6 +53,33 @@ Objects_Name_or_id_lookup_errors _Objects_Name_to_id_u32(
       ))
    search_local_node = true;
 
+  if ( search_local_node && information->name_index != NULL ) {
+    /*
+     * The name index is maintained by the owner of the object allocator mutex.
+     * It may be re-created or dropped by _Objects_Extend_information(), so
+     * check it again while we own the mutex.
+     */
+    _Objects_Allocator_lock();
+
+    if ( information->name_index != NULL ) {
+      the_object = _Objects_Name_index_find_u32( information, name );
+
+      if ( the_object != NULL ) {
+        *id = the_object->id;
+      }
+
+      search_local_node = false;
+    } else {
+      the_object = NULL;
+    }
+
+    _Objects_Allocator_unlock();
+
+    if ( the_object != NULL ) {
+      return OBJECTS_NAME_OR_ID_LOOKUP_SUCCESSFUL;
+    }
+  }
+
   if ( search_local_node ) {
     for ( index = 0; index < maximum; ++index ) {
       the_object = information->local_table[ index ];
@@ -18,6 +18,7 @@
 
 #include <rtems/score/profiling.h>
 #include <rtems/score/assert.h>
+#include <rtems/score/thread.h>
 
 void _Profiling_Outer_most_interrupt_entry_and_exit(
   Per_CPU_Control *cpu,
@@ -25,17 +26,26 @@ void _Profiling_Outer_most_interrupt_entry_and_exit(
   CPU_Counter_ticks interrupt_exit_instant
 )
 {
+#if defined(RTEMS_SCORE_INTERRUPT_INSTANTS)
+  CPU_Counter_ticks  delta;
 #if defined(RTEMS_PROFILING)
   Per_CPU_Stats     *stats;
-  CPU_Counter_ticks  delta;
+#endif
 
   _Assert( cpu->isr_nest_level == 1 );
 
-  stats = &cpu->Stats;
   delta = _CPU_Counter_difference(
     interrupt_exit_instant,
     interrupt_entry_instant
   );
+
+#if defined(RTEMS_THREAD_ACCOUNTING)
+  /* The executing thread is the interrupted thread until the next dispatch */
+  cpu->executing->Accounting.isr_ticks += delta;
+#endif
+
+#if defined(RTEMS_PROFILING)
+  stats = &cpu->Stats;
   ++stats->interrupt_count;
   stats->total_interrupt_time += delta;
 
@@ -46,6 +56,7 @@ void _Profiling_Outer_most_interrupt_entry_and_exit(
   if ( cpu->thread_dispatch_disable_level == 1 ) {
     stats->thread_dispatch_disabled_instant = interrupt_entry_instant;
   }
+#endif
 #else
   (void) cpu;
   (void) interrupt_entry_instant;
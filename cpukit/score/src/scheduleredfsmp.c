@@ -64,7 +64,7 @@ void _Scheduler_EDF_SMP_Initialize( const Scheduler_Control *scheduler )
     _Scheduler_EDF_SMP_Get_context( scheduler );
 
   _Scheduler_SMP_Initialize( &self->Base );
-  _Chain_Initialize_empty( &self->Affine_queues );
+  _RBTree_Initialize_empty( &self->Affine_queues );
   /* The ready queues are zero initialized and thus empty */
 }
 
@@ -99,7 +99,7 @@ static inline bool _Scheduler_EDF_SMP_Has_ready( Scheduler_Context *context )
 {
   Scheduler_EDF_SMP_Context *self = _Scheduler_EDF_SMP_Get_self( context );
 
-  return !_RBTree_Is_empty( &self->Ready[ 0 ].Queue );
+  return self->Ready[ 0 ].minimum != NULL;
 }
 
 static inline bool _Scheduler_EDF_SMP_Overall_less(
@@ -116,16 +116,76 @@ static inline bool _Scheduler_EDF_SMP_Overall_less(
   return lp < rp || (lp == rp && left->generation < right->generation );
 }
 
+static inline bool _Scheduler_EDF_SMP_Affine_less(
+  const void        *left,
+  const RBTree_Node *right
+)
+{
+  const Scheduler_EDF_SMP_Node        *the_left;
+  const Scheduler_EDF_SMP_Ready_queue *the_right;
+
+  the_left = left;
+  the_right = RTEMS_CONTAINER_OF( right, Scheduler_EDF_SMP_Ready_queue, Node );
+
+  return _Scheduler_EDF_SMP_Overall_less( the_left, the_right->minimum );
+}
+
+static inline void _Scheduler_EDF_SMP_Affine_insert(
+  Scheduler_EDF_SMP_Context     *self,
+  Scheduler_EDF_SMP_Ready_queue *ready_queue
+)
+{
+  _Assert( !ready_queue->affine_queued );
+  _Assert( ready_queue->minimum != NULL );
+
+  ready_queue->affine_queued = true;
+  _RBTree_Initialize_node( &ready_queue->Node );
+
+  if (
+    _RBTree_Insert_inline(
+      &self->Affine_queues,
+      &ready_queue->Node,
+      ready_queue->minimum,
+      _Scheduler_EDF_SMP_Affine_less
+    )
+  ) {
+    self->affine_minimum = ready_queue;
+  }
+}
+
+static inline void _Scheduler_EDF_SMP_Affine_extract(
+  Scheduler_EDF_SMP_Context     *self,
+  Scheduler_EDF_SMP_Ready_queue *ready_queue
+)
+{
+  _Assert( ready_queue->affine_queued );
+
+  if ( self->affine_minimum == ready_queue ) {
+    RBTree_Node *next;
+
+    next = _RBTree_Successor( &ready_queue->Node );
+
+    if ( next != NULL ) {
+      self->affine_minimum = RTEMS_CONTAINER_OF(
+        next,
+        Scheduler_EDF_SMP_Ready_queue,
+        Node
+      );
+    } else {
+      self->affine_minimum = NULL;
+    }
+  }
+
+  _RBTree_Extract( &self->Affine_queues, &ready_queue->Node );
+  ready_queue->affine_queued = false;
+}
+
 static inline Scheduler_EDF_SMP_Node *
 _Scheduler_EDF_SMP_Challenge_highest_ready(
-  Scheduler_EDF_SMP_Context *self,
-  Scheduler_EDF_SMP_Node    *highest_ready,
-  RBTree_Control            *ready_queue
+  Scheduler_EDF_SMP_Node *highest_ready,
+  Scheduler_EDF_SMP_Node *other
 )
 {
-  Scheduler_EDF_SMP_Node *other;
-
-  other = (Scheduler_EDF_SMP_Node *) _RBTree_Minimum( ready_queue );
   _Assert( other != NULL );
 
   if ( _Scheduler_EDF_SMP_Overall_less( other, highest_ready ) ) {
@@ -140,16 +200,14 @@ static inline Scheduler_Node *_Scheduler_EDF_SMP_Get_highest_ready(
   Scheduler_Node    *filter
 )
 {
-  Scheduler_EDF_SMP_Context *self;
-  Scheduler_EDF_SMP_Node    *highest_ready;
-  Scheduler_EDF_SMP_Node    *node;
-  uint8_t                    rqi;
-  const Chain_Node          *tail;
-  Chain_Node                *next;
+  Scheduler_EDF_SMP_Context     *self;
+  Scheduler_EDF_SMP_Node        *highest_ready;
+  Scheduler_EDF_SMP_Node        *node;
+  uint8_t                        rqi;
+  Scheduler_EDF_SMP_Ready_queue *affine_minimum;
 
   self = _Scheduler_EDF_SMP_Get_self( context );
-  highest_ready = (Scheduler_EDF_SMP_Node *)
-    _RBTree_Minimum( &self->Ready[ 0 ].Queue );
+  highest_ready = self->Ready[ 0 ].minimum;
   _Assert( highest_ready != NULL );
 
   /*
@@ -161,28 +219,24 @@ static inline Scheduler_Node *_Scheduler_EDF_SMP_Get_highest_ready(
   node = (Scheduler_EDF_SMP_Node *) filter;
   rqi = node->ready_queue_index;
 
-  if ( rqi != 0 && !_RBTree_Is_empty( &self->Ready[ rqi ].Queue ) ) {
+  if ( rqi != 0 && self->Ready[ rqi ].minimum != NULL ) {
     highest_ready = _Scheduler_EDF_SMP_Challenge_highest_ready(
-      self,
       highest_ready,
-      &self->Ready[ rqi ].Queue
+      self->Ready[ rqi ].minimum
     );
   }
 
-  tail = _Chain_Immutable_tail( &self->Affine_queues );
-  next = _Chain_First( &self->Affine_queues );
-
-  while ( next != tail ) {
-    Scheduler_EDF_SMP_Ready_queue *ready_queue;
+  /*
+   * The affine ready queues are ordered by their highest priority ready node,
+   * so only the minimum queue has to be considered.
+   */
+  affine_minimum = self->affine_minimum;
 
-    ready_queue = (Scheduler_EDF_SMP_Ready_queue *) next;
+  if ( affine_minimum != NULL ) {
     highest_ready = _Scheduler_EDF_SMP_Challenge_highest_ready(
-      self,
       highest_ready,
-      &ready_queue->Queue
+      affine_minimum->minimum
     );
-
-    next = _Chain_Next( next );
   }
 
   return &highest_ready->Base.Base;
@@ -258,20 +312,30 @@ static inline void _Scheduler_EDF_SMP_Insert_ready(
   self->generations[ generation_index ] = generation + increment;
 
   _RBTree_Initialize_node( &node->Base.Base.Node.RBTree );
-  _RBTree_Insert_inline(
-    &ready_queue->Queue,
-    &node->Base.Base.Node.RBTree,
-    &insert_priority,
-    _Scheduler_EDF_SMP_Priority_less_equal
-  );
 
-  if ( rqi != 0 && _Chain_Is_node_off_chain( &ready_queue->Node ) ) {
+  if (
+    _RBTree_Insert_inline(
+      &ready_queue->Queue,
+      &node->Base.Base.Node.RBTree,
+      &insert_priority,
+      _Scheduler_EDF_SMP_Priority_less_equal
+    )
+  ) {
+    ready_queue->minimum = node;
+
+    if ( ready_queue->affine_queued ) {
+      _Scheduler_EDF_SMP_Affine_extract( self, ready_queue );
+      _Scheduler_EDF_SMP_Affine_insert( self, ready_queue );
+    }
+  }
+
+  if ( rqi != 0 && !ready_queue->affine_queued ) {
     Scheduler_EDF_SMP_Node *scheduled;
 
     scheduled = _Scheduler_EDF_SMP_Get_scheduled( self, rqi );
 
     if ( scheduled->ready_queue_index == 0 ) {
-      _Chain_Append_unprotected( &self->Affine_queues, &ready_queue->Node );
+      _Scheduler_EDF_SMP_Affine_insert( self, ready_queue );
     }
   }
 }
@@ -294,8 +358,8 @@ static inline void _Scheduler_EDF_SMP_Extract_from_scheduled(
   rqi = node->ready_queue_index;
   ready_queue = &self->Ready[ rqi ];
 
-  if ( rqi != 0 && !_RBTree_Is_empty( &ready_queue->Queue ) ) {
-    _Chain_Append_unprotected( &self->Affine_queues, &ready_queue->Node );
+  if ( rqi != 0 && ready_queue->minimum != NULL ) {
+    _Scheduler_EDF_SMP_Affine_insert( self, ready_queue );
   }
 }
 
@@ -314,17 +378,34 @@ static inline void _Scheduler_EDF_SMP_Extract_from_ready(
   rqi = node->ready_queue_index;
   ready_queue = &self->Ready[ rqi ];
 
-  _RBTree_Extract( &ready_queue->Queue, &node->Base.Base.Node.RBTree );
-  _Chain_Initialize_node( &node->Base.Base.Node.Chain );
+  if ( ready_queue->minimum == node ) {
+    RBTree_Node *next;
 
-  if (
-    rqi != 0
-      && _RBTree_Is_empty( &ready_queue->Queue )
-      && !_Chain_Is_node_off_chain( &ready_queue->Node )
-  ) {
-    _Chain_Extract_unprotected( &ready_queue->Node );
-    _Chain_Set_off_chain( &ready_queue->Node );
+    next = _RBTree_Successor( &node->Base.Base.Node.RBTree );
+    _RBTree_Extract( &ready_queue->Queue, &node->Base.Base.Node.RBTree );
+
+    if ( next != NULL ) {
+      ready_queue->minimum = RTEMS_CONTAINER_OF(
+        next,
+        Scheduler_EDF_SMP_Node,
+        Base.Base.Node.RBTree
+      );
+    } else {
+      ready_queue->minimum = NULL;
+    }
+
+    if ( ready_queue->affine_queued ) {
+      _Scheduler_EDF_SMP_Affine_extract( self, ready_queue );
+
+      if ( next != NULL ) {
+        _Scheduler_EDF_SMP_Affine_insert( self, ready_queue );
+      }
+    }
+  } else {
+    _RBTree_Extract( &ready_queue->Queue, &node->Base.Base.Node.RBTree );
   }
+
+  _Chain_Initialize_node( &node->Base.Base.Node.Chain );
 }
 
 static inline void _Scheduler_EDF_SMP_Move_from_scheduled_to_ready(
@@ -382,9 +463,8 @@ static inline void _Scheduler_EDF_SMP_Allocate_processor(
 
     ready_queue = &self->Ready[ rqi ];
 
-    if ( !_Chain_Is_node_off_chain( &ready_queue->Node ) ) {
-      _Chain_Extract_unprotected( &ready_queue->Node );
-      _Chain_Set_off_chain( &ready_queue->Node );
+    if ( ready_queue->affine_queued ) {
+      _Scheduler_EDF_SMP_Affine_extract( self, ready_queue );
     }
 
     desired_cpu = _Per_CPU_Get_by_index( rqi - 1 );
@@ -0,0 +1,72 @@
+/**
+ * @file
+ *
+ * @ingroup RTEMSScoreSMPLock
+ *
+ * @brief SMP Cohort Lock Implementation
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/score/smplockcohort.h>
+
+void _SMP_cohort_lock_Acquire(
+  SMP_cohort_lock_Control *lock,
+  SMP_lock_Context        *context
+)
+{
+  _SMP_cohort_lock_Acquire_inline( lock, context );
+}
+
+void _SMP_cohort_lock_Release(
+  SMP_cohort_lock_Control *lock,
+  SMP_lock_Context        *context
+)
+{
+  _SMP_cohort_lock_Release_inline( lock, context );
+}
+
+void _SMP_cohort_lock_ISR_disable_and_acquire(
+  SMP_cohort_lock_Control *lock,
+  SMP_lock_Context        *context
+)
+{
+  _ISR_Local_disable( context->isr_level );
+  _SMP_cohort_lock_Acquire_inline( lock, context );
+}
+
+void _SMP_cohort_lock_Release_and_ISR_enable(
+  SMP_cohort_lock_Control *lock,
+  SMP_lock_Context        *context
+)
+{
+  _SMP_cohort_lock_Release_inline( lock, context );
+  _ISR_Local_enable( context->isr_level );
+}
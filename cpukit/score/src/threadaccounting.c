@@ -0,0 +1,124 @@
+/**
+ * @file
+ *
+ * @ingroup RTEMSScoreThread
+ *
+ * @brief Thread Accounting
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/score/threadimpl.h>
+#include <rtems/score/threadqimpl.h>
+
+#if defined(RTEMS_THREAD_ACCOUNTING)
+#include <string.h>
+
+static bool _Thread_Accounting_is_queue(
+  const Thread_Accounting_wait *wait,
+  Objects_Id                    id,
+  const char                   *name
+)
+{
+  if ( wait->id != id ) {
+    return false;
+  }
+
+  return id != 0
+    || strncmp( wait->name, name, sizeof( wait->name ) - 1 ) == 0;
+}
+
+void _Thread_Accounting_add_wait(
+  Thread_Control           *the_thread,
+  const Thread_queue_Queue *queue,
+  const Timestamp_Control  *wait_time
+)
+{
+  Thread_Accounting_control *accounting;
+  Thread_Accounting_wait    *least;
+  Objects_Id                 id;
+  const char                *name;
+  size_t                     i;
+
+  accounting = &the_thread->Accounting;
+  _Timestamp_Add_to( &accounting->wait_time, wait_time );
+
+  /* Get the key without the more expensive object name conversion */
+  name = queue->name;
+
+  if ( name == _Thread_queue_Object_name ) {
+    id = THREAD_QUEUE_QUEUE_TO_OBJECT( queue )->Object.id;
+  } else {
+    id = 0;
+
+    if ( name == NULL ) {
+      name = _Thread_queue_Object_name;
+    }
+  }
+
+  least = &accounting->Waits[ 0 ];
+
+  for ( i = 0; i < THREAD_ACCOUNTING_WAIT_QUEUES; ++i ) {
+    Thread_Accounting_wait *wait;
+
+    wait = &accounting->Waits[ i ];
+
+    /* Accounts are only released by a reset, so the unused ones are last */
+    if ( wait->count == 0 ) {
+      least = wait;
+      break;
+    }
+
+    if ( _Thread_Accounting_is_queue( wait, id, name ) ) {
+      ++wait->count;
+      _Timestamp_Add_to( &wait->time, wait_time );
+      return;
+    }
+
+    if ( _Timestamp_Less_than( &wait->time, &least->time ) ) {
+      least = wait;
+    }
+  }
+
+  if ( least->count != 0 ) {
+    accounting->Other_waits.count += least->count;
+    _Timestamp_Add_to( &accounting->Other_waits.time, &least->time );
+  }
+
+  _Thread_queue_Queue_get_name_and_id(
+    queue,
+    least->name,
+    sizeof( least->name ),
+    &least->id
+  );
+  least->count = 1;
+  least->time = *wait_time;
+}
+#endif
@@ -41,6 +41,7 @@ States_Control _Thread_Clear_state_locked(
     the_thread->current_state = next_state;
 
     if ( _States_Is_ready( next_state ) ) {
+      _Thread_Accounting_ready( the_thread );
       _Scheduler_Unblock( the_thread );
     }
   }
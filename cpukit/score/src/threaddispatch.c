@@ -37,6 +37,39 @@ Thread_Control *_Thread_Allocated_fp;
 CHAIN_DEFINE_EMPTY( _User_extensions_Switches_list );
 
 #if defined(RTEMS_SMP)
+void _Thread_Dispatch_send_deferred_requests(
+  Per_CPU_Control *cpu_self,
+  Processor_mask  *previous
+)
+{
+  ISR_Level       level;
+  Processor_mask *targets;
+  uint32_t        cpu_max;
+  uint32_t        cpu_index;
+
+  /*
+   * Interrupts on this processor may add targets, so stop the deferral before
+   * the targets are evaluated.
+   */
+  _ISR_Local_disable( level );
+  targets = cpu_self->deferred_dispatch_requests;
+  cpu_self->deferred_dispatch_requests = previous;
+  _ISR_Local_enable( level );
+
+  _Assert( targets != NULL );
+  cpu_max = _SMP_Get_processor_maximum();
+
+  for ( cpu_index = 0; cpu_index < cpu_max; ++cpu_index ) {
+    if ( _Processor_mask_Is_set( targets, cpu_index ) ) {
+      Per_CPU_Control *cpu_target;
+
+      cpu_target = _Per_CPU_Get_by_index( cpu_index );
+      _Atomic_Fetch_or_ulong( &cpu_target->message, 0, ATOMIC_ORDER_RELEASE );
+      _CPU_SMP_Send_interrupt( cpu_index );
+    }
+  }
+}
+
 static ISR_Level _Thread_Check_pinning(
   Thread_Control  *executing,
   Per_CPU_Control *cpu_self,
@@ -277,6 +310,7 @@ void _Thread_Do_dispatch( Per_CPU_Control *cpu_self, ISR_Level level )
   do {
     Thread_Control *heir;
 
+    _Profiling_Thread_dispatch_begin( cpu_self );
     level = _Thread_Preemption_intervention( executing, cpu_self, level );
     heir = _Thread_Get_heir_and_make_it_executing( cpu_self );
 
@@ -295,10 +329,12 @@ void _Thread_Do_dispatch( Per_CPU_Control *cpu_self, ISR_Level level )
     if ( heir->budget_algorithm == THREAD_CPU_BUDGET_ALGORITHM_RESET_TIMESLICE )
       heir->cpu_time_budget = rtems_configuration_get_ticks_per_timeslice();
 
+    _Thread_Accounting_switch( executing, heir );
     _ISR_Local_enable( level );
 
     _User_extensions_Thread_switch( executing, heir );
     _Thread_Save_fp( executing );
+    _Thread_Lazy_fp_prepare_switch( cpu_self, heir );
     _Context_Switch( &executing->Registers, &heir->Registers );
     _Thread_Restore_fp( executing );
 
@@ -310,6 +346,7 @@ void _Thread_Do_dispatch( Per_CPU_Control *cpu_self, ISR_Level level )
     cpu_self = _Per_CPU_Get();
 
     _ISR_Local_disable( level );
+    _Profiling_Thread_dispatch_end( cpu_self );
   } while ( cpu_self->dispatch_necessary );
 
 post_switch:
@@ -0,0 +1,76 @@
+/**
+ * @file
+ *
+ * @ingroup RTEMSScoreThread
+ *
+ * @brief Lazy Floating Point Context Switch
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/score/threadimpl.h>
+#include <rtems/score/assert.h>
+
+#if ( CPU_USE_LAZY_FP_SWITCH == TRUE )
+void _Thread_Lazy_fp_switch( Per_CPU_Control *cpu_self )
+{
+  Thread_Control *executing;
+#if !defined(RTEMS_SMP)
+  Thread_Control *owner;
+#endif
+
+  _Assert( _ISR_Get_level() != 0 );
+
+  executing = cpu_self->executing;
+
+  if ( executing->fp_context == NULL ) {
+    _Internal_error( INTERNAL_ERROR_ILLEGAL_USE_OF_FLOATING_POINT_UNIT );
+  }
+
+#if !defined(RTEMS_SMP)
+  /*
+   * On SMP configurations, the owner saved its context when it was switched
+   * out, see _Thread_Save_fp().
+   */
+  owner = cpu_self->fp_owner;
+
+  if ( owner != NULL && owner != executing ) {
+    _Context_Save_fp( &owner->fp_context );
+  }
+#endif
+
+  _Context_Restore_fp( &executing->fp_context );
+  cpu_self->fp_owner = executing;
+
+#if defined(RTEMS_SMP)
+  executing->fp_cpu = cpu_self;
+#endif
+}
+#endif
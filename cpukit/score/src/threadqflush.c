@@ -123,10 +123,22 @@ size_t _Thread_queue_Flush_critical(
 
   if ( node != tail ) {
     Per_CPU_Control *cpu_self;
+#if defined(RTEMS_SMP)
+    Processor_mask   targets;
+    Processor_mask  *previous_targets;
+#endif
 
     cpu_self = _Thread_queue_Dispatch_disable( queue_context );
     _Thread_queue_Queue_release( queue, &queue_context->Lock_context.Lock_context );
 
+#if defined(RTEMS_SMP)
+    /*
+     * Send at most one inter-processor interrupt to each processor which gets
+     * a new heir through the unblocked threads.
+     */
+    previous_targets = _Thread_Dispatch_defer_requests( cpu_self, &targets );
+#endif
+
     do {
       Scheduler_Node *scheduler_node;
       Thread_Control *the_thread;
@@ -148,6 +160,10 @@ size_t _Thread_queue_Flush_critical(
       _Thread_State_release( owner, &lock_context );
     }
 
+#if defined(RTEMS_SMP)
+    _Thread_Dispatch_send_deferred_requests( cpu_self, previous_targets );
+#endif
+
     _Thread_Dispatch_enable( cpu_self );
   } else {
     _Thread_queue_Queue_release( queue, &queue_context->Lock_context.Lock_context );
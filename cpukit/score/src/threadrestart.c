@@ -171,6 +171,7 @@ static void _Thread_Free( Thread_Control *the_thread )
   if ( _Thread_Is_allocated_fp( the_thread ) )
     _Thread_Deallocate_fp();
 #endif
+  _Thread_Lazy_fp_release( the_thread );
 
   _Workspace_Free( the_thread->Start.fp_context );
 #endif
@@ -358,7 +359,10 @@ void _Thread_Life_action_handler(
   _User_extensions_Destroy_iterators( executing );
   _Thread_Load_environment( executing );
 
-#if ( CPU_HARDWARE_FP == TRUE ) || ( CPU_SOFTWARE_FP == TRUE )
+#if ( CPU_USE_LAZY_FP_SWITCH == TRUE )
+  /* The floating point context is loaded on demand */
+  _Context_Set_fp_enabled( &executing->Registers, false );
+#elif ( CPU_HARDWARE_FP == TRUE ) || ( CPU_SOFTWARE_FP == TRUE )
   if ( executing->fp_context != NULL ) {
     _Context_Restore_fp( &executing->fp_context );
   }
@@ -41,6 +41,7 @@ States_Control _Thread_Set_state_locked(
   the_thread->current_state = next_state;
 
   if ( _States_Is_ready( previous_state ) ) {
+    _Thread_Accounting_block( the_thread );
     _Scheduler_Block( the_thread );
   }
 
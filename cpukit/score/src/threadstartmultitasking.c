@@ -37,6 +37,7 @@ void _Thread_Start_multitasking( void )
 #endif
 
   heir = _Thread_Get_heir_and_make_it_executing( cpu_self );
+  _Thread_Lazy_fp_prepare_switch( cpu_self, heir );
 
   _Profiling_Thread_dispatch_disable( cpu_self, 0 );
 
@@ -25,6 +25,7 @@
 
 #include <rtems/score/watchdogimpl.h>
 
+#if !defined(RTEMS_WATCHDOG_TIMER_WHEEL)
 void _Watchdog_Insert(
   Watchdog_Header  *header,
   Watchdog_Control *the_watchdog,
@@ -64,3 +65,4 @@ void _Watchdog_Insert(
   _RBTree_Add_child( &the_watchdog->Node.RBTree, parent, link );
   _RBTree_Insert_color( &header->Watchdogs, &the_watchdog->Node.RBTree );
 }
+#endif
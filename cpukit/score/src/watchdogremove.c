@@ -25,6 +25,7 @@
 
 #include <rtems/score/watchdogimpl.h>
 
+#if !defined(RTEMS_WATCHDOG_TIMER_WHEEL)
 void _Watchdog_Remove(
   Watchdog_Header  *header,
   Watchdog_Control *the_watchdog
@@ -39,3 +40,4 @@ void _Watchdog_Remove(
     _Watchdog_Set_state( the_watchdog, WATCHDOG_INACTIVE );
   }
 }
+#endif
@@ -0,0 +1,384 @@
+/**
+ * @file
+ *
+ * @ingroup RTEMSScoreWatchdog
+ *
+ * @brief Clock Tick Suppression
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/score/watchdogimpl.h>
+#include <rtems/score/smpimpl.h>
+#include <rtems/score/threadimpl.h>
+#include <rtems/score/timecounter.h>
+#include <rtems/score/userextimpl.h>
+
+static const Watchdog_Tick_suppression_operations *
+_Watchdog_Tick_suppression_operations;
+
+static uint32_t _Watchdog_Maximum_suppressed_ticks;
+
+static uint64_t _Watchdog_Nanoseconds_from_expire( uint64_t expire )
+{
+  uint64_t nanoseconds;
+
+  /*
+   * The lower bounds of the timer wheel slots may have a nanoseconds part
+   * greater than or equal to one second.  Clip it to keep the order.
+   */
+  nanoseconds = expire & ( ( (uint64_t) 1 << WATCHDOG_BITS_FOR_1E9_NANOSECONDS )
+    - 1 );
+
+  if ( nanoseconds >= WATCHDOG_NANOSECONDS_PER_SECOND ) {
+    nanoseconds = WATCHDOG_NANOSECONDS_PER_SECOND - 1;
+  }
+
+  return ( expire >> WATCHDOG_BITS_FOR_1E9_NANOSECONDS )
+    * WATCHDOG_NANOSECONDS_PER_SECOND + nanoseconds;
+}
+
+static uint64_t _Watchdog_Nanoseconds_from_timespec(
+  const struct timespec *ts
+)
+{
+  return (uint64_t) ts->tv_sec * WATCHDOG_NANOSECONDS_PER_SECOND
+    + (uint64_t) ts->tv_nsec;
+}
+
+static uint64_t _Watchdog_Uptime_in_nanoseconds( void )
+{
+  struct timespec now;
+
+  _Timecounter_Nanouptime( &now );
+  return _Watchdog_Nanoseconds_from_timespec( &now );
+}
+
+/*
+ * Returns a lower bound of the expiration times of the watchdogs of the
+ * header.  This is exact for the red-black tree.  The timer wheel provides
+ * the begin of the earliest non-empty slot.
+ */
+static bool _Watchdog_Next_expire(
+  const Watchdog_Header *header,
+  uint64_t              *expire
+)
+{
+#if defined(RTEMS_WATCHDOG_TIMER_WHEEL)
+  return _Watchdog_Wheel_first_slot( header, expire ) != NULL;
+#else
+  const Watchdog_Control *first;
+
+  first = (const Watchdog_Control *) header->first;
+
+  if ( first == NULL ) {
+    return false;
+  }
+
+  *expire = first->expire;
+  return true;
+#endif
+}
+
+/*
+ * The watchdogs of the nanoseconds based headers expire in the first clock
+ * tick at or after the expiration time.
+ */
+static uint64_t _Watchdog_Ticks_until_nanoseconds_expire(
+  const Watchdog_Header *header,
+  uint64_t               now
+)
+{
+  uint64_t expire;
+
+  if ( !_Watchdog_Next_expire( header, &expire ) ) {
+    return WATCHDOG_MAXIMUM_TICKS;
+  }
+
+  expire = _Watchdog_Nanoseconds_from_expire( expire );
+
+  if ( expire <= now ) {
+    return 1;
+  }
+
+  return ( expire - now ) / _Watchdog_Nanoseconds_per_tick + 1;
+}
+
+static uint32_t _Watchdog_Ticks_until_next_expire(
+  const Per_CPU_Control *cpu,
+  uint32_t               maximum
+)
+{
+  uint64_t        ticks;
+  uint64_t        expire;
+  uint64_t        other;
+  struct timespec now;
+
+  ticks = maximum;
+
+  if (
+    _Watchdog_Next_expire(
+      &cpu->Watchdog.Header[ PER_CPU_WATCHDOG_TICKS ],
+      &expire
+    )
+  ) {
+    if ( expire > cpu->Watchdog.ticks ) {
+      other = expire - cpu->Watchdog.ticks;
+    } else {
+      other = 1;
+    }
+
+    if ( other < ticks ) {
+      ticks = other;
+    }
+  }
+
+  _Timecounter_Nanouptime( &now );
+  other = _Watchdog_Ticks_until_nanoseconds_expire(
+    &cpu->Watchdog.Header[ PER_CPU_WATCHDOG_MONOTONIC ],
+    _Watchdog_Nanoseconds_from_timespec( &now )
+  );
+
+  if ( other < ticks ) {
+    ticks = other;
+  }
+
+  _Timecounter_Nanotime( &now );
+  other = _Watchdog_Ticks_until_nanoseconds_expire(
+    &cpu->Watchdog.Header[ PER_CPU_WATCHDOG_REALTIME ],
+    _Watchdog_Nanoseconds_from_timespec( &now )
+  );
+
+  if ( other < ticks ) {
+    ticks = other;
+  }
+
+  return (uint32_t) ticks;
+}
+
+static void _Watchdog_Advance_ticks( Per_CPU_Control *cpu, uint64_t ticks )
+{
+  uint64_t delta;
+
+  if ( ticks <= cpu->Watchdog.ticks ) {
+    return;
+  }
+
+  delta = ticks - cpu->Watchdog.ticks;
+  cpu->Watchdog.ticks = ticks;
+
+  if ( _Per_CPU_Is_boot_processor( cpu ) ) {
+    _Watchdog_Ticks_since_boot += (Watchdog_Interval) delta;
+  }
+}
+
+static void _Watchdog_Do_resume_ticks( Per_CPU_Control *cpu_self )
+{
+  uint64_t base;
+  uint32_t ticks;
+  uint32_t elapsed;
+
+  base = cpu_self->Watchdog.Suppressed.ticks;
+  ticks = (uint32_t) ( cpu_self->Watchdog.Suppressed.until - base );
+  elapsed = ( *_Watchdog_Tick_suppression_operations->resume )(
+    cpu_self,
+    ticks
+  );
+  _Assert( elapsed < ticks );
+
+  cpu_self->Watchdog.Suppressed.until = 0;
+  _Watchdog_Advance_ticks( cpu_self, base + elapsed );
+}
+
+static bool _Watchdog_May_suppress_ticks( const Per_CPU_Control *cpu_self )
+{
+  const Thread_Control *executing;
+
+  executing = cpu_self->executing;
+
+  if ( cpu_self->heir != executing || cpu_self->dispatch_necessary ) {
+    return false;
+  }
+
+#if defined(RTEMS_SMP)
+  if ( _Per_CPU_Is_boot_processor( cpu_self ) ) {
+    return executing->is_idle && _SMP_Get_processor_maximum() == 1;
+  }
+
+  /*
+   * An isolated processor which runs a single thread needs the clock tick
+   * only for the CPU budget algorithms.  The switch to another thread resumes
+   * the periodic clock tick.
+   */
+  return executing->is_idle
+    || executing->budget_algorithm == THREAD_CPU_BUDGET_ALGORITHM_NONE;
+#else
+  return executing->is_idle;
+#endif
+}
+
+static void _Watchdog_Tick_suppression_switch(
+  Thread_Control *executing,
+  Thread_Control *heir
+)
+{
+  Per_CPU_Control *cpu_self;
+
+  (void) executing;
+  (void) heir;
+
+  cpu_self = _Per_CPU_Get();
+
+  if ( cpu_self->Watchdog.Suppressed.until != 0 ) {
+    _Watchdog_Resume_ticks( cpu_self );
+  }
+}
+
+static User_extensions_Control _Watchdog_Tick_suppression_extensions = {
+  .Callouts = {
+    .thread_switch = _Watchdog_Tick_suppression_switch
+  }
+};
+
+void _Watchdog_Enable_tick_suppression(
+  const Watchdog_Tick_suppression_operations *operations,
+  uint32_t                                    maximum_ticks
+)
+{
+  if ( !_Watchdog_Tick_suppression_configured || maximum_ticks <= 1 ) {
+    return;
+  }
+
+  _Assert( _Watchdog_Tick_suppression_operations == NULL );
+  _Watchdog_Maximum_suppressed_ticks = maximum_ticks;
+  _Watchdog_Tick_suppression_operations = operations;
+  _User_extensions_Add_API_set( &_Watchdog_Tick_suppression_extensions );
+}
+
+bool _Watchdog_Is_tick_suppression_enabled( void )
+{
+  return _Watchdog_Tick_suppression_operations != NULL;
+}
+
+void _Watchdog_Suppress_ticks( Per_CPU_Control *cpu_self )
+{
+  ISR_lock_Context lock_context;
+  uint32_t         ticks;
+
+  if ( _Watchdog_Tick_suppression_operations == NULL ) {
+    return;
+  }
+
+  _ISR_lock_ISR_disable_and_acquire( &cpu_self->Watchdog.Lock, &lock_context );
+
+  if (
+    cpu_self->Watchdog.Suppressed.until == 0
+      && _Watchdog_May_suppress_ticks( cpu_self )
+  ) {
+    ticks = _Watchdog_Ticks_until_next_expire(
+      cpu_self,
+      _Watchdog_Maximum_suppressed_ticks
+    );
+
+    if ( ticks > 1 ) {
+      cpu_self->Watchdog.Suppressed.until = cpu_self->Watchdog.ticks + ticks;
+      cpu_self->Watchdog.Suppressed.ticks = cpu_self->Watchdog.ticks;
+      cpu_self->Watchdog.Suppressed.uptime = _Watchdog_Uptime_in_nanoseconds();
+      ( *_Watchdog_Tick_suppression_operations->suppress )( cpu_self, ticks );
+    }
+  }
+
+  _ISR_lock_Release_and_ISR_enable( &cpu_self->Watchdog.Lock, &lock_context );
+}
+
+void _Watchdog_Resume_ticks( Per_CPU_Control *cpu_self )
+{
+  ISR_lock_Context lock_context;
+
+  _ISR_lock_ISR_disable_and_acquire( &cpu_self->Watchdog.Lock, &lock_context );
+
+  if ( cpu_self->Watchdog.Suppressed.until != 0 ) {
+    _Watchdog_Do_resume_ticks( cpu_self );
+  }
+
+  _ISR_lock_Release_and_ISR_enable( &cpu_self->Watchdog.Lock, &lock_context );
+}
+
+void _Watchdog_Update_suppressed_ticks( Per_CPU_Control *cpu )
+{
+  uint64_t elapsed;
+  uint64_t ticks;
+
+  elapsed = _Watchdog_Uptime_in_nanoseconds()
+    - cpu->Watchdog.Suppressed.uptime;
+  ticks = cpu->Watchdog.Suppressed.ticks
+    + elapsed / _Watchdog_Nanoseconds_per_tick;
+
+  /* The clock tick interrupt accounts for the last tick */
+  if ( ticks >= cpu->Watchdog.Suppressed.until ) {
+    ticks = cpu->Watchdog.Suppressed.until - 1;
+  }
+
+  _Watchdog_Advance_ticks( cpu, ticks );
+}
+
+void _Watchdog_Check_suppressed_ticks( Per_CPU_Control *cpu )
+{
+  uint64_t until;
+  uint32_t ticks;
+
+  until = cpu->Watchdog.Suppressed.until;
+  ticks = _Watchdog_Ticks_until_next_expire(
+    cpu,
+    _Watchdog_Maximum_suppressed_ticks
+  );
+
+  if ( cpu->Watchdog.ticks + ticks >= until ) {
+    return;
+  }
+
+#if defined(RTEMS_SMP)
+  if ( cpu != _Per_CPU_Get() ) {
+    _SMP_Send_message(
+      _Per_CPU_Get_index( cpu ),
+      SMP_MESSAGE_RESUME_CLOCK_TICKS
+    );
+    return;
+  }
+#endif
+
+  _Watchdog_Do_resume_ticks( cpu );
+}
+
+void _Watchdog_Finish_tick_suppression( Per_CPU_Control *cpu )
+{
+  _Watchdog_Advance_ticks( cpu, cpu->Watchdog.Suppressed.until - 1 );
+  cpu->Watchdog.Suppressed.until = 0;
+}
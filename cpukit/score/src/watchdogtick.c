@@ -21,6 +21,7 @@
 #include <rtems/score/threaddispatch.h>
 #include <rtems/score/timecounter.h>
 
+#if !defined(RTEMS_WATCHDOG_TIMER_WHEEL)
 void _Watchdog_Do_tickle(
   Watchdog_Header  *header,
   Watchdog_Control *first,
@@ -50,6 +51,7 @@ void _Watchdog_Do_tickle(
     first = _Watchdog_Header_first( header );
   } while ( first != NULL );
 }
+#endif
 
 void _Watchdog_Tick( Per_CPU_Control *cpu )
 {
@@ -65,6 +67,10 @@ void _Watchdog_Tick( Per_CPU_Control *cpu )
 
   _ISR_lock_ISR_disable_and_acquire( &cpu->Watchdog.Lock, &lock_context );
 
+  if ( RTEMS_PREDICT_FALSE( cpu->Watchdog.Suppressed.until != 0 ) ) {
+    _Watchdog_Finish_tick_suppression( cpu );
+  }
+
   ticks = cpu->Watchdog.ticks;
   _Assert( ticks < UINT64_MAX );
   ++ticks;
@@ -0,0 +1,253 @@
+/**
+ * @file
+ *
+ * @ingroup RTEMSScoreWatchdog
+ *
+ * @brief Watchdog Timer Wheel
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/score/watchdogimpl.h>
+
+#if defined(RTEMS_WATCHDOG_TIMER_WHEEL)
+
+#include <stddef.h>
+
+RTEMS_STATIC_ASSERT(
+  offsetof( Watchdog_Control, Node.Wheel.slot )
+    + sizeof( Watchdog_Wheel_slot * )
+    <= offsetof( Watchdog_Control, Node.RBTree.Node.rbe_color ),
+  WATCHDOG_WHEEL_NODE
+);
+
+static void _Watchdog_Wheel_enqueue(
+  Watchdog_Header  *header,
+  Watchdog_Control *the_watchdog
+)
+{
+  uint64_t             now;
+  uint64_t             expire;
+  size_t               level;
+  size_t               index;
+  Watchdog_Wheel_slot *slot;
+  Watchdog_Control    *last;
+
+  now = header->now;
+  expire = the_watchdog->expire;
+
+  /*
+   * The level is determined by the most significant bit which differs between
+   * the expiration time and the current time of the wheel.  Watchdogs which
+   * already expired go to the level zero slot of the current time.
+   */
+  if ( expire <= now ) {
+    level = 0;
+    index = (size_t) ( now % WATCHDOG_WHEEL_SLOTS );
+  } else {
+    level = (size_t) ( 63 - __builtin_clzll( expire ^ now ) )
+      / WATCHDOG_WHEEL_LEVEL_BITS;
+    index = (size_t) ( ( expire >> ( level * WATCHDOG_WHEEL_LEVEL_BITS ) )
+      % WATCHDOG_WHEEL_SLOTS );
+  }
+
+  slot = &header->slots[ level ][ index ];
+  last = slot->last;
+  the_watchdog->Node.Wheel.next = NULL;
+  the_watchdog->Node.Wheel.previous = last;
+  the_watchdog->Node.Wheel.slot = slot;
+  slot->last = the_watchdog;
+
+  if ( last != NULL ) {
+    last->Node.Wheel.next = the_watchdog;
+  } else {
+    slot->first = the_watchdog;
+    header->occupied[ level ] |= (uint64_t) 1 << index;
+  }
+}
+
+static void _Watchdog_Wheel_dequeue(
+  Watchdog_Header  *header,
+  Watchdog_Control *the_watchdog
+)
+{
+  Watchdog_Wheel_slot *slot;
+  Watchdog_Control    *next;
+  Watchdog_Control    *previous;
+
+  slot = the_watchdog->Node.Wheel.slot;
+  next = the_watchdog->Node.Wheel.next;
+  previous = the_watchdog->Node.Wheel.previous;
+
+  if ( previous != NULL ) {
+    previous->Node.Wheel.next = next;
+  } else {
+    slot->first = next;
+  }
+
+  if ( next != NULL ) {
+    next->Node.Wheel.previous = previous;
+  } else {
+    slot->last = previous;
+  }
+
+  if ( slot->first == NULL ) {
+    size_t offset;
+
+    offset = (size_t) ( slot - &header->slots[ 0 ][ 0 ] );
+    header->occupied[ offset / WATCHDOG_WHEEL_SLOTS ] &=
+      ~( (uint64_t) 1 << ( offset % WATCHDOG_WHEEL_SLOTS ) );
+  }
+}
+
+static bool _Watchdog_Wheel_next(
+  const Watchdog_Header  *header,
+  uint64_t               *next,
+  Watchdog_Wheel_slot   **slot
+)
+{
+  *slot = _Watchdog_Wheel_first_slot( header, next );
+  return *slot != NULL;
+}
+
+/*
+ * The realtime clock may be set backwards.  Distribute all watchdogs again
+ * relative to the new time.
+ */
+static void _Watchdog_Wheel_rewind( Watchdog_Header *header, uint64_t now )
+{
+  Watchdog_Control  *head;
+  Watchdog_Control **tail;
+  uint64_t           next;
+  Watchdog_Wheel_slot *slot;
+
+  head = NULL;
+  tail = &head;
+
+  while ( _Watchdog_Wheel_next( header, &next, &slot ) ) {
+    Watchdog_Control *the_watchdog;
+
+    the_watchdog = slot->first;
+    _Watchdog_Wheel_dequeue( header, the_watchdog );
+    the_watchdog->Node.Wheel.next = NULL;
+    *tail = the_watchdog;
+    tail = &the_watchdog->Node.Wheel.next;
+  }
+
+  header->now = now;
+
+  while ( head != NULL ) {
+    Watchdog_Control *the_watchdog;
+
+    the_watchdog = head;
+    head = the_watchdog->Node.Wheel.next;
+    _Watchdog_Wheel_enqueue( header, the_watchdog );
+  }
+}
+
+void _Watchdog_Insert(
+  Watchdog_Header  *header,
+  Watchdog_Control *the_watchdog,
+  uint64_t          expire
+)
+{
+  _Assert( _Watchdog_Get_state( the_watchdog ) == WATCHDOG_INACTIVE );
+
+  the_watchdog->expire = expire;
+  _Watchdog_Set_state( the_watchdog, WATCHDOG_SCHEDULED_BLACK );
+  _Watchdog_Wheel_enqueue( header, the_watchdog );
+}
+
+void _Watchdog_Remove(
+  Watchdog_Header  *header,
+  Watchdog_Control *the_watchdog
+)
+{
+  if ( _Watchdog_Is_scheduled( the_watchdog ) ) {
+    _Watchdog_Wheel_dequeue( header, the_watchdog );
+    _Watchdog_Set_state( the_watchdog, WATCHDOG_INACTIVE );
+  }
+}
+
+void _Watchdog_Do_tickle(
+  Watchdog_Header  *header,
+  Watchdog_Control *first,
+  uint64_t          now,
+#ifdef RTEMS_SMP
+  ISR_lock_Control *lock,
+#endif
+  ISR_lock_Context *lock_context
+)
+{
+  uint64_t             next;
+  Watchdog_Wheel_slot *slot;
+
+  (void) first;
+
+  if ( now < header->now ) {
+    _Watchdog_Wheel_rewind( header, now );
+  }
+
+  while ( _Watchdog_Wheel_next( header, &next, &slot ) && next <= now ) {
+    Watchdog_Control *the_watchdog;
+
+    header->now = next;
+    the_watchdog = slot->first;
+
+    if ( slot < &header->slots[ 1 ][ 0 ] ) {
+      Watchdog_Service_routine_entry routine;
+
+      _Watchdog_Wheel_dequeue( header, the_watchdog );
+      _Watchdog_Set_state( the_watchdog, WATCHDOG_INACTIVE );
+      routine = the_watchdog->routine;
+
+      _ISR_lock_Release_and_ISR_enable( lock, lock_context );
+      ( *routine )( the_watchdog );
+      _ISR_lock_ISR_disable_and_acquire( lock, lock_context );
+    } else {
+      /* Move the watchdogs of the slot to lower levels */
+      do {
+        _Watchdog_Wheel_dequeue( header, the_watchdog );
+        _Watchdog_Wheel_enqueue( header, the_watchdog );
+        the_watchdog = slot->first;
+      } while ( the_watchdog != NULL );
+    }
+  }
+
+  /*
+   * A concurrent tickle during a watchdog routine invocation may have
+   * advanced the time of the wheel already.
+   */
+  if ( header->now < now ) {
+    header->now = now;
+  }
+}
+
+#endif /* RTEMS_WATCHDOG_TIMER_WHEEL */
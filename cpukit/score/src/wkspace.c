@@ -173,7 +173,12 @@ void _Workspace_Handler_initialization(
   remaining = rtems_configuration_get_work_space_size();
   remaining += _Workspace_Space_for_TLS( page_size );
 
-  init_or_extend = _Heap_Initialize;
+  init_or_extend = _Workspace_Initialize_handler;
+
+  if ( init_or_extend != _Heap_Initialize ) {
+    remaining += _Heap_Segregated_fit_overhead();
+  }
+
   do_zero = rtems_configuration_get_do_zero_of_workspace();
   unified = rtems_configuration_get_unified_work_area();
   overhead = _Heap_Area_overhead( page_size );
@@ -0,0 +1,319 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/dosfs.h>
+#include <rtems/libio.h>
+#include <rtems/sparse-disk.h>
+
+const char rtems_test_name[] = "FSDOSFSEXTENT 1";
+
+#define DEV_NAME "/dev/sda"
+
+#define MOUNT_DIR "/mnt"
+
+#define FILE_PATH "/mnt/file"
+
+#define OTHER_FILE_PATH "/mnt/other"
+
+#define SECTOR_SIZE 512
+
+/* A 16MiB disk */
+#define SECTOR_COUNT (32 * 1024)
+
+#define SECTORS_WITH_BUFFER 1024
+
+#define CLUSTER_SIZE SECTOR_SIZE
+
+#define FRAGMENT_CLUSTERS 8
+
+#define FRAGMENT_COUNT 64
+
+#define FILE_CLUSTERS (FRAGMENT_CLUSTERS * FRAGMENT_COUNT)
+
+#define RANDOM_COUNT 1024
+
+static uint8_t cluster_buf[CLUSTER_SIZE];
+
+static uint8_t zero_buf[CLUSTER_SIZE];
+
+static uint32_t random_state;
+
+static uint32_t random_next(void)
+{
+  random_state = random_state * 1103515245 + 12345;
+  return random_state >> 8;
+}
+
+/*
+ * The cluster content is the cluster index in the file plus a generation
+ * marker in the first word, the other bytes are equal to the sparse disk
+ * fill pattern.
+ */
+static void write_cluster(int fd, uint32_t value)
+{
+  ssize_t n;
+
+  memcpy(cluster_buf, &value, sizeof(value));
+  n = write(fd, cluster_buf, sizeof(cluster_buf));
+  rtems_test_assert(n == (ssize_t) sizeof(cluster_buf));
+}
+
+static void read_cluster(int fd, uint32_t index, uint32_t value)
+{
+  off_t offset;
+  ssize_t n;
+
+  offset = lseek(fd, (off_t) index * CLUSTER_SIZE, SEEK_SET);
+  rtems_test_assert(offset == (off_t) index * CLUSTER_SIZE);
+
+  n = read(fd, cluster_buf, sizeof(cluster_buf));
+  rtems_test_assert(n == (ssize_t) sizeof(cluster_buf));
+  rtems_test_assert(memcmp(cluster_buf, &value, sizeof(value)) == 0);
+}
+
+/*
+ * Write the file and another file in turns, so that the file consists of
+ * fragments which are separated by clusters of the other file.
+ */
+static void create_fragmented_file(void)
+{
+  struct statvfs buf;
+  int fd;
+  int other_fd;
+  uint32_t i;
+  uint32_t j;
+  int rv;
+
+  rv = statvfs(MOUNT_DIR, &buf);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(buf.f_frsize == CLUSTER_SIZE);
+
+  fd = open(FILE_PATH, O_WRONLY | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  other_fd = open(OTHER_FILE_PATH, O_WRONLY | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(other_fd >= 0);
+
+  for (i = 0; i < FRAGMENT_COUNT; ++i) {
+    for (j = 0; j < FRAGMENT_CLUSTERS; ++j) {
+      write_cluster(fd, i * FRAGMENT_CLUSTERS + j);
+    }
+
+    for (j = 0; j < FRAGMENT_CLUSTERS; ++j) {
+      ssize_t n;
+
+      n = write(other_fd, zero_buf, sizeof(zero_buf));
+      rtems_test_assert(n == (ssize_t) sizeof(zero_buf));
+    }
+  }
+
+  rv = close(other_fd);
+  rtems_test_assert(rv == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void random_read(uint32_t cache_size)
+{
+  rtems_counter_ticks t;
+  int fd;
+  int i;
+  int rv;
+
+  rtems_dosfs_extent_cache_size = cache_size;
+  random_state = 0;
+
+  fd = open(FILE_PATH, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  t = rtems_counter_read();
+
+  for (i = 0; i < RANDOM_COUNT; ++i) {
+    uint32_t index;
+
+    index = random_next() % FILE_CLUSTERS;
+    read_cluster(fd, index, index);
+  }
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  printf(
+    "  <RandomRead extentCacheSize=\"%" PRIu32 "\" count=\"%i\">"
+      "<Time unit=\"ns\">%" PRIu64 "</Time></RandomRead>\n",
+    cache_size,
+    RANDOM_COUNT,
+    rtems_counter_ticks_to_nanoseconds(t)
+  );
+}
+
+/*
+ * The truncated clusters are reused by the extension in a different order,
+ * so stale extents would map to the wrong clusters.
+ */
+static void test_truncate_and_extend(void)
+{
+  static const uint32_t generation = UINT32_C(1) << 16;
+
+  off_t offset;
+  uint32_t i;
+  int fd;
+  int rv;
+
+  fd = open(FILE_PATH, O_RDWR);
+  rtems_test_assert(fd >= 0);
+
+  for (i = 0; i < FILE_CLUSTERS; ++i) {
+    read_cluster(fd, FILE_CLUSTERS - 1 - i, FILE_CLUSTERS - 1 - i);
+  }
+
+  rv = ftruncate(fd, (FILE_CLUSTERS / 2) * CLUSTER_SIZE);
+  rtems_test_assert(rv == 0);
+
+  rv = unlink(OTHER_FILE_PATH);
+  rtems_test_assert(rv == 0);
+
+  offset = lseek(fd, 0, SEEK_END);
+  rtems_test_assert(offset == (FILE_CLUSTERS / 2) * CLUSTER_SIZE);
+
+  for (i = FILE_CLUSTERS / 2; i < FILE_CLUSTERS; ++i) {
+    write_cluster(fd, generation + i);
+  }
+
+  for (i = 0; i < FILE_CLUSTERS; ++i) {
+    uint32_t index;
+
+    index = FILE_CLUSTERS - 1 - i;
+
+    if (index < FILE_CLUSTERS / 2) {
+      read_cluster(fd, index, index);
+    } else {
+      read_cluster(fd, index, generation + index);
+    }
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  static const msdos_format_request_param_t rqdata = {
+    .sectors_per_cluster = CLUSTER_SIZE / SECTOR_SIZE,
+    .quick_format        = true
+  };
+
+  rtems_status_code sc;
+  uint32_t cache_size;
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = mkdir(MOUNT_DIR, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_sparse_disk_create_and_register(
+    DEV_NAME,
+    SECTOR_SIZE,
+    SECTORS_WITH_BUFFER,
+    SECTOR_COUNT,
+    0
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rv = msdos_format(DEV_NAME, &rqdata);
+  rtems_test_assert(rv == 0);
+
+  rv = mount(
+    DEV_NAME,
+    MOUNT_DIR,
+    RTEMS_FILESYSTEM_TYPE_DOSFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+
+  create_fragmented_file();
+
+  cache_size = rtems_dosfs_extent_cache_size;
+
+  printf("<FSDOSFSExtent01>\n");
+  random_read(0);
+  random_read(cache_size);
+  printf("</FSDOSFSExtent01>\n");
+
+  test_truncate_and_extend();
+
+  rv = unmount(MOUNT_DIR);
+  rtems_test_assert(rv == 0);
+
+  rv = unlink(DEV_NAME);
+  rtems_test_assert(rv == 0);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_FILESYSTEM_DOSFS
+
+/* two files + stdin + stdout + stderr + device file when mounted */
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 6
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (32 * 1024)
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,315 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/dosfs.h>
+#include <rtems/libio.h>
+#include <rtems/sparse-disk.h>
+
+const char rtems_test_name[] = "FSDOSFSFAT 1";
+
+#define DEV_NAME "/dev/sda"
+
+#define MOUNT_DIR "/mnt"
+
+#define FILE_PATH "/mnt/file"
+
+#define SECTOR_SIZE 512
+
+/* A 32GiB disk */
+#define SECTOR_COUNT (64 * 1024 * 1024)
+
+#define SECTORS_WITH_BUFFER 1024
+
+#define SECTORS_PER_CLUSTER 64
+
+#define CLUSTER_SIZE (SECTORS_PER_CLUSTER * SECTOR_SIZE)
+
+#define FRAG_FILE_COUNT 16
+
+#define FRAG_ROUNDS 64
+
+#define FRAG_USED_CLUSTERS ((FRAG_FILE_COUNT / 2) * FRAG_ROUNDS)
+
+#define WRITE_CLUSTERS 1024
+
+/*
+ * The buffer content is equal to the sparse disk fill pattern, so the data
+ * clusters need no sparse disk buffers.
+ */
+static uint8_t cluster_buf[CLUSTER_SIZE];
+
+static fsblkcnt_t get_free_clusters(void)
+{
+  struct statvfs buf;
+  int rv;
+
+  rv = statvfs(MOUNT_DIR, &buf);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(buf.f_frsize == CLUSTER_SIZE);
+
+  return buf.f_bfree;
+}
+
+static void frag_file_path(char *path, size_t size, int i)
+{
+  int n;
+
+  n = snprintf(path, size, MOUNT_DIR "/frag%02i", i);
+  rtems_test_assert(n > 0 && (size_t) n < size);
+}
+
+static void do_mount(void)
+{
+  int rv;
+
+  rv = mount(
+    DEV_NAME,
+    MOUNT_DIR,
+    RTEMS_FILESYSTEM_TYPE_DOSFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void do_unmount(void)
+{
+  int rv;
+
+  rv = unmount(MOUNT_DIR);
+  rtems_test_assert(rv == 0);
+}
+
+/*
+ * Grow the fragment files in turns by one cluster and remove every second
+ * file afterwards.  This leaves single free clusters between the used
+ * clusters at the start of the volume.
+ */
+static void fragment(void)
+{
+  char path[32];
+  int fd[FRAG_FILE_COUNT];
+  int i;
+  int j;
+  int rv;
+
+  for (i = 0; i < FRAG_FILE_COUNT; ++i) {
+    frag_file_path(path, sizeof(path), i);
+    fd[i] = open(path, O_WRONLY | O_CREAT | O_TRUNC, S_IRWXU);
+    rtems_test_assert(fd[i] >= 0);
+  }
+
+  for (j = 0; j < FRAG_ROUNDS; ++j) {
+    for (i = 0; i < FRAG_FILE_COUNT; ++i) {
+      ssize_t n;
+
+      n = write(fd[i], cluster_buf, sizeof(cluster_buf));
+      rtems_test_assert(n == (ssize_t) sizeof(cluster_buf));
+    }
+  }
+
+  for (i = 0; i < FRAG_FILE_COUNT; ++i) {
+    rv = close(fd[i]);
+    rtems_test_assert(rv == 0);
+  }
+
+  for (i = 0; i < FRAG_FILE_COUNT; i += 2) {
+    frag_file_path(path, sizeof(path), i);
+    rv = unlink(path);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static void remove_fragments(void)
+{
+  char path[32];
+  int i;
+  int rv;
+
+  for (i = 1; i < FRAG_FILE_COUNT; i += 2) {
+    frag_file_path(path, sizeof(path), i);
+    rv = unlink(path);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static void do_write(uint32_t cache_sectors, bool free_map)
+{
+  rtems_counter_ticks t;
+  int fd;
+  int i;
+  int rv;
+
+  fd = open(FILE_PATH, O_WRONLY | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  t = rtems_counter_read();
+
+  for (i = 0; i < WRITE_CLUSTERS; ++i) {
+    ssize_t n;
+
+    n = write(fd, cluster_buf, sizeof(cluster_buf));
+    rtems_test_assert(n == (ssize_t) sizeof(cluster_buf));
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+
+  printf(
+    "  <FragmentedWrite cacheSectors=\"%" PRIu32 "\" freeMap=\"%s\" "
+      "size=\"%i\"><Time unit=\"ns\">%" PRIu64 "</Time>"
+      "</FragmentedWrite>\n",
+    cache_sectors,
+    free_map ? "yes" : "no",
+    WRITE_CLUSTERS * CLUSTER_SIZE,
+    rtems_counter_ticks_to_nanoseconds(t)
+  );
+}
+
+static void test(uint32_t cache_sectors, uint32_t free_map_max_size)
+{
+  fsblkcnt_t free_cls;
+  int rv;
+
+  rtems_dosfs_fat_cache_sectors = cache_sectors;
+  rtems_dosfs_fat_free_map_max_size = free_map_max_size;
+  do_mount();
+  free_cls = get_free_clusters();
+
+  fragment();
+  rtems_test_assert(
+    get_free_clusters() == free_cls - FRAG_USED_CLUSTERS
+  );
+
+  do_write(cache_sectors, free_map_max_size != 0);
+  rtems_test_assert(
+    get_free_clusters() == free_cls - FRAG_USED_CLUSTERS - WRITE_CLUSTERS
+  );
+
+  /* Make sure the FAT and the free cluster count made it to the disk */
+  do_unmount();
+  do_mount();
+  rtems_test_assert(
+    get_free_clusters() == free_cls - FRAG_USED_CLUSTERS - WRITE_CLUSTERS
+  );
+
+  rv = unlink(FILE_PATH);
+  rtems_test_assert(rv == 0);
+
+  remove_fragments();
+  rtems_test_assert(get_free_clusters() == free_cls);
+
+  do_unmount();
+}
+
+static void Init(rtems_task_argument arg)
+{
+  static const msdos_format_request_param_t rqdata = {
+    .sectors_per_cluster = SECTORS_PER_CLUSTER,
+    .quick_format        = true
+  };
+
+  rtems_status_code sc;
+  uint32_t cache_sectors;
+  uint32_t free_map_max_size;
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = mkdir(MOUNT_DIR, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_sparse_disk_create_and_register(
+    DEV_NAME,
+    SECTOR_SIZE,
+    SECTORS_WITH_BUFFER,
+    SECTOR_COUNT,
+    0
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rv = msdos_format(DEV_NAME, &rqdata);
+  rtems_test_assert(rv == 0);
+
+  cache_sectors = rtems_dosfs_fat_cache_sectors;
+  free_map_max_size = rtems_dosfs_fat_free_map_max_size;
+
+  printf("<FSDOSFSFat01>\n");
+  test(1, free_map_max_size);
+  test(cache_sectors, free_map_max_size);
+  test(cache_sectors, 0);
+  printf("</FSDOSFSFat01>\n");
+
+  rv = unlink(DEV_NAME);
+  rtems_test_assert(rv == 0);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_FILESYSTEM_DOSFS
+
+/* fragment files + stdin + stdout + stderr + device file when mounted */
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS (FRAG_FILE_COUNT + 4)
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (32 * 1024)
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_BDBUF_BUFFER_MAX_SIZE CLUSTER_SIZE
+
+#define CONFIGURE_BDBUF_CACHE_MEMORY_SIZE (8 * CLUSTER_SIZE)
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
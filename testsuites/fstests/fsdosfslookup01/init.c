@@ -0,0 +1,371 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/dosfs.h>
+#include <rtems/libio.h>
+#include <rtems/sparse-disk.h>
+
+const char rtems_test_name[] = "FSDOSFSLOOKUP 1";
+
+#define DEV_NAME "/dev/sda"
+
+#define MOUNT_DIR "/mnt"
+
+#define DIR_PATH "/mnt/dcim"
+
+#define SECTOR_SIZE 512
+
+/* A 64MiB disk */
+#define SECTOR_COUNT (128 * 1024)
+
+#define SECTORS_WITH_BUFFER 2048
+
+#define CLUSTER_SIZE (8 * SECTOR_SIZE)
+
+#define FILE_COUNT 5000
+
+/* Must be less than the default name cache size */
+#define LOOKUP_COUNT 64
+
+static char path[64];
+
+/*
+ * The lower case names with a four character extension cannot be short names,
+ * so each directory entry consists of two long name entries and the short
+ * name entry.
+ */
+static const char *file_path(int i)
+{
+  snprintf(path, sizeof(path), DIR_PATH "/dsc_%05i.jpeg", i);
+  return path;
+}
+
+static const char *missing_file_path(int i)
+{
+  snprintf(path, sizeof(path), DIR_PATH "/dsc_%05i.png", i);
+  return path;
+}
+
+static void create_file(const char *file)
+{
+  int fd;
+  int rv;
+
+  fd = open(file, O_WRONLY | O_CREAT | O_EXCL, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void open_file(const char *file)
+{
+  int fd;
+  int rv;
+
+  fd = open(file, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void assert_missing(const char *file)
+{
+  struct stat st;
+  int rv;
+
+  errno = 0;
+  rv = stat(file, &st);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOENT);
+}
+
+static void assert_size(const char *file, off_t size)
+{
+  struct stat st;
+  int rv;
+
+  rv = stat(file, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == size);
+}
+
+static void mount_disk(uint32_t cache_size)
+{
+  int rv;
+
+  rtems_dosfs_name_cache_size = cache_size;
+
+  rv = mount(
+    DEV_NAME,
+    MOUNT_DIR,
+    RTEMS_FILESYSTEM_TYPE_DOSFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void unmount_disk(void)
+{
+  int rv;
+
+  rv = unmount(MOUNT_DIR);
+  rtems_test_assert(rv == 0);
+}
+
+static void create_files(void)
+{
+  rtems_counter_ticks t;
+  int rv;
+  int i;
+
+  rv = mkdir(DIR_PATH, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  t = rtems_counter_read();
+
+  for (i = 0; i < FILE_COUNT; ++i) {
+    create_file(file_path(i));
+  }
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+
+  printf(
+    "  <Create count=\"%i\"><Time unit=\"ns\">%" PRIu64 "</Time></Create>\n",
+    FILE_COUNT,
+    rtems_counter_ticks_to_nanoseconds(t)
+  );
+}
+
+/* Spread the looked up files over the directory, the last is at the end */
+static int lookup_index(int i)
+{
+  return FILE_COUNT - 1 - i * (FILE_COUNT / LOOKUP_COUNT);
+}
+
+static void lookup(uint32_t cache_size, const char *pass)
+{
+  rtems_counter_ticks t;
+  int i;
+
+  t = rtems_counter_read();
+
+  for (i = 0; i < LOOKUP_COUNT; ++i) {
+    open_file(file_path(lookup_index(i)));
+  }
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+
+  printf(
+    "  <Open nameCacheSize=\"%" PRIu32 "\" pass=\"%s\" count=\"%i\">"
+      "<Time unit=\"ns\">%" PRIu64 "</Time></Open>\n",
+    cache_size,
+    pass,
+    LOOKUP_COUNT,
+    rtems_counter_ticks_to_nanoseconds(t)
+  );
+
+  t = rtems_counter_read();
+
+  for (i = 0; i < LOOKUP_COUNT; ++i) {
+    assert_missing(missing_file_path(lookup_index(i)));
+  }
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+
+  printf(
+    "  <Missing nameCacheSize=\"%" PRIu32 "\" pass=\"%s\" count=\"%i\">"
+      "<Time unit=\"ns\">%" PRIu64 "</Time></Missing>\n",
+    cache_size,
+    pass,
+    LOOKUP_COUNT,
+    rtems_counter_ticks_to_nanoseconds(t)
+  );
+}
+
+static void benchmark(uint32_t cache_size)
+{
+  mount_disk(cache_size);
+  lookup(cache_size, "cold");
+  lookup(cache_size, "warm");
+  unmount_disk();
+}
+
+/*
+ * Each step looks up names which are in the name cache due to the previous
+ * steps.
+ */
+static void test_invalidation(uint32_t cache_size)
+{
+  static const char data[] = "data";
+
+  char file[64];
+  char other_file[64];
+  char dir_file[64];
+  ssize_t n;
+  int fd;
+  int rv;
+
+  mount_disk(cache_size);
+
+  strcpy(file, file_path(0));
+  strcpy(other_file, missing_file_path(0));
+  strcpy(dir_file, DIR_PATH "/sub/file.txt");
+
+  open_file(file);
+  assert_missing(other_file);
+
+  /* The file size is read from the directory entry for each lookup */
+  assert_size(file, 0);
+  fd = open(file, O_WRONLY);
+  rtems_test_assert(fd >= 0);
+  n = write(fd, data, sizeof(data));
+  rtems_test_assert(n == (ssize_t) sizeof(data));
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+  assert_size(file, sizeof(data));
+
+  /* Rename */
+  rv = rename(file, other_file);
+  rtems_test_assert(rv == 0);
+  assert_missing(file);
+  assert_size(other_file, sizeof(data));
+
+  /* Remove */
+  rv = unlink(other_file);
+  rtems_test_assert(rv == 0);
+  assert_missing(other_file);
+  assert_missing(file);
+
+  /* Create */
+  create_file(file);
+  assert_size(file, 0);
+
+  /* Remove a directory, the next directory may reuse its cluster */
+  rv = mkdir(DIR_PATH "/sub", S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+  create_file(dir_file);
+  assert_size(dir_file, 0);
+  rv = unlink(dir_file);
+  rtems_test_assert(rv == 0);
+  assert_missing(dir_file);
+  rv = rmdir(DIR_PATH "/sub");
+  rtems_test_assert(rv == 0);
+  rv = mkdir(DIR_PATH "/sub", S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+  assert_missing(dir_file);
+  create_file(dir_file);
+  assert_size(dir_file, 0);
+
+  unmount_disk();
+}
+
+static void Init(rtems_task_argument arg)
+{
+  static const msdos_format_request_param_t rqdata = {
+    .sectors_per_cluster = CLUSTER_SIZE / SECTOR_SIZE,
+    .quick_format        = true
+  };
+
+  rtems_status_code sc;
+  uint32_t cache_size;
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = mkdir(MOUNT_DIR, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_sparse_disk_create_and_register(
+    DEV_NAME,
+    SECTOR_SIZE,
+    SECTORS_WITH_BUFFER,
+    SECTOR_COUNT,
+    0
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rv = msdos_format(DEV_NAME, &rqdata);
+  rtems_test_assert(rv == 0);
+
+  cache_size = rtems_dosfs_name_cache_size;
+
+  printf("<FSDOSFSLookup01>\n");
+  mount_disk(cache_size);
+  create_files();
+  unmount_disk();
+  benchmark(0);
+  benchmark(cache_size);
+  printf("</FSDOSFSLookup01>\n");
+
+  test_invalidation(cache_size);
+
+  rv = unlink(DEV_NAME);
+  rtems_test_assert(rv == 0);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_FILESYSTEM_DOSFS
+
+/* one file + stdin + stdout + stderr + device file when mounted */
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 5
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (32 * 1024)
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -136,7 +136,7 @@ static void test_normal_file_write(
     .write_errors         = 0
   };
   static const rtems_blkdev_stats complete_new_block_stats = {
-    .read_hits            = 3,
+    .read_hits            = 2,
     .read_misses          = 2,
     .read_ahead_transfers = 0,
     .read_blocks          = 2,
@@ -146,7 +146,7 @@ static void test_normal_file_write(
     .write_errors         = 0
   };
   static const rtems_blkdev_stats partial_new_block_stats = {
-    .read_hits            = 3,
+    .read_hits            = 2,
     .read_misses          = 3,
     .read_ahead_transfers = 0,
     .read_blocks          = 3,
@@ -0,0 +1,404 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/libio.h>
+
+const char rtems_test_name[] = "FSIMFSEXTFILE 1";
+
+#define FILE_SIZE (1024 * 1024)
+
+#define CHUNK_SIZE 4096
+
+#define RANDOM_SIZE 512
+
+#define RANDOM_COUNT 1024
+
+#define MAP_SIZE (64 * 1024)
+
+#define EXTFILE_PATH "/file"
+
+#define MEMFILE_DIR "/mem"
+
+#define MEMFILE_PATH "/mem/file"
+
+static unsigned char chunk[CHUNK_SIZE];
+
+static unsigned char other_chunk[CHUNK_SIZE];
+
+static uint32_t random_state;
+
+static uint32_t random_next(void)
+{
+  random_state = random_state * 1103515245 + 12345;
+  return random_state >> 8;
+}
+
+static off_t random_offset(void)
+{
+  return (off_t) (random_next() % (FILE_SIZE / RANDOM_SIZE)) * RANDOM_SIZE;
+}
+
+static void fill(unsigned char *buf, size_t n, off_t offset)
+{
+  size_t i;
+
+  for (i = 0; i < n; ++i) {
+    buf[i] = (unsigned char) ((offset + i) % 251);
+  }
+}
+
+static void print_time(const char *name, rtems_counter_ticks ticks)
+{
+  printf(
+    "    <%s><Time unit=\"ns\">%" PRIu64 "</Time></%s>\n",
+    name,
+    rtems_counter_ticks_to_nanoseconds(ticks),
+    name
+  );
+}
+
+static void do_sequential_write(int fd)
+{
+  rtems_counter_ticks t;
+  off_t offset;
+
+  t = rtems_counter_read();
+
+  for (offset = 0; offset < FILE_SIZE; offset += CHUNK_SIZE) {
+    ssize_t n;
+
+    n = write(fd, chunk, CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+  }
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+  print_time("SequentialWrite", t);
+}
+
+static void do_sequential_read(int fd)
+{
+  rtems_counter_ticks t;
+  off_t offset;
+  off_t rv;
+
+  rv = lseek(fd, 0, SEEK_SET);
+  rtems_test_assert(rv == 0);
+
+  t = rtems_counter_read();
+
+  for (offset = 0; offset < FILE_SIZE; offset += CHUNK_SIZE) {
+    ssize_t n;
+
+    n = read(fd, other_chunk, CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+  }
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+  print_time("SequentialRead", t);
+}
+
+static void do_random_write(int fd)
+{
+  rtems_counter_ticks t;
+  int i;
+
+  random_state = 1;
+  t = rtems_counter_read();
+
+  for (i = 0; i < RANDOM_COUNT; ++i) {
+    off_t rv;
+    ssize_t n;
+
+    rv = lseek(fd, random_offset(), SEEK_SET);
+    rtems_test_assert(rv >= 0);
+    n = write(fd, chunk, RANDOM_SIZE);
+    rtems_test_assert(n == RANDOM_SIZE);
+  }
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+  print_time("RandomWrite", t);
+}
+
+static void do_random_read(int fd)
+{
+  rtems_counter_ticks t;
+  int i;
+
+  random_state = 2;
+  t = rtems_counter_read();
+
+  for (i = 0; i < RANDOM_COUNT; ++i) {
+    off_t rv;
+    ssize_t n;
+
+    rv = lseek(fd, random_offset(), SEEK_SET);
+    rtems_test_assert(rv >= 0);
+    n = read(fd, other_chunk, RANDOM_SIZE);
+    rtems_test_assert(n == RANDOM_SIZE);
+  }
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+  print_time("RandomRead", t);
+}
+
+static void benchmark(const char *name, const char *path)
+{
+  int fd;
+  int rv;
+
+  printf("  <Throughput file=\"%s\" size=\"%i\">\n", name, FILE_SIZE);
+
+  fd = open(path, O_RDWR | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  do_sequential_write(fd);
+  do_sequential_read(fd);
+  do_random_write(fd);
+  do_random_read(fd);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  rv = unlink(path);
+  rtems_test_assert(rv == 0);
+
+  printf("  </Throughput>\n");
+}
+
+static void test_data(void)
+{
+  struct stat st;
+  off_t offset;
+  off_t rv;
+  ssize_t n;
+  int fd;
+  int eno;
+
+  fd = open(EXTFILE_PATH, O_RDWR | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  /* Write with a hole and check the data */
+  rv = lseek(fd, CHUNK_SIZE + 1, SEEK_SET);
+  rtems_test_assert(rv == CHUNK_SIZE + 1);
+
+  for (offset = CHUNK_SIZE + 1; offset < 8 * CHUNK_SIZE; offset += 1000) {
+    fill(chunk, 1000, offset);
+    n = write(fd, chunk, 1000);
+    rtems_test_assert(n == 1000);
+  }
+
+  eno = fstat(fd, &st);
+  rtems_test_assert(eno == 0);
+  rtems_test_assert(st.st_size == offset);
+
+  rv = lseek(fd, 0, SEEK_SET);
+  rtems_test_assert(rv == 0);
+  n = read(fd, other_chunk, CHUNK_SIZE + 1);
+  rtems_test_assert(n == CHUNK_SIZE + 1);
+  memset(chunk, 0, CHUNK_SIZE + 1);
+  rtems_test_assert(memcmp(chunk, other_chunk, CHUNK_SIZE + 1) == 0);
+
+  for (offset = CHUNK_SIZE + 1; offset < 8 * CHUNK_SIZE; offset += 1000) {
+    fill(chunk, 1000, offset);
+    n = read(fd, other_chunk, 1000);
+    rtems_test_assert(n == 1000);
+    rtems_test_assert(memcmp(chunk, other_chunk, 1000) == 0);
+  }
+
+  /* Shrink and grow again, the previous data must be gone */
+  eno = ftruncate(fd, 1);
+  rtems_test_assert(eno == 0);
+  eno = ftruncate(fd, CHUNK_SIZE + 1);
+  rtems_test_assert(eno == 0);
+
+  rv = lseek(fd, 1, SEEK_SET);
+  rtems_test_assert(rv == 1);
+  n = read(fd, other_chunk, CHUNK_SIZE);
+  rtems_test_assert(n == CHUNK_SIZE);
+  memset(chunk, 0, CHUNK_SIZE);
+  rtems_test_assert(memcmp(chunk, other_chunk, CHUNK_SIZE) == 0);
+
+  n = read(fd, other_chunk, CHUNK_SIZE);
+  rtems_test_assert(n == 0);
+
+  eno = close(fd);
+  rtems_test_assert(eno == 0);
+
+  eno = unlink(EXTFILE_PATH);
+  rtems_test_assert(eno == 0);
+}
+
+static void test_mmap(void)
+{
+  unsigned char *p;
+  void *q;
+  ssize_t n;
+  off_t rv;
+  int fd;
+  int eno;
+
+  fd = open(EXTFILE_PATH, O_RDWR | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  /* The preallocation by ftruncate() enables a mapping of the whole file */
+  eno = ftruncate(fd, MAP_SIZE);
+  rtems_test_assert(eno == 0);
+
+  p = mmap(NULL, MAP_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  rtems_test_assert(p != MAP_FAILED);
+  rtems_test_assert(p[0] == 0);
+  rtems_test_assert(p[MAP_SIZE - 1] == 0);
+
+  fill(p, MAP_SIZE, 0);
+
+  rv = lseek(fd, MAP_SIZE - CHUNK_SIZE, SEEK_SET);
+  rtems_test_assert(rv == MAP_SIZE - CHUNK_SIZE);
+  n = read(fd, other_chunk, CHUNK_SIZE);
+  rtems_test_assert(n == CHUNK_SIZE);
+  rtems_test_assert(
+    memcmp(&p[MAP_SIZE - CHUNK_SIZE], other_chunk, CHUNK_SIZE) == 0
+  );
+
+  /* A write is visible in the mapping */
+  memset(chunk, 0xaa, CHUNK_SIZE);
+  rv = lseek(fd, 0, SEEK_SET);
+  rtems_test_assert(rv == 0);
+  n = write(fd, chunk, CHUNK_SIZE);
+  rtems_test_assert(n == CHUNK_SIZE);
+  rtems_test_assert(memcmp(p, chunk, CHUNK_SIZE) == 0);
+
+  /* The extension is a new extent, a mapping must not span extents */
+  rv = lseek(fd, MAP_SIZE, SEEK_SET);
+  rtems_test_assert(rv == MAP_SIZE);
+  n = write(fd, chunk, CHUNK_SIZE);
+  rtems_test_assert(n == CHUNK_SIZE);
+
+  errno = 0;
+  q = mmap(NULL, 2 * CHUNK_SIZE, PROT_READ, MAP_SHARED, fd,
+    MAP_SIZE - CHUNK_SIZE);
+  rtems_test_assert(q == MAP_FAILED);
+  rtems_test_assert(errno == ENOTSUP);
+
+  q = mmap(NULL, CHUNK_SIZE, PROT_READ, MAP_SHARED, fd, MAP_SIZE);
+  rtems_test_assert(q != MAP_FAILED);
+  rtems_test_assert(memcmp(q, chunk, CHUNK_SIZE) == 0);
+
+  /* The mappings keep the file memory after a close() and unlink() */
+  eno = close(fd);
+  rtems_test_assert(eno == 0);
+
+  eno = unlink(EXTFILE_PATH);
+  rtems_test_assert(eno == 0);
+
+  errno = 0;
+  fd = open(EXTFILE_PATH, O_RDONLY);
+  rtems_test_assert(fd == -1);
+  rtems_test_assert(errno == ENOENT);
+
+  rtems_test_assert(memcmp(p, chunk, CHUNK_SIZE) == 0);
+  rtems_test_assert(memcmp(q, chunk, CHUNK_SIZE) == 0);
+
+  fill(p, MAP_SIZE, 1);
+  fill(other_chunk, CHUNK_SIZE, MAP_SIZE - CHUNK_SIZE + 1);
+  rtems_test_assert(
+    memcmp(&p[MAP_SIZE - CHUNK_SIZE], other_chunk, CHUNK_SIZE) == 0
+  );
+
+  eno = munmap(q, CHUNK_SIZE);
+  rtems_test_assert(eno == 0);
+
+  eno = munmap(p, MAP_SIZE);
+  rtems_test_assert(eno == 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  test_data();
+  test_mmap();
+
+  rv = mkdir(MEMFILE_DIR, S_IRWXU);
+  rtems_test_assert(rv == 0);
+
+  rv = mount(
+    NULL,
+    MEMFILE_DIR,
+    RTEMS_FILESYSTEM_TYPE_IMFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+
+  memset(chunk, 0x55, sizeof(chunk));
+
+  printf("<FSIMFSExtFile01>\n");
+  benchmark("extent", EXTFILE_PATH);
+  benchmark("memory", MEMFILE_PATH);
+  printf("</FSIMFSExtFile01>\n");
+
+  rv = unmount(MEMFILE_DIR);
+  rtems_test_assert(rv == 0);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_FILESYSTEM_IMFS
+
+#define CONFIGURE_IMFS_USE_EXTENT_FILES
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,225 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/imfs.h>
+
+const char rtems_test_name[] = "FSIMFSLOOKUP 1";
+
+#define MAX_ENTRIES 10000
+
+#define FILE_MODE (S_IFREG | S_IRWXU | S_IRWXG | S_IRWXO)
+
+#define DIR_MODE (S_IRWXU | S_IRWXG | S_IRWXO)
+
+static const size_t entry_counts[] = {
+  8,
+  IMFS_DIRECTORY_INDEX_THRESHOLD,
+  IMFS_DIRECTORY_INDEX_THRESHOLD + 1,
+  100,
+  1000,
+  MAX_ENTRIES
+};
+
+static void make_path(char *path, size_t size, size_t dir, size_t entry)
+{
+  int n;
+
+  n = snprintf(path, size, "/d%zu/f%05zu", dir, entry);
+  rtems_test_assert(n > 0 && (size_t) n < size);
+}
+
+static void make_other_path(char *path, size_t size, size_t dir, size_t entry)
+{
+  int n;
+
+  n = snprintf(path, size, "/d%zu/x%05zu", dir, entry);
+  rtems_test_assert(n > 0 && (size_t) n < size);
+}
+
+static uint64_t stat_time(const char *path, int expected_rv)
+{
+  struct stat st;
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  int rv;
+
+  a = rtems_counter_read();
+  rv = stat(path, &st);
+  b = rtems_counter_read();
+  rtems_test_assert(rv == expected_rv);
+
+  return rtems_counter_ticks_to_nanoseconds(
+    rtems_counter_difference(b, a)
+  );
+}
+
+static void test_lookup(size_t dir, size_t count)
+{
+  char path[32];
+  uint64_t hit;
+  uint64_t miss;
+  size_t i;
+  int rv;
+
+  rv = snprintf(path, sizeof(path), "/d%zu", dir);
+  rtems_test_assert(rv > 0 && (size_t) rv < sizeof(path));
+  rv = mkdir(path, DIR_MODE);
+  rtems_test_assert(rv == 0);
+
+  for (i = 0; i < count; ++i) {
+    make_path(path, sizeof(path), dir, i);
+    rv = mknod(path, FILE_MODE, 0);
+    rtems_test_assert(rv == 0);
+  }
+
+  hit = 0;
+  miss = 0;
+
+  for (i = 0; i < count; ++i) {
+    make_path(path, sizeof(path), dir, i);
+    hit += stat_time(path, 0);
+
+    make_other_path(path, sizeof(path), dir, i);
+    miss += stat_time(path, -1);
+    rtems_test_assert(errno == ENOENT);
+  }
+
+  printf(
+    "  <Lookup entries=\"%zu\">\n"
+    "    <Hit unit=\"ns\">%" PRIu64 "</Hit>"
+    "<Miss unit=\"ns\">%" PRIu64 "</Miss>\n"
+    "  </Lookup>\n",
+    count,
+    hit / count,
+    miss / count
+  );
+}
+
+static void test_rename_and_link(size_t dir, size_t count)
+{
+  char path[32];
+  char other[32];
+  struct stat st;
+  size_t i;
+  int rv;
+
+  /* Rename every second entry and add a hard link for the others */
+  for (i = 0; i < count; ++i) {
+    make_path(path, sizeof(path), dir, i);
+    make_other_path(other, sizeof(other), dir, i);
+
+    if ((i % 2) == 0) {
+      rv = rename(path, other);
+    } else {
+      rv = link(path, other);
+    }
+
+    rtems_test_assert(rv == 0);
+  }
+
+  for (i = 0; i < count; ++i) {
+    make_path(path, sizeof(path), dir, i);
+    rv = stat(path, &st);
+
+    if ((i % 2) == 0) {
+      rtems_test_assert(rv == -1);
+      rtems_test_assert(errno == ENOENT);
+    } else {
+      rtems_test_assert(rv == 0);
+      rtems_test_assert(st.st_nlink == 2);
+      rv = unlink(path);
+      rtems_test_assert(rv == 0);
+    }
+
+    make_other_path(other, sizeof(other), dir, i);
+    rv = stat(other, &st);
+    rtems_test_assert(rv == 0);
+    rtems_test_assert(st.st_nlink == 1);
+  }
+
+  for (i = 0; i < count; ++i) {
+    make_other_path(other, sizeof(other), dir, i);
+    rv = unlink(other);
+    rtems_test_assert(rv == 0);
+    rv = stat(other, &st);
+    rtems_test_assert(rv == -1);
+    rtems_test_assert(errno == ENOENT);
+  }
+
+  rv = snprintf(path, sizeof(path), "/d%zu", dir);
+  rtems_test_assert(rv > 0 && (size_t) rv < sizeof(path));
+  rv = rmdir(path);
+  rtems_test_assert(rv == 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  size_t i;
+
+  TEST_BEGIN();
+
+  printf(
+    "<FSIMFSLookup01 indexThreshold=\"%i\">\n",
+    IMFS_DIRECTORY_INDEX_THRESHOLD
+  );
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(entry_counts); ++i) {
+    test_lookup(i, entry_counts[i]);
+    test_rename_and_link(i, entry_counts[i]);
+  }
+
+  printf("</FSIMFSLookup01>\n");
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,331 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/bdbuf.h>
+#include <rtems/blkdev.h>
+
+const char rtems_test_name[] = "BLOCK 18";
+
+#define BLOCK_SIZE 512
+
+#define BLOCK_COUNT 128
+
+#define MAX_WRITE_BLOCKS 16
+
+typedef struct {
+  const char *path;
+  bool continuous;
+  uint32_t requests;
+  uint32_t blocks;
+  rtems_disk_device *dd;
+  unsigned char data[BLOCK_COUNT][BLOCK_SIZE];
+} test_disk;
+
+typedef struct {
+  const char *name;
+  void (*fill)(rtems_blkdev_bnum *blocks, size_t *count);
+} test_pattern;
+
+static test_disk disks[] = {
+  { .path = "/disk-sg", .continuous = false },
+  { .path = "/disk-cont", .continuous = true }
+};
+
+/*
+ * A RAM disk which counts the transfer requests and blocks.  The continuous
+ * variant reports the RTEMS_BLKDEV_CAP_MULTISECTOR_CONT capability and
+ * checks that each request covers consecutive blocks.
+ */
+static int test_disk_ioctl(rtems_disk_device *dd, uint32_t req, void *arg)
+{
+  test_disk *disk = rtems_disk_get_driver_data(dd);
+  int rv = 0;
+
+  if (req == RTEMS_BLKIO_REQUEST) {
+    rtems_blkdev_request *breq = arg;
+    rtems_blkdev_sg_buffer *sg = breq->bufs;
+    uint32_t i;
+
+    rtems_test_assert(breq->req == RTEMS_BLKDEV_REQ_WRITE);
+    rtems_test_assert(breq->bufnum <= MAX_WRITE_BLOCKS);
+
+    ++disk->requests;
+
+    for (i = 0; i < breq->bufnum; ++i) {
+      rtems_blkdev_bnum block = sg[i].block;
+
+      rtems_test_assert(block < BLOCK_COUNT);
+      rtems_test_assert(sg[i].length == BLOCK_SIZE);
+      rtems_test_assert(!disk->continuous || i == 0
+        || block == sg[i - 1].block + 1);
+
+      memcpy(disk->data[block], sg[i].buffer, BLOCK_SIZE);
+      ++disk->blocks;
+    }
+
+    rtems_blkdev_request_done(breq, RTEMS_SUCCESSFUL);
+  } else if (req == RTEMS_BLKIO_CAPABILITIES) {
+    *(uint32_t *) arg = disk->continuous ?
+      RTEMS_BLKDEV_CAP_MULTISECTOR_CONT : 0;
+  } else {
+    rv = rtems_blkdev_ioctl(dd, req, arg);
+  }
+
+  return rv;
+}
+
+static void shuffle(rtems_blkdev_bnum *blocks, size_t count)
+{
+  uint32_t seed = 12345;
+  size_t i;
+
+  for (i = count - 1; i > 0; --i) {
+    size_t j;
+    rtems_blkdev_bnum tmp;
+
+    seed = seed * 1103515245 + 12345;
+    j = (seed >> 16) % (i + 1);
+
+    tmp = blocks[i];
+    blocks[i] = blocks[j];
+    blocks[j] = tmp;
+  }
+}
+
+static void fill_sequential(rtems_blkdev_bnum *blocks, size_t *count)
+{
+  size_t i;
+
+  for (i = 0; i < BLOCK_COUNT; ++i) {
+    blocks[i] = i;
+  }
+
+  *count = BLOCK_COUNT;
+}
+
+static void fill_reverse(rtems_blkdev_bnum *blocks, size_t *count)
+{
+  size_t i;
+
+  for (i = 0; i < BLOCK_COUNT; ++i) {
+    blocks[i] = BLOCK_COUNT - 1 - i;
+  }
+
+  *count = BLOCK_COUNT;
+}
+
+static void fill_random(rtems_blkdev_bnum *blocks, size_t *count)
+{
+  fill_sequential(blocks, count);
+  shuffle(blocks, *count);
+}
+
+static void fill_random_strided(rtems_blkdev_bnum *blocks, size_t *count)
+{
+  size_t i;
+
+  for (i = 0; i < BLOCK_COUNT / 2; ++i) {
+    blocks[i] = 2 * i;
+  }
+
+  *count = BLOCK_COUNT / 2;
+  shuffle(blocks, *count);
+}
+
+static const test_pattern patterns[] = {
+  { "sequential", fill_sequential },
+  { "reverse", fill_reverse },
+  { "random", fill_random },
+  { "random strided", fill_random_strided }
+};
+
+static void write_pattern(
+  test_disk *disk,
+  const rtems_blkdev_bnum *blocks,
+  size_t count,
+  uint8_t value
+)
+{
+  rtems_status_code sc;
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    rtems_bdbuf_buffer *bd;
+
+    sc = rtems_bdbuf_get(disk->dd, blocks[i], &bd);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    memset(bd->buffer, value, BLOCK_SIZE);
+
+    sc = rtems_bdbuf_release_modified(bd);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  sc = rtems_bdbuf_syncdev(disk->dd);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (i = 0; i < count; ++i) {
+    size_t j;
+
+    for (j = 0; j < BLOCK_SIZE; ++j) {
+      rtems_test_assert(disk->data[blocks[i]][j] == value);
+    }
+  }
+}
+
+static void test_patterns(void)
+{
+  static rtems_blkdev_bnum blocks[BLOCK_COUNT];
+  size_t p;
+  uint8_t value = 0;
+
+  printf(
+    "%-16s | %-10s | %8s | %8s\n",
+    "PATTERN",
+    "DISK",
+    "REQUESTS",
+    "BLOCKS"
+  );
+
+  for (p = 0; p < RTEMS_ARRAY_SIZE(patterns); ++p) {
+    const test_pattern *pattern = &patterns[p];
+    size_t count;
+    size_t d;
+
+    (*pattern->fill)(blocks, &count);
+
+    for (d = 0; d < RTEMS_ARRAY_SIZE(disks); ++d) {
+      test_disk *disk = &disks[d];
+
+      disk->requests = 0;
+      disk->blocks = 0;
+      ++value;
+
+      write_pattern(disk, blocks, count, value);
+
+      rtems_test_assert(disk->blocks == count);
+
+      printf(
+        "%-16s | %-10s | %8" PRIu32 " | %8" PRIu32 "\n",
+        pattern->name,
+        disk->continuous ? "continuous" : "sg",
+        disk->requests,
+        disk->blocks
+      );
+    }
+  }
+}
+
+static void create_disks(void)
+{
+  size_t d;
+
+  for (d = 0; d < RTEMS_ARRAY_SIZE(disks); ++d) {
+    test_disk *disk = &disks[d];
+    rtems_status_code sc;
+    int fd;
+    int rv;
+
+    sc = rtems_blkdev_create(
+      disk->path,
+      BLOCK_SIZE,
+      BLOCK_COUNT,
+      test_disk_ioctl,
+      disk
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    fd = open(disk->path, O_RDWR);
+    rtems_test_assert(fd >= 0);
+
+    rv = rtems_disk_fd_get_disk_device(fd, &disk->dd);
+    rtems_test_assert(rv == 0);
+
+    rv = close(fd);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static void delete_disks(void)
+{
+  size_t d;
+
+  for (d = 0; d < RTEMS_ARRAY_SIZE(disks); ++d) {
+    int rv;
+
+    rv = unlink(disks[d].path);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  create_disks();
+  test_patterns();
+  delete_disks();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_BDBUF_BUFFER_MIN_SIZE BLOCK_SIZE
+#define CONFIGURE_BDBUF_BUFFER_MAX_SIZE BLOCK_SIZE
+#define CONFIGURE_BDBUF_CACHE_MEMORY_SIZE (2 * BLOCK_COUNT * BLOCK_SIZE)
+#define CONFIGURE_BDBUF_MAX_WRITE_BLOCKS MAX_WRITE_BLOCKS
+
+/* Ensure that only the sync writes the modified blocks */
+#define CONFIGURE_SWAPOUT_BLOCK_HOLD 60000
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,394 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/bdbuf.h>
+#include <rtems/blkdev.h>
+
+const char rtems_test_name[] = "BLOCK 20";
+
+#define DISK_PATH "/disk"
+
+#define BUFFER_COUNT 128
+
+#define BLOCK_COUNT (4 * BUFFER_COUNT)
+
+#define MAX_READ_AHEAD_BLOCKS 16
+
+static int block_access_counts[BLOCK_COUNT];
+
+static rtems_bdbuf_buffer *bds[BUFFER_COUNT];
+
+static int test_disk_ioctl(rtems_disk_device *dd, uint32_t req, void *arg)
+{
+  int rv = 0;
+
+  if (req == RTEMS_BLKIO_REQUEST) {
+    rtems_blkdev_request *breq = arg;
+    uint32_t i;
+
+    rtems_test_assert(breq->req == RTEMS_BLKDEV_REQ_READ);
+
+    for (i = 0; i < breq->bufnum; ++i) {
+      rtems_blkdev_bnum block = breq->bufs[i].block;
+
+      rtems_test_assert(block < BLOCK_COUNT);
+
+      ++block_access_counts[block];
+    }
+
+    rtems_blkdev_request_done(breq, RTEMS_SUCCESSFUL);
+  } else {
+    rv = rtems_blkdev_ioctl(dd, req, arg);
+  }
+
+  return rv;
+}
+
+static void read_block(rtems_disk_device *dd, rtems_blkdev_bnum block)
+{
+  rtems_status_code sc;
+  rtems_bdbuf_buffer *bd;
+
+  sc = rtems_bdbuf_read(dd, block, &bd);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_bdbuf_release(bd);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void read_blocks(
+  rtems_disk_device *dd,
+  rtems_blkdev_bnum begin,
+  rtems_blkdev_bnum end
+)
+{
+  rtems_blkdev_bnum block;
+
+  for (block = begin; block < end; ++block) {
+    read_block(dd, block);
+  }
+}
+
+static void check_transferred(rtems_blkdev_bnum begin, rtems_blkdev_bnum end)
+{
+  rtems_blkdev_bnum block;
+
+  for (block = 0; block < BLOCK_COUNT; ++block) {
+    int expected = block >= begin && block < end ? 1 : 0;
+
+    rtems_test_assert(block_access_counts[block] == expected);
+  }
+}
+
+static const rtems_blkdev_read_ahead *find_stream(
+  const rtems_disk_device *dd,
+  rtems_blkdev_bnum expected
+)
+{
+  size_t i;
+
+  for (i = 0; i < RTEMS_DISK_READ_AHEAD_STREAM_COUNT; ++i) {
+    if (dd->read_ahead[i].expected == expected) {
+      return &dd->read_ahead[i];
+    }
+  }
+
+  rtems_test_assert(0);
+  return NULL;
+}
+
+static void check_stream(
+  const rtems_disk_device *dd,
+  rtems_blkdev_bnum expected,
+  uint32_t window,
+  rtems_blkdev_bnum trigger,
+  rtems_blkdev_bnum next
+)
+{
+  const rtems_blkdev_read_ahead *ra = find_stream(dd, expected);
+
+  rtems_test_assert(ra->window == window);
+  rtems_test_assert(ra->trigger == trigger);
+  rtems_test_assert(ra->next == next);
+}
+
+static void reset(rtems_disk_device *dd)
+{
+  rtems_bdbuf_purge_dev(dd);
+  rtems_bdbuf_reset_device_stats(dd);
+  memset(&block_access_counts, 0, sizeof(block_access_counts));
+}
+
+/*
+ * The window starts with four blocks and doubles with each trigger hit up to
+ * the maximum read-ahead blocks.
+ */
+static void test_window_growth(rtems_disk_device *dd)
+{
+  rtems_blkdev_stats stats;
+
+  reset(dd);
+
+  read_block(dd, 0);
+  check_stream(dd, 1, 0, 1, 2);
+  read_block(dd, 1);
+  check_stream(dd, 2, 4, 4, 6);
+  check_transferred(0, 6);
+  read_blocks(dd, 2, 5);
+  check_stream(dd, 5, 8, 10, 14);
+  check_transferred(0, 14);
+  read_blocks(dd, 5, 11);
+  check_stream(dd, 11, 16, 22, 30);
+  check_transferred(0, 30);
+  read_blocks(dd, 11, 23);
+  check_stream(dd, 23, 16, 38, 46);
+  check_transferred(0, 46);
+  read_blocks(dd, 23, 40);
+  check_stream(dd, 40, 16, 54, 62);
+  check_transferred(0, 62);
+
+  rtems_bdbuf_get_device_stats(dd, &stats);
+  rtems_test_assert(stats.read_hits == 38);
+  rtems_test_assert(stats.read_misses == 2);
+  rtems_test_assert(stats.read_blocks == 62);
+  rtems_test_assert(stats.read_ahead_transfers == 5);
+  rtems_test_assert(stats.read_ahead_hits == 38);
+  rtems_test_assert(stats.read_ahead_misses == 0);
+  rtems_test_assert(stats.read_ahead_wasted == 0);
+}
+
+/*
+ * Get all buffers of the cache, so that the blocks of the last read-ahead
+ * window of the stream of test_window_growth() are lost before the stream
+ * reaches them.  The window shrinks and grows again afterwards.
+ */
+static void test_window_shrink(rtems_disk_device *dd)
+{
+  rtems_status_code sc;
+  rtems_blkdev_stats stats;
+  size_t i;
+
+  rtems_bdbuf_reset_device_stats(dd);
+  memset(&block_access_counts, 0, sizeof(block_access_counts));
+
+  for (i = 0; i < BUFFER_COUNT; ++i) {
+    sc = rtems_bdbuf_get(dd, BLOCK_COUNT - BUFFER_COUNT + i, &bds[i]);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  for (i = 0; i < BUFFER_COUNT; ++i) {
+    sc = rtems_bdbuf_release(bds[i]);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  rtems_bdbuf_get_device_stats(dd, &stats);
+  rtems_test_assert(stats.read_ahead_wasted == 22);
+
+  read_block(dd, 40);
+  check_stream(dd, 41, 8, 45, 49);
+  check_transferred(40, 49);
+
+  rtems_bdbuf_get_device_stats(dd, &stats);
+  rtems_test_assert(stats.read_misses == 1);
+  rtems_test_assert(stats.read_ahead_misses == 1);
+
+  read_blocks(dd, 41, 46);
+  check_stream(dd, 46, 16, 57, 65);
+  check_transferred(40, 65);
+
+  rtems_bdbuf_get_device_stats(dd, &stats);
+  rtems_test_assert(stats.read_hits == 5);
+  rtems_test_assert(stats.read_misses == 1);
+  rtems_test_assert(stats.read_ahead_transfers == 2);
+  rtems_test_assert(stats.read_ahead_hits == 5);
+  rtems_test_assert(stats.read_ahead_misses == 1);
+}
+
+/*
+ * While the read-ahead task is suspended, the stream reads the blocks of its
+ * queued read-ahead request.  These read misses are no read-ahead misses and
+ * the window stays the same.
+ */
+static void test_queued_read_ahead(rtems_disk_device *dd)
+{
+  rtems_status_code sc;
+  rtems_blkdev_stats stats;
+  rtems_id id;
+
+  sc = rtems_task_ident(
+    rtems_build_name('B', 'R', 'D', 'A'),
+    RTEMS_SEARCH_LOCAL_NODE,
+    &id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  reset(dd);
+
+  read_block(dd, 100);
+
+  sc = rtems_task_suspend(id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  read_blocks(dd, 101, 104);
+  check_stream(dd, 104, 4, 103, 104);
+  check_transferred(100, 104);
+
+  rtems_bdbuf_get_device_stats(dd, &stats);
+  rtems_test_assert(stats.read_misses == 4);
+  rtems_test_assert(stats.read_ahead_transfers == 0);
+  rtems_test_assert(stats.read_ahead_misses == 0);
+
+  sc = rtems_task_resume(id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  check_stream(dd, 104, 4, 106, 108);
+  check_transferred(100, 108);
+
+  read_blocks(dd, 104, 108);
+  check_stream(dd, 108, 8, 112, 116);
+  check_transferred(100, 116);
+
+  rtems_bdbuf_get_device_stats(dd, &stats);
+  rtems_test_assert(stats.read_hits == 4);
+  rtems_test_assert(stats.read_misses == 4);
+  rtems_test_assert(stats.read_ahead_transfers == 2);
+  rtems_test_assert(stats.read_ahead_hits == 4);
+  rtems_test_assert(stats.read_ahead_misses == 0);
+}
+
+/*
+ * Two interleaved sequential streams get their own read-ahead windows.
+ */
+static void test_multiple_streams(rtems_disk_device *dd)
+{
+  rtems_blkdev_stats stats;
+  rtems_blkdev_bnum block;
+  rtems_blkdev_bnum other = BLOCK_COUNT / 2;
+  rtems_blkdev_bnum i;
+
+  reset(dd);
+
+  for (block = 0; block < 16; ++block) {
+    read_block(dd, block);
+    read_block(dd, other + block);
+  }
+
+  check_stream(dd, 16, 16, 22, 30);
+  check_stream(dd, other + 16, 16, other + 22, other + 30);
+
+  for (i = 0; i < BLOCK_COUNT; ++i) {
+    int expected = i < 30 || (i >= other && i < other + 30) ? 1 : 0;
+
+    rtems_test_assert(block_access_counts[i] == expected);
+  }
+
+  rtems_bdbuf_get_device_stats(dd, &stats);
+  rtems_test_assert(stats.read_hits == 28);
+  rtems_test_assert(stats.read_misses == 4);
+  rtems_test_assert(stats.read_ahead_transfers == 6);
+  rtems_test_assert(stats.read_ahead_hits == 28);
+  rtems_test_assert(stats.read_ahead_misses == 0);
+}
+
+static void test(void)
+{
+  rtems_status_code sc;
+  rtems_disk_device *dd;
+  int fd;
+  int rv;
+
+  sc = rtems_blkdev_create(
+    DISK_PATH,
+    1,
+    BLOCK_COUNT,
+    test_disk_ioctl,
+    NULL
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  fd = open(DISK_PATH, O_RDWR);
+  rtems_test_assert(fd >= 0);
+
+  rv = rtems_disk_fd_get_disk_device(fd, &dd);
+  rtems_test_assert(rv == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  test_window_growth(dd);
+  test_window_shrink(dd);
+  test_queued_read_ahead(dd);
+  test_multiple_streams(dd);
+
+  rv = unlink(DISK_PATH);
+  rtems_test_assert(rv == 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_BDBUF_BUFFER_MIN_SIZE 1
+#define CONFIGURE_BDBUF_BUFFER_MAX_SIZE 1
+#define CONFIGURE_BDBUF_CACHE_MEMORY_SIZE BUFFER_COUNT
+#define CONFIGURE_BDBUF_MAX_READ_AHEAD_BLOCKS MAX_READ_AHEAD_BLOCKS
+#define CONFIGURE_BDBUF_READ_AHEAD_TASK_PRIORITY 1
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_INITIAL_MODES RTEMS_DEFAULT_MODES
+#define CONFIGURE_INIT_TASK_PRIORITY 2
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
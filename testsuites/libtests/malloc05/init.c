@@ -0,0 +1,296 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/malloc.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <tmacros.h>
+
+const char rtems_test_name[] = "MALLOC 5";
+
+#define CLASS_INDEX 1
+
+#define OBJECT_SIZE 40
+
+#define MAX_OBJECTS 64
+
+static void *objects[ MAX_OBJECTS ];
+
+static rtems_malloc_cache_class_info get_class_info( size_t index )
+{
+  rtems_malloc_cache_info info;
+  int rv;
+
+  rv = malloc_cache_info( &info );
+  rtems_test_assert( rv == 0 );
+
+  return info.classes[ index ];
+}
+
+static void check_distinct( size_t count )
+{
+  size_t i;
+  size_t j;
+
+  for ( i = 0; i < count; ++i ) {
+    for ( j = i + 1; j < count; ++j ) {
+      rtems_test_assert( objects[ i ] != objects[ j ] );
+    }
+  }
+}
+
+static void test_info( void )
+{
+  rtems_malloc_cache_info info;
+  size_t i;
+  int rv;
+
+  rv = malloc_cache_info( NULL );
+  rtems_test_assert( rv == -1 );
+
+  rv = malloc_cache_info( &info );
+  rtems_test_assert( rv == 0 );
+
+  for ( i = 0; i < RTEMS_MALLOC_CACHE_CLASS_COUNT; ++i ) {
+    rtems_test_assert(
+      info.classes[ i ].size == ( i + 1 ) * RTEMS_MALLOC_CACHE_CLASS_SIZE
+    );
+    rtems_test_assert(
+      info.classes[ i ].cached <= 2 * RTEMS_MALLOC_CACHE_MAGAZINE_SIZE
+    );
+  }
+}
+
+static void test_allocate_and_free( void )
+{
+  rtems_malloc_cache_class_info before;
+  rtems_malloc_cache_class_info after;
+  size_t count;
+  size_t i;
+
+  /* Drain the cache until the first refill */
+  before = get_class_info( CLASS_INDEX );
+  count = 0;
+
+  do {
+    rtems_test_assert( count < MAX_OBJECTS );
+    objects[ count ] = malloc( OBJECT_SIZE );
+    rtems_test_assert( objects[ count ] != NULL );
+    memset( objects[ count ], 0xa5, OBJECT_SIZE );
+    ++count;
+    after = get_class_info( CLASS_INDEX );
+  } while ( after.misses == before.misses );
+
+  rtems_test_assert( after.hits - before.hits == before.cached );
+  rtems_test_assert( after.misses - before.misses == 1 );
+  rtems_test_assert( after.refills - before.refills == 1 );
+  rtems_test_assert( after.cached == RTEMS_MALLOC_CACHE_MAGAZINE_SIZE - 1 );
+
+  /* Now the cache satisfies the next allocations */
+  before = after;
+
+  for ( i = 0; i < RTEMS_MALLOC_CACHE_MAGAZINE_SIZE - 1; ++i ) {
+    rtems_test_assert( count < MAX_OBJECTS );
+    objects[ count ] = malloc( OBJECT_SIZE );
+    rtems_test_assert( objects[ count ] != NULL );
+    memset( objects[ count ], 0x5a, OBJECT_SIZE );
+    ++count;
+  }
+
+  after = get_class_info( CLASS_INDEX );
+  rtems_test_assert( after.hits - before.hits == i );
+  rtems_test_assert( after.misses == before.misses );
+  rtems_test_assert( after.cached == 0 );
+
+  check_distinct( count );
+
+  /* Overflow of both magazines returns a batch to the heap */
+  before = after;
+
+  for ( i = 0; i < count; ++i ) {
+    free( objects[ i ] );
+  }
+
+  after = get_class_info( CLASS_INDEX );
+  rtems_test_assert( after.frees - before.frees == count );
+  rtems_test_assert( after.cached <= 2 * RTEMS_MALLOC_CACHE_MAGAZINE_SIZE );
+  rtems_test_assert(
+    after.cached + RTEMS_MALLOC_CACHE_MAGAZINE_SIZE
+      * ( after.flushes - before.flushes ) == count
+  );
+}
+
+static void test_not_cached( void )
+{
+  rtems_malloc_cache_info before;
+  rtems_malloc_cache_info after;
+  size_t large;
+  void *p;
+  int rv;
+
+  rv = malloc_cache_info( &before );
+  rtems_test_assert( rv == 0 );
+
+  large = ( RTEMS_MALLOC_CACHE_CLASS_COUNT + 1 )
+    * RTEMS_MALLOC_CACHE_CLASS_SIZE;
+  p = malloc( large );
+  rtems_test_assert( p != NULL );
+  free( p );
+
+  p = rtems_heap_allocate_aligned_with_boundary( 32, 256, 0 );
+  rtems_test_assert( p != NULL );
+  rtems_test_assert( ( (uintptr_t) p % 256 ) == 0 );
+
+  rv = malloc_cache_info( &after );
+  rtems_test_assert( rv == 0 );
+  rtems_test_assert( memcmp( &before, &after, sizeof( before ) ) == 0 );
+
+  /* The aligned memory area may go to the cache */
+  free( p );
+}
+
+static void test_realloc( void )
+{
+  char *p;
+  char *q;
+  size_t i;
+
+  p = malloc( OBJECT_SIZE );
+  rtems_test_assert( p != NULL );
+
+  for ( i = 0; i < OBJECT_SIZE; ++i ) {
+    p[ i ] = (char) i;
+  }
+
+  q = realloc( p, 4 * OBJECT_SIZE );
+  rtems_test_assert( q != NULL );
+
+  for ( i = 0; i < OBJECT_SIZE; ++i ) {
+    rtems_test_assert( q[ i ] == (char) i );
+  }
+
+  free( q );
+}
+
+static void check_nothing_cached( void )
+{
+  rtems_malloc_cache_info info;
+  size_t i;
+  int rv;
+
+  rv = malloc_cache_info( &info );
+  rtems_test_assert( rv == 0 );
+
+  for ( i = 0; i < RTEMS_MALLOC_CACHE_CLASS_COUNT; ++i ) {
+    rtems_test_assert( info.classes[ i ].cached == 0 );
+  }
+}
+
+static void test_flush_on_failure( void )
+{
+  rtems_malloc_cache_class_info before;
+  rtems_malloc_cache_class_info after;
+  void *list;
+  void *p;
+  void *q;
+
+  /*
+   * Exhaust the heap.  The memory areas are linked through their first
+   * word.  The last allocation fails, even after the cache was flushed.
+   */
+  list = NULL;
+
+  while ( ( p = malloc( OBJECT_SIZE ) ) != NULL ) {
+    *(void **) p = list;
+    list = p;
+  }
+
+  check_nothing_cached();
+
+  /* The cache takes the two memory areas */
+  before = get_class_info( CLASS_INDEX );
+  p = list;
+  list = *(void **) p;
+  free( p );
+  q = list;
+  list = *(void **) q;
+  free( q );
+  after = get_class_info( CLASS_INDEX );
+  rtems_test_assert( after.frees - before.frees == 2 );
+  rtems_test_assert( after.cached == 2 );
+
+  /*
+   * An allocation which bypasses the cache fails in the heap, so the cache
+   * is flushed and the allocation is retried.
+   */
+  p = rtems_heap_allocate_aligned_with_boundary(
+    OBJECT_SIZE,
+    CPU_HEAP_ALIGNMENT,
+    0
+  );
+  rtems_test_assert( p != NULL );
+  check_nothing_cached();
+  free( p );
+
+  while ( list != NULL ) {
+    p = list;
+    list = *(void **) p;
+    free( p );
+  }
+}
+
+static void Init( rtems_task_argument arg )
+{
+  TEST_BEGIN();
+  test_info();
+  test_allocate_and_free();
+  test_not_cached();
+  test_realloc();
+  test_flush_on_failure();
+  test_info();
+  TEST_END();
+  rtems_test_exit( 0 );
+}
+
+#define CONFIGURE_APPLICATION_DOES_NOT_NEED_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MALLOC_PER_CPU_CACHE
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
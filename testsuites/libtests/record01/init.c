@@ -428,17 +428,20 @@ static void test_drain(test_context *ctx, Record_Control *control)
   rtems_record_drain(visitor, &vctx);
   rtems_test_assert(vctx.todo == 0);
 
+  rtems_test_assert(rtems_record_get_maximum_content() == 0);
   rtems_record_produce(UE(1), 3);
   set_time(&control->Items[0], 2);
   rtems_record_produce(UE(4), 6);
   set_time(&control->Items[1], 5);
   rtems_record_produce(UE(7), 9);
   set_time(&control->Items[2], 8);
+  rtems_test_assert(rtems_record_get_maximum_content() == 3);
 
   vctx.todo = RTEMS_ARRAY_SIZE(expected_items_8);
   vctx.items = expected_items_8;
   rtems_record_drain(visitor, &vctx);
   rtems_test_assert(vctx.todo == 0);
+  rtems_test_assert(rtems_record_get_maximum_content() == 0);
 
   vctx.todo = 0;
   vctx.items = NULL;
@@ -514,6 +517,75 @@ static void test_drain(test_context *ctx, Record_Control *control)
   rtems_test_assert(vctx.todo == 0);
 }
 
+static void watermark_handler(void *arg)
+{
+  rtems_status_code sc;
+  rtems_id *task;
+
+  task = arg;
+  sc = rtems_event_send(*task, RTEMS_EVENT_0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static bool is_woken_up(void)
+{
+  rtems_status_code sc;
+  rtems_event_set events;
+
+  sc = rtems_event_receive(
+    RTEMS_EVENT_0,
+    RTEMS_EVENT_ALL | RTEMS_NO_WAIT,
+    0,
+    &events
+  );
+
+  return sc == RTEMS_SUCCESSFUL;
+}
+
+static void test_watermark(test_context *ctx)
+{
+  rtems_interrupt_level level;
+  rtems_id self;
+
+  init_context(ctx);
+  self = rtems_task_self();
+
+  _Record_Arm_watermark(2, watermark_handler, &self);
+  rtems_test_assert(!is_woken_up());
+
+  rtems_record_produce(UE(1), 3);
+  rtems_test_assert(!is_woken_up());
+
+  rtems_interrupt_local_disable(level);
+  rtems_record_produce(UE(4), 6);
+  rtems_interrupt_local_enable(level);
+  rtems_test_assert(rtems_record_get_maximum_content() == 2);
+  rtems_test_assert(!is_woken_up());
+
+  rtems_record_produce(UE(7), 9);
+  rtems_test_assert(is_woken_up());
+
+  rtems_record_produce(UE(10), 12);
+  rtems_test_assert(!is_woken_up());
+
+  _Record_Arm_watermark(2, watermark_handler, &self);
+  rtems_test_assert(is_woken_up());
+
+  init_context(ctx);
+  _Record_Arm_watermark(2, watermark_handler, &self);
+  rtems_record_produce(UE(13), 15);
+  rtems_test_assert(!is_woken_up());
+  rtems_record_produce(UE(16), 18);
+  rtems_test_assert(is_woken_up());
+
+  init_context(ctx);
+  _Record_Arm_watermark(2, watermark_handler, &self);
+  _Record_Disarm_watermark();
+  rtems_record_produce(UE(19), 21);
+  rtems_record_produce(UE(22), 24);
+  rtems_test_assert(!is_woken_up());
+}
+
 #ifdef RTEMS_NETWORKING
 #define PORT 1234
 
@@ -758,6 +830,7 @@ static void Init(rtems_task_argument arg)
   test_produce_2(ctx, &ctx->control);
   test_produce_n(ctx, &ctx->control);
   test_drain(ctx, &ctx->control);
+  test_watermark(ctx);
 #ifdef RTEMS_NETWORKING
   test_server(ctx, &ctx->control);
 #endif
@@ -0,0 +1,401 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/record.h>
+#include <rtems/recordclient.h>
+#include <rtems.h>
+
+#include <string.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "RECORD 3";
+
+#define UE(user) RTEMS_RECORD_USER(user)
+
+#define EVENT_COUNT 4096
+
+typedef struct {
+  uint64_t bt;
+  uint32_t cpu;
+  rtems_record_event event;
+  uint64_t data;
+} event;
+
+typedef struct {
+  rtems_record_client_context client;
+  size_t count;
+  event events[EVENT_COUNT];
+} client_context;
+
+typedef struct {
+  client_context native;
+  client_context compact;
+  rtems_record_compact_encoder encoder;
+  size_t item_count;
+  size_t native_size;
+  size_t compact_size;
+  rtems_id worker;
+} test_context;
+
+static test_context test_instance;
+
+static rtems_record_client_status client_handler(
+  uint64_t            bt,
+  uint32_t            cpu,
+  rtems_record_event  event,
+  uint64_t            data,
+  void               *arg
+)
+{
+  client_context *cctx;
+  size_t i;
+
+  cctx = arg;
+  i = cctx->count;
+  rtems_test_assert(i < EVENT_COUNT);
+  cctx->events[i].bt = bt;
+  cctx->events[i].cpu = cpu;
+  cctx->events[i].event = event;
+  cctx->events[i].data = data;
+  cctx->count = i + 1;
+
+  return RTEMS_RECORD_CLIENT_SUCCESS;
+}
+
+static void run_native(
+  test_context *ctx,
+  const rtems_record_item *items,
+  size_t count
+)
+{
+  rtems_record_client_status cs;
+
+  cs = rtems_record_client_run(
+    &ctx->native.client,
+    items,
+    count * sizeof(*items)
+  );
+  rtems_test_assert(cs == RTEMS_RECORD_CLIENT_SUCCESS);
+  ctx->native_size += count * sizeof(*items);
+}
+
+static void run_compact(
+  test_context *ctx,
+  const rtems_record_item *items,
+  size_t count
+)
+{
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    uint8_t buf[RTEMS_RECORD_COMPACT_ITEM_SIZE_MAX];
+    size_t size;
+    rtems_record_client_status cs;
+
+    size = rtems_record_compact_encode(&ctx->encoder, &items[i], buf);
+    rtems_test_assert(size > 0);
+    rtems_test_assert(size <= sizeof(buf));
+    cs = rtems_record_client_run(&ctx->compact.client, buf, size);
+    rtems_test_assert(cs == RTEMS_RECORD_CLIENT_SUCCESS);
+    ctx->compact_size += size;
+  }
+
+  ctx->item_count += count;
+}
+
+static void drain_visitor(
+  const rtems_record_item *items,
+  size_t                   count,
+  void                    *arg
+)
+{
+  test_context *ctx;
+
+  ctx = arg;
+  run_native(ctx, items, count);
+  run_compact(ctx, items, count);
+}
+
+static void discard_visitor(
+  const rtems_record_item *items,
+  size_t                   count,
+  void                    *arg
+)
+{
+  (void) items;
+  (void) count;
+  (void) arg;
+}
+
+static void send_header(test_context *ctx)
+{
+  Record_Stream_header header;
+  size_t size;
+  size_t prefix;
+  rtems_record_client_status cs;
+
+  size = _Record_Stream_header_initialize(&header);
+  prefix = sizeof(header.format) + sizeof(header.magic);
+
+  cs = rtems_record_client_run(&ctx->native.client, &header, prefix);
+  rtems_test_assert(cs == RTEMS_RECORD_CLIENT_SUCCESS);
+  run_native(
+    ctx,
+    &header.Version,
+    (size - prefix) / sizeof(header.Version)
+  );
+
+  header.format = rtems_record_compact_format();
+  cs = rtems_record_client_run(&ctx->compact.client, &header, prefix);
+  rtems_test_assert(cs == RTEMS_RECORD_CLIENT_SUCCESS);
+  run_compact(
+    ctx,
+    &header.Version,
+    (size - prefix) / sizeof(header.Version)
+  );
+}
+
+static void worker_task(rtems_task_argument arg)
+{
+  (void) arg;
+
+  while (true) {
+    rtems_status_code sc;
+    rtems_event_set events;
+
+    sc = rtems_event_receive(
+      RTEMS_EVENT_0,
+      RTEMS_EVENT_ALL | RTEMS_WAIT,
+      RTEMS_NO_TIMEOUT,
+      &events
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+    rtems_record_line_arg(events);
+  }
+}
+
+static void produce(test_context *ctx)
+{
+  rtems_status_code sc;
+  int i;
+
+  sc = rtems_task_create(
+    rtems_build_name('W', 'O', 'R', 'K'),
+    1,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &ctx->worker
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(ctx->worker, worker_task, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (i = 0; i < 50; ++i) {
+    uint32_t level;
+
+    sc = rtems_event_send(ctx->worker, RTEMS_EVENT_0);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    level = rtems_record_interrupt_disable();
+    rtems_record_interrupt_enable(level);
+
+    rtems_record_caller_arg_2((rtems_record_data) i, 0);
+    rtems_record_entry_1(RTEMS_RECORD_USER_0, (rtems_record_data) i);
+    rtems_record_exit_1(RTEMS_RECORD_USER_0, 0);
+
+    if (i % 10 == 0) {
+      rtems_task_wake_after(1);
+    }
+  }
+
+  sc = rtems_task_delete(ctx->worker);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+/*
+ * This is the producer and drain sequence of the record01 test.
+ */
+static void produce_record01(test_context *ctx)
+{
+  rtems_record_item items[5];
+  int i;
+
+  for (i = 0; i < 5; ++i) {
+    rtems_record_produce(UE(4 * i + 1), 4 * i + 3);
+  }
+
+  rtems_record_drain(drain_visitor, ctx);
+
+  rtems_record_produce_2(UE(1), 3, UE(5), 7);
+  rtems_record_produce(UE(9), 11);
+  rtems_record_produce_2(UE(13), 15, UE(17), 19);
+  rtems_record_drain(drain_visitor, ctx);
+
+  for (i = 0; i < 5; ++i) {
+    items[i].event = UE(4 * i + 1);
+    items[i].data = 4 * i + 3;
+  }
+
+  rtems_record_produce_n(items, RTEMS_ARRAY_SIZE(items));
+  rtems_record_drain(drain_visitor, ctx);
+
+  rtems_record_produce(UE(1), 3);
+  rtems_record_produce(UE(4), 6);
+  rtems_record_produce(UE(7), 9);
+  rtems_record_drain(drain_visitor, ctx);
+
+  rtems_record_produce(UE(10), 12);
+  rtems_record_produce(UE(13), 15);
+  rtems_record_drain(drain_visitor, ctx);
+
+  rtems_record_produce(UE(16), 18);
+  rtems_record_produce(UE(19), 21);
+  rtems_record_produce(UE(22), 24);
+  rtems_record_drain(drain_visitor, ctx);
+
+  rtems_record_produce(UE(25), 27);
+  rtems_record_drain(drain_visitor, ctx);
+
+  for (i = 0; i < 6; ++i) {
+    rtems_record_produce(UE(3 * i + 28), 3 * i + 30);
+  }
+
+  rtems_record_drain(drain_visitor, ctx);
+}
+
+static void produce_switches(test_context *ctx)
+{
+  produce(ctx);
+  rtems_record_drain(drain_visitor, ctx);
+  produce(ctx);
+  rtems_record_drain(drain_visitor, ctx);
+}
+
+static void print_size(const char *name, size_t size, size_t count)
+{
+  printf(
+    "%s bytes per item: %zu.%02zu\n",
+    name,
+    size / count,
+    (100 * (size % count)) / count
+  );
+}
+
+static void run_workload(
+  test_context *ctx,
+  const char *name,
+  void (*workload)(test_context *)
+)
+{
+  size_t i;
+
+  ctx->native.count = 0;
+  ctx->compact.count = 0;
+  ctx->item_count = 0;
+  ctx->native_size = 0;
+  ctx->compact_size = 0;
+
+  rtems_record_client_init(
+    &ctx->native.client,
+    client_handler,
+    &ctx->native
+  );
+  rtems_record_client_init(
+    &ctx->compact.client,
+    client_handler,
+    &ctx->compact
+  );
+  rtems_record_compact_encoder_initialize(&ctx->encoder);
+
+  /* Discard the items of the previous workload */
+  rtems_record_drain(discard_visitor, NULL);
+
+  send_header(ctx);
+  (*workload)(ctx);
+
+  rtems_record_client_destroy(&ctx->native.client);
+  rtems_record_client_destroy(&ctx->compact.client);
+
+  rtems_test_assert(ctx->native.count > 0);
+  rtems_test_assert(ctx->native.count == ctx->compact.count);
+
+  for (i = 0; i < ctx->native.count; ++i) {
+    const event *a;
+    const event *b;
+
+    a = &ctx->native.events[i];
+    b = &ctx->compact.events[i];
+    rtems_test_assert(a->bt == b->bt);
+    rtems_test_assert(a->cpu == b->cpu);
+    rtems_test_assert(a->event == b->event);
+    rtems_test_assert(a->data == b->data);
+  }
+
+  rtems_test_assert(ctx->compact_size < ctx->native_size);
+  printf("%s items: %zu\n", name, ctx->item_count);
+  print_size("native", ctx->native_size, ctx->item_count);
+  print_size("compact", ctx->compact_size, ctx->item_count);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  test_context *ctx;
+
+  TEST_BEGIN();
+  ctx = &test_instance;
+
+  run_workload(ctx, "switch", produce_switches);
+  run_workload(ctx, "record01", produce_record01);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+
+#define CONFIGURE_INIT_TASK_PRIORITY 2
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_RECORD_PER_PROCESSOR_ITEMS 2048
+
+#define CONFIGURE_RECORD_EXTENSIONS_ENABLED
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -28,6 +28,8 @@
 #include <rtems.h>
 #include <rtems/captureimpl.h>
 
+#include <string.h>
+
 #include "tmacros.h"
 
 const char rtems_test_name[] = "SMPCAPTURE 1";
@@ -190,6 +192,74 @@ static void test(void)
   test_delay(25);
 }
 
+/*
+ * Encode the records of the workload in the compact format, decode them, and
+ * report the bytes per record of both formats.  The records are not released,
+ * so that they are printed afterwards.
+ */
+static void test_compact(void)
+{
+  rtems_status_code sc;
+  uint32_t          cpu_count;
+  uint32_t          cpu;
+  size_t            count = 0;
+  size_t            native_size = 0;
+  size_t            compact_size = 0;
+
+  cpu_count = rtems_scheduler_get_processor_maximum();
+
+  for (cpu = 0; cpu < cpu_count; cpu++) {
+    rtems_capture_compact_state encoder;
+    rtems_capture_compact_state decoder;
+    const void*                 recs;
+    size_t                      read;
+    size_t                      i;
+
+    rtems_capture_compact_initialize(&encoder);
+    rtems_capture_compact_initialize(&decoder);
+
+    sc = rtems_capture_read(cpu, &read, &recs);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    for (i = 0; i < read; i++) {
+      rtems_capture_record rec;
+      uint8_t              buf[RTEMS_CAPTURE_COMPACT_HEADER_SIZE_MAX + 64];
+      uint8_t              out[sizeof(rec) + 64];
+      size_t               size;
+      size_t               n;
+
+      rtems_capture_record_extract(recs, &rec, sizeof(rec));
+      rtems_test_assert(rec.size <= sizeof(out));
+
+      size = rtems_capture_compact_encode(&encoder, recs, buf);
+      rtems_test_assert(size > 0);
+      rtems_test_assert(size <= sizeof(buf));
+
+      n = rtems_capture_compact_decode(&decoder, buf, size, out, sizeof(out));
+      rtems_test_assert(n == size);
+      rtems_test_assert(memcmp(out, recs, rec.size) == 0);
+
+      native_size += rec.size;
+      compact_size += size;
+      ++count;
+      recs = ((const uint8_t*) recs) + rec.size;
+    }
+
+    sc = rtems_capture_release(cpu, 0);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  if (count > 0) {
+    rtems_test_assert(compact_size < native_size);
+    printf(
+      "capture records: %zu, native bytes: %zu, compact bytes: %zu\n",
+      count,
+      native_size,
+      compact_size
+    );
+  }
+}
+
 static void Init(rtems_task_argument arg)
 {
   rtems_status_code   sc;
@@ -240,6 +310,8 @@ static void Init(rtems_task_argument arg)
   sc = rtems_capture_set_control (false);
   rtems_test_assert(sc == RTEMS_SUCCESSFUL);
 
+  test_compact();
+
   rtems_capture_print_trace_records ( 22, false );
   rtems_capture_print_trace_records ( 22, false );
   rtems_capture_print_trace_records ( 22, false );
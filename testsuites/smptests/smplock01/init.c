@@ -17,6 +17,7 @@
 #endif
 
 #include <rtems/score/smplock.h>
+#include <rtems/score/smplockcohort.h>
 #include <rtems/score/smplockmcs.h>
 #include <rtems/score/smplockseq.h>
 #include <rtems/test.h>
@@ -30,7 +31,7 @@ const char rtems_test_name[] = "SMPLOCK 1";
 
 #define CPU_COUNT 32
 
-#define TEST_COUNT 13
+#define TEST_COUNT 16
 
 typedef struct {
   rtems_test_parallel_context base;
@@ -43,6 +44,7 @@ typedef struct {
   SMP_lock_Stats mcs_stats;
 #endif
   SMP_sequence_lock_Control seq_lock RTEMS_ALIGNED(CPU_CACHE_LINE_BYTES);
+  SMP_cohort_lock_Control cohort_lock RTEMS_ALIGNED(CPU_CACHE_LINE_BYTES);
   int a RTEMS_ALIGNED(CPU_CACHE_LINE_BYTES);
   int b RTEMS_ALIGNED(CPU_CACHE_LINE_BYTES);
 } test_context;
@@ -54,7 +56,8 @@ static test_context test_instance = {
 #endif
   .flag = ATOMIC_INITIALIZER_UINT(0),
   .mcs_lock = SMP_MCS_LOCK_INITIALIZER,
-  .seq_lock = SMP_SEQUENCE_LOCK_INITIALIZER
+  .seq_lock = SMP_SEQUENCE_LOCK_INITIALIZER,
+  .cohort_lock = SMP_COHORT_LOCK_INITIALIZER("global cohort")
 };
 
 static rtems_interval test_duration(void)
@@ -668,6 +671,119 @@ static void test_12_fini(
   );
 }
 
+static void test_13_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  size_t test = 13;
+  unsigned long counter = 0;
+  SMP_lock_Context lock_context;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    _SMP_cohort_lock_Acquire(&ctx->cohort_lock, &lock_context);
+    _SMP_cohort_lock_Release(&ctx->cohort_lock, &lock_context);
+    ++counter;
+  }
+
+  ctx->local_counter[active_workers - 1][test][worker_index] = counter;
+}
+
+static void test_13_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    ctx,
+    "GlobalCohortLockWithLocalCounter",
+    13,
+    active_workers
+  );
+}
+
+static void test_14_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  size_t test = 14;
+  unsigned long counter = 0;
+  SMP_lock_Context lock_context;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    _SMP_cohort_lock_Acquire(&ctx->cohort_lock, &lock_context);
+    ++ctx->counter[test];
+    _SMP_cohort_lock_Release(&ctx->cohort_lock, &lock_context);
+    ++counter;
+  }
+
+  ctx->local_counter[active_workers - 1][test][worker_index] = counter;
+}
+
+static void test_14_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    ctx,
+    "GlobalCohortLockWithGlobalCounter",
+    14,
+    active_workers
+  );
+}
+
+static void test_15_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  size_t test = 15;
+  unsigned long counter = 0;
+  SMP_lock_Context lock_context;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    _SMP_cohort_lock_Acquire(&ctx->cohort_lock, &lock_context);
+    busy_section();
+    _SMP_cohort_lock_Release(&ctx->cohort_lock, &lock_context);
+    ++counter;
+  }
+
+  ctx->local_counter[active_workers - 1][test][worker_index] = counter;
+}
+
+static void test_15_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    ctx,
+    "GlobalCohortLockWithBusySection",
+    15,
+    active_workers
+  );
+}
+
 static const rtems_test_parallel_job test_jobs[TEST_COUNT] = {
   {
     .init = test_init,
@@ -734,6 +850,21 @@ static const rtems_test_parallel_job test_jobs[TEST_COUNT] = {
     .body = test_12_body,
     .fini = test_12_fini,
     .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_13_body,
+    .fini = test_13_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_14_body,
+    .fini = test_14_fini,
+    .cascade = false
+  }, {
+    .init = test_init,
+    .body = test_15_body,
+    .fini = test_15_fini,
+    .cascade = false
   }
 };
 
@@ -762,6 +893,9 @@ static void Init(rtems_task_argument arg)
 
 #define CONFIGURE_MAXIMUM_PROCESSORS CPU_COUNT
 
+/* Use small clusters to exercise the cohort lock hand overs */
+#define CONFIGURE_PROCESSORS_PER_CLUSTER 2
+
 #define CONFIGURE_MAXIMUM_TASKS CPU_COUNT
 
 #define CONFIGURE_MAXIMUM_SEMAPHORES 1
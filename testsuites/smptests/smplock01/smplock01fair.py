@@ -26,6 +26,7 @@ plt.ylabel('Normed Coefficient of Variation')
 i = 1
 ticket = []
 mcs = []
+cohort = []
 tas = []
 ttas = []
 
@@ -43,6 +44,7 @@ try:
 		i = i + 1
 		ticket.append(normedCoefficientOfVariation('GlobalTicketLockWithLocalCounter', i))
 		mcs.append(normedCoefficientOfVariation('GlobalMCSLockWithLocalCounter', i))
+		cohort.append(normedCoefficientOfVariation('GlobalCohortLockWithLocalCounter', i))
 		tas.append(normedCoefficientOfVariation('GlobalTASLockWithLocalCounter', i))
 		ttas.append(normedCoefficientOfVariation('GlobalTTASLockWithLocalCounter', i))
 except:
@@ -53,6 +55,7 @@ plt.xticks(x)
 plt.yscale('symlog', linthreshy = 1e-6)
 plt.plot(x, ticket, label = 'Ticket Lock', marker = 'o')
 plt.plot(x, mcs, label = 'MCS Lock', marker = 'o')
+plt.plot(x, cohort, label = 'Cohort Lock', marker = 'o')
 plt.plot(x, tas, label = 'TAS Lock', marker = 'o')
 plt.plot(x, ttas, label = 'TTAS Lock', marker = 'o')
 plt.legend(loc = 'best')
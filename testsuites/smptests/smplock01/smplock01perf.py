@@ -29,6 +29,9 @@ plt.plot(x, y, label = 'Ticket Lock', marker = 'o')
 y = map(xmlNode.getContent, ctx.xpathEval('/SMPLock01/GlobalMCSLockWithLocalCounter/SumOfLocalCounter'))
 plt.plot(x, y, label = 'MCS Lock', marker = 'o')
 
+y = map(xmlNode.getContent, ctx.xpathEval('/SMPLock01/GlobalCohortLockWithLocalCounter/SumOfLocalCounter'))
+plt.plot(x, y, label = 'Cohort Lock', marker = 'o')
+
 y = map(xmlNode.getContent, ctx.xpathEval('/SMPLock01/GlobalTASLockWithLocalCounter/SumOfLocalCounter'))
 plt.plot(x, y, label = 'TAS Lock', marker = 'o')
 
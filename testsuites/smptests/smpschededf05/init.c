@@ -0,0 +1,270 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <rtems.h>
+#include <rtems/counter.h>
+
+const char rtems_test_name[] = "SMPSCHEDEDF 5";
+
+#define CPU_COUNT 4
+
+#define WORKER_COUNT 256
+
+#define SAMPLE_COUNT 16
+
+typedef struct {
+  volatile bool done;
+  rtems_id busy_ids[CPU_COUNT];
+  rtems_id worker_ids[WORKER_COUNT];
+  size_t worker_count;
+} test_context;
+
+static test_context test_instance;
+
+static const size_t thread_counts[] = { 8, 32, 64, 128, 192, WORKER_COUNT };
+
+static void set_affinity(rtems_id id, uint32_t cpu_index)
+{
+  rtems_status_code sc;
+  cpu_set_t cpuset;
+
+  CPU_ZERO(&cpuset);
+  CPU_SET((int) cpu_index, &cpuset);
+  sc = rtems_task_set_affinity(id, sizeof(cpuset), &cpuset);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void busy_task(rtems_task_argument arg)
+{
+  test_context *ctx;
+
+  ctx = (test_context *) arg;
+
+  while (!ctx->done) {
+    /* Wait */
+  }
+
+  (void) rtems_task_suspend(RTEMS_SELF);
+}
+
+static void worker_task(rtems_task_argument arg)
+{
+  (void) arg;
+
+  /* The workers are never scheduled, since their priority is too low */
+  rtems_test_assert(0);
+}
+
+static void start_busy_tasks(test_context *ctx, uint32_t cpu_count)
+{
+  uint32_t cpu_index;
+
+  set_affinity(RTEMS_SELF, 0);
+
+  for (cpu_index = 1; cpu_index < cpu_count; ++cpu_index) {
+    rtems_status_code sc;
+    rtems_id id;
+
+    sc = rtems_task_create(
+      rtems_build_name('B', 'U', 'S', 'Y'),
+      2,
+      RTEMS_MINIMUM_STACK_SIZE,
+      RTEMS_DEFAULT_MODES,
+      RTEMS_DEFAULT_ATTRIBUTES,
+      &id
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    set_affinity(id, cpu_index);
+
+    sc = rtems_task_start(id, busy_task, (rtems_task_argument) ctx);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    ctx->busy_ids[cpu_index] = id;
+  }
+}
+
+static void add_workers(test_context *ctx, uint32_t cpu_count, size_t count)
+{
+  while (ctx->worker_count < count) {
+    rtems_status_code sc;
+    rtems_id id;
+    size_t i;
+
+    i = ctx->worker_count;
+
+    sc = rtems_task_create(
+      rtems_build_name('W', 'O', 'R', 'K'),
+      3 + (rtems_task_priority) (i % 200),
+      RTEMS_MINIMUM_STACK_SIZE,
+      RTEMS_DEFAULT_MODES,
+      RTEMS_DEFAULT_ATTRIBUTES,
+      &id
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    /* Every second worker has a one-to-one processor affinity */
+    if (i % 2 == 1) {
+      set_affinity(id, (uint32_t) ((i / 2) % cpu_count));
+    }
+
+    sc = rtems_task_start(id, worker_task, 0);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    ctx->worker_ids[i] = id;
+    ctx->worker_count = i + 1;
+  }
+}
+
+static uint64_t to_ns(rtems_counter_ticks ticks, size_t count)
+{
+  return rtems_counter_ticks_to_nanoseconds(ticks) / count;
+}
+
+static void measure(test_context *ctx)
+{
+  rtems_counter_ticks suspend;
+  rtems_counter_ticks resume;
+  rtems_counter_ticks yield;
+  size_t sample;
+  size_t count;
+
+  suspend = 0;
+  resume = 0;
+  yield = 0;
+  count = ctx->worker_count;
+
+  for (sample = 0; sample < SAMPLE_COUNT; ++sample) {
+    size_t i;
+
+    for (i = 0; i < count; ++i) {
+      rtems_status_code sc;
+      rtems_counter_ticks t0;
+      rtems_counter_ticks t1;
+      rtems_counter_ticks t2;
+      rtems_counter_ticks t3;
+
+      t0 = rtems_counter_read();
+      sc = rtems_task_suspend(ctx->worker_ids[i]);
+      t1 = rtems_counter_read();
+      rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+      sc = rtems_task_resume(ctx->worker_ids[i]);
+      t2 = rtems_counter_read();
+      rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+      sc = rtems_task_wake_after(RTEMS_YIELD_PROCESSOR);
+      t3 = rtems_counter_read();
+      rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+      suspend += rtems_counter_difference(t1, t0);
+      resume += rtems_counter_difference(t2, t1);
+      yield += rtems_counter_difference(t3, t2);
+    }
+  }
+
+  count *= SAMPLE_COUNT;
+  printf(
+    "thread count %3zu: suspend %" PRIu64 "ns, resume %" PRIu64
+      "ns, yield %" PRIu64 "ns\n",
+    ctx->worker_count,
+    to_ns(suspend, count),
+    to_ns(resume, count),
+    to_ns(yield, count)
+  );
+}
+
+static void test(void)
+{
+  test_context *ctx;
+  uint32_t cpu_count;
+  size_t i;
+
+  ctx = &test_instance;
+  cpu_count = rtems_scheduler_get_processor_maximum();
+
+  start_busy_tasks(ctx, cpu_count);
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(thread_counts); ++i) {
+    add_workers(ctx, cpu_count, thread_counts[i]);
+    measure(ctx);
+  }
+
+  ctx->done = true;
+
+  for (i = 0; i < ctx->worker_count; ++i) {
+    rtems_status_code sc;
+
+    sc = rtems_task_delete(ctx->worker_ids[i]);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  for (i = 1; i < cpu_count; ++i) {
+    rtems_status_code sc;
+
+    sc = rtems_task_delete(ctx->busy_ids[i]);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  if (rtems_scheduler_get_processor_maximum() >= 2) {
+    test();
+  } else {
+    puts("warning: wrong processor count to run the test");
+  }
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_DOES_NOT_NEED_CLOCK_DRIVER
+
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS (CPU_COUNT + WORKER_COUNT)
+
+#define CONFIGURE_MAXIMUM_PROCESSORS CPU_COUNT
+
+#define CONFIGURE_SCHEDULER_EDF_SMP
+
+#define CONFIGURE_INIT_TASK_PRIORITY 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
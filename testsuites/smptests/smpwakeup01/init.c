@@ -0,0 +1,354 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/counter.h>
+#include <rtems/test.h>
+#include <rtems.h>
+
+#include <inttypes.h>
+#include <pthread.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "SMPWAKEUP 1";
+
+#define TASK_PRIORITY 1
+
+#define CPU_COUNT 32
+
+typedef struct {
+  rtems_test_parallel_context base;
+  rtems_id barrier;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  size_t waiting;
+  unsigned long generation;
+  bool done;
+  Atomic_Ulong arrive_instant RTEMS_ALIGNED(CPU_CACHE_LINE_BYTES);
+  Atomic_Ulong wake_instant RTEMS_ALIGNED(CPU_CACHE_LINE_BYTES);
+  unsigned long rounds;
+  uint64_t total_latency;
+  rtems_counter_ticks max_latency;
+} test_context;
+
+static test_context test_instance = {
+  .mutex = PTHREAD_MUTEX_INITIALIZER,
+  .cond = PTHREAD_COND_INITIALIZER
+};
+
+/* Sets the instant to the latest of the instant and now */
+static void update_instant(Atomic_Ulong *instant, rtems_counter_ticks now)
+{
+  unsigned long current;
+
+  current = _Atomic_Load_ulong(instant, ATOMIC_ORDER_RELAXED);
+
+  while (
+    rtems_counter_difference(now, (rtems_counter_ticks) current)
+      <= (rtems_counter_ticks) -1 / 2
+      && !_Atomic_Compare_exchange_ulong(
+        instant,
+        &current,
+        now,
+        ATOMIC_ORDER_RELAXED,
+        ATOMIC_ORDER_RELAXED
+      )
+  ) {
+    /* Retry */
+  }
+}
+
+static void barrier_wait(test_context *ctx)
+{
+  rtems_status_code sc;
+
+  sc = rtems_barrier_wait(ctx->barrier, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void reset_instants(test_context *ctx, rtems_counter_ticks now)
+{
+  _Atomic_Store_ulong(&ctx->arrive_instant, now, ATOMIC_ORDER_RELAXED);
+  _Atomic_Store_ulong(&ctx->wake_instant, now, ATOMIC_ORDER_RELAXED);
+}
+
+/*
+ * Ends a round.  The master worker accounts the latency from the broadcast to
+ * the last woken worker and decides if the job is done.  All workers agree on
+ * the done state, since otherwise some would wait forever at the barrier.
+ */
+static bool end_round(test_context *ctx, size_t worker_index)
+{
+  barrier_wait(ctx);
+
+  if (rtems_test_parallel_is_master_worker(worker_index)) {
+    rtems_counter_ticks latency;
+
+    latency = rtems_counter_difference(
+      _Atomic_Load_ulong(&ctx->wake_instant, ATOMIC_ORDER_RELAXED),
+      _Atomic_Load_ulong(&ctx->arrive_instant, ATOMIC_ORDER_RELAXED)
+    );
+
+    ++ctx->rounds;
+    ctx->total_latency += latency;
+
+    if (latency > ctx->max_latency) {
+      ctx->max_latency = latency;
+    }
+
+    reset_instants(ctx, rtems_counter_read());
+    ctx->done = rtems_test_parallel_stop_job(&ctx->base);
+  }
+
+  barrier_wait(ctx);
+  return ctx->done;
+}
+
+static rtems_interval test_init(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+  rtems_status_code sc;
+
+  sc = rtems_barrier_create(
+    rtems_build_name('W', 'A', 'K', 'E'),
+    RTEMS_BARRIER_AUTOMATIC_RELEASE,
+    (uint32_t) active_workers,
+    &ctx->barrier
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  ctx->waiting = 0;
+  ctx->done = false;
+  ctx->rounds = 0;
+  ctx->total_latency = 0;
+  ctx->max_latency = 0;
+  reset_instants(ctx, rtems_counter_read());
+
+  return rtems_clock_get_ticks_per_second();
+}
+
+static void test_fini(
+  test_context *ctx,
+  const char *name,
+  size_t active_workers
+)
+{
+  rtems_status_code sc;
+  uint64_t mean;
+
+  sc = rtems_barrier_delete(ctx->barrier);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  if (ctx->rounds > 0) {
+    mean = ctx->total_latency / ctx->rounds;
+  } else {
+    mean = 0;
+  }
+
+  printf(
+    "  <%s activeWorker=\"%zu\">\n"
+    "    <Rounds>%lu</Rounds>\n"
+    "    <MeanLatency unit=\"ns\">%" PRIu64 "</MeanLatency>\n"
+    "    <MaxLatency unit=\"ns\">%" PRIu64 "</MaxLatency>\n"
+    "  </%s>\n",
+    name,
+    active_workers,
+    ctx->rounds,
+    rtems_counter_ticks_to_nanoseconds((rtems_counter_ticks) mean),
+    rtems_counter_ticks_to_nanoseconds(ctx->max_latency),
+    name
+  );
+}
+
+/*
+ * All active workers wait at the barrier with automatic release.  The last
+ * arriving worker releases the other workers.  The latency is the time from
+ * the last arrival to the last wake up.
+ */
+static void barrier_release_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  do {
+    update_instant(&ctx->arrive_instant, rtems_counter_read());
+    barrier_wait(ctx);
+    update_instant(&ctx->wake_instant, rtems_counter_read());
+  } while (!end_round(ctx, worker_index));
+}
+
+static void barrier_release_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(ctx, "BarrierRelease", active_workers);
+}
+
+/*
+ * The master worker broadcasts the condition variable once all other active
+ * workers wait on it.  The waiting count is protected by the mutex, so a
+ * worker accounted as waiting is blocked on the condition variable.  The
+ * latency is the time from the broadcast to the last wake up including the
+ * mutex hand over.
+ */
+static void condition_broadcast_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  int eno;
+
+  do {
+    eno = pthread_mutex_lock(&ctx->mutex);
+    rtems_test_assert(eno == 0);
+
+    if (rtems_test_parallel_is_master_worker(worker_index)) {
+      while (ctx->waiting + 1 < active_workers) {
+        eno = pthread_mutex_unlock(&ctx->mutex);
+        rtems_test_assert(eno == 0);
+
+        eno = pthread_mutex_lock(&ctx->mutex);
+        rtems_test_assert(eno == 0);
+      }
+
+      ctx->waiting = 0;
+      ++ctx->generation;
+      update_instant(&ctx->arrive_instant, rtems_counter_read());
+
+      eno = pthread_cond_broadcast(&ctx->cond);
+      rtems_test_assert(eno == 0);
+
+      /* The other workers wake up after the mutex release */
+      update_instant(&ctx->wake_instant, rtems_counter_read());
+    } else {
+      unsigned long generation;
+
+      generation = ctx->generation;
+      ++ctx->waiting;
+
+      while (generation == ctx->generation) {
+        eno = pthread_cond_wait(&ctx->cond, &ctx->mutex);
+        rtems_test_assert(eno == 0);
+      }
+
+      update_instant(&ctx->wake_instant, rtems_counter_read());
+    }
+
+    eno = pthread_mutex_unlock(&ctx->mutex);
+    rtems_test_assert(eno == 0);
+  } while (!end_round(ctx, worker_index));
+}
+
+static void condition_broadcast_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(ctx, "ConditionBroadcast", active_workers);
+}
+
+static const rtems_test_parallel_job test_jobs[] = {
+  {
+    .init = test_init,
+    .body = barrier_release_body,
+    .fini = barrier_release_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = condition_broadcast_body,
+    .fini = condition_broadcast_fini,
+    .cascade = true
+  }
+};
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  const char *test = "SMPWakeUp01";
+
+  printf("<%s>\n", test);
+  rtems_test_parallel(
+    &ctx->base,
+    NULL,
+    &test_jobs[0],
+    RTEMS_ARRAY_SIZE(test_jobs)
+  );
+  printf("</%s>\n", test);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_PROCESSORS CPU_COUNT
+
+#define CONFIGURE_MAXIMUM_TASKS CPU_COUNT
+
+#define CONFIGURE_MAXIMUM_BARRIERS 1
+
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_INIT_TASK_PRIORITY TASK_PRIORITY
+#define CONFIGURE_INIT_TASK_INITIAL_MODES RTEMS_DEFAULT_MODES
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_DEFAULT_ATTRIBUTES
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
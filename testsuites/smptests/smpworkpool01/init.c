@@ -0,0 +1,296 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/workpool.h>
+#include <rtems/test.h>
+#include <rtems.h>
+
+#include <string.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "SMPWORKPOOL 1";
+
+#define TASK_PRIORITY 2
+
+#define WORKER_PRIORITY 3
+
+#define CPU_COUNT 32
+
+#define VECTOR_SIZE 4096
+
+#define GRAIN 64
+
+typedef struct {
+  rtems_work_item item;
+  unsigned long n;
+  unsigned long result;
+} fib_item;
+
+typedef struct {
+  rtems_test_parallel_context base;
+  rtems_work_pool *pool;
+  unsigned long counter[CPU_COUNT];
+  Atomic_Ulong sum;
+  float x[VECTOR_SIZE];
+  float y[VECTOR_SIZE];
+} test_context;
+
+static test_context test_instance;
+
+static unsigned long fib(unsigned long n)
+{
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+static void fib_handler(rtems_work_pool *pool, rtems_work_item *base)
+{
+  fib_item *item = RTEMS_CONTAINER_OF(base, fib_item, item);
+  rtems_work_group group;
+  fib_item a;
+  fib_item b;
+
+  if (item->n < 10) {
+    item->result = fib(item->n);
+    return;
+  }
+
+  a.n = item->n - 1;
+  b.n = item->n - 2;
+  rtems_work_group_initialize(&group);
+  rtems_work_pool_fork(pool, &group, &a.item, fib_handler);
+  fib_handler(pool, &b.item);
+  rtems_work_pool_join(pool, &group);
+  item->result = a.result + b.result;
+}
+
+static void sum_range(void *arg, size_t begin, size_t end)
+{
+  test_context *ctx = arg;
+  unsigned long sum = 0;
+  size_t i;
+
+  for (i = begin; i < end; ++i) {
+    sum += i;
+  }
+
+  _Atomic_Fetch_add_ulong(&ctx->sum, sum, ATOMIC_ORDER_RELAXED);
+}
+
+static void saxpy_range(void *arg, size_t begin, size_t end)
+{
+  test_context *ctx = arg;
+  size_t i;
+
+  for (i = begin; i < end; ++i) {
+    ctx->y[i] = 2.0f * ctx->x[i] + ctx->y[i];
+  }
+}
+
+static rtems_work_pool *create_pool(size_t active_workers)
+{
+  rtems_status_code sc;
+  rtems_work_pool_config config;
+  rtems_work_pool *pool;
+  cpu_set_t cpuset;
+  size_t i;
+
+  CPU_ZERO(&cpuset);
+
+  for (i = 0; i < active_workers; ++i) {
+    CPU_SET((int) i, &cpuset);
+  }
+
+  memset(&config, 0, sizeof(config));
+  config.name = rtems_build_name('W', 'P', 'O', 'L');
+  config.priority = WORKER_PRIORITY;
+  config.attributes = RTEMS_FLOATING_POINT;
+  config.cpusetsize = sizeof(cpuset);
+  config.cpuset = &cpuset;
+
+  sc = rtems_work_pool_create(&config, &pool);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(rtems_work_pool_get_worker_count(pool) == active_workers);
+
+  return pool;
+}
+
+static void test_fork_join(test_context *ctx)
+{
+  rtems_work_pool *pool;
+  rtems_work_group group;
+  fib_item item;
+  size_t n;
+  size_t grain;
+
+  n = rtems_scheduler_get_processor_maximum();
+  pool = create_pool(n);
+
+  item.n = 25;
+  rtems_work_group_initialize(&group);
+  rtems_work_pool_fork(pool, &group, &item.item, fib_handler);
+  rtems_work_pool_join(pool, &group);
+  rtems_test_assert(item.result == 75025);
+
+  for (grain = 0; grain < 100; grain += 7) {
+    _Atomic_Store_ulong(&ctx->sum, 0, ATOMIC_ORDER_RELAXED);
+    rtems_work_pool_parallel_for(pool, 3, 10000, grain, sum_range, ctx);
+    rtems_test_assert(
+      _Atomic_Load_ulong(&ctx->sum, ATOMIC_ORDER_RELAXED)
+        == 10000UL * 9999UL / 2 - 3UL
+    );
+  }
+
+  rtems_work_pool_delete(pool);
+}
+
+static rtems_interval test_parallel_for_init(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  ctx->pool = create_pool(active_workers);
+
+  return rtems_clock_get_ticks_per_second();
+}
+
+static void test_parallel_for_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  unsigned long counter = 0;
+
+  if (!rtems_test_parallel_is_master_worker(worker_index)) {
+    /* Leave the processor to the work pool worker */
+    while (!rtems_test_parallel_stop_job(&ctx->base)) {
+      rtems_task_wake_after(1);
+    }
+
+    return;
+  }
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    rtems_work_pool_parallel_for(
+      ctx->pool,
+      0,
+      VECTOR_SIZE,
+      GRAIN,
+      saxpy_range,
+      ctx
+    );
+    ++counter;
+  }
+
+  ctx->counter[active_workers - 1] = counter;
+}
+
+static void test_parallel_for_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  rtems_work_pool_delete(ctx->pool);
+  ctx->pool = NULL;
+
+  printf(
+    "  <ParallelFor activeWorker=\"%zu\" vectorSize=\"%u\" grain=\"%u\">"
+      "%lu</ParallelFor>\n",
+    active_workers,
+    VECTOR_SIZE,
+    GRAIN,
+    ctx->counter[active_workers - 1]
+  );
+}
+
+static const rtems_test_parallel_job test_jobs[] = {
+  {
+    .init = test_parallel_for_init,
+    .body = test_parallel_for_body,
+    .fini = test_parallel_for_fini,
+    .cascade = true
+  }
+};
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  const char *test = "SMPWorkPool01";
+
+  test_fork_join(ctx);
+
+  printf("<%s>\n", test);
+  rtems_test_parallel(
+    &ctx->base,
+    NULL,
+    &test_jobs[0],
+    RTEMS_ARRAY_SIZE(test_jobs)
+  );
+  printf("</%s>\n", test);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_PROCESSORS CPU_COUNT
+
+#define CONFIGURE_MAXIMUM_TASKS (2 * CPU_COUNT + 1)
+
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_INIT_TASK_PRIORITY TASK_PRIORITY
+#define CONFIGURE_INIT_TASK_INITIAL_MODES RTEMS_DEFAULT_MODES
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -40,7 +40,7 @@ static rtems_timer_service_routine test_release_from_isr(
 {
   Per_CPU_Control *cpu_self = _Per_CPU_Get();
   Watchdog_Header *header = &cpu_self->Watchdog.Header[ PER_CPU_WATCHDOG_TICKS ];
-  Watchdog_Control *watchdog = (Watchdog_Control *) header->first;
+  Watchdog_Control *watchdog = _Watchdog_Header_first( header );
 
   if (
     watchdog != NULL
@@ -113,6 +113,74 @@ static void test_iterate(void)
   rtems_interrupt_lock_destroy(&ctx->d);
 }
 
+typedef struct {
+  uint32_t scheduler_count;
+  uint32_t processor_count;
+  uint64_t block_count;
+  uint64_t unblock_count;
+  uint64_t dispatch_count;
+} scheduler_visitor_context;
+
+static uint64_t histogram_sum(const rtems_profiling_operation_stats *stats)
+{
+  uint64_t sum = 0;
+  size_t i;
+
+  for (i = 0; i < RTEMS_PROFILING_HISTOGRAM_BINS; ++i) {
+    sum += stats->histogram[i];
+  }
+
+  return sum;
+}
+
+static void scheduler_visitor(void *arg, const rtems_profiling_data *data)
+{
+  scheduler_visitor_context *ctx = arg;
+
+  if (data->header.type == RTEMS_PROFILING_SCHEDULER) {
+    const rtems_profiling_scheduler *ps = &data->scheduler;
+    size_t i;
+
+    for (i = 0; i < RTEMS_PROFILING_OPERATION_COUNT; ++i) {
+      const rtems_profiling_operation_stats *stats = &ps->operations[i];
+
+      rtems_test_assert(histogram_sum(stats) == stats->count);
+      rtems_test_assert(stats->total_time >= stats->max_time);
+    }
+
+    ++ctx->scheduler_count;
+    ctx->processor_count += ps->processor_count;
+    ctx->block_count +=
+      ps->operations[RTEMS_PROFILING_OPERATION_SCHEDULER_BLOCK].count;
+    ctx->unblock_count +=
+      ps->operations[RTEMS_PROFILING_OPERATION_SCHEDULER_UNBLOCK].count;
+    ctx->dispatch_count +=
+      ps->operations[RTEMS_PROFILING_OPERATION_THREAD_DISPATCH].count;
+  }
+}
+
+static void test_scheduler(void)
+{
+  scheduler_visitor_context ctx;
+  rtems_status_code sc;
+
+  sc = rtems_task_wake_after(2);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  memset(&ctx, 0, sizeof(ctx));
+  rtems_profiling_iterate(scheduler_visitor, &ctx);
+
+#ifdef RTEMS_PROFILING
+  rtems_test_assert(ctx.scheduler_count == 1);
+  rtems_test_assert(ctx.processor_count == 1);
+  rtems_test_assert(ctx.block_count > 0);
+  rtems_test_assert(ctx.unblock_count > 0);
+  rtems_test_assert(ctx.dispatch_count > 0);
+#else
+  rtems_test_assert(ctx.scheduler_count == 0);
+#endif
+}
+
 static void test_report_xml(void)
 {
   rtems_status_code sc;
@@ -130,6 +198,7 @@ static void Init(rtems_task_argument arg)
   TEST_BEGIN();
 
   test_iterate();
+  test_scheduler();
   test_report_xml();
 
   TEST_END();
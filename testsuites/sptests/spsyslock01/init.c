@@ -18,6 +18,8 @@
 
 #include "tmacros.h"
 
+#include <rtems/thread.h>
+
 #include <sys/lock.h>
 #include <errno.h>
 #include <limits.h>
@@ -49,12 +51,19 @@ const char rtems_test_name[] = "SPSYSLOCK 1";
 
 #define EVENT_CONDITION_WAIT_REC RTEMS_EVENT_10
 
+#define EVENT_FAST_MTX_ACQUIRE RTEMS_EVENT_11
+
+#define EVENT_FAST_MTX_RELEASE RTEMS_EVENT_12
+
+#define EVENT_FAST_MTX_PRIO_INV RTEMS_EVENT_13
+
 typedef struct {
   rtems_id high[2];
   rtems_id mid;
   rtems_id low;
   struct _Mutex_Control mtx;
   struct _Mutex_recursive_Control rec_mtx;
+  rtems_fast_mutex fast_mtx;
   struct _Condition_Control cond;
   struct _Semaphore_Control sem;
   struct _Futex_Control futex;
@@ -148,6 +157,17 @@ static bool eq_futex(
   return eq_tq(&a->_Queue, &b->_Queue);
 }
 
+static const char fast_mtx_name[] = "fast";
+
+static bool eq_fast_mtx(
+  const struct _Mutex_fast_Control *a,
+  const struct _Mutex_fast_Control *b
+)
+{
+  return eq_mtx(&a->_Mutex, &b->_Mutex)
+    && a->_owner == b->_owner;
+}
+
 static void test_initialization(test_context *ctx)
 {
   struct _Mutex_Control mtx = _MUTEX_INITIALIZER;
@@ -155,21 +175,25 @@ static void test_initialization(test_context *ctx)
   struct _Condition_Control cond = _CONDITION_INITIALIZER;
   struct _Semaphore_Control sem = _SEMAPHORE_INITIALIZER(1);
   struct _Futex_Control futex = _FUTEX_INITIALIZER;
+  rtems_fast_mutex fast_mtx = RTEMS_FAST_MUTEX_INITIALIZER(fast_mtx_name);
 
   _Mutex_Initialize(&ctx->mtx);
   _Mutex_recursive_Initialize(&ctx->rec_mtx);
+  rtems_fast_mutex_init(&ctx->fast_mtx, fast_mtx_name);
   _Condition_Initialize(&ctx->cond);
   _Semaphore_Initialize(&ctx->sem, 1);
   _Futex_Initialize(&ctx->futex);
 
   rtems_test_assert(eq_mtx(&mtx, &ctx->mtx));
   rtems_test_assert(eq_rec_mtx(&rec_mtx, &ctx->rec_mtx));
+  rtems_test_assert(eq_fast_mtx(&fast_mtx, &ctx->fast_mtx));
   rtems_test_assert(eq_cond(&cond, &ctx->cond));
   rtems_test_assert(eq_sem(&sem, &ctx->sem));
   rtems_test_assert(eq_futex(&futex, &ctx->futex));
 
   _Mutex_Destroy(&mtx);
   _Mutex_recursive_Destroy(&rec_mtx);
+  rtems_fast_mutex_destroy(&fast_mtx);
   _Condition_Destroy(&cond);
   _Semaphore_Destroy(&sem);
   _Futex_Destroy(&futex);
@@ -295,6 +319,95 @@ static void test_prio_inv_recursive(test_context *ctx)
   rtems_test_assert(ctx->generation[idx] == gen + 1);
 }
 
+static void test_fast_mtx_acquire(test_context *ctx)
+{
+  rtems_fast_mutex *mtx = &ctx->fast_mtx;
+  size_t idx = 0;
+  int eno;
+
+  eno = rtems_fast_mutex_try_lock(mtx);
+  rtems_test_assert(eno == 0);
+
+  eno = rtems_fast_mutex_try_lock(mtx);
+  rtems_test_assert(eno == EBUSY);
+
+  rtems_fast_mutex_unlock(mtx);
+
+  rtems_fast_mutex_lock(mtx);
+
+  eno = rtems_fast_mutex_try_lock(mtx);
+  rtems_test_assert(eno == EBUSY);
+
+  rtems_fast_mutex_unlock(mtx);
+
+  send_event(ctx, idx, EVENT_FAST_MTX_ACQUIRE);
+
+  eno = rtems_fast_mutex_try_lock(mtx);
+  rtems_test_assert(eno == EBUSY);
+
+  send_event(ctx, idx, EVENT_FAST_MTX_RELEASE);
+
+  eno = rtems_fast_mutex_try_lock(mtx);
+  rtems_test_assert(eno == 0);
+
+  rtems_fast_mutex_unlock(mtx);
+}
+
+static void test_fast_mtx_prio_acquire_order(test_context *ctx)
+{
+  rtems_fast_mutex *mtx = &ctx->fast_mtx;
+  size_t a = 0;
+  size_t b = 1;
+  int gen_a;
+  int gen_b;
+  int eno;
+
+  rtems_fast_mutex_lock(mtx);
+
+  gen_a = ctx->generation[a];
+  gen_b = ctx->generation[b];
+
+  send_event(ctx, b, EVENT_FAST_MTX_ACQUIRE);
+  send_event(ctx, a, EVENT_FAST_MTX_ACQUIRE);
+
+  rtems_test_assert(ctx->generation[a] == gen_a);
+  rtems_test_assert(ctx->generation[b] == gen_b);
+
+  rtems_fast_mutex_unlock(mtx);
+
+  rtems_test_assert(ctx->generation[a] == gen_a + 1);
+  rtems_test_assert(ctx->generation[b] == gen_b);
+
+  send_event(ctx, a, EVENT_FAST_MTX_RELEASE);
+
+  rtems_test_assert(ctx->generation[a] == gen_a + 1);
+  rtems_test_assert(ctx->generation[b] == gen_b + 1);
+
+  send_event(ctx, b, EVENT_FAST_MTX_RELEASE);
+
+  /* The mutex must be back in the uncontended state */
+  rtems_test_assert(mtx->_owner == 0);
+  eno = rtems_fast_mutex_try_lock(mtx);
+  rtems_test_assert(eno == 0);
+  rtems_fast_mutex_unlock(mtx);
+  rtems_test_assert(mtx->_owner == 0);
+}
+
+static void test_fast_mtx_prio_inv(test_context *ctx)
+{
+  rtems_fast_mutex *mtx = &ctx->fast_mtx;
+  size_t idx = 0;
+  int gen;
+
+  rtems_fast_mutex_lock(mtx);
+  gen = ctx->generation[idx];
+  send_event(ctx, idx, EVENT_FAST_MTX_PRIO_INV);
+  rtems_test_assert(ctx->generation[idx] == gen);
+  rtems_fast_mutex_unlock(mtx);
+  rtems_test_assert(ctx->generation[idx] == gen + 1);
+  rtems_test_assert(mtx->_owner == 0);
+}
+
 static void test_mtx_timeout_normal(test_context *ctx)
 {
   struct _Mutex_Control *mtx = &ctx->mtx;
@@ -623,6 +736,27 @@ static void high_task(rtems_task_argument idx)
       rtems_test_assert(sc == RTEMS_SUCCESSFUL);
     }
 
+    if ((events & EVENT_FAST_MTX_ACQUIRE) != 0) {
+      rtems_fast_mutex_lock(&ctx->fast_mtx);
+      ctx->generation[idx] = generation(ctx, idx);
+    }
+
+    if ((events & EVENT_FAST_MTX_RELEASE) != 0) {
+      rtems_fast_mutex_unlock(&ctx->fast_mtx);
+    }
+
+    if ((events & EVENT_FAST_MTX_PRIO_INV) != 0) {
+      sc = rtems_task_resume(ctx->mid);
+      rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+      rtems_fast_mutex_lock(&ctx->fast_mtx);
+      ctx->generation[idx] = generation(ctx, idx);
+      rtems_fast_mutex_unlock(&ctx->fast_mtx);
+
+      sc = rtems_task_suspend(ctx->mid);
+      rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+    }
+
     if ((events & EVENT_SEM_WAIT) != 0) {
       _Semaphore_Wait(&ctx->sem);
       ctx->generation[idx] = generation(ctx, idx);
@@ -702,6 +836,9 @@ static void test(void)
   test_prio_acquire_order(ctx);
   test_prio_inv_normal(ctx);
   test_prio_inv_recursive(ctx);
+  test_fast_mtx_acquire(ctx);
+  test_fast_mtx_prio_acquire_order(ctx);
+  test_fast_mtx_prio_inv(ctx);
   test_mtx_timeout_normal(ctx);
   test_mtx_timeout_recursive(ctx);
   test_mtx_deadlock(ctx);
@@ -723,6 +860,7 @@ static void test(void)
 
   _Mutex_Destroy(&ctx->mtx);
   _Mutex_recursive_Destroy(&ctx->rec_mtx);
+  rtems_fast_mutex_destroy(&ctx->fast_mtx);
   _Condition_Destroy(&ctx->cond);
   _Semaphore_Destroy(&ctx->sem);
   _Futex_Destroy(&ctx->futex);
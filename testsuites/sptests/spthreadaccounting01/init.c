@@ -0,0 +1,349 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems.h>
+#include <rtems/cpuuse.h>
+
+#include <string.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "SPTHREADACCOUNTING 1";
+
+#define SEMAPHORE_COUNT ( RTEMS_THREAD_ACCOUNTING_WAIT_QUEUES + 1 )
+
+typedef struct {
+  rtems_id id;
+  bool found;
+  rtems_thread_accounting accounting;
+} test_context;
+
+static test_context test_instance;
+
+static rtems_id semaphores[ SEMAPHORE_COUNT ];
+
+static uint64_t ticks_to_nanoseconds( rtems_interval ticks )
+{
+  return (uint64_t) ticks * rtems_configuration_get_nanoseconds_per_tick();
+}
+
+static bool visitor( const rtems_thread_accounting *accounting, void *arg )
+{
+  test_context *ctx;
+
+  ctx = arg;
+
+  if ( accounting->id == ctx->id ) {
+    ctx->accounting = *accounting;
+    ctx->found = true;
+    return true;
+  }
+
+  return false;
+}
+
+static const rtems_thread_accounting *get_accounting(
+  test_context *ctx,
+  rtems_id      id
+)
+{
+  rtems_status_code sc;
+
+  ctx->id = id;
+  ctx->found = false;
+  sc = rtems_thread_accounting_iterate( visitor, ctx );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( ctx->found );
+
+  return &ctx->accounting;
+}
+
+static void busy_wait( rtems_interval ticks )
+{
+  rtems_interval start;
+
+  start = rtems_clock_get_ticks_since_boot();
+
+  while ( rtems_clock_get_ticks_since_boot() - start < ticks ) {
+    /* Wait */
+  }
+}
+
+static void wait_once( rtems_task_argument arg )
+{
+  rtems_status_code sc;
+
+  sc = rtems_semaphore_obtain(
+    semaphores[ 0 ],
+    RTEMS_WAIT,
+    RTEMS_NO_TIMEOUT
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  rtems_task_suspend( RTEMS_SELF );
+}
+
+static void wait_with_timeouts( rtems_task_argument arg )
+{
+  size_t i;
+
+  for ( i = 0; i < SEMAPHORE_COUNT; ++i ) {
+    rtems_status_code sc;
+
+    sc = rtems_semaphore_obtain( semaphores[ i ], RTEMS_WAIT, i + 1 );
+    rtems_test_assert( sc == RTEMS_TIMEOUT );
+  }
+
+  rtems_task_suspend( RTEMS_SELF );
+}
+
+static void wait_with_timeout( rtems_task_argument arg )
+{
+  rtems_status_code sc;
+
+  sc = rtems_semaphore_obtain( (rtems_id) arg, RTEMS_WAIT, 1 );
+  rtems_test_assert( sc == RTEMS_TIMEOUT );
+
+  rtems_task_suspend( RTEMS_SELF );
+}
+
+static rtems_id start_task(
+  rtems_task_entry    entry,
+  rtems_task_argument arg
+)
+{
+  rtems_status_code sc;
+  rtems_id          id;
+
+  sc = rtems_task_create(
+    rtems_build_name( 'W', 'O', 'R', 'K' ),
+    2,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_task_start( id, entry, arg );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  return id;
+}
+
+static void test_wait_and_ready_time( test_context *ctx )
+{
+  const rtems_thread_accounting *accounting;
+  rtems_status_code              sc;
+  rtems_id                       id;
+
+  id = start_task( wait_once, 0 );
+
+  /* Let the task block on the semaphore */
+  sc = rtems_task_wake_after( 1 );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_task_wake_after( 4 );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  /* The task is ready but cannot preempt us */
+  sc = rtems_semaphore_release( semaphores[ 0 ] );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  busy_wait( 2 );
+
+  sc = rtems_task_wake_after( 1 );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  accounting = get_accounting( ctx, id );
+  rtems_test_assert( accounting->wait_queue_count == 1 );
+  rtems_test_assert( accounting->wait_queues[ 0 ].id == semaphores[ 0 ] );
+  rtems_test_assert(
+    strcmp( accounting->wait_queues[ 0 ].name, "SEM0" ) == 0
+  );
+  rtems_test_assert( accounting->wait_queues[ 0 ].count == 1 );
+  rtems_test_assert(
+    accounting->wait_queues[ 0 ].wait_time >= ticks_to_nanoseconds( 3 )
+  );
+  rtems_test_assert(
+    accounting->wait_time == accounting->wait_queues[ 0 ].wait_time
+  );
+  rtems_test_assert( accounting->other_wait_queues.count == 0 );
+  rtems_test_assert( accounting->ready_time >= ticks_to_nanoseconds( 1 ) );
+
+  rtems_cpu_usage_reset();
+
+  accounting = get_accounting( ctx, id );
+  rtems_test_assert( accounting->wait_queue_count == 0 );
+  rtems_test_assert( accounting->wait_time == 0 );
+  rtems_test_assert( accounting->ready_time == 0 );
+
+  sc = rtems_task_delete( id );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+}
+
+static void test_other_wait_queues( test_context *ctx )
+{
+  const rtems_thread_accounting *accounting;
+  rtems_status_code              sc;
+  rtems_id                       id;
+  size_t                         i;
+
+  id = start_task( wait_with_timeouts, 0 );
+
+  sc = rtems_task_wake_after( 2 * SEMAPHORE_COUNT * SEMAPHORE_COUNT );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  accounting = get_accounting( ctx, id );
+  rtems_test_assert(
+    accounting->wait_queue_count == RTEMS_THREAD_ACCOUNTING_WAIT_QUEUES
+  );
+
+  /* The account of the shortest wait moved to the other thread queues */
+  rtems_test_assert( accounting->other_wait_queues.id == 0 );
+  rtems_test_assert( accounting->other_wait_queues.name[ 0 ] == '\0' );
+  rtems_test_assert( accounting->other_wait_queues.count == 1 );
+
+  for ( i = 0; i < accounting->wait_queue_count; ++i ) {
+    const rtems_thread_accounting_wait *wait;
+
+    wait = &accounting->wait_queues[ i ];
+    rtems_test_assert( wait->id == semaphores[ SEMAPHORE_COUNT - 1 - i ] );
+    rtems_test_assert( wait->count == 1 );
+    rtems_test_assert(
+      wait->wait_time >= accounting->other_wait_queues.wait_time
+    );
+  }
+
+  sc = rtems_task_delete( id );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+}
+
+static void test_deleted_wait_queue( test_context *ctx )
+{
+  const rtems_thread_accounting *accounting;
+  rtems_status_code              sc;
+  rtems_id                       id;
+  rtems_id                       deleted;
+  rtems_id                       reused;
+
+  sc = rtems_semaphore_create(
+    rtems_build_name( 'D', 'E', 'L', 'E' ),
+    0,
+    RTEMS_COUNTING_SEMAPHORE | RTEMS_PRIORITY,
+    0,
+    &deleted
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  id = start_task( wait_with_timeout, (rtems_task_argument) deleted );
+
+  sc = rtems_task_wake_after( 3 );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_semaphore_delete( deleted );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  /* Reuse the object of the deleted semaphore with a different name */
+  sc = rtems_semaphore_create(
+    rtems_build_name( 'N', 'E', 'W', ' ' ),
+    0,
+    RTEMS_COUNTING_SEMAPHORE | RTEMS_PRIORITY,
+    0,
+    &reused
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  /* The account must not refer to the thread queue of the deleted object */
+  accounting = get_accounting( ctx, id );
+  rtems_test_assert( accounting->wait_queue_count == 1 );
+  rtems_test_assert( accounting->wait_queues[ 0 ].id == deleted );
+  rtems_test_assert(
+    strcmp( accounting->wait_queues[ 0 ].name, "DELE" ) == 0
+  );
+  rtems_test_assert( accounting->wait_queues[ 0 ].count == 1 );
+
+  sc = rtems_semaphore_delete( reused );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_task_delete( id );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+}
+
+static void Init( rtems_task_argument arg )
+{
+  test_context      *ctx;
+  rtems_status_code  sc;
+  size_t             i;
+
+  TEST_BEGIN();
+  ctx = &test_instance;
+
+  sc = rtems_thread_accounting_iterate( visitor, ctx );
+
+  if ( sc == RTEMS_NOT_IMPLEMENTED ) {
+    TEST_END();
+    rtems_test_exit( 0 );
+  }
+
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  for ( i = 0; i < SEMAPHORE_COUNT; ++i ) {
+    sc = rtems_semaphore_create(
+      rtems_build_name( 'S', 'E', 'M', (char) ( '0' + i ) ),
+      0,
+      RTEMS_COUNTING_SEMAPHORE | RTEMS_PRIORITY,
+      0,
+      &semaphores[ i ]
+    );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  }
+
+  test_wait_and_ready_time( ctx );
+  test_other_wait_queues( ctx );
+  test_deleted_wait_queue( ctx );
+
+  TEST_END();
+  rtems_test_exit( 0 );
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES ( SEMAPHORE_COUNT + 1 )
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,288 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <rtems.h>
+#include <rtems/clockdrv.h>
+#include <rtems/score/watchdogimpl.h>
+
+const char rtems_test_name[] = "SPTICKLESS 1";
+
+#define TICK_COUNT 100
+
+#define MAXIMUM_CLOCK_INTERRUPTS 10
+
+#define LONG_IDLE_SECONDS 3
+
+typedef struct {
+  rtems_id timer;
+  rtems_interval fired_at;
+  bool enabled;
+} test_context;
+
+static test_context test_instance;
+
+static uint64_t nanoseconds_per_tick(void)
+{
+  return (uint64_t) rtems_configuration_get_nanoseconds_per_tick();
+}
+
+static void synchronize_with_clock_tick(void)
+{
+  rtems_status_code sc;
+
+  sc = rtems_task_wake_after(1);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void check_clock_interrupts(
+  const test_context *ctx,
+  const char *name,
+  uint32_t interrupts
+)
+{
+  printf("%s: %" PRIu32 " clock interrupts\n", name, interrupts);
+
+  if (ctx->enabled) {
+    rtems_test_assert(interrupts <= MAXIMUM_CLOCK_INTERRUPTS);
+  }
+}
+
+static void test_wake_after(test_context *ctx)
+{
+  rtems_status_code sc;
+  rtems_interval ticks;
+  uint64_t uptime;
+  uint32_t interrupts;
+
+  synchronize_with_clock_tick();
+  ticks = rtems_clock_get_ticks_since_boot();
+  uptime = rtems_clock_get_uptime_nanoseconds();
+  interrupts = Clock_driver_ticks;
+
+  sc = rtems_task_wake_after(TICK_COUNT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  interrupts = Clock_driver_ticks - interrupts;
+  uptime = rtems_clock_get_uptime_nanoseconds() - uptime;
+  ticks = rtems_clock_get_ticks_since_boot() - ticks;
+
+  rtems_test_assert(ticks == TICK_COUNT);
+  rtems_test_assert(uptime >= (TICK_COUNT - 1) * nanoseconds_per_tick());
+  check_clock_interrupts(ctx, "wake after", interrupts);
+}
+
+static rtems_timer_service_routine timer(rtems_id id, void *arg)
+{
+  test_context *ctx;
+
+  ctx = arg;
+  ctx->fired_at = rtems_clock_get_ticks_since_boot();
+}
+
+static void test_timer(test_context *ctx)
+{
+  rtems_status_code sc;
+  rtems_interval ticks;
+  uint32_t interrupts;
+
+  synchronize_with_clock_tick();
+  ticks = rtems_clock_get_ticks_since_boot();
+  interrupts = Clock_driver_ticks;
+  ctx->fired_at = 0;
+
+  sc = rtems_timer_fire_after(ctx->timer, TICK_COUNT / 2, timer, ctx);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_wake_after(TICK_COUNT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  interrupts = Clock_driver_ticks - interrupts;
+  rtems_test_assert(ctx->fired_at - ticks == TICK_COUNT / 2);
+  rtems_test_assert(rtems_clock_get_ticks_since_boot() - ticks == TICK_COUNT);
+  check_clock_interrupts(ctx, "timer", interrupts);
+}
+
+static void test_monotonic_sleep(test_context *ctx)
+{
+  struct timespec delta;
+  uint64_t uptime;
+  uint64_t expected;
+  uint32_t interrupts;
+  int eno;
+
+  expected = TICK_COUNT * nanoseconds_per_tick();
+  delta.tv_sec = (time_t) (expected / 1000000000);
+  delta.tv_nsec = (long) (expected % 1000000000);
+
+  synchronize_with_clock_tick();
+  uptime = rtems_clock_get_uptime_nanoseconds();
+  interrupts = Clock_driver_ticks;
+
+  eno = clock_nanosleep(CLOCK_MONOTONIC, 0, &delta, NULL);
+  rtems_test_assert(eno == 0);
+
+  interrupts = Clock_driver_ticks - interrupts;
+  uptime = rtems_clock_get_uptime_nanoseconds() - uptime;
+  rtems_test_assert(uptime >= expected);
+  check_clock_interrupts(ctx, "monotonic sleep", interrupts);
+}
+
+static void test_wake_when(test_context *ctx)
+{
+  rtems_status_code sc;
+  rtems_time_of_day tod;
+  rtems_interval seconds;
+  rtems_interval now;
+  uint32_t interrupts;
+
+  build_time(&tod, 1, 1, 2020, 0, 0, 0, 0);
+  sc = rtems_clock_set(&tod);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  synchronize_with_clock_tick();
+  sc = rtems_clock_get_seconds_since_epoch(&seconds);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_clock_get_tod(&tod);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  tod.second += 2;
+  tod.ticks = 0;
+  interrupts = Clock_driver_ticks;
+
+  sc = rtems_task_wake_when(&tod);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  interrupts = Clock_driver_ticks - interrupts;
+  sc = rtems_clock_get_seconds_since_epoch(&now);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(now - seconds >= 2);
+
+  check_clock_interrupts(ctx, "wake when", interrupts);
+}
+
+static uint64_t get_realtime_nanoseconds(void)
+{
+  struct timespec now;
+  int rv;
+
+  rv = clock_gettime(CLOCK_REALTIME, &now);
+  rtems_test_assert(rv == 0);
+
+  return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+
+static void test_long_idle(test_context *ctx)
+{
+  rtems_status_code sc;
+  rtems_interval ticks_per_long_idle;
+  rtems_interval ticks;
+  uint64_t uptime;
+  uint64_t realtime;
+  uint64_t expected;
+  uint32_t interrupts;
+
+  /*
+   * Idle for longer than the clock driver may suppress ticks at once, so that
+   * the suppression is renewed several times.  The clock must neither lose
+   * nor gain time across the suppressed intervals.
+   */
+  ticks_per_long_idle = LONG_IDLE_SECONDS * rtems_clock_get_ticks_per_second();
+  expected = ticks_per_long_idle * nanoseconds_per_tick();
+
+  synchronize_with_clock_tick();
+  ticks = rtems_clock_get_ticks_since_boot();
+  uptime = rtems_clock_get_uptime_nanoseconds();
+  realtime = get_realtime_nanoseconds();
+  interrupts = Clock_driver_ticks;
+
+  sc = rtems_task_wake_after(ticks_per_long_idle);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  interrupts = Clock_driver_ticks - interrupts;
+  realtime = get_realtime_nanoseconds() - realtime;
+  uptime = rtems_clock_get_uptime_nanoseconds() - uptime;
+  ticks = rtems_clock_get_ticks_since_boot() - ticks;
+
+  rtems_test_assert(ticks == ticks_per_long_idle);
+  rtems_test_assert(uptime >= expected - nanoseconds_per_tick());
+  rtems_test_assert(uptime <= expected + nanoseconds_per_tick());
+  rtems_test_assert(realtime >= uptime - nanoseconds_per_tick());
+  rtems_test_assert(realtime <= uptime + nanoseconds_per_tick());
+  check_clock_interrupts(ctx, "long idle", interrupts);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  test_context *ctx;
+  rtems_status_code sc;
+
+  TEST_BEGIN();
+  ctx = &test_instance;
+  ctx->enabled = _Watchdog_Is_tick_suppression_enabled();
+
+  if (ctx->enabled) {
+    puts("clock tick suppression: enabled");
+  } else {
+    puts("clock tick suppression: not supported by the clock driver");
+  }
+
+  sc = rtems_timer_create(rtems_build_name('T', 'I', 'M', 'R'), &ctx->timer);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_wake_after(ctx);
+  test_timer(ctx);
+  test_monotonic_sleep(ctx);
+  test_wake_when(ctx);
+  test_long_idle(ctx);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_CLOCK_TICK_SUPPRESSION
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
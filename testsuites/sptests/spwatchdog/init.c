@@ -100,15 +100,14 @@ static uint64_t test_watchdog_tick( Watchdog_Header *header, uint64_t now )
 
 static void test_watchdog_operations( void )
 {
-  Watchdog_Header header;
+  static Watchdog_Header header;
   uint64_t now;
   test_watchdog a;
   test_watchdog b;
   test_watchdog c;
 
   _Watchdog_Header_initialize( &header );
-  rtems_test_assert( _RBTree_Is_empty( &header.Watchdogs ) );
-  rtems_test_assert( header.first == NULL );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == NULL );
 
   test_watchdog_init( &a, 10 );
   test_watchdog_init( &b, 20 );
@@ -118,80 +117,80 @@ static void test_watchdog_operations( void )
   now = test_watchdog_tick( &header, now );
 
   _Watchdog_Insert( &header, &a.Base, now + 1 );
-  rtems_test_assert( header.first == &a.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &a.Base );
   rtems_test_assert( !test_watchdog_is_inactive( &a ) ) ;
   rtems_test_assert( a.Base.expire == 2 );
   rtems_test_assert( a.counter == 10 );
 
   _Watchdog_Remove( &header, &a.Base );
-  rtems_test_assert( header.first == NULL );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == NULL );
   rtems_test_assert( test_watchdog_is_inactive( &a ) ) ;
   rtems_test_assert( a.Base.expire == 2 );
   rtems_test_assert( a.counter == 10 );
 
   _Watchdog_Remove( &header, &a.Base );
-  rtems_test_assert( header.first == NULL );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == NULL );
   rtems_test_assert( test_watchdog_is_inactive( &a ) ) ;
   rtems_test_assert( a.Base.expire == 2 );
   rtems_test_assert( a.counter == 10 );
 
   _Watchdog_Insert( &header, &a.Base, now + 1 );
-  rtems_test_assert( header.first == &a.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &a.Base );
   rtems_test_assert( !test_watchdog_is_inactive( &a ) ) ;
   rtems_test_assert( a.Base.expire == 2 );
   rtems_test_assert( a.counter == 10 );
 
   _Watchdog_Insert( &header, &b.Base, now + 1 );
-  rtems_test_assert( header.first == &a.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &a.Base );
   rtems_test_assert( !test_watchdog_is_inactive( &b ) ) ;
   rtems_test_assert( b.Base.expire == 2 );
   rtems_test_assert( b.counter == 20 );
 
   _Watchdog_Insert( &header, &c.Base, now + 2 );
-  rtems_test_assert( header.first == &a.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &a.Base );
   rtems_test_assert( !test_watchdog_is_inactive( &c ) ) ;
   rtems_test_assert( c.Base.expire == 3 );
   rtems_test_assert( c.counter == 30 );
 
   _Watchdog_Remove( &header, &a.Base );
-  rtems_test_assert( header.first == &b.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &b.Base );
   rtems_test_assert( test_watchdog_is_inactive( &a ) ) ;
   rtems_test_assert( a.Base.expire == 2 );
   rtems_test_assert( a.counter == 10 );
 
   _Watchdog_Remove( &header, &b.Base );
-  rtems_test_assert( header.first == &c.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &c.Base );
   rtems_test_assert( test_watchdog_is_inactive( &b ) ) ;
   rtems_test_assert( b.Base.expire == 2 );
   rtems_test_assert( b.counter == 20 );
 
   _Watchdog_Remove( &header, &c.Base );
-  rtems_test_assert( header.first == NULL );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == NULL );
   rtems_test_assert( test_watchdog_is_inactive( &c ) ) ;
   rtems_test_assert( c.Base.expire == 3 );
   rtems_test_assert( c.counter == 30 );
 
   _Watchdog_Insert( &header, &a.Base, now + 2 );
-  rtems_test_assert( header.first == &a.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &a.Base );
   rtems_test_assert( !test_watchdog_is_inactive( &a ) ) ;
   rtems_test_assert( a.Base.expire == 3 );
   rtems_test_assert( a.counter == 10 );
 
   _Watchdog_Insert( &header, &b.Base, now + 2 );
-  rtems_test_assert( header.first == &a.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &a.Base );
   rtems_test_assert( !test_watchdog_is_inactive( &b ) ) ;
   rtems_test_assert( b.Base.expire == 3 );
   rtems_test_assert( b.counter == 20 );
 
   _Watchdog_Insert( &header, &c.Base, now + 3 );
-  rtems_test_assert( header.first == &a.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &a.Base );
   rtems_test_assert( !test_watchdog_is_inactive( &c ) ) ;
   rtems_test_assert( c.Base.expire == 4 );
   rtems_test_assert( c.counter == 30 );
 
   now = test_watchdog_tick( &header, now );
-  rtems_test_assert( !_RBTree_Is_empty( &header.Watchdogs ) );
-  rtems_test_assert( header.first == &a.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) != NULL );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &a.Base );
   rtems_test_assert( !test_watchdog_is_inactive( &a ) ) ;
   rtems_test_assert( a.Base.expire == 3 );
   rtems_test_assert( a.counter == 10 );
@@ -203,8 +202,8 @@ static void test_watchdog_operations( void )
   rtems_test_assert( c.counter == 30 );
 
   now = test_watchdog_tick( &header, now );
-  rtems_test_assert( !_RBTree_Is_empty( &header.Watchdogs ) );
-  rtems_test_assert( header.first == &c.Base.Node.RBTree );
+  rtems_test_assert( _Watchdog_Header_first( &header ) != NULL );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == &c.Base );
   rtems_test_assert( test_watchdog_is_inactive( &a ) ) ;
   rtems_test_assert( a.Base.expire == 3 );
   rtems_test_assert( a.counter == 11 );
@@ -216,8 +215,7 @@ static void test_watchdog_operations( void )
   rtems_test_assert( c.counter == 30 );
 
   now = test_watchdog_tick( &header, now );
-  rtems_test_assert( _RBTree_Is_empty( &header.Watchdogs ) );
-  rtems_test_assert( header.first == NULL );
+  rtems_test_assert( _Watchdog_Header_first( &header ) == NULL );
   rtems_test_assert( test_watchdog_is_inactive( &a ) ) ;
   rtems_test_assert( a.Base.expire == 3 );
   rtems_test_assert( a.counter == 11 );
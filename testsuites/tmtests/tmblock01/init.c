@@ -0,0 +1,324 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <rtems/bdbuf.h>
+#include <rtems/blkdev.h>
+#include <rtems/ramdisk.h>
+#include <rtems/test.h>
+
+const char rtems_test_name[] = "TMBLOCK 1";
+
+#if defined(RTEMS_SMP)
+#define CPU_COUNT 32
+#else
+#define CPU_COUNT 1
+#endif
+
+#define DISK_PATH "/disk"
+
+#define BLOCK_SIZE 512
+
+#define BLOCKS_PER_WORKER 8
+
+#define BLOCK_COUNT (CPU_COUNT * BLOCKS_PER_WORKER)
+
+typedef struct {
+  rtems_test_parallel_context base;
+  rtems_disk_device *dd;
+  uint32_t read_same_block_ops[CPU_COUNT][CPU_COUNT];
+  uint32_t read_private_blocks_ops[CPU_COUNT][CPU_COUNT];
+  uint32_t modify_private_blocks_ops[CPU_COUNT][CPU_COUNT];
+} test_context;
+
+static test_context test_instance;
+
+static rtems_interval test_init(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  return rtems_clock_get_ticks_per_second();
+}
+
+static void test_fini(
+  const char *name,
+  uint32_t *counters,
+  size_t active_workers
+)
+{
+  size_t i;
+
+  printf("  <%s activeWorker=\"%zu\">\n", name, active_workers);
+
+  for (i = 0; i < active_workers; ++i) {
+    printf(
+      "    <Counter worker=\"%zu\">%" PRIu32 "</Counter>\n",
+      i,
+      counters[i]
+    );
+  }
+
+  printf("  </%s>\n", name);
+}
+
+static void read_and_release(rtems_disk_device *dd, rtems_blkdev_bnum block)
+{
+  rtems_status_code sc;
+  rtems_bdbuf_buffer *bd;
+
+  sc = rtems_bdbuf_read(dd, block, &bd);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_bdbuf_release(bd);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void test_read_same_block_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  uint32_t counter = 0;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    ++counter;
+    read_and_release(ctx->dd, 0);
+  }
+
+  ctx->read_same_block_ops[active_workers - 1][worker_index] = counter;
+}
+
+static void test_read_same_block_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    "ReadSameBlock",
+    &ctx->read_same_block_ops[active_workers - 1][0],
+    active_workers
+  );
+}
+
+static void test_read_private_blocks_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  rtems_blkdev_bnum first = worker_index * BLOCKS_PER_WORKER;
+  uint32_t counter = 0;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    read_and_release(ctx->dd, first + counter % BLOCKS_PER_WORKER);
+    ++counter;
+  }
+
+  ctx->read_private_blocks_ops[active_workers - 1][worker_index] = counter;
+}
+
+static void test_read_private_blocks_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    "ReadPrivateBlocks",
+    &ctx->read_private_blocks_ops[active_workers - 1][0],
+    active_workers
+  );
+}
+
+static void test_modify_private_blocks_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  rtems_blkdev_bnum first = worker_index * BLOCKS_PER_WORKER;
+  uint32_t counter = 0;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    rtems_status_code sc;
+    rtems_bdbuf_buffer *bd;
+
+    sc = rtems_bdbuf_get(ctx->dd, first + counter % BLOCKS_PER_WORKER, &bd);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    bd->buffer[0] = (unsigned char) counter;
+
+    sc = rtems_bdbuf_release_modified(bd);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    ++counter;
+  }
+
+  ctx->modify_private_blocks_ops[active_workers - 1][worker_index] = counter;
+}
+
+static void test_modify_private_blocks_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+  rtems_status_code sc;
+
+  sc = rtems_bdbuf_syncdev(ctx->dd);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_fini(
+    "ModifyPrivateBlocks",
+    &ctx->modify_private_blocks_ops[active_workers - 1][0],
+    active_workers
+  );
+}
+
+static const rtems_test_parallel_job test_jobs[] = {
+  {
+    .init = test_init,
+    .body = test_read_same_block_body,
+    .fini = test_read_same_block_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_read_private_blocks_body,
+    .fini = test_read_private_blocks_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_modify_private_blocks_body,
+    .fini = test_modify_private_blocks_fini,
+    .cascade = true
+  }
+};
+
+static void create_disk(test_context *ctx)
+{
+  rtems_status_code sc;
+  ramdisk *rd;
+  int fd;
+  int rv;
+
+  rd = ramdisk_allocate(NULL, BLOCK_SIZE, BLOCK_COUNT, false);
+  rtems_test_assert(rd != NULL);
+
+  ramdisk_enable_free_at_delete_request(rd);
+
+  sc = rtems_blkdev_create(
+    DISK_PATH,
+    BLOCK_SIZE,
+    BLOCK_COUNT,
+    ramdisk_ioctl,
+    rd
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  fd = open(DISK_PATH, O_RDWR);
+  rtems_test_assert(fd >= 0);
+
+  rv = rtems_disk_fd_get_disk_device(fd, &ctx->dd);
+  rtems_test_assert(rv == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  test_context *ctx = &test_instance;
+  const char *test = "TestTimeBlock01";
+
+  TEST_BEGIN();
+
+  create_disk(ctx);
+
+  printf("<%s>\n", test);
+
+  rtems_test_parallel(
+    &ctx->base,
+    NULL,
+    &test_jobs[0],
+    RTEMS_ARRAY_SIZE(test_jobs)
+  );
+
+  printf("</%s>\n", test);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_BDBUF_BUFFER_MIN_SIZE BLOCK_SIZE
+#define CONFIGURE_BDBUF_BUFFER_MAX_SIZE BLOCK_SIZE
+#define CONFIGURE_BDBUF_CACHE_MEMORY_SIZE (BLOCK_COUNT * BLOCK_SIZE)
+
+#define CONFIGURE_MAXIMUM_TASKS CPU_COUNT
+
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_PRIORITY 2
+
+#define CONFIGURE_MAXIMUM_PROCESSORS CPU_COUNT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
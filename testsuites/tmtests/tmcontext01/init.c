@@ -32,6 +32,20 @@
 
 #define CPU_COUNT 32
 
+#define SWITCH_TASKS 2
+
+/*
+ * Ports opt into the lazy floating point context switch of the score with
+ * CPU_USE_LAZY_FP_SWITCH, e.g. the i386 port with the --enable-lazy-fp-switch
+ * configure option.  The SPARC port has its own lazy floating point context
+ * switch in uniprocessor configurations.
+ */
+#if CPU_USE_LAZY_FP_SWITCH == TRUE || defined(SPARC_USE_LAZY_FP_SWITCH)
+#define LAZY_FP_SWITCH "yes"
+#else
+#define LAZY_FP_SWITCH "no"
+#endif
+
 const char rtems_test_name[] = "TMCONTEXT 1";
 
 static rtems_counter_ticks t[SAMPLES];
@@ -46,6 +60,20 @@ static volatile int *main_data;
 
 static Context_Control ctx;
 
+typedef enum {
+  SWITCH_INTEGER,
+  SWITCH_FP_UNUSED,
+  SWITCH_FP_USED
+} switch_kind;
+
+static rtems_id switch_master;
+
+static volatile rtems_counter_ticks switch_begin;
+
+static volatile int switch_sample;
+
+static volatile double fp_data = 1.0;
+
 static int dirty_data_cache(volatile int *data, size_t n, size_t clsz, int j)
 {
   size_t m = n / sizeof(*data);
@@ -136,29 +164,14 @@ static void sort_t(void)
   qsort(&t[0], SAMPLES, sizeof(t[0]), cmp);
 }
 
-static void test_by_function_level(int fl, bool dirty)
+static void print_sample(const char *name, const char *value)
 {
-  RTEMS_INTERRUPT_LOCK_DECLARE(, lock)
-  rtems_interrupt_lock_context lock_context;
-  int s;
   uint64_t min;
   uint64_t q1;
   uint64_t q2;
   uint64_t q3;
   uint64_t max;
 
-  fl += prevent_optimization;
-
-  rtems_interrupt_lock_initialize(&lock, "test");
-  rtems_interrupt_lock_acquire(&lock, &lock_context);
-
-  for (s = 0; s < SAMPLES; ++s) {
-    call_at_level(fl, fl, s, dirty);
-  }
-
-  rtems_interrupt_lock_release(&lock, &lock_context);
-  rtems_interrupt_lock_destroy(&lock);
-
   sort_t();
 
   min = t[0];
@@ -168,14 +181,15 @@ static void test_by_function_level(int fl, bool dirty)
   max = t[SAMPLES - 1];
 
   printf(
-    "    <Sample functionNestLevel=\"%i\">\n"
+    "    <Sample %s=\"%s\">\n"
     "      <Min unit=\"ns\">%" PRIu64 "</Min>"
       "<Q1 unit=\"ns\">%" PRIu64 "</Q1>"
       "<Q2 unit=\"ns\">%" PRIu64 "</Q2>"
       "<Q3 unit=\"ns\">%" PRIu64 "</Q3>"
       "<Max unit=\"ns\">%" PRIu64 "</Max>\n"
     "    </Sample>\n",
-    fl,
+    name,
+    value,
     rtems_counter_ticks_to_nanoseconds(min),
     rtems_counter_ticks_to_nanoseconds(q1),
     rtems_counter_ticks_to_nanoseconds(q2),
@@ -184,6 +198,29 @@ static void test_by_function_level(int fl, bool dirty)
   );
 }
 
+static void test_by_function_level(int fl, bool dirty)
+{
+  RTEMS_INTERRUPT_LOCK_DECLARE(, lock)
+  rtems_interrupt_lock_context lock_context;
+  int s;
+  char value[12];
+
+  fl += prevent_optimization;
+
+  rtems_interrupt_lock_initialize(&lock, "test");
+  rtems_interrupt_lock_acquire(&lock, &lock_context);
+
+  for (s = 0; s < SAMPLES; ++s) {
+    call_at_level(fl, fl, s, dirty);
+  }
+
+  rtems_interrupt_lock_release(&lock, &lock_context);
+  rtems_interrupt_lock_destroy(&lock);
+
+  snprintf(value, sizeof(value), "%i", fl);
+  print_sample("functionNestLevel", value);
+}
+
 static void test(bool dirty, uint32_t load)
 {
   int fl;
@@ -206,6 +243,110 @@ static void test(bool dirty, uint32_t load)
   printf("  </ContextSwitchTest>\n");
 }
 
+static void switch_task(rtems_task_argument arg)
+{
+  switch_kind kind = (switch_kind) arg;
+
+  while (true) {
+    rtems_counter_ticks b;
+    int s;
+
+    switch_begin = rtems_counter_read();
+    rtems_task_wake_after(RTEMS_YIELD_PROCESSOR);
+
+    /*
+     * With the lazy floating point context switch the first floating point
+     * instruction after the switch traps and the floating point context is
+     * switched now.
+     */
+    if (kind == SWITCH_FP_USED) {
+      fp_data = fp_data * 0.5 + 1.0;
+    }
+
+    b = rtems_counter_read();
+    s = switch_sample;
+
+    if (s < SAMPLES) {
+      /* The first switch to each task starts no measurement */
+      if (s >= 0) {
+        t[s] = rtems_counter_difference(b, switch_begin);
+      }
+
+      ++s;
+      switch_sample = s;
+
+      if (s == SAMPLES) {
+        rtems_event_transient_send(switch_master);
+      }
+    }
+  }
+}
+
+static void test_thread_switch(switch_kind kind)
+{
+  static const char * const kinds[] = {
+    "integer",
+    "floatingPointUnused",
+    "floatingPointUsed"
+  };
+  rtems_status_code sc;
+  rtems_id id[SWITCH_TASKS];
+  cpu_set_t cpu;
+  size_t i;
+
+  switch_master = rtems_task_self();
+  switch_sample = -SWITCH_TASKS;
+
+  CPU_ZERO(&cpu);
+  CPU_SET((int) rtems_scheduler_get_processor(), &cpu);
+
+  for (i = 0; i < SWITCH_TASKS; ++i) {
+    sc = rtems_task_create(
+      rtems_build_name('S', 'W', 'T', 'H'),
+      2,
+      RTEMS_MINIMUM_STACK_SIZE,
+      RTEMS_DEFAULT_MODES,
+      kind == SWITCH_INTEGER ?
+        RTEMS_DEFAULT_ATTRIBUTES : RTEMS_FLOATING_POINT,
+      &id[i]
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_task_set_affinity(id[i], sizeof(cpu), &cpu);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_task_start(id[i], switch_task, (rtems_task_argument) kind);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (i = 0; i < SWITCH_TASKS; ++i) {
+    sc = rtems_task_delete(id[i]);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  print_sample("kind", kinds[kind]);
+}
+
+static void test_thread_switches(void)
+{
+  printf(
+    "  <ThreadSwitchTest lazyFloatingPointSwitch=\"%s\">\n",
+    LAZY_FP_SWITCH
+  );
+
+  test_thread_switch(SWITCH_INTEGER);
+
+#if CPU_HARDWARE_FP == TRUE || CPU_SOFTWARE_FP == TRUE
+  test_thread_switch(SWITCH_FP_UNUSED);
+  test_thread_switch(SWITCH_FP_USED);
+#endif
+
+  printf("  </ThreadSwitchTest>\n");
+}
+
 static void Init(rtems_task_argument arg)
 {
   uint32_t load = 0;
@@ -229,6 +370,7 @@ static void Init(rtems_task_argument arg)
 
   test(false, load);
   test(true, load);
+  test_thread_switches();
 
   for (load = 1; load < rtems_scheduler_get_processor_maximum(); ++load) {
     rtems_status_code sc;
@@ -270,7 +412,7 @@ static void Init(rtems_task_argument arg)
 
 #define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
 
-#define CONFIGURE_MAXIMUM_TASKS (1 + CPU_COUNT)
+#define CONFIGURE_MAXIMUM_TASKS (1 + SWITCH_TASKS + CPU_COUNT)
 
 #define CONFIGURE_INIT_TASK_STACK_SIZE (32 * 1024)
 
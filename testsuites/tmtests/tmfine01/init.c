@@ -25,6 +25,7 @@
 #include <stdio.h>
 
 #include <rtems/test.h>
+#include <rtems/thread.h>
 
 const char rtems_test_name[] = "TMFINE 1";
 
@@ -57,6 +58,9 @@ typedef struct {
   uint32_t many_pthread_spinlock_ops[CPU_COUNT][CPU_COUNT];
   uint32_t many_pthread_mutex_inherit_ops[CPU_COUNT][CPU_COUNT];
   uint32_t many_pthread_mutex_protect_ops[CPU_COUNT][CPU_COUNT];
+  uint32_t one_fast_mutex_ops[CPU_COUNT][CPU_COUNT];
+  uint32_t many_fast_mutex_ops[CPU_COUNT][CPU_COUNT];
+  rtems_fast_mutex fast_mutex;
 } test_context;
 
 static test_context test_instance;
@@ -697,6 +701,82 @@ static void test_many_pthread_mutex_protect_fini(
   );
 }
 
+static void test_one_fast_mutex_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  rtems_fast_mutex *mtx = &ctx->fast_mutex;
+  uint32_t counter = 0;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    ++counter;
+
+    rtems_fast_mutex_lock(mtx);
+    rtems_fast_mutex_unlock(mtx);
+  }
+
+  ctx->one_fast_mutex_ops[active_workers - 1][worker_index] = counter;
+}
+
+static void test_one_fast_mutex_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    "OneFastMutex",
+    &ctx->one_fast_mutex_ops[active_workers - 1][0],
+    active_workers
+  );
+}
+
+static void test_many_fast_mutex_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  rtems_fast_mutex mtx;
+  uint32_t counter = 0;
+
+  rtems_fast_mutex_init(&mtx, "test");
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    ++counter;
+
+    rtems_fast_mutex_lock(&mtx);
+    rtems_fast_mutex_unlock(&mtx);
+  }
+
+  ctx->many_fast_mutex_ops[active_workers - 1][worker_index] = counter;
+
+  rtems_fast_mutex_destroy(&mtx);
+}
+
+static void test_many_fast_mutex_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    "ManyFastMutex",
+    &ctx->many_fast_mutex_ops[active_workers - 1][0],
+    active_workers
+  );
+}
+
 static const rtems_test_parallel_job test_jobs[] = {
   {
     .init = test_init,
@@ -758,6 +838,16 @@ static const rtems_test_parallel_job test_jobs[] = {
     .body = test_many_pthread_mutex_protect_body,
     .fini = test_many_pthread_mutex_protect_fini,
     .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_one_fast_mutex_body,
+    .fini = test_one_fast_mutex_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_many_fast_mutex_body,
+    .fini = test_many_fast_mutex_fini,
+    .cascade = true
   }
 };
 
@@ -771,6 +861,7 @@ static void Init(rtems_task_argument arg)
   TEST_BEGIN();
 
   ctx->master = rtems_task_self();
+  rtems_fast_mutex_init(&ctx->fast_mutex, "test");
 
   sc = rtems_semaphore_create(
     rtems_build_name('T', 'E', 'S', 'T'),
@@ -58,5 +58,8 @@ plt.plot(x, y, label = 'Pthread Mutex Inherit', marker = 'o')
 y = getCounterSums('ManyPthreadMutexProtect')
 plt.plot(x, y, label = 'Pthread Mutex Protect', marker = 'o')
 
+y = getCounterSums('ManyFastMutex')
+plt.plot(x, y, label = 'Fast Mutex', marker = 'o')
+
 plt.legend(loc = 'best')
 plt.show()
@@ -0,0 +1,255 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+#include <rtems/score/heapimpl.h>
+
+const char rtems_test_name[] = "TMHEAP 1";
+
+#define SAMPLES 100
+
+#define SMALL_SIZE 24
+
+#define LARGE_SIZE 4096
+
+typedef struct {
+  Heap_Control heap;
+  void *area;
+  uintptr_t area_size;
+  void **fragments;
+  size_t fragment_count;
+} test_context;
+
+static test_context test_instance;
+
+static void init_heap(
+  test_context *ctx,
+  Heap_Initialization_or_extend_handler init
+)
+{
+  uintptr_t size;
+
+  size = (*init)( &ctx->heap, ctx->area, ctx->area_size, 0 );
+  rtems_test_assert( size > 0 );
+}
+
+/*
+ * Allocates pairs of small blocks and frees the first block of each pair.  So,
+ * the heap contains the requested count of small free blocks followed by one
+ * large free block.
+ */
+static void fragment_heap( test_context *ctx, size_t free_blocks )
+{
+  size_t i;
+
+  for ( i = 0; i < free_blocks; ++i ) {
+    ctx->fragments[ 2 * i ] = _Heap_Allocate( &ctx->heap, SMALL_SIZE );
+    rtems_test_assert( ctx->fragments[ 2 * i ] != NULL );
+    ctx->fragments[ 2 * i + 1 ] = _Heap_Allocate( &ctx->heap, SMALL_SIZE );
+    rtems_test_assert( ctx->fragments[ 2 * i + 1 ] != NULL );
+  }
+
+  for ( i = 0; i < free_blocks; ++i ) {
+    bool ok;
+
+    ok = _Heap_Free( &ctx->heap, ctx->fragments[ 2 * i ] );
+    rtems_test_assert( ok );
+  }
+
+  rtems_test_assert( _Heap_Walk( &ctx->heap, 0, false ) );
+}
+
+static void measure(
+  test_context *ctx,
+  const char *name,
+  uintptr_t alloc_size
+)
+{
+  rtems_counter_ticks alloc_max;
+  rtems_counter_ticks free_max;
+  uint32_t max_search;
+  size_t i;
+
+  alloc_max = 0;
+  free_max = 0;
+  max_search = 0;
+
+  for ( i = 0; i < SAMPLES; ++i ) {
+    rtems_interrupt_level level;
+    rtems_counter_ticks a;
+    rtems_counter_ticks b;
+    rtems_counter_ticks c;
+    void *p;
+    bool ok;
+
+    ctx->heap.stats.max_search = 0;
+
+    rtems_interrupt_local_disable( level );
+    a = rtems_counter_read();
+    p = _Heap_Allocate( &ctx->heap, alloc_size );
+    b = rtems_counter_read();
+    ok = _Heap_Free( &ctx->heap, p );
+    c = rtems_counter_read();
+    rtems_interrupt_local_enable( level );
+
+    rtems_test_assert( p != NULL );
+    rtems_test_assert( ok );
+
+    a = rtems_counter_difference( b, a );
+    b = rtems_counter_difference( c, b );
+
+    if ( a > alloc_max ) {
+      alloc_max = a;
+    }
+
+    if ( b > free_max ) {
+      free_max = b;
+    }
+
+    if ( ctx->heap.stats.max_search > max_search ) {
+      max_search = ctx->heap.stats.max_search;
+    }
+  }
+
+  printf(
+    "      <%s size=\"%" PRIuPTR "\"><MaxSearch>%" PRIu32 "</MaxSearch>"
+    "<AllocateMax unit=\"ns\">%" PRIu64 "</AllocateMax>"
+    "<FreeMax unit=\"ns\">%" PRIu64 "</FreeMax></%s>\n",
+    name,
+    alloc_size,
+    max_search,
+    rtems_counter_ticks_to_nanoseconds( alloc_max ),
+    rtems_counter_ticks_to_nanoseconds( free_max ),
+    name
+  );
+}
+
+static void test_heap(
+  test_context *ctx,
+  const char *name,
+  Heap_Initialization_or_extend_handler init,
+  size_t free_blocks
+)
+{
+  init_heap( ctx, init );
+  fragment_heap( ctx, free_blocks );
+
+  printf( "    <%s>\n", name );
+  measure( ctx, "Small", SMALL_SIZE );
+  measure( ctx, "Large", LARGE_SIZE );
+  printf( "    </%s>\n", name );
+}
+
+static void test( test_context *ctx )
+{
+  size_t free_blocks;
+
+  ctx->area_size = 1024 * 1024;
+
+  while ( true ) {
+    ctx->area = malloc( ctx->area_size );
+
+    if ( ctx->area != NULL ) {
+      break;
+    }
+
+    ctx->area_size /= 2;
+    rtems_test_assert( ctx->area_size >= 64 * 1024 );
+  }
+
+  /*
+   * Leave one quarter of the area for the large free block at the end of the
+   * heap.
+   */
+  ctx->fragment_count = ( 3 * ctx->area_size / 4 )
+    / ( 2 * _Heap_Size_with_overhead( 0, SMALL_SIZE, 0 ) );
+  ctx->fragments = calloc( 2 * ctx->fragment_count, sizeof( void * ) );
+  rtems_test_assert( ctx->fragments != NULL );
+
+  printf( "<TMHeap01 areaSize=\"%" PRIuPTR "\">\n", ctx->area_size );
+
+  free_blocks = 0;
+
+  while ( true ) {
+    printf( "  <Sample>\n    <FreeBlocks>%zu</FreeBlocks>\n", free_blocks );
+    test_heap( ctx, "FirstFit", _Heap_Initialize, free_blocks );
+    test_heap(
+      ctx,
+      "SegregatedFit",
+      _Heap_Initialize_segregated_fit,
+      free_blocks
+    );
+    printf( "  </Sample>\n" );
+
+    if ( free_blocks == ctx->fragment_count ) {
+      break;
+    }
+
+    free_blocks = 2 * free_blocks + 1;
+
+    if ( free_blocks > ctx->fragment_count ) {
+      free_blocks = ctx->fragment_count;
+    }
+  }
+
+  printf( "</TMHeap01>\n" );
+
+  free( ctx->fragments );
+  free( ctx->area );
+}
+
+static void Init( rtems_task_argument arg )
+{
+  TEST_BEGIN();
+
+  test( &test_instance );
+
+  TEST_END();
+  rtems_test_exit( 0 );
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,295 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <semaphore.h>
+#include <stdio.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+#include <rtems/posix/semaphoreimpl.h>
+#include <rtems/rtems/semimpl.h>
+
+const char rtems_test_name[] = "TMIDENT 1";
+
+#define OBJECT_COUNT 10000
+
+typedef struct {
+  rtems_id semaphores[ OBJECT_COUNT ];
+  sem_t *named_semaphores[ OBJECT_COUNT ];
+} test_context;
+
+static test_context test_instance;
+
+static rtems_name semaphore_name( size_t i )
+{
+  return rtems_build_name( 'S', 'E', (char) ( i >> 8 ), (char) i );
+}
+
+static void named_semaphore_name( char name[ 8 ], size_t i )
+{
+  snprintf( name, 8, "/S%05zu", i );
+}
+
+static void create( test_context *ctx, size_t i )
+{
+  rtems_status_code sc;
+  char name[ 8 ];
+
+  sc = rtems_semaphore_create(
+    semaphore_name( i ),
+    1,
+    RTEMS_COUNTING_SEMAPHORE,
+    0,
+    &ctx->semaphores[ i ]
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  named_semaphore_name( name, i );
+  ctx->named_semaphores[ i ] = sem_open( name, O_CREAT | O_EXCL, 0777, 0 );
+  rtems_test_assert( ctx->named_semaphores[ i ] != SEM_FAILED );
+}
+
+static uint64_t semaphore_ident( test_context *ctx, size_t i )
+{
+  rtems_status_code sc;
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  rtems_id id;
+
+  a = rtems_counter_read();
+  sc = rtems_semaphore_ident(
+    semaphore_name( i ),
+    RTEMS_SEARCH_LOCAL_NODE,
+    &id
+  );
+  b = rtems_counter_read();
+
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( id == ctx->semaphores[ i ] );
+
+  return rtems_counter_ticks_to_nanoseconds( rtems_counter_difference( b, a ) );
+}
+
+static uint64_t named_semaphore_open( test_context *ctx, size_t i )
+{
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  char name[ 8 ];
+  sem_t *sem;
+  int rv;
+
+  named_semaphore_name( name, i );
+
+  a = rtems_counter_read();
+  sem = sem_open( name, 0 );
+  b = rtems_counter_read();
+
+  rtems_test_assert( sem == ctx->named_semaphores[ i ] );
+
+  rv = sem_close( sem );
+  rtems_test_assert( rv == 0 );
+
+  return rtems_counter_ticks_to_nanoseconds( rtems_counter_difference( b, a ) );
+}
+
+static void print_time( const char *name, uint64_t ns )
+{
+  printf( "<%s unit=\"ns\">%" PRIu64 "</%s>", name, ns, name );
+}
+
+static void test_case( test_context *ctx, size_t n )
+{
+  Objects_Name_index *semaphore_index;
+  Objects_Name_index *named_semaphore_index;
+  uint64_t indexed;
+  uint64_t table;
+
+  semaphore_index = _Semaphore_Information.name_index;
+  named_semaphore_index = _POSIX_Semaphore_Information.name_index;
+  rtems_test_assert( semaphore_index != NULL );
+  rtems_test_assert( named_semaphore_index != NULL );
+
+  printf( "  <Sample>\n    <ObjectCount>%zu</ObjectCount>\n", n );
+
+  /*
+   * The last object is the worst case for the table search.  Temporarily drop
+   * the name index to measure the table search.  Nothing changes the
+   * namespace in the meantime.
+   */
+  indexed = semaphore_ident( ctx, n - 1 );
+  _Semaphore_Information.name_index = NULL;
+  table = semaphore_ident( ctx, n - 1 );
+  _Semaphore_Information.name_index = semaphore_index;
+
+  printf( "    <SemaphoreIdent>" );
+  print_time( "Index", indexed );
+  print_time( "Table", table );
+  printf( "</SemaphoreIdent>\n" );
+
+  indexed = named_semaphore_open( ctx, n - 1 );
+  _POSIX_Semaphore_Information.name_index = NULL;
+  table = named_semaphore_open( ctx, n - 1 );
+  _POSIX_Semaphore_Information.name_index = named_semaphore_index;
+
+  printf( "    <SemOpen>" );
+  print_time( "Index", indexed );
+  print_time( "Table", table );
+  printf( "</SemOpen>\n  </Sample>\n" );
+}
+
+static void test_namespace( test_context *ctx )
+{
+  rtems_status_code sc;
+  rtems_id id;
+  rtems_id other;
+  sem_t *sem;
+  int rv;
+
+  /* Duplicate names yield the object with the lowest index */
+  sc = rtems_semaphore_delete( ctx->semaphores[ 0 ] );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_semaphore_ident(
+    semaphore_name( 0 ),
+    RTEMS_SEARCH_LOCAL_NODE,
+    &id
+  );
+  rtems_test_assert( sc == RTEMS_INVALID_NAME );
+
+  sc = rtems_semaphore_create(
+    semaphore_name( 1 ),
+    1,
+    RTEMS_COUNTING_SEMAPHORE,
+    0,
+    &ctx->semaphores[ 0 ]
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( ctx->semaphores[ 0 ] < ctx->semaphores[ 1 ] );
+
+  sc = rtems_semaphore_ident(
+    semaphore_name( 1 ),
+    RTEMS_SEARCH_LOCAL_NODE,
+    &id
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( id == ctx->semaphores[ 0 ] );
+
+  /* A new name moves the object in the index */
+  sc = rtems_object_set_name( ctx->semaphores[ 0 ], "NEW" );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_semaphore_ident(
+    rtems_build_name( 'N', 'E', 'W', ' ' ),
+    RTEMS_SEARCH_LOCAL_NODE,
+    &id
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( id == ctx->semaphores[ 0 ] );
+
+  sc = rtems_semaphore_ident(
+    semaphore_name( 1 ),
+    RTEMS_SEARCH_LOCAL_NODE,
+    &other
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( other == ctx->semaphores[ 1 ] );
+
+  /* An unlinked named semaphore leaves the index */
+  rv = sem_unlink( "/S00000" );
+  rtems_test_assert( rv == 0 );
+
+  sem = sem_open( "/S00000", 0 );
+  rtems_test_assert( sem == SEM_FAILED );
+  rtems_test_assert( errno == ENOENT );
+
+  rv = sem_close( ctx->named_semaphores[ 0 ] );
+  rtems_test_assert( rv == 0 );
+}
+
+static void test( void )
+{
+  test_context *ctx = &test_instance;
+  size_t i;
+  size_t n;
+
+  printf( "<TMIdent01 objectCount=\"%i\">\n", OBJECT_COUNT );
+
+  i = 0;
+  n = 1;
+
+  while ( n <= OBJECT_COUNT ) {
+    while ( i < n ) {
+      create( ctx, i );
+      ++i;
+    }
+
+    test_case( ctx, n );
+    n *= 10;
+  }
+
+  printf( "</TMIdent01>\n" );
+
+  test_namespace( ctx );
+}
+
+static void Init( rtems_task_argument arg )
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit( 0 );
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES OBJECT_COUNT
+
+#define CONFIGURE_MAXIMUM_POSIX_SEMAPHORES OBJECT_COUNT
+
+#define CONFIGURE_OBJECT_NAME_INDEX
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,399 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+
+const char rtems_test_name[] = "TMMSGREF 1";
+
+#define FRAME_SIZE_MAX ( 64 * 1024 )
+
+#define MESSAGE_COUNT 4
+
+#define ITERATIONS 100
+
+#define RECEIVER_COUNT 2
+
+typedef struct {
+  rtems_id copy_queue;
+  rtems_id reference_queue;
+  rtems_id receivers[ RECEIVER_COUNT ];
+  uint32_t received[ RECEIVER_COUNT ];
+  uint8_t frame[ FRAME_SIZE_MAX ];
+  uint8_t receive_frame[ FRAME_SIZE_MAX ];
+} test_context;
+
+static test_context test_instance;
+
+static uint64_t copy_frames( test_context *ctx, size_t frame_size )
+{
+  rtems_status_code sc;
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  size_t size;
+  int i;
+
+  a = rtems_counter_read();
+
+  for ( i = 0; i < ITERATIONS; ++i ) {
+    sc = rtems_message_queue_send( ctx->copy_queue, ctx->frame, frame_size );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+    sc = rtems_message_queue_receive(
+      ctx->copy_queue,
+      ctx->receive_frame,
+      &size,
+      RTEMS_NO_WAIT,
+      0
+    );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+    rtems_test_assert( size == frame_size );
+  }
+
+  b = rtems_counter_read();
+
+  return rtems_counter_ticks_to_nanoseconds( rtems_counter_difference( b, a ) )
+    / ITERATIONS;
+}
+
+static uint64_t pass_frames( test_context *ctx, size_t frame_size )
+{
+  rtems_status_code sc;
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  void *buffer;
+  void *received;
+  size_t size;
+  int i;
+
+  a = rtems_counter_read();
+
+  for ( i = 0; i < ITERATIONS; ++i ) {
+    sc = rtems_message_queue_get_buffer( ctx->reference_queue, &buffer );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+    sc = rtems_message_queue_send_reference(
+      ctx->reference_queue,
+      buffer,
+      frame_size
+    );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+    sc = rtems_message_queue_receive_reference(
+      ctx->reference_queue,
+      &received,
+      &size,
+      RTEMS_NO_WAIT,
+      0
+    );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+    rtems_test_assert( received == buffer );
+    rtems_test_assert( size == frame_size );
+
+    sc = rtems_message_queue_return_buffer( ctx->reference_queue, received );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  }
+
+  b = rtems_counter_read();
+
+  return rtems_counter_ticks_to_nanoseconds( rtems_counter_difference( b, a ) )
+    / ITERATIONS;
+}
+
+static void print_time( const char *name, uint64_t ns )
+{
+  printf( "<%s unit=\"ns\">%" PRIu64 "</%s>", name, ns, name );
+}
+
+static uint32_t get_all_buffers( test_context *ctx, void **buffers )
+{
+  rtems_status_code sc;
+  uint32_t n;
+
+  n = 0;
+
+  while ( true ) {
+    sc = rtems_message_queue_get_buffer( ctx->reference_queue, &buffers[ n ] );
+
+    if ( sc != RTEMS_SUCCESSFUL ) {
+      rtems_test_assert( sc == RTEMS_UNSATISFIED );
+      break;
+    }
+
+    rtems_test_assert( n < MESSAGE_COUNT );
+    ++n;
+  }
+
+  return n;
+}
+
+static void return_all_buffers( test_context *ctx, void **buffers, uint32_t n )
+{
+  rtems_status_code sc;
+  uint32_t i;
+
+  for ( i = 0; i < n; ++i ) {
+    sc = rtems_message_queue_return_buffer(
+      ctx->reference_queue,
+      buffers[ i ]
+    );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  }
+}
+
+static void receiver( rtems_task_argument arg )
+{
+  test_context *ctx = &test_instance;
+
+  while ( true ) {
+    rtems_status_code sc;
+    void *buffer;
+    size_t size;
+
+    sc = rtems_message_queue_receive_reference(
+      ctx->reference_queue,
+      &buffer,
+      &size,
+      RTEMS_WAIT,
+      RTEMS_NO_TIMEOUT
+    );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+    rtems_test_assert( size == 1 );
+    rtems_test_assert( *(uint8_t *) buffer == 0xa5 );
+
+    ++ctx->received[ arg ];
+
+    sc = rtems_message_queue_return_buffer( ctx->reference_queue, buffer );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  }
+}
+
+static void test_ownership( test_context *ctx )
+{
+  rtems_status_code sc;
+  void *buffers[ MESSAGE_COUNT ];
+  void *buffer;
+  uint32_t count;
+  uint32_t n;
+  size_t size;
+  uint8_t external;
+  size_t i;
+
+  /* The copying and passing directives do not mix */
+  sc = rtems_message_queue_send( ctx->reference_queue, &external, 1 );
+  rtems_test_assert( sc == RTEMS_NOT_DEFINED );
+
+  sc = rtems_message_queue_get_buffer( ctx->copy_queue, &buffer );
+  rtems_test_assert( sc == RTEMS_NOT_DEFINED );
+
+  sc = rtems_message_queue_return_buffer( ctx->reference_queue, &external );
+  rtems_test_assert( sc == RTEMS_INVALID_ADDRESS );
+
+  n = get_all_buffers( ctx, buffers );
+  rtems_test_assert( n == MESSAGE_COUNT );
+
+  sc = rtems_message_queue_send_reference(
+    ctx->reference_queue,
+    buffers[ 0 ],
+    FRAME_SIZE_MAX + 1
+  );
+  rtems_test_assert( sc == RTEMS_INVALID_SIZE );
+
+  /* Urgent messages overtake, external buffers pass as is */
+  sc = rtems_message_queue_send_reference(
+    ctx->reference_queue,
+    buffers[ 0 ],
+    1
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_message_queue_urgent_reference(
+    ctx->reference_queue,
+    &external,
+    1
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_message_queue_receive_reference(
+    ctx->reference_queue,
+    &buffer,
+    &size,
+    RTEMS_NO_WAIT,
+    0
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( buffer == &external );
+
+  /* The flush returns the buffers of the pending messages */
+  sc = rtems_message_queue_flush( ctx->reference_queue, &count );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( count == 1 );
+
+  return_all_buffers( ctx, &buffers[ 1 ], n - 1 );
+  n = get_all_buffers( ctx, buffers );
+  rtems_test_assert( n == MESSAGE_COUNT );
+  return_all_buffers( ctx, &buffers[ 1 ], n - 1 );
+
+  /* Each receiver of a broadcast owns a reference */
+  for ( i = 0; i < RECEIVER_COUNT; ++i ) {
+    sc = rtems_task_create(
+      rtems_build_name( 'R', 'E', 'C', 'V' ),
+      1,
+      RTEMS_MINIMUM_STACK_SIZE,
+      RTEMS_DEFAULT_MODES,
+      RTEMS_DEFAULT_ATTRIBUTES,
+      &ctx->receivers[ i ]
+    );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+    sc = rtems_task_start( ctx->receivers[ i ], receiver, i );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  }
+
+  *(uint8_t *) buffers[ 0 ] = 0xa5;
+  sc = rtems_message_queue_broadcast_reference(
+    ctx->reference_queue,
+    buffers[ 0 ],
+    1,
+    &count
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( count == RECEIVER_COUNT );
+
+  for ( i = 0; i < RECEIVER_COUNT; ++i ) {
+    rtems_test_assert( ctx->received[ i ] == 1 );
+
+    sc = rtems_task_delete( ctx->receivers[ i ] );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  }
+
+  n = get_all_buffers( ctx, buffers );
+  rtems_test_assert( n == MESSAGE_COUNT );
+
+  /* A broadcast without receivers returns the buffer */
+  sc = rtems_message_queue_broadcast_reference(
+    ctx->reference_queue,
+    buffers[ 0 ],
+    1,
+    &count
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( count == 0 );
+
+  return_all_buffers( ctx, &buffers[ 1 ], n - 1 );
+  n = get_all_buffers( ctx, buffers );
+  rtems_test_assert( n == MESSAGE_COUNT );
+  return_all_buffers( ctx, buffers, n );
+}
+
+static void test( void )
+{
+  test_context *ctx = &test_instance;
+  rtems_status_code sc;
+  size_t frame_size;
+
+  sc = rtems_message_queue_create(
+    rtems_build_name( 'C', 'O', 'P', 'Y' ),
+    MESSAGE_COUNT,
+    FRAME_SIZE_MAX,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &ctx->copy_queue
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_message_queue_create(
+    rtems_build_name( 'R', 'E', 'F', ' ' ),
+    MESSAGE_COUNT,
+    FRAME_SIZE_MAX,
+    RTEMS_MESSAGE_BY_REFERENCE,
+    &ctx->reference_queue
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  memset( ctx->frame, 0xa5, sizeof( ctx->frame ) );
+
+  printf( "<TMMsgRef01 iterations=\"%i\">\n", ITERATIONS );
+
+  for ( frame_size = 4096; frame_size <= FRAME_SIZE_MAX; frame_size *= 4 ) {
+    printf( "  <Sample>\n    <FrameSize>%zu</FrameSize>\n    ", frame_size );
+    print_time( "Copy", copy_frames( ctx, frame_size ) );
+    print_time( "Reference", pass_frames( ctx, frame_size ) );
+    printf( "\n  </Sample>\n" );
+  }
+
+  printf( "</TMMsgRef01>\n" );
+
+  test_ownership( ctx );
+
+  sc = rtems_message_queue_delete( ctx->copy_queue );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_message_queue_delete( ctx->reference_queue );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+}
+
+static void Init( rtems_task_argument arg )
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit( 0 );
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS ( 1 + RECEIVER_COUNT )
+
+#define CONFIGURE_MAXIMUM_MESSAGE_QUEUES 2
+
+#define CONFIGURE_MESSAGE_BUFFER_MEMORY \
+  ( CONFIGURE_MESSAGE_BUFFERS_FOR_QUEUE( MESSAGE_COUNT, FRAME_SIZE_MAX ) \
+    + CONFIGURE_MESSAGE_BUFFERS_FOR_REFERENCE_QUEUE( \
+      MESSAGE_COUNT, \
+      FRAME_SIZE_MAX \
+    ) )
+
+#define CONFIGURE_INIT_TASK_PRIORITY 2
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
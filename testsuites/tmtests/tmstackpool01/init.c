@@ -0,0 +1,295 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+#include <rtems/stackpool.h>
+
+/*
+ * This file is built twice.  The TMSTACKPOOL 2 build allocates the task stacks
+ * from the workspace and provides the baseline for the stack pool results of
+ * TMSTACKPOOL 1.
+ */
+#ifdef TMSTACKPOOL_WORKSPACE
+const char rtems_test_name[] = "TMSTACKPOOL 2";
+
+#define TEST_TAG "TMStackPool02"
+
+#define ALLOCATOR "workspace"
+#else
+const char rtems_test_name[] = "TMSTACKPOOL 1";
+
+#define TEST_TAG "TMStackPool01"
+
+#define ALLOCATOR "pool"
+#endif
+
+#define LIVE_TASKS 16
+
+#define SAMPLES 200
+
+#define STACK_UNIT RTEMS_MINIMUM_STACK_SIZE
+
+#define INIT_TASK_STACK_SIZE ( 2 * STACK_UNIT )
+
+typedef struct {
+  rtems_id tasks[ LIVE_TASKS ];
+  rtems_counter_ticks create[ SAMPLES ];
+  rtems_counter_ticks delete[ SAMPLES ];
+  uint32_t seed;
+} test_context;
+
+static test_context test_instance;
+
+static uint32_t next_random( test_context *ctx )
+{
+  ctx->seed = ctx->seed * 1103515245 + 12345;
+
+  return ctx->seed >> 8;
+}
+
+static int cmp( const void *ap, const void *bp )
+{
+  const rtems_counter_ticks *a = ap;
+  const rtems_counter_ticks *b = bp;
+
+  return *a < *b ? -1 : ( *a > *b ? 1 : 0 );
+}
+
+static void print_times( const char *name, rtems_counter_ticks *t )
+{
+  qsort( t, SAMPLES, sizeof( t[ 0 ] ), cmp );
+
+  printf(
+    "    <%s><Min unit=\"ns\">%" PRIu64 "</Min>"
+      "<Median unit=\"ns\">%" PRIu64 "</Median>"
+      "<Max unit=\"ns\">%" PRIu64 "</Max></%s>\n",
+    name,
+    rtems_counter_ticks_to_nanoseconds( t[ 0 ] ),
+    rtems_counter_ticks_to_nanoseconds( t[ SAMPLES / 2 ] ),
+    rtems_counter_ticks_to_nanoseconds( t[ SAMPLES - 1 ] ),
+    name
+  );
+}
+
+static rtems_id create_task( test_context *ctx )
+{
+  rtems_status_code sc;
+  rtems_id id;
+
+  sc = rtems_task_create(
+    rtems_build_name( 'C', 'H', 'R', 'N' ),
+    2,
+    ( 1 + next_random( ctx ) % 4 ) * STACK_UNIT,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  return id;
+}
+
+static void delete_task( rtems_id id )
+{
+  rtems_status_code sc;
+
+  sc = rtems_task_delete( id );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+}
+
+static void test_churn( test_context *ctx )
+{
+#ifndef TMSTACKPOOL_WORKSPACE
+  uint32_t workspace_allocations;
+#endif
+  size_t i;
+
+#ifndef TMSTACKPOOL_WORKSPACE
+  workspace_allocations = rtems_stack_pool_get_workspace_allocations();
+#endif
+
+  for ( i = 0; i < LIVE_TASKS; ++i ) {
+    ctx->tasks[ i ] = create_task( ctx );
+  }
+
+  for ( i = 0; i < SAMPLES; ++i ) {
+    rtems_counter_ticks a;
+    rtems_counter_ticks b;
+    rtems_counter_ticks c;
+    size_t j;
+
+    j = next_random( ctx ) % LIVE_TASKS;
+
+    /*
+     * The stack of a deleted task is freed during the next task creation, so
+     * the create time includes the stack free.
+     */
+    a = rtems_counter_read();
+    delete_task( ctx->tasks[ j ] );
+    b = rtems_counter_read();
+    ctx->tasks[ j ] = create_task( ctx );
+    c = rtems_counter_read();
+
+    ctx->delete[ i ] = rtems_counter_difference( b, a );
+    ctx->create[ i ] = rtems_counter_difference( c, b );
+  }
+
+  for ( i = 0; i < LIVE_TASKS; ++i ) {
+    delete_task( ctx->tasks[ i ] );
+  }
+
+  printf( "  <Churn allocator=\"" ALLOCATOR "\">\n" );
+  print_times( "Create", ctx->create );
+  print_times( "Delete", ctx->delete );
+
+#ifndef TMSTACKPOOL_WORKSPACE
+  workspace_allocations =
+    rtems_stack_pool_get_workspace_allocations() - workspace_allocations;
+  rtems_test_assert( workspace_allocations == 0 );
+#endif
+
+  printf( "  </Churn>\n" );
+}
+
+#ifndef TMSTACKPOOL_WORKSPACE
+
+static void test_sample( test_context *ctx )
+{
+  rtems_status_code sc;
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  size_t high_water;
+  size_t i;
+
+  for ( i = 0; i < LIVE_TASKS; ++i ) {
+    ctx->tasks[ i ] = create_task( ctx );
+  }
+
+  a = rtems_counter_read();
+  rtems_stack_pool_sample();
+  b = rtems_counter_read();
+
+  for ( i = 0; i < LIVE_TASKS; ++i ) {
+    delete_task( ctx->tasks[ i ] );
+  }
+
+  sc = rtems_stack_pool_get_high_water( RTEMS_SELF, &high_water );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( high_water > 0 );
+  rtems_test_assert( high_water < INIT_TASK_STACK_SIZE );
+
+  printf(
+    "  <Sample taskCount=\"%i\">"
+      "<Time unit=\"ns\">%" PRIu64 "</Time></Sample>\n",
+    LIVE_TASKS + 1,
+    rtems_counter_ticks_to_nanoseconds( rtems_counter_difference( b, a ) )
+  );
+}
+
+static void test_class_information( void )
+{
+  rtems_stack_pool_class_information info;
+  rtems_status_code sc;
+  size_t i;
+
+  for ( i = 0; i < rtems_stack_pool_class_count; ++i ) {
+    sc = rtems_stack_pool_get_class_information( i, &info );
+    rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+    rtems_test_assert(
+      info.stack_size == rtems_stack_pool_classes[ i ].stack_size
+    );
+    rtems_test_assert( info.max_used <= info.stack_count );
+    rtems_test_assert( info.max_high_water < info.stack_size );
+  }
+
+  sc = rtems_stack_pool_get_class_information( i, &info );
+  rtems_test_assert( sc == RTEMS_INVALID_NUMBER );
+}
+#endif
+
+static void Init( rtems_task_argument arg )
+{
+  test_context *ctx = &test_instance;
+
+  TEST_BEGIN();
+
+  ctx->seed = 123;
+
+  printf( "<" TEST_TAG " liveTasks=\"%i\">\n", LIVE_TASKS );
+  test_churn( ctx );
+#ifndef TMSTACKPOOL_WORKSPACE
+  test_sample( ctx );
+#endif
+  printf( "</" TEST_TAG ">\n" );
+
+#ifndef TMSTACKPOOL_WORKSPACE
+  test_class_information();
+#endif
+
+  TEST_END();
+  rtems_test_exit( 0 );
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS ( 1 + LIVE_TASKS )
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE INIT_TASK_STACK_SIZE
+
+#ifdef TMSTACKPOOL_WORKSPACE
+#define CONFIGURE_EXTRA_TASK_STACKS \
+  ( ( LIVE_TASKS + 1 ) * 4 * STACK_UNIT )
+#else
+/*
+ * A deleted task may still own its stack during the next task creation, so
+ * each class has room for one more stack than the live tasks need.  The
+ * initialization task stack is in the first class.
+ */
+#define CONFIGURE_TASK_STACK_POOL \
+  RTEMS_STACK_POOL_CLASS( 2 * STACK_UNIT, LIVE_TASKS + 2 ) \
+  RTEMS_STACK_POOL_CLASS( 4 * STACK_UNIT, LIVE_TASKS + 1 )
+
+#define CONFIGURE_TASK_STACK_POOL_PAINTING
+#endif
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,229 @@
+/*
+ * SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+#include <rtems/score/watchdogimpl.h>
+
+const char rtems_test_name[] = "TMWATCHDOG 1";
+
+#define WATCHDOG_COUNT 10000
+
+#define TICK_COUNT 1000
+
+typedef struct {
+  Watchdog_Header header;
+  Watchdog_Control watchdogs[ WATCHDOG_COUNT ];
+  uint64_t now;
+  uint32_t seed;
+  size_t fired;
+} test_context;
+
+static test_context test_instance;
+
+static void fire( Watchdog_Control *the_watchdog )
+{
+  test_context *ctx = &test_instance;
+
+  rtems_test_assert( the_watchdog->expire <= ctx->now );
+  ++ctx->fired;
+}
+
+static uint32_t next_random( test_context *ctx )
+{
+  ctx->seed = ctx->seed * 1103515245 + 12345;
+
+  return ctx->seed >> 8;
+}
+
+static uint64_t ticks_to_ns( rtems_counter_ticks a, rtems_counter_ticks b )
+{
+  return rtems_counter_ticks_to_nanoseconds( rtems_counter_difference( b, a ) );
+}
+
+static void tick( test_context *ctx )
+{
+  ISR_LOCK_DEFINE( , lock, "Test" )
+  ISR_lock_Context lock_context;
+  Watchdog_Control *first;
+
+  _ISR_lock_ISR_disable_and_acquire( &lock, &lock_context );
+
+  ++ctx->now;
+  first = _Watchdog_Header_first( &ctx->header );
+
+  if ( first != NULL ) {
+    _Watchdog_Tickle(
+      &ctx->header,
+      first,
+      ctx->now,
+      &lock,
+      &lock_context
+    );
+  }
+
+  _ISR_lock_Release_and_ISR_enable( &lock, &lock_context );
+  _ISR_lock_Destroy( &lock );
+}
+
+static void insert_all( test_context *ctx, size_t n, uint64_t offset )
+{
+  size_t i;
+
+  for ( i = 0; i < n; ++i ) {
+    _Watchdog_Insert(
+      &ctx->header,
+      &ctx->watchdogs[ i ],
+      ctx->now + offset + next_random( ctx ) % ( 4 * TICK_COUNT )
+    );
+  }
+}
+
+static void remove_all( test_context *ctx, size_t n )
+{
+  size_t i;
+
+  for ( i = 0; i < n; ++i ) {
+    _Watchdog_Remove( &ctx->header, &ctx->watchdogs[ i ] );
+  }
+}
+
+static void print_time( const char *name, uint64_t ns )
+{
+  printf( "<%s unit=\"ns\">%" PRIu64 "</%s>", name, ns, name );
+}
+
+static void test_case( test_context *ctx, size_t n )
+{
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  uint64_t insert;
+  uint64_t remove;
+  uint64_t idle_tick;
+  uint64_t busy_tick;
+  size_t i;
+
+  /* Mostly cancelled timeouts: insert and remove all watchdogs */
+  a = rtems_counter_read();
+  insert_all( ctx, n, 1 );
+  b = rtems_counter_read();
+  insert = ticks_to_ns( a, b ) / n;
+
+  a = rtems_counter_read();
+  remove_all( ctx, n );
+  b = rtems_counter_read();
+  remove = ticks_to_ns( a, b ) / n;
+
+  /* Ticks with outstanding watchdogs in the future */
+  insert_all( ctx, n, TICK_COUNT + 1 );
+  ctx->fired = 0;
+
+  a = rtems_counter_read();
+
+  for ( i = 0; i < TICK_COUNT; ++i ) {
+    tick( ctx );
+  }
+
+  b = rtems_counter_read();
+  idle_tick = ticks_to_ns( a, b ) / TICK_COUNT;
+  rtems_test_assert( ctx->fired == 0 );
+
+  /* Ticks which let all watchdogs expire */
+  a = rtems_counter_read();
+
+  for ( i = 0; i < 4 * TICK_COUNT; ++i ) {
+    tick( ctx );
+  }
+
+  b = rtems_counter_read();
+  busy_tick = ticks_to_ns( a, b ) / ( 4 * TICK_COUNT );
+  rtems_test_assert( ctx->fired == n );
+  rtems_test_assert( _Watchdog_Header_first( &ctx->header ) == NULL );
+
+  printf( "  <Sample>\n    <WatchdogCount>%zu</WatchdogCount>\n    ", n );
+  print_time( "Insert", insert );
+  print_time( "Remove", remove );
+  printf( "\n    " );
+  print_time( "IdleTick", idle_tick );
+  print_time( "BusyTick", busy_tick );
+  printf( "\n  </Sample>\n" );
+}
+
+static void test( void )
+{
+  test_context *ctx = &test_instance;
+  size_t i;
+  size_t n;
+
+  _Watchdog_Header_initialize( &ctx->header );
+  ctx->seed = 123;
+
+  for ( i = 0; i < WATCHDOG_COUNT; ++i ) {
+    _Watchdog_Preinitialize( &ctx->watchdogs[ i ], _Per_CPU_Get_snapshot() );
+    _Watchdog_Initialize( &ctx->watchdogs[ i ], fire );
+  }
+
+  printf( "<TMWatchdog01 tickCount=\"%i\">\n", TICK_COUNT );
+
+  for ( n = 1; n <= WATCHDOG_COUNT; n *= 10 ) {
+    test_case( ctx, n );
+  }
+
+  printf( "</TMWatchdog01>\n" );
+
+  _Watchdog_Header_destroy( &ctx->header );
+}
+
+static void Init( rtems_task_argument arg )
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit( 0 );
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>